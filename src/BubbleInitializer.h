@@ -42,8 +42,8 @@ inline BubbleData createBubblesRandomDist(
     while(bubbleCounter < numBubbles) {
         auto coord = sys.getCompartmentGrid()->getRandomCoordinates();
         if(
-            b.within(mathfunc::vec2Vector(coord)) &&
-            b.distance(mathfunc::vec2Vector(coord)) > mechParams.BubbleRadius[bubbleType]
+            b.within(coord) &&
+            b.distance(coord) > mechParams.BubbleRadius[bubbleType]
         ) {
             ret.bubbles.push_back({ bubbleType, coord });
             ++bubbleCounter;
@@ -74,8 +74,8 @@ void BranchingManager::addPossibleBindings(CCylinder* cc, short bindingSite) {
             auto mp = (float) bindingSite /
                       SysParams::Geometry().cylinderNumMon[_filamentType];
 
-            auto x1 = cc->getCylinder()->getFirstBead()->vcoordinate();
-            auto x2 = cc->getCylinder()->getSecondBead()->vcoordinate();
+            const auto& x1 = cc->getCylinder()->getFirstBead()->coordinate();
+            const auto& x2 = cc->getCylinder()->getSecondBead()->coordinate();
 
             auto coord = midPointCoordinate(x1, x2, mp);
 
@@ -85,7 +85,7 @@ void BranchingManager::addPossibleBindings(CCylinder* cc, short bindingSite) {
             if(_subSystem->membranes.size()) {
                 if(cc->getCompartment()->isActivated()) {
                     if(cc->getCompartment()->getVolumeFrac() < 1.0) // Not fully activated
-                        if(!medyan::contains(*_subSystem, _subSystem->membranes.begin()->getMesh(), vector2Vec<3, floatingpoint>(coord)))
+                        if(!medyan::contains(*_subSystem, _subSystem->membranes.begin()->getMesh(), coord))
                             inZone = false;
                 }
                 else inZone = false;
@@ -200,8 +200,8 @@ void BranchingManager::updateAllPossibleBindings() {
 
                 auto mp = (float)*it / SysParams::Geometry().cylinderNumMon[_filamentType];
 
-                auto x1 = cc->getCylinder()->getFirstBead()->vcoordinate();
-                auto x2 = cc->getCylinder()->getSecondBead()->vcoordinate();
+                const auto& x1 = cc->getCylinder()->getFirstBead()->coordinate();
+                const auto& x2 = cc->getCylinder()->getSecondBead()->coordinate();
 
                 auto coord = midPointCoordinate(x1, x2, mp);
 
@@ -211,7 +211,7 @@ void BranchingManager::updateAllPossibleBindings() {
                     if(_subSystem->membranes.size()) {
                         if(cc->getCompartment()->isActivated()) {
                             if(cc->getCompartment()->getVolumeFrac() < 1.0) // Not fully activated
-                                if(!medyan::contains(*_subSystem, _subSystem->membranes.begin()->getMesh(), vector2Vec<3, floatingpoint>(coord)))
+                                if(!medyan::contains(*_subSystem, _subSystem->membranes.begin()->getMesh(), coord))
                                     inZone = false;
                         }
                         else inZone = false;
@@ -342,8 +342,8 @@ void BranchingManager::addPossibleBindingsstencil(CCylinder* cc, short bindingSi
 
         auto mp = (float)bindingSite / SysParams::Geometry().cylinderNumMon[_filamentType];
 
-        auto x1 = cc->getCylinder()->getFirstBead()->vcoordinate();
-        auto x2 = cc->getCylinder()->getSecondBead()->vcoordinate();
+        const auto& x1 = cc->getCylinder()->getFirstBead()->coordinate();
+        const auto& x2 = cc->getCylinder()->getSecondBead()->coordinate();
 
         auto coord = midPointCoordinate(x1, x2, mp);
 
@@ -419,8 +419,8 @@ void BranchingManager::updateAllPossibleBindingsstencil() {
 
                 auto mp = (float)*it / SysParams::Geometry().cylinderNumMon[_filamentType];
 
-                auto x1 = cc->getCylinder()->getFirstBead()->vcoordinate();
-                auto x2 = cc->getCylinder()->getSecondBead()->vcoordinate();
+                const auto& x1 = cc->getCylinder()->getFirstBead()->coordinate();
+                const auto& x2 = cc->getCylinder()->getSecondBead()->coordinate();
 
                 auto coord = midPointCoordinate(x1, x2, mp);
 
@@ -462,8 +462,8 @@ void BranchingManager::updateAllPossibleBindingsstencil() {
             if (areEqual(boundstate[0][maxnbs * c->getStableIndex() + j], (floatingpoint)1.0) && inZone) {
 //                output test
 //                auto mp = (float)*it / SysParams::Geometry().cylinderNumMon[_filamentType];
-//                auto x1 = cc->getCylinder()->getFirstBead()->vcoordinate();
-//                auto x2 = cc->getCylinder()->getSecondBead()->vcoordinate();
+//                const auto& x1 = cc->getCylinder()->getFirstBead()->coordinate();
+//                const auto& x2 = cc->getCylinder()->getSecondBead()->coordinate();
 //
 //                auto coord = midPointCoordinate(x1, x2, mp);
 //                std::cout<<c->_dcIndex<<" "<<*it<<" "<<_subSystem->getBoundary()->distance(coord)<<endl;
@@ -682,7 +682,7 @@ void LinkerBindingManager::addPossibleBindings(CCylinder* cc, short bindingSite)
 
             //loop through neighbors
             //now re add valid based on CCNL
-            vector<Cylinder *> nList = _neighborLists[_nlIndex]->getNeighbors(
+            auto nList = _neighborLists[_nlIndex]->getNeighbors(
                     cc->getCylinder());
             for (auto cn : nList) {
                 Cylinder *c = cc->getCylinder();
@@ -715,10 +715,10 @@ void LinkerBindingManager::addPossibleBindings(CCylinder* cc, short bindingSite)
                         auto mp2 = (float) *it /
                                     SysParams::Geometry().cylinderNumMon[_nfilamentType];
 
-                        auto x1 = c->getFirstBead()->vcoordinate();
-                        auto x2 = c->getSecondBead()->vcoordinate();
-                        auto x3 = cn->getFirstBead()->vcoordinate();
-                        auto x4 = cn->getSecondBead()->vcoordinate();
+                        const auto& x1 = c->getFirstBead()->coordinate();
+                        const auto& x2 = c->getSecondBead()->coordinate();
+                        const auto& x3 = cn->getFirstBead()->coordinate();
+                        const auto& x4 = cn->getSecondBead()->coordinate();
 
                         auto m1 = midPointCoordinate(x1, x2, mp1);
                         auto m2 = midPointCoordinate(x3, x4, mp2);
@@ -1198,10 +1198,10 @@ void LinkerBindingManager::addPossibleBindingsstencil(CCylinder* cc, short bindi
                         auto mp2 = (float) *it /
                                     SysParams::Geometry().cylinderNumMon[complimentaryfID];
 
-                        auto x1 = c->getFirstBead()->vcoordinate();
-                        auto x2 = c->getSecondBead()->vcoordinate();
-                        auto x3 = cn->getFirstBead()->vcoordinate();
-                        auto x4 = cn->getSecondBead()->vcoordinate();
+                        const auto& x1 = c->getFirstBead()->coordinate();
+                        const auto& x2 = c->getSecondBead()->coordinate();
+                        const auto& x3 = cn->getFirstBead()->coordinate();
+                        const auto& x4 = cn->getSecondBead()->coordinate();
 
                         auto m1 = midPointCoordinate(x1, x2, mp1);
                         auto m2 = midPointCoordinate(x3, x4, mp2);
@@ -1303,8 +1303,8 @@ void LinkerBindingManager::updateAllPossibleBindingsstencil() {
         nbs1 = SysParams::Chemistry().bindingSites[_filamentType].size();
         nbs2 = SysParams::Chemistry().bindingSites[complimentaryfID].size();
 
-        const auto& x1 = Bead::getStableElement(c.beadIndices[0])->coord;
-        const auto& x2 = Bead::getStableElement(c.beadIndices[1])->coord;
+        const auto& x1 = Bead::getStableElement(c.beadIndices[0])->coordinate();
+        const auto& x2 = Bead::getStableElement(c.beadIndices[1])->coordinate();
         floatingpoint X1X2[3] ={x2[0] - x1[0], x2[1] - x1[1], x2[2] - x1[2]};
 
         int* cnindices = ncindices[i].data();
@@ -1318,8 +1318,8 @@ void LinkerBindingManager::updateAllPossibleBindingsstencil() {
             if(cn.type != complimentaryfID){
                 continue;}
 
-            const auto& x3 = Bead::getStableElement(cn.beadIndices[0])->coord;
-            const auto& x4 = Bead::getStableElement(cn.beadIndices[1])->coord;
+            const auto& x3 = Bead::getStableElement(cn.beadIndices[0])->coordinate();
+            const auto& x4 = Bead::getStableElement(cn.beadIndices[1])->coordinate();
             floatingpoint X1X3[3] = {x3[0] - x1[0], x3[1] - x1[1], x3[2] - x1[2]};
             floatingpoint X3X4[3] = {x4[0] - x3[0], x4[1] - x3[1], x4[2] - x3[2]};
             floatingpoint X1X3squared = sqmagnitude(X1X3);
@@ -1739,7 +1739,7 @@ void MotorBindingManager::addPossibleBindings(CCylinder* cc, short bindingSite)
 
             //loop through neighbors
             //now re add valid based on CCNL
-            vector<Cylinder *> nList = _neighborLists[_nlIndex]->getNeighbors(
+            auto nList = _neighborLists[_nlIndex]->getNeighbors(
                     cc->getCylinder());
 
             //loop through neighbors
@@ -1770,10 +1770,10 @@ void MotorBindingManager::addPossibleBindings(CCylinder* cc, short bindingSite)
                         auto mp2 = (float) *it /
                                     SysParams::Geometry().cylinderNumMon[complimentaryfID];
 
-                        auto x1 = c->getFirstBead()->vcoordinate();
-                        auto x2 = c->getSecondBead()->vcoordinate();
-                        auto x3 = cn->getFirstBead()->vcoordinate();
-                        auto x4 = cn->getSecondBead()->vcoordinate();
+                        const auto& x1 = c->getFirstBead()->coordinate();
+                        const auto& x2 = c->getSecondBead()->coordinate();
+                        const auto& x3 = cn->getFirstBead()->coordinate();
+                        const auto& x4 = cn->getSecondBead()->coordinate();
 
                         auto m1 = midPointCoordinate(x1, x2, mp1);
                         auto m2 = midPointCoordinate(x3, x4, mp2);
@@ -2223,10 +2223,10 @@ void MotorBindingManager::addPossibleBindingsstencil(CCylinder* cc, short bindin
                         auto mp2 = (float) *it /
                                     SysParams::Geometry().cylinderNumMon[complimentaryfID];
 
-                        auto x1 = c->getFirstBead()->vcoordinate();
-                        auto x2 = c->getSecondBead()->vcoordinate();
-                        auto x3 = cn->getFirstBead()->vcoordinate();
-                        auto x4 = cn->getSecondBead()->vcoordinate();
+                        const auto& x1 = c->getFirstBead()->coordinate();
+                        const auto& x2 = c->getSecondBead()->coordinate();
+                        const auto& x3 = cn->getFirstBead()->coordinate();
+                        const auto& x4 = cn->getSecondBead()->coordinate();
 
                         auto m1 = midPointCoordinate(x1, x2, mp1);
                         auto m2 = midPointCoordinate(x3, x4, mp2);
@@ -2331,8 +2331,8 @@ void MotorBindingManager::updateAllPossibleBindingsstencil() {
         short nbs1 = SysParams::Chemistry().bindingSites[_filamentType].size();
         short nbs2 = SysParams::Chemistry().bindingSites[complimentaryfID].size();
 
-        const auto& x1 = Bead::getStableElement(c.beadIndices[0])->coord;
-        const auto& x2 = Bead::getStableElement(c.beadIndices[1])->coord;
+        const auto& x1 = Bead::getStableElement(c.beadIndices[0])->coordinate();
+        const auto& x2 = Bead::getStableElement(c.beadIndices[1])->coordinate();
         floatingpoint X1X2[3] ={x2[0] - x1[0], x2[1] - x1[1], x2[2] - x1[2]};
         int* cnindices = ncindices[i].data();
         for(int arraycount = 0; arraycount < ncindices[i].size();arraycount++){
@@ -2345,8 +2345,8 @@ void MotorBindingManager::updateAllPossibleBindingsstencil() {
             if(cn.type != complimentaryfID){
                  continue;}
 
-            const auto& x3 = Bead::getStableElement(cn.beadIndices[0])->coord;
-            const auto& x4 = Bead::getStableElement(cn.beadIndices[1])->coord;
+            const auto& x3 = Bead::getStableElement(cn.beadIndices[0])->coordinate();
+            const auto& x4 = Bead::getStableElement(cn.beadIndices[1])->coordinate();
             floatingpoint X1X3[3] = {x3[0] - x1[0], x3[1] - x1[1], x3[2] - x1[2]};
             floatingpoint X3X4[3] = {x4[0] - x3[0], x4[1] - x3[1], x4[2] - x3[2]};
             floatingpoint X1X3squared = sqmagnitude(X1X3);
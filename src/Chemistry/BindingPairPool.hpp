@@ -0,0 +1,109 @@
+#ifndef MEDYAN_Chemistry_BindingPairPool_hpp
+#define MEDYAN_Chemistry_BindingPairPool_hpp
+
+#include <algorithm> // find, sort
+#include <cstdint>
+#include <functional> // greater
+#include <unordered_map>
+#include <vector>
+
+#include "common.h"
+
+namespace medyan {
+
+// Stores possible binding pairs of binding sites contiguously, so that a pair
+// can be chosen uniformly by index.
+//
+// Notes:
+// - A binding site is identified by the packed integer used in the binding
+//   search, i.e. (cylinder stable index << shiftbybits) | binding site position.
+// - Each site keeps the indices of the pairs it belongs to, so that removing a
+//   site only touches its own pairs. Removing a pair moves the last pair to its
+//   place, so pair indices are not stable after removal.
+// - The same pair may be inserted more than once, just like the map of vectors
+//   used previously.
+class BindingPairPool {
+public:
+    struct Pair {
+        std::uint32_t site1;
+        std::uint32_t site2;
+    };
+
+    auto begin() const noexcept { return pairs_.cbegin(); }
+    auto end()   const noexcept { return pairs_.cend(); }
+
+    Size size()  const noexcept { return pairs_.size(); }
+    bool empty() const noexcept { return pairs_.empty(); }
+
+    const Pair& operator[](Index i) const { return pairs_[i]; }
+
+    void clear() {
+        pairs_.clear();
+        sitePairs_.clear();
+    }
+
+    void insert(std::uint32_t site1, std::uint32_t site2) {
+        const Index i = pairs_.size();
+        pairs_.push_back({ site1, site2 });
+        sitePairs_[site1].push_back(i);
+        if(site2 != site1) sitePairs_[site2].push_back(i);
+    }
+
+    // Number of pairs containing the site.
+    Size count(std::uint32_t site) const {
+        const auto it = sitePairs_.find(site);
+        return it == sitePairs_.end() ? 0 : it->second.size();
+    }
+
+    // Remove all pairs containing the site. Returns the number of pairs removed.
+    Size removeSite(std::uint32_t site) {
+        const auto it = sitePairs_.find(site);
+        if(it == sitePairs_.end()) return 0;
+
+        auto indices = std::move(it->second);
+        sitePairs_.erase(it);
+
+        // Pairs are removed from the back, so that moving the last pair never
+        // moves a pair that is yet to be removed.
+        std::sort(indices.begin(), indices.end(), std::greater<>{});
+        for(auto i : indices) removeAt_(i, site);
+        return indices.size();
+    }
+
+private:
+    std::vector< Pair > pairs_;
+    std::unordered_map< std::uint32_t, std::vector< Index > > sitePairs_;
+
+    void eraseIndex_(std::uint32_t site, Index i) {
+        auto& v = sitePairs_[site];
+        auto pos = std::find(v.begin(), v.end(), i);
+        *pos = v.back();
+        v.pop_back();
+        if(v.empty()) sitePairs_.erase(site);
+    }
+    void replaceIndex_(std::uint32_t site, Index oldIndex, Index newIndex) {
+        auto& v = sitePairs_[site];
+        *std::find(v.begin(), v.end(), oldIndex) = newIndex;
+    }
+
+    // Remove the pair at index i. The index list of the removed site is
+    // already gone.
+    void removeAt_(Index i, std::uint32_t removedSite) {
+        const auto p = pairs_[i];
+        if(p.site1 != removedSite) eraseIndex_(p.site1, i);
+        if(p.site2 != removedSite && p.site2 != p.site1) eraseIndex_(p.site2, i);
+
+        const Index last = pairs_.size() - 1;
+        if(i != last) {
+            const auto moved = pairs_[last];
+            pairs_[i] = moved;
+            replaceIndex_(moved.site1, last, i);
+            if(moved.site2 != moved.site1) replaceIndex_(moved.site2, last, i);
+        }
+        pairs_.pop_back();
+    }
+};
+
+} // namespace medyan
+
+#endif
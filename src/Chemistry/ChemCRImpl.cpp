@@ -0,0 +1,329 @@
+
+//------------------------------------------------------------------
+//  **MEDYAN** - Simulation Package for the Mechanochemical
+//               Dynamics of Active Networks, v4.0
+//
+//  Copyright (2015-2018)  Papoian Lab, University of Maryland
+//
+//                 ALL RIGHTS RESERVED
+//
+//  See the MEDYAN web page for more information:
+//  http://www.medyan.org
+//------------------------------------------------------------------
+
+#include "ChemCRImpl.h"
+
+#include <cmath>
+
+#include "SysParams.h"
+#include "Chemistry/DissipationTracker.h"
+
+namespace medyan {
+
+RNodeCR::RNodeCR(ReactionBase *r, ChemCRImpl &chem_CR)
+    : _react(r), _chem_CR(chem_CR) {
+    _react->setRnode(this);
+}
+
+RNodeCR::~RNodeCR() noexcept {
+    _react->setRnode(nullptr);
+}
+
+void RNodeCR::printSelf() const {
+    cout << "RNodeCR: ptr=" << this << ", a=" << _a << ", group=" <<
+        _group << ", points to Reaction:\n";
+    cout << (*_react);
+}
+
+void RNodeCR::activateReaction() {
+    _chem_CR.activateReaction(getReaction());
+}
+
+void RNodeCR::passivateReaction() {
+    _chem_CR.passivateReaction(getReaction());
+}
+
+ChemCRImpl::~ChemCRImpl() noexcept {
+    _map_rnodes.clear();
+}
+
+void ChemCRImpl::initialize() {
+    resetTime();
+
+    // Rebuild all groups from scratch.
+    for (auto &x : _map_rnodes) {
+        auto rn = x.second.get();
+        rn->_group = RNodeCR::noGroup;
+        rn->_a = 0;
+    }
+    _groups.clear();
+    std::fill(_groupIndex.begin(), _groupIndex.end(), RNodeCR::noGroup);
+    _instant.clear();
+
+    for (auto &x : _map_rnodes){
+        auto rn = x.second.get();
+#ifdef TRACK_DEPENDENTS
+        rn->getReaction()->activateReactionUnconditional();
+#endif
+        updatePropensity(rn, rn->getReaction()->computePropensity());
+    }
+}
+
+void ChemCRImpl::initializerestart(floatingpoint restarttime){
+
+    if(SysParams::RUNSTATE){
+        LOG(ERROR) << "initializerestart Function from ChemCRImpl class can "
+                      "only be called "
+                      "during restart phase. Exiting.";
+        throw std::logic_error("Illegal function call pattern");
+    }
+
+    setTime(restarttime);
+}
+
+floatingpoint ChemCRImpl::generateTau(floatingpoint a) {
+    #ifdef DEBUGCONSTANTSEED
+    Rand::chemistrycounter++;
+    #endif
+    return medyan::rand::safeExpDist(_exp_distr, a, *_eng);
+}
+
+floatingpoint ChemCRImpl::generateUniform() {
+    #ifdef DEBUGCONSTANTSEED
+    Rand::chemistrycounter++;
+    #endif
+    return _uniform_distr(*_eng);
+}
+
+floatingpoint ChemCRImpl::computeTotalA() const {
+    if(!_instant.empty()) return std::numeric_limits<floatingpoint>::infinity();
+
+    double rates_sum = 0;
+    for (auto &g : _groups) rates_sum += g.sum;
+    return rates_sum;
+}
+
+Size ChemCRImpl::getNumGroups() const {
+    Size res = 0;
+    for (auto &g : _groups) {
+        if(!g.members.empty()) ++res;
+    }
+    return res;
+}
+
+Index ChemCRImpl::groupIndexOf(int exponent) {
+    auto& gi = _groupIndex[exponent - minExponent];
+    if(gi == RNodeCR::noGroup) {
+        gi = _groups.size();
+        auto& g = _groups.emplace_back();
+        g.exponent = exponent;
+        g.upperBound = std::ldexp((floatingpoint)1, exponent);
+    }
+    return gi;
+}
+
+void ChemCRImpl::detach(RNodeCR *rn) {
+    if(rn->_group == RNodeCR::noGroup) return;
+
+    auto& members = rn->_group == RNodeCR::instantGroup ? _instant : _groups[rn->_group].members;
+    // Swap with the last member and pop.
+    auto last = members.back();
+    members[rn->_posInGroup] = last;
+    last->_posInGroup = rn->_posInGroup;
+    members.pop_back();
+
+    if(rn->_group != RNodeCR::instantGroup) {
+        auto& g = _groups[rn->_group];
+        if(members.empty()) {
+            g.sum = 0;
+            g.numUpdates = 0;
+        } else {
+            g.sum -= rn->_a;
+            ++g.numUpdates;
+        }
+    }
+    rn->_group = RNodeCR::noGroup;
+}
+
+void ChemCRImpl::attach(RNodeCR *rn) {
+    const auto a = rn->_a;
+    if(!(a > 0)) return;
+
+    if(a == std::numeric_limits<floatingpoint>::infinity()) {
+        rn->_group = RNodeCR::instantGroup;
+        rn->_posInGroup = _instant.size();
+        _instant.push_back(rn);
+        return;
+    }
+
+    int exponent;
+    std::frexp(a, &exponent);
+    rn->_group = groupIndexOf(exponent);
+    auto& g = _groups[rn->_group];
+    rn->_posInGroup = g.members.size();
+    g.members.push_back(rn);
+    g.sum += a;
+    ++g.numUpdates;
+
+    // Accumulated rounding errors in the group sum are cleared periodically,
+    // with amortized constant cost per update.
+    if(g.numUpdates > 2 * (Size)g.members.size() + 16) {
+        g.sum = 0;
+        for(auto m : g.members) g.sum += m->_a;
+        g.numUpdates = 0;
+    }
+}
+
+void ChemCRImpl::updatePropensity(RNodeCR *rn, floatingpoint a) {
+    if(rn->_group >= 0) {
+        auto& g = _groups[rn->_group];
+        if(a < g.upperBound && a >= g.upperBound / 2) {
+            // Stays in the same group.
+            g.sum += a - rn->_a;
+            ++g.numUpdates;
+            rn->_a = a;
+            return;
+        }
+    }
+    detach(rn);
+    rn->_a = a;
+    attach(rn);
+}
+
+RNodeCR* ChemCRImpl::selectReaction(double aTotal) {
+    // Composition step: find the group.
+    const double mu = aTotal * generateUniform();
+    double rates_sum = 0;
+    Group* pg = nullptr;
+    for(auto& g : _groups) {
+        if(g.members.empty()) continue;
+        pg = &g;
+        rates_sum += g.sum;
+        if(rates_sum > mu) break;
+    }
+    // Due to rounding, the last nonempty group is used if mu is not reached.
+    if(pg == nullptr) return nullptr;
+
+    // Rejection step: find the reaction within the group.
+    const auto n = pg->members.size();
+    while(true) {
+        const auto i = std::min<size_t>(n - 1, (size_t)(generateUniform() * n));
+        auto rn = pg->members[i];
+        if(generateUniform() * pg->upperBound < rn->_a) return rn;
+    }
+}
+
+bool ChemCRImpl::makeStep(floatingpoint endTime) {
+    // Reactions with infinite propensity fire without time passing.
+    if(_instant.empty()) {
+        const floatingpoint a_total = computeTotalA();
+        floatingpoint tau = generateTau(a_total);
+        // Check if a reaction happened before endTime
+        if (_t+tau>endTime){
+            setTime(endTime);
+            return true;
+        }
+        // this means that the network has come to a halt
+        if(a_total<1e-15)
+            return false;
+        _t+=tau;
+        syncGlobalTime();
+    }
+
+    return fireNextReaction();
+}
+
+bool ChemCRImpl::fireNextReaction() {
+    RNodeCR *rn_selected = nullptr;
+
+    if(!_instant.empty()) {
+        rn_selected = _instant.back();
+    }
+    else {
+        const floatingpoint a_total = computeTotalA();
+        if(a_total<1e-15)
+            return false;
+        rn_selected = selectReaction(a_total);
+        if(rn_selected==nullptr){
+            log::error("ChemCRImpl::fireNextReaction(): a_total={}, but no group is populated.", a_total);
+            throw runtime_error("ChemCRImpl::fireNextReaction(): No Reaction was selected during the CR step!");
+        }
+    }
+
+    ReactionBase *r = rn_selected->getReaction();
+
+    // if dissipation tracking is enabled and the reaction is supported, then compute the change in Gibbs free energy and store it
+    if(SysParams::Chemistry().dissTracking){
+        if((r->getHRCDIndex() != hrcdidDNT) || (r->getReactionType() == ReactionType::DIFFUSION)){
+            dt->updateDelGChem(r);
+        }
+    }
+
+    rn_selected->makeStep();
+    if(!rn_selected->isPassivated()){
+        updatePropensity(rn_selected, r->computePropensity());
+    }
+
+    // Updating dependencies
+    if(r->updateDependencies()) {
+        for(auto rit = r->dependents().begin(); rit!=r->dependents().end(); ++rit){
+            RNode *rn = (*rit)->getRnode();
+            // The dependent might not be simulated by any network.
+            if(rn == nullptr) continue;
+            RNodeCR *rn_other = dynamic_cast<RNodeCR*>(rn);
+            if(rn_other != nullptr && &rn_other->_chem_CR == this)
+                updatePropensity(rn_other, rn_other->getReaction()->computePropensity());
+            else
+                // The reaction is simulated by another network, which might
+                // use a different algorithm.
+                (*rit)->updatePropensity();
+        }
+    }
+
+    // Send signal.
+    r->emitSignal();
+
+    syncGlobalTime();
+    return true;
+}
+
+void ChemCRImpl::addReaction(ReactionBase *r) {
+    auto rn = make_unique<RNodeCR>(r, *this);
+    auto prn = rn.get();
+    _map_rnodes.emplace(r, move(rn));
+    updatePropensity(prn, r->computePropensity());
+}
+
+void ChemCRImpl::removeReaction(ReactionBase *r) {
+    auto mit = _map_rnodes.find(r);
+    if(mit == _map_rnodes.end()) return;
+    detach(mit->second.get());
+    _map_rnodes.erase(mit);
+}
+
+void ChemCRImpl::printReactions() const {
+    for (auto &x : _map_rnodes){
+        auto rn = x.second.get();
+        rn->printSelf();
+    }
+}
+
+RNodeCR* ChemCRImpl::findRNode(ReactionBase *r, const char* caller) const {
+    auto mit = _map_rnodes.find(r);
+    if(mit==_map_rnodes.end())
+        throw out_of_range(
+        std::string("ChemCRImpl::") + caller + "(...): Reaction not found!");
+    return mit->second.get();
+}
+
+void ChemCRImpl::activateReaction(ReactionBase *r) {
+    auto rn_this = findRNode(r, "activateReaction");
+    updatePropensity(rn_this, r->computePropensity());
+}
+
+void ChemCRImpl::passivateReaction(ReactionBase *r) {
+    auto rn_this = findRNode(r, "passivateReaction");
+    updatePropensity(rn_this, 0);
+}
+
+} // namespace medyan
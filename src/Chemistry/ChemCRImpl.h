@@ -0,0 +1,295 @@
+
+//------------------------------------------------------------------
+//  **MEDYAN** - Simulation Package for the Mechanochemical
+//               Dynamics of Active Networks, v4.0
+//
+//  Copyright (2015-2018)  Papoian Lab, University of Maryland
+//
+//                 ALL RIGHTS RESERVED
+//
+//  See the MEDYAN web page for more information:
+//  http://www.medyan.org
+//------------------------------------------------------------------
+
+#ifndef MEDYAN_ChemCRImpl_h
+#define MEDYAN_ChemCRImpl_h
+
+#include <random>
+#include <vector>
+
+#include "common.h"
+#include "Rand.h"
+#include "Reaction.h"
+#include "ChemRNode.h"
+#include "Chemistry/ChemSim.h"
+
+namespace medyan {
+
+//FORWARD DECLARATIONS
+class RNodeCR;
+class ChemCRImpl;
+
+/// Used by ChemCRImpl to implement the composition-rejection algorithm.
+/*! RNodeCR manages a single chemical reaction within the composition-rejection
+ *  algorithm. Besides the cached propensity, it records the propensity group
+ *  it currently belongs to, as well as its position in that group, so that it
+ *  can be moved between groups in constant time.
+ */
+class RNodeCR : public RNode {
+public:
+    /// Index of the group for reactions that are not in any group.
+    static constexpr Index noGroup = -1;
+    /// Index of the group for reactions with infinite propensity.
+    static constexpr Index instantGroup = -2;
+
+    /// Ctor:
+    /// @param *r is the Reaction object corresponding to this RNodeCR
+    /// @param &chem_CR is a reference to the ChemCRImpl object, which manages
+    /// the propensity groups and the random number generation.
+    RNodeCR(ReactionBase *r, ChemCRImpl &chem_CR);
+
+    /// Copying is not allowed
+    RNodeCR(const RNodeCR& rhs) = delete;
+
+    /// Assignment is not allowed
+    RNodeCR& operator=(RNodeCR &rhs) = delete;
+
+    /// Dtor: The RNode pointer of the tracked Reaction object is set to nullptr
+    virtual ~RNodeCR() noexcept;
+
+    /// Returns a pointer to the Reaction which corresponds to this RNodeCR.
+    ReactionBase* getReaction() const {return _react;};
+
+    /// Return the currently stored propensity, "a", for this Reaction.
+    /// @note The propensity is not recomputed in this method, so it potentially
+    /// can be out of sync.
+    floatingpoint getPropensity() const {return _a;}
+
+    /// This method calls the corresponding Reaction::makeStep() method of the underyling Reaction object
+    void makeStep() {_react->makeStep();}
+
+    /// Forwards the call to the similarly named method of ChemCRImpl
+    virtual void activateReaction();
+
+    /// Forwards the call to the similarly named method of ChemCRImpl
+    virtual void passivateReaction();
+
+    /// Forwards the call to the similarly named method of ChemCRImpl
+    bool isPassivated() const {return _react->isPassivated();}
+
+    /// Print information about this RNodeCR such as "a", the group it belongs
+    /// to and the Reaction which this RNodeCR tracks.
+    void printSelf() const;
+
+private:
+    friend class ChemCRImpl;
+
+    ReactionBase *_react; ///< The pointer to the associated Reaction object. The
+                          ///< corresponding memory is not managed by RNodeCR.
+    ChemCRImpl &_chem_CR; ///< A reference to the ChemCRImpl which contains the
+                          ///< propensity groups and random number generators.
+    floatingpoint _a = 0; ///< The propensity associated with the Reaction.
+    Index _group = noGroup; ///< The group this RNodeCR currently belongs to.
+    Index _posInGroup = 0;  ///< Position of this RNodeCR in the group.
+};
+
+/// Implements the composition-rejection (CR) stochastic simulation algorithm.
+/*! ChemCRImpl partitions reactions into groups by their propensities, where
+ *  each group covers propensities in [2^(e-1), 2^e) for some integer e.
+ *  The total propensity of each group is cached. A reaction event is selected
+ *  in two stages: a group is first chosen with probability proportional to the
+ *  group propensity (the composition step), then a reaction within the group is
+ *  chosen by rejection sampling against the group's upper bound (the rejection
+ *  step), which is accepted with probability at least 1/2.
+ *
+ *  Since the number of groups is bounded by the dynamic range of the
+ *  propensities rather than the number of reactions, and updating a reaction
+ *  propensity only moves it between groups, the cost of each step does not grow
+ *  with the size of the network (as opposed to the O(log N) heap updates in
+ *  ChemNRMImpl and the O(N) selection in ChemGillespieImpl).
+ *
+ *  Reactions with infinite propensity are fired immediately, with no time
+ *  elapsed.
+ *
+ *  Several ChemCRImpl objects can share one reaction network, each simulating
+ *  a part of it (see ChemPartitionedImpl). When a fired reaction affects a
+ *  reaction that is simulated by another ChemCRImpl, the propensity update is
+ *  forwarded to it.
+ *
+ *  @note Same as ChemGillespieImpl, the algorithm relies on tracking dependent
+ *  Reactions, so TRACK_DEPENDENTS must be defined.
+ */
+class ChemCRImpl : public ChemSim {
+public:
+    /// Ctor: Sets global time to 0.0
+    ChemCRImpl() { resetTime(); }
+
+    /// Copying is not allowed
+    ChemCRImpl(const ChemCRImpl &rhs) = delete;
+
+    /// Assignment is not allowed
+    ChemCRImpl& operator=(ChemCRImpl &rhs) = delete;
+
+    ///Dtor: The reaction network is cleared. The RNodeCR objects will be
+    /// destructed, but Reaction objects will stay intact.
+    virtual ~ChemCRImpl() noexcept;
+
+    /// Return the number of reactions in the network.
+    size_t getSize() const {return _map_rnodes.size();}
+
+    /// Return the number of nonempty propensity groups.
+    Size getNumGroups() const;
+
+    /// Return the current global time
+    floatingpoint getTime() const {return _t;}
+
+    /// Sets the global time to 0.0
+    void resetTime() {_t=0.0; syncGlobalTime(); }
+
+    /// Sets global time variable to ChemCRImpl's global time, if this network owns the global time
+    void syncGlobalTime() { if(_ownsGlobalTime) global_time=_t; }
+
+    /// Sets the time of this network.
+    void setTime(floatingpoint timepoint){ _t=timepoint; syncGlobalTime();}
+
+    /// Set whether this network updates the global time. Networks simulated
+    /// concurrently with others should not own the global time.
+    void setOwnsGlobalTime(bool ownsGlobalTime) { _ownsGlobalTime = ownsGlobalTime; }
+
+    /// Use a separate random number generator instead of the global one.
+    /// Required for networks simulated concurrently with others.
+    void setRandomEngine(std::mt19937& eng) { _eng = &eng; }
+
+    /// Add ReactionBase *r to the network
+    virtual void addReaction(ReactionBase *r);
+
+    /// Remove ReactionBase *r from the network
+    virtual void removeReaction(ReactionBase *r);
+
+    //sets global time to restart time when called.
+    virtual void initializerestart(floatingpoint restarttime);
+
+    /// Unconditionally compute the total propensity associated with the network.
+    floatingpoint computeTotalA() const;
+
+    /// Returns a random time tau, drawn from the exponential distribution,
+    /// with the propensity given by a.
+    floatingpoint generateTau(floatingpoint a);
+
+    /// Returns a random number between 0 and 1, drawn from the uniform distribution
+    floatingpoint generateUniform();
+
+    /// This function iterates over all RNodeCR objects in the network,
+    /// activating all Reaction objects and rebuilding all propensity groups.
+    /// @note This method needs to be called before calling run(...).
+    virtual void initialize();
+
+    /// This method runs the CR algorithm for the given amount of time.
+    /// @return true if successful.
+    virtual bool run(floatingpoint time) {
+        floatingpoint endTime = _t + time;
+        while(_t < endTime) {
+            bool success = makeStep(endTime);
+            if(!success)
+                return false;
+        }
+        return true;
+    }
+
+    /// This method runs the CR algorithm for the given amount of reaction steps.
+    /// @return true if successful.
+    virtual bool runSteps(int steps) {
+        for(int i = 0; i < steps; i++) {
+            bool success = makeStep();
+            if(!success)
+                return false;
+        }
+        return true;
+    }
+
+    /// Selects and fires one reaction event in this network, without advancing time.
+    /// This is used when several networks are simulated together, where the time
+    /// step is sampled using the total propensity of all networks.
+    /// @return false if there are no reactions to fire.
+    bool fireNextReaction();
+
+    /// This method is used to track the change in the propensity of the
+    /// previously passivated ReactionBase *r which has become activated
+    void activateReaction(ReactionBase *r);
+
+    /// This method is used to track the change in the propensity of the
+    /// ReactionBase *r which has become passivated
+    void passivateReaction(ReactionBase *r);
+
+    /// Prints all RNodes in the reaction network
+    virtual void printReactions() const;
+
+    /// Cross checks all reactions in the network for firing time.
+    virtual bool crosschecktau() const {
+        log::warn("Cannot check for tau in reactions in ChemCRImpl.h");
+        return true;
+    };
+
+private:
+    /// A group of reactions with propensities in [upperBound/2, upperBound).
+    struct Group {
+        int exponent = 0;
+        floatingpoint upperBound = 0;
+        double sum = 0;
+        std::vector<RNodeCR*> members;
+        Size numUpdates = 0; ///< Updates of the sum since last recomputed.
+    };
+
+    /// Range of exponents of the propensity groups, large enough for all
+    /// finite positive double values.
+    static constexpr int minExponent = -1100;
+    static constexpr int maxExponent = 1100;
+
+    /// Find the RNodeCR associated with the reaction.
+    RNodeCR* findRNode(ReactionBase *r, const char* caller) const;
+
+    /// Set the propensity of the RNodeCR and move it to the corresponding group.
+    void updatePropensity(RNodeCR *rn, floatingpoint a);
+
+    /// Remove the RNodeCR from the group it belongs to.
+    void detach(RNodeCR *rn);
+    /// Add the RNodeCR to the group corresponding to its propensity.
+    void attach(RNodeCR *rn);
+
+    /// Returns the group index for the exponent, creating the group if necessary.
+    Index groupIndexOf(int exponent);
+
+    /// Select the reaction to fire, given a total propensity.
+    RNodeCR* selectReaction(double aTotal);
+
+    /// One step of the composition-rejection algorithm.
+    /// First Tau the time to the next reaction event is sampled.
+    /// If it is after endTime, then time is set to endTime and Returns true.
+    /// Otherwise the reaction is selected by composition and rejection, and
+    /// the propensities of the fired and dependent reactions are updated.
+    /// Returns true if successful, false if endTime==inf and there are no reactions.
+    bool makeStep(floatingpoint endTime = std::numeric_limits<floatingpoint>::infinity());
+
+private:
+    #ifdef DEBUGCONSTANTSEED
+    map<ReactionBase*, unique_ptr<RNodeCR>> _map_rnodes;
+    #else
+    unordered_map<ReactionBase*, unique_ptr<RNodeCR>> _map_rnodes;
+    #endif
+    ///< The database of RNodeCR objects, representing the reaction network
+
+    std::vector<Group> _groups; ///< Propensity groups, in order of creation.
+    std::vector<Index> _groupIndex = std::vector<Index>(maxExponent - minExponent + 1, RNodeCR::noGroup);
+                                ///< Group index by exponent, offset by minExponent.
+    std::vector<RNodeCR*> _instant; ///< Reactions with infinite propensity.
+
+    exponential_distribution<floatingpoint> _exp_distr; ///< Adaptor for the exponential distribution
+    uniform_real_distribution<floatingpoint> _uniform_distr;
+    floatingpoint _t = 0; ///< global time
+    bool _ownsGlobalTime = true;
+    std::mt19937* _eng = &Rand::eng; ///< The random number generator
+};
+
+} // namespace medyan
+
+#endif
@@ -41,6 +41,7 @@
 #include <chrono>
 #include "CUDAcommon.h"
 #include "Util/Io/Log.hpp"
+#include "Util/SlabAllocator.hpp"
 
 
 namespace medyan {
@@ -54,6 +55,10 @@ using namespace mathfunc;
 ///         needs to be found dynamically to ensure correct behavior - the alternative may
 ///         cause brutal bugs that are difficult to track in simulation.
 ///
+///         Callbacks created for every cylinder or bound object derive from
+///         SlabAllocated, so that the std::function holding them allocates
+///         from a slab pool.
+///
 
 /// Callback to update the compartment-local binding species based on
 /// a change of copy number for an empty site.
@@ -242,7 +247,7 @@ struct UpdateMotorIDCallback{
 
 /// Callback to extend the plus end of a Filament after a polymerization
 /// Reaction occurs in the system.
-struct FilamentExtensionPlusEndCallback {
+struct FilamentExtensionPlusEndCallback : SlabAllocated< FilamentExtensionPlusEndCallback > {
     
     Cylinder* _cylinder;
     
@@ -269,7 +274,7 @@ struct FilamentExtensionPlusEndCallback {
 
 /// Callback to extend the minus end of a Filament after a polymerization
 /// Reaction occurs in the system.
-struct FilamentExtensionMinusEndCallback {
+struct FilamentExtensionMinusEndCallback : SlabAllocated< FilamentExtensionMinusEndCallback > {
     
     Cylinder* _cylinder;
     
@@ -295,7 +300,7 @@ struct FilamentExtensionMinusEndCallback {
 
 /// Callback to retract the plus end of a Filament after a depolymerization
 /// Reaction occurs in the system.
-struct FilamentRetractionPlusEndCallback {
+struct FilamentRetractionPlusEndCallback : SlabAllocated< FilamentRetractionPlusEndCallback > {
     
     Cylinder* _cylinder;
 
@@ -318,7 +323,7 @@ struct FilamentRetractionPlusEndCallback {
 
 /// Callback to retract the minus end of a Filament after a depolymerization
 /// Reaction occurs in the system.
-struct FilamentRetractionMinusEndCallback {
+struct FilamentRetractionMinusEndCallback : SlabAllocated< FilamentRetractionMinusEndCallback > {
     
     Cylinder* _cylinder;
 
@@ -341,7 +346,7 @@ struct FilamentRetractionMinusEndCallback {
 
 /// Callback to polymerize the plus end of a Filament after a polymerization
 /// Reaction occurs in the system.
-struct FilamentPolymerizationPlusEndCallback {
+struct FilamentPolymerizationPlusEndCallback : SlabAllocated< FilamentPolymerizationPlusEndCallback > {
     
     Cylinder* _cylinder;
 
@@ -364,7 +369,7 @@ struct FilamentPolymerizationPlusEndCallback {
 
 /// Callback to polymerize the minus end of a Filament after a polymerization
 /// Reaction occurs in the system.
-struct FilamentPolymerizationMinusEndCallback {
+struct FilamentPolymerizationMinusEndCallback : SlabAllocated< FilamentPolymerizationMinusEndCallback > {
     
     Cylinder* _cylinder;
 
@@ -387,7 +392,7 @@ struct FilamentPolymerizationMinusEndCallback {
 
 /// Callback to depolymerize the plus end of a Filament after a depolymerization
 /// Reaction occurs in the system.
-struct FilamentDepolymerizationPlusEndCallback {
+struct FilamentDepolymerizationPlusEndCallback : SlabAllocated< FilamentDepolymerizationPlusEndCallback > {
     
     Cylinder* _cylinder;
 
@@ -411,7 +416,7 @@ struct FilamentDepolymerizationPlusEndCallback {
 
 /// Callback to depolymerize the back of a Filament after a depolymerization
 /// Reaction occurs in the system.
-struct FilamentDepolymerizationMinusEndCallback {
+struct FilamentDepolymerizationMinusEndCallback : SlabAllocated< FilamentDepolymerizationMinusEndCallback > {
     
     Cylinder* _cylinder;
 
@@ -433,7 +438,7 @@ struct FilamentDepolymerizationMinusEndCallback {
 };
 
 /// Callback to unbind a BranchingPoint from a Filament
-struct BranchingPointUnbindingCallback {
+struct BranchingPointUnbindingCallback : SlabAllocated< BranchingPointUnbindingCallback > {
     
     SubSystem* _ps;
     BranchingPoint* _branchingPoint;
@@ -503,12 +508,12 @@ struct BranchingCallback {
         if(SysParams::RUNSTATE==true) {
 
             //Get a position and direction of a new filament
-            auto x1 = c1->getFirstBead()->vcoordinate();
-            auto x2 = c1->getSecondBead()->vcoordinate();
+            const auto& x1 = c1->getFirstBead()->coordinate();
+            const auto& x2 = c1->getSecondBead()->coordinate();
             
             //get original direction of cylinder
-            auto p= midPointCoordinate(x1, x2, pos);
-            vector<floatingpoint> n = twoPointDirection(x1, x2);
+            auto p = vec2Vector(midPointCoordinate(x1, x2, pos));
+            auto n = vec2Vector(twoPointDirection(x1, x2));
             
             //get branch projection
             //use mechanical parameters
@@ -550,20 +555,22 @@ struct BranchingCallback {
                 auto branchPosDir = branchProjection(n, p, l, s, theta);
                 auto bd = get<0>(branchPosDir);//branch direction
                 auto bp = get<1>(branchPosDir);//branch position
-                const auto b2 = vector2Vec< 3, floatingpoint >(bp) + s * vector2Vec< 3, floatingpoint >(bd);
+                const auto bpVec = vector2Vec< 3, floatingpoint >(bp);
+                const auto bdVec = vector2Vec< 3, floatingpoint >(bd);
+                const auto b2 = bpVec + s * bdVec;
 
                 //Check if the branch will be within boundary
                 auto projlength = SysParams::Geometry().cylinderSize[filType] / 10;
-                auto pos2 = nextPointProjection(bp, projlength, bd);
+                auto pos2 = nextPointProjection(bpVec, projlength, bdVec);
                 //check if within cutoff of boundary
                 auto regionInMembrane = _ps->getRegionInMembrane();
                 if(
                     (regionInMembrane && (
-                        regionInMembrane->contains(*_ps, vector2Vec< 3, floatingpoint >(bp)) &&
+                        regionInMembrane->contains(*_ps, bpVec) &&
                         regionInMembrane->contains(*_ps, b2)
                     )) ||
                     (!regionInMembrane && (
-                        _ps->getBoundary()->distance(bp) >= boundary_cutoff_distance &&
+                        _ps->getBoundary()->distance(bpVec) >= boundary_cutoff_distance &&
                         _ps->getBoundary()->distance(pos2) >= boundary_cutoff_distance
                     ))
                 ) {
@@ -639,7 +646,7 @@ struct BranchingCallback {
 };
 
 /// Callback to unbind a Linker from a Filament
-struct LinkerUnbindingCallback {
+struct LinkerUnbindingCallback : SlabAllocated< LinkerUnbindingCallback > {
     
     SubSystem* _ps;
     Linker* _linker;
@@ -738,7 +745,7 @@ struct LinkerBindingCallback {
 };
 
 /// Callback to unbind a MotorGhost from a Filament
-struct MotorUnbindingCallback {
+struct MotorUnbindingCallback : SlabAllocated< MotorUnbindingCallback > {
     
     SubSystem* _ps;
     MotorGhost* _motor;
@@ -845,7 +852,7 @@ struct MotorBindingCallback {
 };
 
 /// Callback to walk a MotorGhost on a Filament
-struct MotorWalkingCallback {
+struct MotorWalkingCallback : SlabAllocated< MotorWalkingCallback > {
     
     Cylinder* _c;        ///< Cylinder this callback is attached to
     
@@ -906,7 +913,7 @@ struct MotorWalkingCallback {
 };
 
 /// Callback to walk a MotorGhost on a Filament to a new Cylinder
-struct MotorMovingCylinderCallback {
+struct MotorMovingCylinderCallback : SlabAllocated< MotorMovingCylinderCallback > {
     
     Cylinder* _oldC;        ///< Old cylinder the motor is attached to
     Cylinder* _newC;        ///< New cylinder motor will be attached to
@@ -1001,12 +1008,12 @@ struct FilamentCreationCallback {
             c = _compartment;
         
         //set up a random initial position and direction
-        vector<floatingpoint> position;
-        vector<floatingpoint> direction;
+        Vec<3, floatingpoint> position;
+        Vec<3, floatingpoint> direction;
 
         if(_ps->getBoundary()->getShape() == BoundaryShape::Cylinder) {
             while(true) {
-                position = mathfunc::vec2Vector(_ps->getCompartmentGrid()->getRandomCenterCoordinatesIn(*c));
+                position = _ps->getCompartmentGrid()->getRandomCenterCoordinatesIn(*c);
                 
                 //getting random numbers between -1 and 1
                 
@@ -1021,8 +1028,8 @@ struct FilamentCreationCallback {
                 for(auto& bb : _ps->bubbles) {
                     auto radius = bb.getRadius();
 
-                    if((twoPointDistancesquared(vec2Vector(bb.coord), position) < (radius * radius)) ||
-                       (twoPointDistancesquared(vec2Vector(bb.coord), npp) < (radius * radius))){
+                    if((twoPointDistancesquared(bb.coord, position) < (radius * radius)) ||
+                       (twoPointDistancesquared(bb.coord, npp) < (radius * radius))){
                         inbubble = true;
                         break;
                     }
@@ -1041,14 +1048,14 @@ struct FilamentCreationCallback {
             }
             
             //create filament, set up ends and filament species
-            Filament* f = _ps->addTrackable<Filament>(_ps, _filType, position, direction, true, false);
+            Filament* f = _ps->addTrackable<Filament>(_ps, _filType, vec2Vector(position), vec2Vector(direction), true, false);
             
             //initialize the nucleation
             f->nucleate(_plusEnd, _filament, _minusEnd);
         }
         else {
             while(true) {
-                position = mathfunc::vec2Vector(_ps->getCompartmentGrid()->getRandomCoordinatesIn(*c));
+                position = _ps->getCompartmentGrid()->getRandomCoordinatesIn(*c);
                 
                 //getting random numbers between -1 and 1
                 
@@ -1063,8 +1070,8 @@ struct FilamentCreationCallback {
                 for(auto& bb : _ps->bubbles) {
                     auto radius = bb.getRadius();
 
-                    if((twoPointDistancesquared(vec2Vector(bb.coord), position) < (radius * radius)) ||
-                       (twoPointDistancesquared(vec2Vector(bb.coord), npp) < (radius * radius))){
+                    if((twoPointDistancesquared(bb.coord, position) < (radius * radius)) ||
+                       (twoPointDistancesquared(bb.coord, npp) < (radius * radius))){
                         inbubble = true;
                         break;
                     }
@@ -1078,13 +1085,13 @@ struct FilamentCreationCallback {
                     _ps->getBoundary()->within(npp) &&
                     c->isActivated() &&
                     (c->getVolumeFrac() >= 1.0 ||
-                        (medyan::contains(*_ps, _ps->membranes.begin()->getMesh(), vector2Vec<3, floatingpoint>(position)) &&
-                        medyan::contains(*_ps, _ps->membranes.begin()->getMesh(), vector2Vec<3, floatingpoint>(npp))))
+                        (medyan::contains(*_ps, _ps->membranes.begin()->getMesh(), position) &&
+                        medyan::contains(*_ps, _ps->membranes.begin()->getMesh(), npp)))
                 ) break;
             }
             
             //create filament, set up ends and filament species
-            Filament* f = _ps->addTrackable<Filament>(_ps, _filType, position, direction, true, false);
+            Filament* f = _ps->addTrackable<Filament>(_ps, _filType, vec2Vector(position), vec2Vector(direction), true, false);
             
             //initialize the nucleation
             f->nucleate(_plusEnd, _filament, _minusEnd);
@@ -1099,7 +1106,7 @@ struct FilamentCreationCallback {
 };
 
 ///Struct to sever a filament based on a reaction
-struct FilamentSeveringCallback {
+struct FilamentSeveringCallback : SlabAllocated< FilamentSeveringCallback > {
     
     Cylinder* _c1;  ///< Filament severing point
 
@@ -1130,7 +1137,7 @@ struct FilamentSeveringCallback {
 };
 
 /// Struct to destroy a filament based on a reaction
-struct FilamentDestructionCallback {
+struct FilamentDestructionCallback : SlabAllocated< FilamentDestructionCallback > {
     
     Cylinder* _c; ///< Cylinder to destroy
     
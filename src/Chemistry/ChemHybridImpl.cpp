@@ -0,0 +1,232 @@
+
+//------------------------------------------------------------------
+//  **MEDYAN** - Simulation Package for the Mechanochemical
+//               Dynamics of Active Networks, v4.0
+//
+//  Copyright (2015-2018)  Papoian Lab, University of Maryland
+//
+//                 ALL RIGHTS RESERVED
+//
+//  See the MEDYAN web page for more information:
+//  http://www.medyan.org
+//------------------------------------------------------------------
+
+#include "ChemHybridImpl.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Rand.h"
+#include "SysParams.h"
+#include "Chemistry/Reaction.h"
+
+namespace medyan {
+
+ChemHybridImpl::ChemHybridImpl(floatingpoint copyNumberThreshold, floatingpoint leapTime) :
+    _copyNumberThreshold(copyNumberThreshold),
+    _leapTime(leapTime)
+{
+    if(!(copyNumberThreshold > 0)) {
+        log::error("Hybrid chemistry copy number threshold must be positive, but {} is given.", copyNumberThreshold);
+        throw std::runtime_error("Invalid hybrid chemistry copy number threshold");
+    }
+    if(!(leapTime > 0)) {
+        log::error("Hybrid chemistry leap time must be positive, but {} is given.", leapTime);
+        throw std::runtime_error("Invalid hybrid chemistry leap time");
+    }
+}
+
+bool ChemHybridImpl::isCandidate(ReactionBase *r) {
+    if(dynamic_cast<DiffusionReaction*>(r) == nullptr) return false;
+    if(r->hasCallbacks()) return false;
+    for(Index i = 0; i < 2; ++i) {
+        auto rs = r->rspecies()[i];
+        // Constant and averaging species are not changed normally.
+        if(dynamic_cast<RSpeciesReg*>(rs) == nullptr || rs->hasCallbacks()) return false;
+    }
+    return true;
+}
+
+void ChemHybridImpl::addReaction(ReactionBase *r) {
+    _exact.addReaction(r);
+    if(isCandidate(r)) {
+        _candidateIndex[r] = _candidates.size();
+        _candidates.push_back({ r, r->rspecies()[0], r->rspecies()[1] });
+    }
+}
+
+void ChemHybridImpl::removeReaction(ReactionBase *r) {
+    auto it = _candidateIndex.find(r);
+    if(it == _candidateIndex.end()) {
+        _exact.removeReaction(r);
+        return;
+    }
+
+    const Index i = it->second;
+    if(_candidates[i].leaped) --_numLeaped;
+    else                      _exact.removeReaction(r);
+    _candidateIndex.erase(it);
+
+    // The order of candidates does not matter, so the last one is moved here.
+    if(i + 1 != _candidates.size()) {
+        _candidates[i] = _candidates.back();
+        _candidateIndex[_candidates[i].r] = i;
+    }
+    _candidates.pop_back();
+}
+
+void ChemHybridImpl::initialize() {
+    _exact.dt = dt;
+    updatePartition(true);
+    _exact.initialize();
+}
+
+void ChemHybridImpl::initializerestart(floatingpoint restarttime) {
+    _exact.initializerestart(restarttime);
+}
+
+void ChemHybridImpl::updatePartition(bool exactOnly) {
+    for(auto& c : _candidates) {
+        const auto n = c.from->getTrueN();
+        const bool leaped = !exactOnly
+            && !c.r->hasCallbacks() && !c.from->hasCallbacks() && !c.to->hasCallbacks()
+            && n >= (c.leaped ? 0.5 : 1.0) * _copyNumberThreshold;
+
+        if(leaped && !c.leaped) {
+            _exact.removeReaction(c.r);
+            c.leaped = true;
+            ++_numLeaped;
+        }
+        else if(!leaped && c.leaped) {
+            _exact.addReaction(c.r);
+            c.r->activateReaction();
+            c.leaped = false;
+            --_numLeaped;
+        }
+    }
+}
+
+void ChemHybridImpl::changeCopyNumber(RSpecies& rs, species_copy_t newN) {
+    if(_changedSpeciesIndex.try_emplace(&rs, _changedSpecies.size()).second) {
+        _changedSpecies.push_back({ &rs, rs.getTrueN() });
+    }
+    rs.setN(newN);
+}
+
+void ChemHybridImpl::refreshChangedSpecies() {
+    for(auto& cs : _changedSpecies) {
+        auto& rs = *cs.rs;
+        const auto newN = rs.getTrueN();
+        if(newN == cs.oldN) continue;
+
+        // Same as RSpecies::up() and RSpecies::down(), but for an arbitrary change.
+        bool refreshed = false;
+#ifdef TRACK_ZERO_COPY_N
+        if(cs.oldN == 0) {
+            rs.activateAssocReactantReactions();
+            refreshed = true;
+        }
+        else if(newN == 0) {
+            rs.passivateAssocReactantReactions();
+            refreshed = true;
+        }
+#endif
+#ifdef TRACK_UPPER_COPY_N
+        const auto ulim = rs.getUpperLimitForN();
+        if(cs.oldN == ulim)    rs.activateAssocProductReactions();
+        else if(newN == ulim) rs.passivateAssocProductReactions();
+#endif
+        if(!refreshed) {
+            // Leaped reactions are not in the exact network, and are not affected.
+            for(auto r : rs.reactantReactions()) r->updatePropensity();
+        }
+    }
+    _changedSpecies.clear();
+    _changedSpeciesIndex.clear();
+}
+
+void ChemHybridImpl::leap(floatingpoint time) {
+    // Draw the number of events using the propensities at the beginning of the window.
+    for(auto& c : _candidates) {
+        c.numEvents = 0;
+        if(!c.leaped) continue;
+        const floatingpoint a = c.r->computePropensity();
+        if(a > 0) {
+            _poisson_distr.param(decltype(_poisson_distr)::param_type(a * time));
+            c.numEvents = _poisson_distr(Rand::eng);
+        }
+    }
+
+    // Apply the events. Events that would make copy numbers out of range are rejected.
+    for(auto& c : _candidates) {
+        if(c.numEvents == 0) continue;
+        long long k = std::min<long long>(c.numEvents, c.from->getTrueN());
+#ifdef TRACK_UPPER_COPY_N
+        const long long ulim = c.to->getUpperLimitForN();
+        k = std::min<long long>(k, std::max<long long>(ulim - c.to->getTrueN(), 0));
+#endif
+        _stats.numRejectedEvents += c.numEvents - k;
+        _stats.numLeapEvents += k;
+        changeCopyNumber(*c.from, c.from->getTrueN() - k);
+        changeCopyNumber(*c.to,   c.to->getTrueN() + k);
+    }
+
+    // The propensity of a leaped reaction is proportional to the reactant copy number.
+    double change = 0;
+    for(auto& cs : _changedSpecies) {
+        if(cs.oldN > 0) {
+            change = std::max(change, std::abs((double)cs.rs->getTrueN() - cs.oldN) / cs.oldN);
+        }
+    }
+    ++_stats.numLeapSteps;
+    _stats.sumPropensityChange += change;
+    _stats.maxPropensityChange = std::max(_stats.maxPropensityChange, change);
+
+    refreshChangedSpecies();
+}
+
+bool ChemHybridImpl::run(floatingpoint time) {
+    floatingpoint t = getTime();
+    const floatingpoint endTime = t + time;
+    while(t < endTime) {
+        const floatingpoint windowTime = std::min(_leapTime, endTime - t);
+
+        updatePartition(false);
+        if(_numLeaped > 0) {
+            ++_stats.numWindows;
+            _stats.numLeapedReactions += _numLeaped;
+
+            // Symmetric splitting of the leaped and the exact reactions.
+            leap(windowTime / 2);
+            if(!_exact.run(windowTime)) return false;
+            leap(windowTime / 2);
+        }
+        else {
+            if(!_exact.run(windowTime)) return false;
+        }
+
+        t = std::min(t + windowTime, endTime);
+    }
+    return true;
+}
+
+bool ChemHybridImpl::runSteps(int steps) {
+    updatePartition(true);
+    return _exact.runSteps(steps);
+}
+
+void ChemHybridImpl::printStats() const {
+    if(_stats.numWindows == 0) return;
+
+    const double meanChange = _stats.sumPropensityChange / _stats.numLeapSteps;
+    log::info("Hybrid chemistry: {} leap windows, {:.1f} leaped reactions per window, {} leaped events, {} rejected events",
+        _stats.numWindows, (double)_stats.numLeapedReactions / _stats.numWindows, _stats.numLeapEvents, _stats.numRejectedEvents);
+    // This is the leap condition of tau-leaping, not a comparison with the exact simulation.
+    log::info("- Relative propensity change of leaped reactions per leap step: mean {:.3g}, max {:.3g}", meanChange, _stats.maxPropensityChange);
+    // A commonly used bound for the relative propensity change in tau-leaping.
+    if(meanChange > 0.03 || _stats.numRejectedEvents > 0) {
+        log::warn("Tau-leaping might be inaccurate. Consider using a smaller chem-hybrid-leap-time or a larger chem-hybrid-copy-number-threshold.");
+    }
+}
+
+} // namespace medyan
@@ -0,0 +1,198 @@
+
+//------------------------------------------------------------------
+//  **MEDYAN** - Simulation Package for the Mechanochemical
+//               Dynamics of Active Networks, v4.0
+//
+//  Copyright (2015-2018)  Papoian Lab, University of Maryland
+//
+//                 ALL RIGHTS RESERVED
+//
+//  See the MEDYAN web page for more information:
+//  http://www.medyan.org
+//------------------------------------------------------------------
+
+#ifndef MEDYAN_ChemHybridImpl_h
+#define MEDYAN_ChemHybridImpl_h
+
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "common.h"
+#include "Chemistry/ChemNRMImpl.h"
+#include "Chemistry/ChemSim.h"
+
+namespace medyan {
+
+//FORWARD DECLARATIONS
+class RSpecies;
+
+/// Runs diffusion of abundant species by tau-leaping, and everything else by NRM.
+/*! ChemHybridImpl keeps track of all diffusion reactions that may be leaped,
+ *  i.e. DiffusionReaction objects without callbacks, between regular species
+ *  without callbacks. Such a reaction is leaped while the copy number of its
+ *  reactant is at least the copy number threshold. It goes back to the exact
+ *  network when the copy number drops below half of the threshold, so that
+ *  reactions do not switch back and forth around the threshold. All other
+ *  reactions, including all filament reactions, are simulated exactly by a
+ *  ChemNRMImpl.
+ *
+ *  Time advances in leap windows. At the beginning of each window, the leaped
+ *  reactions are selected. The leaped and the exact reactions are then
+ *  interleaved by symmetric (Strang) splitting: the leaped reactions are fired
+ *  for half of the window, the exact network is simulated for the whole
+ *  window, and the leaped reactions are fired for the other half. In each
+ *  leap step, the number of events of each leaped reaction is drawn from a
+ *  Poisson distribution using the propensity at the beginning of the step.
+ *  The copy numbers are updated, and the exact reactions involving the
+ *  changed species are brought up to date.
+ *
+ *  There are two sources of error compared with the exact simulation:
+ *  - Tau-leaping error, because the propensities of the leaped reactions are
+ *    fixed within a leap step. It is controlled by the relative change of the
+ *    propensities of the leaped reactions in each leap step (the leap
+ *    condition), which is recorded in the statistics (see Stats).
+ *  - Splitting error, because the leaped reactions see the copy numbers
+ *    changed by the exact reactions only at the leap steps, and vice versa.
+ *    With the symmetric splitting, it is of second order in the window.
+ *  Neither is compared with an exact simulation at run time. The leap window
+ *  should be chosen such that the propensity change is small (e.g. a few
+ *  percent), and a window that is short compared with the time scales of the
+ *  exact reactions involving the leaped species keeps the splitting error
+ *  small.
+ *
+ *  When running for a number of steps instead of a time, all reactions are
+ *  simulated exactly.
+ *
+ *  @note The algorithm relies on tracking dependent Reactions, so
+ *  TRACK_DEPENDENTS must be defined.
+ */
+class ChemHybridImpl : public ChemSim {
+public:
+    /// Statistics of tau-leaping. They measure how well the leap condition
+    /// holds, and are not compared with the exact simulation.
+    struct Stats {
+        Size numWindows = 0;
+        /// Number of leap steps, two in each window.
+        Size numLeapSteps = 0;
+        /// Sum of the number of leaped reactions over all windows.
+        Size numLeapedReactions = 0;
+        /// Total number of reaction events by tau-leaping.
+        Size numLeapEvents = 0;
+        /// Number of events removed to keep copy numbers in range.
+        Size numRejectedEvents = 0;
+        /// Sum and maximum over leap steps of the largest relative propensity
+        /// change of the leaped reactions in the step.
+        double sumPropensityChange = 0;
+        double maxPropensityChange = 0;
+    };
+
+    /// Ctor:
+    /// @param copyNumberThreshold is the reactant copy number above which a
+    /// diffusion reaction is leaped.
+    /// @param leapTime is the length of the leap window.
+    ChemHybridImpl(floatingpoint copyNumberThreshold, floatingpoint leapTime);
+
+    /// Copying is not allowed
+    ChemHybridImpl(const ChemHybridImpl &rhs) = delete;
+
+    /// Assignment is not allowed
+    ChemHybridImpl& operator=(ChemHybridImpl &rhs) = delete;
+
+    virtual ~ChemHybridImpl() = default;
+
+    /// Return the number of reactions in the exact network.
+    size_t getExactSize() const { return _exact.getSize(); }
+    /// Return the number of reactions being leaped.
+    Size getLeapedSize() const { return _numLeaped; }
+    /// Return the statistics of tau-leaping.
+    const Stats& getStats() const { return _stats; }
+
+    /// Return the current global time
+    floatingpoint getTime() const { return _exact.getTime(); }
+
+    /// Add ReactionBase *r to the network
+    virtual void addReaction(ReactionBase *r);
+
+    /// Remove ReactionBase *r from the network
+    virtual void removeReaction(ReactionBase *r);
+
+    /// Initializes the network. All reactions are initially simulated exactly.
+    virtual void initialize();
+
+    //sets global time to restart time when called.
+    virtual void initializerestart(floatingpoint restarttime);
+
+    /// Run the chemical dynamics for a set amount of time, in leap windows.
+    virtual bool run(floatingpoint time);
+
+    /// Run the chemical dynamics for a set amount of reaction steps, exactly.
+    virtual bool runSteps(int steps);
+
+    /// Prints all RNodes in the exact network
+    virtual void printReactions() const { _exact.printReactions(); }
+
+    /// Cross checks all exact reactions in the network for firing time.
+    virtual bool crosschecktau() const { return _exact.crosschecktau(); }
+
+    /// Batch the propensity updates of the exact reactions.
+    virtual void beginRateUpdates() { _exact.beginRateUpdates(); }
+    virtual void endRateUpdates() { _exact.endRateUpdates(); }
+
+    /// Print the statistics of tau-leaping.
+    virtual void printStats() const;
+
+private:
+    /// A diffusion reaction that may be leaped.
+    struct Candidate {
+        ReactionBase* r;
+        RSpecies*     from;
+        RSpecies*     to;
+        bool          leaped = false;
+        long long     numEvents = 0; ///< Events drawn in the current window.
+    };
+    /// A species whose copy number is changed by leaping.
+    struct ChangedSpecies {
+        RSpecies*      rs;
+        species_copy_t oldN;
+    };
+
+    /// Returns whether the reaction is a candidate for leaping.
+    static bool isCandidate(ReactionBase *r);
+
+    /// Move candidates between the exact network and tau-leaping according to
+    /// their reactant copy numbers. If exactOnly is true, all candidates are
+    /// moved to the exact network.
+    void updatePartition(bool exactOnly);
+
+    /// Fire the leaped reactions for the given amount of time, in one leap step.
+    void leap(floatingpoint time);
+
+    /// Change the copy number of a species by tau-leaping.
+    void changeCopyNumber(RSpecies& rs, species_copy_t newN);
+
+    /// Bring the reactions involving the changed species up to date.
+    void refreshChangedSpecies();
+
+private:
+    ChemNRMImpl _exact; ///< Network of the reactions simulated exactly
+
+    std::vector<Candidate> _candidates;
+    std::unordered_map<ReactionBase*, Index> _candidateIndex;
+    Size _numLeaped = 0;
+
+    std::vector<ChangedSpecies> _changedSpecies;
+    std::unordered_map<RSpecies*, Index> _changedSpeciesIndex;
+
+    floatingpoint _copyNumberThreshold; ///< Copy number to start leaping
+    floatingpoint _leapTime; ///< Length of the leap window
+
+    Stats _stats;
+
+    poisson_distribution<long long> _poisson_distr;
+};
+
+} // namespace medyan
+
+#endif
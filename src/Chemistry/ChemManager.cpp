@@ -1547,6 +1547,7 @@ void ChemManager::genFilBindingReactions(SubSystem& sys, const medyan::SimulConf
             if(sc.chemParams.dissTracking){
                 rxn->setGNumber(r.gnum);
                 rxn->setHRCDID(r.hrcdid);
+                registerHRCDIDOff(rxn->getHRCDIndex());
             }
 
 
@@ -1742,6 +1743,7 @@ void ChemManager::genFilBindingReactions(SubSystem& sys, const medyan::SimulConf
             if(sc.chemParams.dissTracking){
                 rxn->setGNumber(r.gnum);
                 rxn->setHRCDID(r.hrcdid);
+                registerHRCDIDOff(rxn->getHRCDIndex());
             }
 
 
@@ -11,15 +11,11 @@
 //  http://www.medyan.org
 //------------------------------------------------------------------
 
+#include <algorithm>
 #include <iostream>
 #include <chrono>
 #include <cmath>
 
-#ifdef BOOST_MEM_POOL
-    #include <boost/pool/pool.hpp>
-    #include <boost/pool/pool_alloc.hpp>
-#endif
-
 #include "ChemNRMImpl.h"
 #include "Chemistry/DissipationTracker.h"
 #include "Rand.h"
@@ -29,38 +25,6 @@
 
 namespace medyan {
 
-#ifdef BOOST_MEM_POOL
-#ifdef BOOST_POOL_MEM_RNODENRM
-boost::pool<> allocator_rnodenrm(sizeof(RNodeNRM),BOOL_POOL_NSIZE);
-#endif
-
-#ifdef BOOST_POOL_MEM_PQNODE
-boost::pool<> allocator_pqnode(sizeof(PQNode),BOOL_POOL_NSIZE);
-#endif
-
-
-#ifdef BOOST_POOL_MEM_PQNODE
-void* PQNode::operator new(size_t size) {
-    void *ptr = boost::fast_pool_allocator<PQNode>::allocate();
-    return ptr;
-}
-
-void PQNode::operator delete(void* ptr) noexcept {
-    boost::fast_pool_allocator<PQNode>::deallocate((PQNode*)ptr);
-}
-#endif
-
-#ifdef BOOST_POOL_MEM_RNODENRM
-void* RNodeNRM::operator new(size_t size) {
-    void *ptr = boost::fast_pool_allocator<RNodeNRM>::allocate();
-    return ptr;
-}
-
-void RNodeNRM::operator delete(void* ptr) noexcept {
-    boost::fast_pool_allocator<RNodeNRM>::deallocate((RNodeNRM*)ptr);
-}
-#endif
-#endif
 
 RNodeNRM::RNodeNRM(ReactionBase *r, ChemNRMImpl &chem_nrm)
     : _chem_nrm (chem_nrm), _react(r) {
@@ -121,7 +85,10 @@ void RNodeNRM::generateNewRandTau() {
 
 void RNodeNRM::activateReaction() {
     generateNewRandTau();
-    updateHeap();
+    if(_chem_nrm.rateUpdatesDeferred())
+        _chem_nrm.deferHeapUpdate(this);
+    else
+        updateHeap();
 }
 
 void RNodeNRM::passivateReaction() {
@@ -204,9 +171,7 @@ bool ChemNRMImpl::makeStep(floatingpoint endTime) {
     // if dissipation tracking is enabled and the reaction is supported, then compute the change in Gibbs free energy and store it
     if(SysParams::Chemistry().dissTracking){
         ReactionBase* react = rn->getReaction();
-        string HRCDID = react->getHRCDID();
-        string testString = "DNT";
-        if((HRCDID != testString) || (react->getReactionType() == ReactionType::DIFFUSION)){
+        if((react->getHRCDIndex() != hrcdidDNT) || (react->getReactionType() == ReactionType::DIFFUSION)){
             dt->updateDelGChem(react);
         }
     }
@@ -255,6 +220,8 @@ bool ChemNRMImpl::makeStep(floatingpoint endTime) {
         for(auto& prdep : r->dependents()) {
 
             RNodeNRM *rn_other = (RNodeNRM*)(prdep->getRnode());
+            // The dependent might not be simulated by this network.
+            if(rn_other == nullptr) continue;
             floatingpoint a_old = rn_other->getPropensity();
 
             //recompute propensity
@@ -280,6 +247,10 @@ bool ChemNRMImpl::makeStep(floatingpoint endTime) {
                     tau_new = rn_other->getTau();
                 }
             }
+            else if(a_new == a_old) {
+                // The propensity is unchanged, so tau and the heap need no update.
+                continue;
+            }
             else {
                 tau_new = (a_old/a_new)*(tau_old-_t) + _t;
             }
@@ -361,7 +332,43 @@ void ChemNRMImpl::addReaction(ReactionBase *r) {
 }
 
 void ChemNRMImpl::removeReaction(ReactionBase *r) {
-    _map_rnodes.erase(r);
+    auto it = _map_rnodes.find(r);
+    if(it == _map_rnodes.end()) return;
+
+    if(it->second->_heapUpdateDeferred) {
+        auto& v = _deferredRNodes;
+        v.erase(std::find(v.begin(), v.end(), it->second.get()));
+    }
+    _map_rnodes.erase(it);
+}
+
+void ChemNRMImpl::endRateUpdates() {
+    _rateUpdatesDeferred = false;
+
+    if(_deferredRNodes.size() >= heapRebuildFraction * _map_rnodes.size()) {
+        rebuildHeap_();
+    }
+    else {
+        // Updating a node re-links it and its children by the current taus, so
+        // the heap is valid after all deferred nodes are updated.
+        for(auto rn : _deferredRNodes) rn->updateHeap();
+    }
+
+    for(auto rn : _deferredRNodes) rn->_heapUpdateDeferred = false;
+    _deferredRNodes.clear();
+}
+
+void ChemNRMImpl::rebuildHeap_() {
+    vector<PQNode> nodes;
+    nodes.reserve(_map_rnodes.size());
+    for(auto &x : _map_rnodes) {
+        auto rn = x.second.get();
+        nodes.emplace_back(rn);
+        nodes.back()._tau = rn->getTau();
+    }
+
+    _heap.clear();
+    for(auto &node : nodes) node._rn->_handle = _heap.push(node);
 }
 
 void ChemNRMImpl::printReactions() const {
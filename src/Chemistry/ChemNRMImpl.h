@@ -31,14 +31,7 @@
 #include "Chemistry/ChemSim.h"
 #include "ChemRNode.h"
 
-#ifdef BOOST_MEM_POOL
-#include <boost/pool/pool.hpp>
-#include <boost/pool/pool_alloc.hpp>
-#endif
-
-#define BOOST_POOL_MEM_PQNODE
-#define BOOST_POOL_MEM_RNODENRM
-#define BOOST_POOL_MEM_HEAP_ELEMENT
+#include "Util/SlabAllocator.hpp"
 
 namespace medyan {
 
@@ -47,16 +40,10 @@ class PQNode;
 class RNodeNRM;
 class ChemNRMImpl;
 
-#if defined BOOST_MEM_POOL && defined BOOST_POOL_MEM_HEAP_ELEMENT
-typedef boost::fast_pool_allocator<PQNode> fast_allocator_t;
-typedef boost::heap::pairing_heap<PQNode,
-        boost::heap::allocator<fast_allocator_t>> boost_heap;
+// Heap nodes are allocated in slab pools.
 typedef boost::heap::pairing_heap<PQNode,
-        boost::heap::allocator<fast_allocator_t>>::handle_type handle_t;
-#else
-typedef boost::heap::pairing_heap<PQNode> boost_heap;
-typedef boost::heap::pairing_heap<PQNode>::handle_type handle_t;
-#endif
+        boost::heap::allocator<SlabStdAllocator<PQNode>>> boost_heap;
+typedef boost_heap::handle_type handle_t;
     
 /// Priority Queue Node. It is stored as an element of a heap, such as
 /// boost::heap::pairing_heap<PQNode>. There will be an associated heap handle which
@@ -91,14 +78,10 @@ public:
         return _tau > rhs._tau;
     }
     
-#ifdef BOOST_MEM_POOL
-#ifdef BOOST_POOL_MEM_PQNODE
-    /// Advanced memory management
-    void* operator new(size_t size);
-    
-    void operator delete(void* ptr) noexcept;
-#endif
-#endif
+    /// Allocated in slab pools.
+    static void* operator new(size_t size) { return slabAllocate< PQNode >(size); }
+
+    static void operator delete(void* ptr, size_t size) noexcept { slabDeallocate< PQNode >(ptr, size); }
 private: 
     RNodeNRM *_rn; ///< Pointer to the reaction node (RNodeNRM) which this PQNode
                    ///< represents (or tracks)
@@ -216,14 +199,10 @@ public:
     /// Reaction object dependencies)
     void printDependents() const;
     
-#ifdef BOOST_MEM_POOL
-#ifdef BOOST_POOL_MEM_RNODENRM
-    /// Advanced memory management
-    void* operator new(size_t size);
-    
-    void operator delete(void* ptr) noexcept;
-#endif
-#endif
+    /// Allocated in slab pools.
+    static void* operator new(size_t size) { return slabAllocate< RNodeNRM >(size); }
+
+    static void operator delete(void* ptr, size_t size) noexcept { slabDeallocate< RNodeNRM >(ptr, size); }
 private:
     ChemNRMImpl &_chem_nrm; ///< A reference to the ChemNRMImpl which containts the
                             ///<heap, random number generators, etc.
@@ -232,6 +211,10 @@ private:
                           ///< corresponding memory is not managed by RNodeNRM.
     floatingpoint _a; ///< The propensity associated with the Reaction.
                ///< It may be outdated and may need to be recomputed if needed.
+    bool _heapUpdateDeferred = false; ///< Whether the heap update of the new tau is
+                                      ///< deferred until the end of rate updates.
+
+    friend class ChemNRMImpl;
 };
 
 
@@ -332,6 +315,30 @@ public:
 
     /// Cross checks all reactions in the network for firing time.
     virtual bool crosschecktau() const;
+
+    /// Start deferring the heap updates of activated reactions. New taus are still
+    /// generated immediately, but the heap is only fixed in endRateUpdates().
+    virtual void beginRateUpdates() { _rateUpdatesDeferred = true; }
+
+    /// Fix the heap for all reactions activated since beginRateUpdates(). If most
+    /// of the reactions have been updated, the heap is rebuilt from scratch, which
+    /// is cheaper than updating the nodes one by one.
+    virtual void endRateUpdates();
+
+    /// Whether the heap updates are currently deferred.
+    bool rateUpdatesDeferred() const { return _rateUpdatesDeferred; }
+
+    /// Defer the heap update of the rnode until endRateUpdates().
+    void deferHeapUpdate(RNodeNRM* rn) {
+        if(!rn->_heapUpdateDeferred) {
+            rn->_heapUpdateDeferred = true;
+            _deferredRNodes.push_back(rn);
+        }
+    }
+
+    /// Fraction of the reactions with deferred heap updates, above which the heap
+    /// is rebuilt instead of updated node by node.
+    static constexpr floatingpoint heapRebuildFraction = 0.75;
     
 private:
     /// This is a somewhat complex subroutine which implements the main part of the
@@ -360,6 +367,12 @@ private:
                       ///< containing PQNode elements
     exponential_distribution<floatingpoint> _exp_distr; ///< Adaptor for the exponential distribution
     floatingpoint _t; ///< global time
+
+    bool _rateUpdatesDeferred = false; ///< Whether heap updates are deferred
+    vector<RNodeNRM*> _deferredRNodes; ///< RNodes with deferred heap updates
+
+    /// Rebuild the heap from the taus of all the RNodes.
+    void rebuildHeap_();
 };
 
 } // namespace medyan
@@ -0,0 +1,257 @@
+
+//------------------------------------------------------------------
+//  **MEDYAN** - Simulation Package for the Mechanochemical
+//               Dynamics of Active Networks, v4.0
+//
+//  Copyright (2015-2018)  Papoian Lab, University of Maryland
+//
+//                 ALL RIGHTS RESERVED
+//
+//  See the MEDYAN web page for more information:
+//  http://www.medyan.org
+//------------------------------------------------------------------
+
+#include "ChemPartitionedImpl.h"
+
+#include "Rand.h"
+#include "SysParams.h"
+#include "Chemistry/ReactionDy.hpp"
+#include "Util/ThreadPool.hpp"
+
+namespace medyan {
+
+ChemPartitionedImpl::ChemPartitionedImpl(
+    std::unordered_map<const Composite*, Index> domainOfParent,
+    Size numDomains,
+    floatingpoint syncTime
+) :
+    _domainOfParent(std::move(domainOfParent)),
+    _shared(std::make_unique<ChemCRImpl>()),
+    _syncTime(syncTime)
+{
+    if(numDomains < 1) {
+        log::error("Number of chemistry sub-domains must be positive, but {} is given.", numDomains);
+        throw std::runtime_error("Invalid number of chemistry sub-domains");
+    }
+    if(!(syncTime > 0)) {
+        log::error("Chemistry synchronization time must be positive, but {} is given.", syncTime);
+        throw std::runtime_error("Invalid chemistry synchronization time");
+    }
+
+    // Each sub-domain uses its own random number generator, seeded from the global one.
+    _domainEngines.reserve(numDomains);
+    for(Index d = 0; d < numDomains; ++d) {
+        _domainEngines.emplace_back(Rand::eng());
+    }
+    for(Index d = 0; d < numDomains; ++d) {
+        auto& pd = _domains.emplace_back(std::make_unique<ChemCRImpl>());
+        pd->setOwnsGlobalTime(false);
+        pd->setRandomEngine(_domainEngines[d]);
+    }
+    resetTime();
+}
+
+ChemPartitionedImpl::~ChemPartitionedImpl() noexcept {
+    // Reactions might still be deferred if an exception was thrown.
+    for(auto r : _sharedReactions) r->setUpdatesDeferred(false);
+}
+
+Index ChemPartitionedImpl::classifyReaction(ReactionBase *r) const {
+    if(r->hasCallbacks()) return sharedDomain;
+    if(r->getReactionType() != ReactionType::REGULAR && r->getReactionType() != ReactionType::DIFFUSION) return sharedDomain;
+
+    Index domain = sharedDomain;
+    const auto checkSpecies = [&](RSpecies& rs) {
+        // Averaging species depend on the global time.
+        if(dynamic_cast<RSpeciesAvg*>(&rs)) return false;
+
+        auto it = _domainOfParent.find(rs.getSpecies().getParent());
+        if(it == _domainOfParent.end()) return false;
+        if(domain == sharedDomain) domain = it->second;
+        return domain == it->second;
+    };
+
+    if(auto rdy = dynamic_cast<ReactionDy*>(r)) {
+        for(auto& rep : rdy->getRepRSpecies()) {
+            if(!checkSpecies(*rep.prs)) return sharedDomain;
+        }
+    }
+    else {
+        for(Index i = 0; i < r->size(); ++i) {
+            if(!checkSpecies(*r->rspecies()[i])) return sharedDomain;
+        }
+    }
+    return domain;
+}
+
+void ChemPartitionedImpl::addReaction(ReactionBase *r) {
+    const auto domain = classifyReaction(r);
+    network(domain).addReaction(r);
+    _domainOfReaction[r] = domain;
+    if(domain == sharedDomain) _sharedReactions.insert(r);
+}
+
+void ChemPartitionedImpl::removeReaction(ReactionBase *r) {
+    auto it = _domainOfReaction.find(r);
+    if(it == _domainOfReaction.end()) return;
+    network(it->second).removeReaction(r);
+    if(it->second == sharedDomain) _sharedReactions.erase(r);
+    _domainOfReaction.erase(it);
+}
+
+void ChemPartitionedImpl::updateReaction(ReactionBase *r) {
+    auto it = _domainOfReaction.find(r);
+    if(it == _domainOfReaction.end()) return;
+    if(classifyReaction(r) == it->second) return;
+
+    removeReaction(r);
+    addReaction(r);
+}
+
+void ChemPartitionedImpl::initialize() {
+    resetTime();
+    for(auto& pd : _domains) {
+        pd->dt = dt;
+        pd->initialize();
+    }
+    _shared->dt = dt;
+    _shared->initialize();
+    syncGlobalTime();
+}
+
+void ChemPartitionedImpl::initializerestart(floatingpoint restarttime){
+
+    if(SysParams::RUNSTATE){
+        LOG(ERROR) << "initializerestart Function from ChemPartitionedImpl class can "
+                      "only be called "
+                      "during restart phase. Exiting.";
+        throw std::logic_error("Illegal function call pattern");
+    }
+
+    _t = restarttime;
+    for(auto& pd : _domains) pd->setTime(restarttime);
+    _shared->setTime(restarttime);
+    syncGlobalTime();
+}
+
+floatingpoint ChemPartitionedImpl::computeTotalA() const {
+    floatingpoint res = _shared->computeTotalA();
+    for(auto& pd : _domains) res += pd->computeTotalA();
+    return res;
+}
+
+void ChemPartitionedImpl::refreshSharedReaction(ReactionBase *r) {
+    r->setUpdatesDeferred(false);
+#ifdef TRACK_DEPENDENTS
+    // Only rebuilt if any reaction consuming the species has changed.
+    if(r->areDependentsOutdated()) r->setDependentReactions();
+#endif
+#if defined TRACK_ZERO_COPY_N || defined TRACK_UPPER_COPY_N
+    if(r->isPassivated()) {
+        // Activated only if none of the reactants or products prevents it.
+        r->activateReaction();
+        return;
+    }
+    bool blocked = false;
+#ifdef TRACK_ZERO_COPY_N
+    blocked = blocked || areEqual(r->getProductOfReactants(), 0.0);
+#endif
+#ifdef TRACK_UPPER_COPY_N
+    blocked = blocked || areEqual(r->getProductOfProducts(), 0.0);
+#endif
+    if(blocked) {
+        r->passivateReaction();
+        return;
+    }
+#endif
+    r->updatePropensity();
+}
+
+void ChemPartitionedImpl::runDomains(floatingpoint time) {
+    auto& pool = ThreadPool::global();
+
+    if(_domains.size() == 1 || pool.numThreads() == 0) {
+        // Shared reactions can be updated directly in serial.
+        for(auto& pd : _domains) pd->run(time);
+        return;
+    }
+
+    // Shared reactions might be affected by several sub-domains at the same time.
+    for(auto r : _sharedReactions) r->setUpdatesDeferred(true);
+
+    pool.parallelFor(0, _domains.size(), [&](Index d) {
+        _domains[d]->run(time);
+    });
+
+    for(auto r : _sharedReactions) refreshSharedReaction(r);
+}
+
+bool ChemPartitionedImpl::run(floatingpoint time) {
+    const floatingpoint endTime = _t + time;
+    while(_t < endTime) {
+        const floatingpoint windowTime = std::min(_syncTime, endTime - _t);
+
+        runDomains(windowTime);
+
+        // Shared reactions might use the global time in callbacks.
+        _shared->setTime(_t);
+        if(!_shared->run(windowTime)) return false;
+
+        _t = std::min(_t + windowTime, endTime);
+        syncGlobalTime();
+    }
+    return true;
+}
+
+bool ChemPartitionedImpl::runSteps(int steps) {
+    std::vector<ChemCRImpl*> networks;
+    for(auto& pd : _domains) networks.push_back(pd.get());
+    networks.push_back(_shared.get());
+
+    std::vector<floatingpoint> as(networks.size());
+    for(int i = 0; i < steps; ++i) {
+        floatingpoint aTotal = 0;
+        for(Index ni = 0; ni < networks.size(); ++ni) {
+            as[ni] = networks[ni]->computeTotalA();
+            aTotal += as[ni];
+        }
+        // this means that the network has come to a halt
+        if(aTotal<1e-15)
+            return false;
+
+        const floatingpoint tau = medyan::rand::safeExpDist(_exp_distr, aTotal, Rand::eng);
+        _t += tau;
+        syncGlobalTime();
+
+        // Select the network to fire a reaction in.
+        Index selected = networks.size() - 1;
+        if(aTotal != std::numeric_limits<floatingpoint>::infinity()) {
+            floatingpoint mu = aTotal * _uniform_distr(Rand::eng);
+            for(Index ni = 0; ni < networks.size(); ++ni) {
+                if(as[ni] > 0) selected = ni;
+                mu -= as[ni];
+                if(mu < 0 && as[ni] > 0) break;
+            }
+        }
+        else {
+            for(Index ni = 0; ni < networks.size(); ++ni) {
+                if(as[ni] == std::numeric_limits<floatingpoint>::infinity()) { selected = ni; break; }
+            }
+        }
+
+        networks[selected]->setTime(_t);
+        if(!networks[selected]->fireNextReaction()) return false;
+    }
+    return true;
+}
+
+void ChemPartitionedImpl::printReactions() const {
+    for(Index d = 0; d < _domains.size(); ++d) {
+        cout << "Sub-domain " << d << ":\n";
+        _domains[d]->printReactions();
+    }
+    cout << "Shared:\n";
+    _shared->printReactions();
+}
+
+} // namespace medyan
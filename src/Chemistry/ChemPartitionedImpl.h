@@ -0,0 +1,165 @@
+
+//------------------------------------------------------------------
+//  **MEDYAN** - Simulation Package for the Mechanochemical
+//               Dynamics of Active Networks, v4.0
+//
+//  Copyright (2015-2018)  Papoian Lab, University of Maryland
+//
+//                 ALL RIGHTS RESERVED
+//
+//  See the MEDYAN web page for more information:
+//  http://www.medyan.org
+//------------------------------------------------------------------
+
+#ifndef MEDYAN_ChemPartitionedImpl_h
+#define MEDYAN_ChemPartitionedImpl_h
+
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common.h"
+#include "Chemistry/ChemCRImpl.h"
+#include "Chemistry/ChemSim.h"
+
+namespace medyan {
+
+//FORWARD DECLARATIONS
+class Composite;
+
+/// Runs a reaction network split into spatial sub-domains in parallel.
+/*! ChemPartitionedImpl assigns each reaction either to one of the sub-domains,
+ *  or to the shared part of the network. A reaction belongs to a sub-domain if
+ *  all its species are in compartments of that sub-domain, it is a regular or
+ *  diffusion reaction, and it has no callbacks (so that firing it does not
+ *  modify any state outside the reaction network). All other reactions, such
+ *  as the diffusion reactions crossing sub-domain boundaries and all filament
+ *  reactions, are shared.
+ *
+ *  Each sub-domain, as well as the shared part, is simulated by its own
+ *  ChemCRImpl. Time advances in synchronization windows. In each window, all
+ *  sub-domains are first simulated concurrently on the global thread pool,
+ *  during which the shared reactions are frozen (see
+ *  ReactionBase::setUpdatesDeferred()). Then the shared reactions are brought
+ *  up to date and simulated for the same window. This operator splitting is
+ *  exact in the limit of small windows; the synchronization window should be
+ *  small compared to the typical waiting time of cross-boundary events.
+ *
+ *  When running for a number of steps instead of a time, all parts of the
+ *  network are simulated together in serial, which is exact.
+ *
+ *  @note The algorithm relies on tracking dependent Reactions, so
+ *  TRACK_DEPENDENTS must be defined.
+ */
+class ChemPartitionedImpl : public ChemSim {
+public:
+    /// Ctor:
+    /// @param domainOfParent maps the parents of species (i.e. compartments) to
+    /// sub-domain indices in [0, numDomains). Species whose parents are not
+    /// found do not belong to any sub-domain.
+    /// @param numDomains is the number of sub-domains.
+    /// @param syncTime is the length of the synchronization window.
+    ChemPartitionedImpl(
+        std::unordered_map<const Composite*, Index> domainOfParent,
+        Size numDomains,
+        floatingpoint syncTime);
+
+    /// Copying is not allowed
+    ChemPartitionedImpl(const ChemPartitionedImpl &rhs) = delete;
+
+    /// Assignment is not allowed
+    ChemPartitionedImpl& operator=(ChemPartitionedImpl &rhs) = delete;
+
+    virtual ~ChemPartitionedImpl() noexcept;
+
+    /// Return the number of sub-domains.
+    Size getNumDomains() const { return _domains.size(); }
+    /// Return the number of reactions in the sub-domain.
+    size_t getDomainSize(Index domain) const { return _domains[domain]->getSize(); }
+    /// Return the number of reactions shared by the sub-domains.
+    size_t getSharedSize() const { return _shared->getSize(); }
+    /// Return the length of the synchronization window.
+    floatingpoint getSyncTime() const { return _syncTime; }
+
+    /// Return the current global time
+    floatingpoint getTime() const {return _t;}
+
+    /// Sets the global time to 0.0
+    void resetTime() {_t=0.0; syncGlobalTime(); }
+
+    /// Sets global time variable to this network's time.
+    void syncGlobalTime() {global_time=_t; }
+
+    /// Add ReactionBase *r to the sub-domain it belongs to, or to the shared part.
+    virtual void addReaction(ReactionBase *r);
+
+    /// Remove ReactionBase *r from the network
+    virtual void removeReaction(ReactionBase *r);
+
+    /// Move ReactionBase *r to another sub-domain if its species have changed domain.
+    virtual void updateReaction(ReactionBase *r);
+
+    /// Initializes the networks of all sub-domains and the shared part.
+    virtual void initialize();
+
+    //sets global time to restart time when called.
+    virtual void initializerestart(floatingpoint restarttime);
+
+    /// Unconditionally compute the total propensity associated with the network.
+    floatingpoint computeTotalA() const;
+
+    /// Run the chemical dynamics for a set amount of time, in synchronization windows.
+    virtual bool run(floatingpoint time);
+
+    /// Run the chemical dynamics for a set amount of reaction steps, in serial.
+    virtual bool runSteps(int steps);
+
+    /// Prints all RNodes in the reaction network
+    virtual void printReactions() const;
+
+    /// Cross checks all reactions in the network for firing time.
+    virtual bool crosschecktau() const {
+        log::warn("Cannot check for tau in reactions in ChemPartitionedImpl.h");
+        return true;
+    };
+
+private:
+    /// Index used for reactions in the shared part of the network.
+    static constexpr Index sharedDomain = -1;
+
+    /// Find the sub-domain that the reaction belongs to.
+    Index classifyReaction(ReactionBase *r) const;
+
+    /// Returns the network simulating the given domain.
+    ChemCRImpl& network(Index domain) {
+        return domain == sharedDomain ? *_shared : *_domains[domain];
+    }
+
+    /// Simulate all sub-domains concurrently for the given amount of time.
+    void runDomains(floatingpoint time);
+
+    /// Brings a shared reaction up to date after concurrent simulation of the
+    /// sub-domains, where its updates were deferred.
+    void refreshSharedReaction(ReactionBase *r);
+
+private:
+    std::unordered_map<const Composite*, Index> _domainOfParent;
+    std::vector<std::unique_ptr<ChemCRImpl>> _domains; ///< Networks of each sub-domain
+    std::unique_ptr<ChemCRImpl> _shared; ///< Network of the shared reactions
+    std::vector<std::mt19937> _domainEngines; ///< Random number generators of sub-domains
+
+    std::unordered_map<ReactionBase*, Index> _domainOfReaction;
+    std::unordered_set<ReactionBase*> _sharedReactions;
+
+    floatingpoint _syncTime; ///< Length of the synchronization window
+    floatingpoint _t = 0; ///< global time
+
+    exponential_distribution<floatingpoint> _exp_distr;
+    uniform_real_distribution<floatingpoint> _uniform_distr;
+};
+
+} // namespace medyan
+
+#endif
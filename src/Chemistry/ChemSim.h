@@ -48,6 +48,20 @@ public:
     
     /// Remove Reaction *r from the simulated chemical network 
     virtual void removeReaction(ReactionBase *r) = 0;
+
+    /// Notify that the species of Reaction *r have been replaced in place, which is
+    /// done between passivation and activation of the reaction. By default, nothing
+    /// is needed, because the propensity is recomputed upon activation.
+    virtual void updateReaction(ReactionBase *r) {}
+
+    /// Start a batch of propensity updates, such as the rate updates after
+    /// mechanical minimization. Until endRateUpdates() is called, the
+    /// implementation may defer the bookkeeping of updated reactions, so no
+    /// reaction may be fired in the meantime. By default, nothing is deferred.
+    virtual void beginRateUpdates() {}
+
+    /// Finish the batch of propensity updates started by beginRateUpdates().
+    virtual void endRateUpdates() {}
     
     /// Run the chemical dynamics for a set amount of time
     virtual bool run(floatingpoint time) = 0;
@@ -61,7 +75,10 @@ public:
 
     /// Cross checks all reactions in the network for firing time.
     virtual bool crosschecktau() const = 0;
-    
+
+    /// Print statistics of the simulation algorithm, usually at the end of a run
+    virtual void printStats() const {}
+
     DissipationTracker* getDT() const { return dt; }
 };
 
@@ -71,25 +71,35 @@ private:
     // cumulative change in mechanical energy
     floatingpoint cumGMechEn;
     
-    // vector of HRCD elements
-    vector<tuple<string, floatingpoint>> HRCDVec;
+    // HRCD elements, indexed by the interned HRCDIDs (see hrcdidNames())
+    vector<floatingpoint> HRCDDelG;
+    vector<char> HRCDRecorded;
+    
+    // interned HRCDIDs in the order they are first recorded, used in output
+    vector<Index> HRCDOrder;
+    
+    // interned HRCDIDs of diffusion reactions, indexed by the molecule of the diffusing species
+    vector<Index> difHRCDIDs;
+    
+    // names of the HRMD elements, shared by all HRMD vectors below
+    vector<string> HRMDNames;
     
     // vector of HRMD element
-    vector<tuple<string, floatingpoint>> HRMDVec1;
+    vector<floatingpoint> HRMDVec1;
     
     // vector of HRMD element
-    vector<tuple<string, floatingpoint>> HRMDVecMid;
+    vector<floatingpoint> HRMDVecMid;
     
     
     // vector of HRMD element
-    vector<tuple<string, floatingpoint>> cumHRMDMechDiss;
+    vector<floatingpoint> cumHRMDMechDiss;
     
     // vector of HRMD element
-    vector<tuple<string, floatingpoint>> cumHRMDMechEnergy;
+    vector<floatingpoint> cumHRMDMechEnergy;
     
     // vector of HRMD element
-    vector<tuple<string, floatingpoint>> HRMDVec2;
-    vector<vector<tuple<string, floatingpoint>>> HRMDMat;
+    vector<floatingpoint> HRMDVec2;
+    vector<vector<floatingpoint>> HRMDMat;
     
     // vector of motor walking data
     //ID, birthtime, walktime, xcoord, ycoord, zcoord,
@@ -181,18 +191,12 @@ public:
         vector<species_copy_t> reacN = re->getReactantCopyNumbers();
         vector<species_copy_t> prodN = re->getProductCopyNumbers();
         
-        // get vector of names of the reactants and products
-        vector<string> reacNames = re->getReactantSpecies();
-        vector<string> prodNames = re->getProductSpecies();
-        
-        // get the HRCDID of this reaction
-        string hrcdid;
-        hrcdid = re->getHRCDID();
+        // get the interned HRCDID of this reaction
+        Index hrcdid = re->getHRCDIndex();
         
         // add the name of the diffusing species to the HRCDID of the diffusion reaction
         if(reType == ReactionType::DIFFUSION){
-            hrcdid = "DIF_";
-            hrcdid += reacNames[0];
+            hrcdid = getDifHRCDID(re);
         }
         
         
@@ -322,10 +326,10 @@ public:
             // Filament Aging
             
             vector<species_copy_t> numR;
-            numR.push_back(Filament::countSpecies(0,reacNames[0]));
+            numR.push_back(Filament::countSpecies(0,re->getReactantSpecies()[0]));
             
             vector<species_copy_t> numP;
-            numP.push_back(Filament::countSpecies(0,prodNames[0]));
+            numP.push_back(Filament::countSpecies(0,re->getProductSpecies()[0]));
             
             delGZero = (re->getGNumber());
             delGZero -= sigma*log(volFrac);
@@ -369,7 +373,7 @@ public:
         // record this reaction in the HRCD data
         updateHRCDVec(hrcdid,delG);
         
-        if(hrcdid=="DNT"){
+        if(hrcdid==hrcdidDNT){
             cout<< medyan::underlying(reType) <<endl;
         }
 
@@ -381,6 +385,19 @@ public:
     
     
     
+    // Find the interned HRCDID of a diffusion reaction, which is "DIF_" followed by the
+    // name of the diffusing species. The names are only interned the first time.
+    Index getDifHRCDID(ReactionBase* re){
+        const int molecule = re->rspecies()[0]->getSpecies().getMolecule();
+        if(molecule >= difHRCDIDs.size()){
+            difHRCDIDs.resize(molecule + 1, -1);
+        }
+        if(difHRCDIDs[molecule] == -1){
+            difHRCDIDs[molecule] = hrcdidNames().id("DIF_" + re->getReactantSpecies()[0]);
+        }
+        return difHRCDIDs[molecule];
+    }
+    
     // increment the GChem counter when a reaction fires
     void updateDelGChem(ReactionBase* re){
         GChem += getDelGChem(re);
@@ -414,19 +431,32 @@ public:
         return cumGMechEn;
     }
     
+    // pair the HRMD values with their names, used in output
+    vector<tuple<string, floatingpoint>> namedHRMD(const vector<floatingpoint>& values){
+        vector<tuple<string, floatingpoint>> res;
+        for(auto i = 0; i < values.size(); i++){
+            res.push_back(make_tuple(HRMDNames[i], values[i]));
+        }
+        return res;
+    }
+    
     // return the HRMD cumulative change in mechanical energy
     vector<tuple<string, floatingpoint>> getCumHRMDMechEnergy(){
-        return cumHRMDMechEnergy;
+        return namedHRMD(cumHRMDMechEnergy);
     }
     
     // return the HRMD cumulative change in mechanical dissipation
     vector<tuple<string, floatingpoint>> getCumHRMDMechDiss(){
-        return cumHRMDMechDiss;
+        return namedHRMD(cumHRMDMechDiss);
     }
 
     //get HRMD mat
     vector<vector<tuple<string, floatingpoint>>> getHRMDmat(){
-        return HRMDMat;
+        vector<vector<tuple<string, floatingpoint>>> res;
+        for(auto& values : HRMDMat){
+            res.push_back(namedHRMD(values));
+        }
+        return res;
     }
     //  used to determine if minization should proceed
     floatingpoint getCurrentStress(){
@@ -441,10 +471,16 @@ public:
         HRMDVec1.clear();
         
         for(auto i = 0; i < report.individual.size(); i++){
-            HRMDVec1.push_back(make_tuple(report.individual[i].name, report.individual[i].energy / kT));
-            cumHRMDMechDiss.push_back(make_tuple(report.individual[i].name, 0.0));
-            cumHRMDMechEnergy.push_back(make_tuple(report.individual[i].name, 0.0));
+            HRMDVec1.push_back(report.individual[i].energy / kT);
         };
+        // the energy names are the same in all reports
+        if(HRMDNames.empty()){
+            for(auto i = 0; i < report.individual.size(); i++){
+                HRMDNames.push_back(report.individual[i].name);
+            }
+            cumHRMDMechDiss.assign(HRMDNames.size(), 0.0);
+            cumHRMDMechEnergy.assign(HRMDNames.size(), 0.0);
+        }
         
         G1 = report.total / kT;
       
@@ -454,7 +490,7 @@ public:
     void setG2(const EnergyReport& report){
         HRMDVec2.clear();
         for(auto i = 0; i < report.individual.size(); i++){
-            HRMDVec2.push_back(make_tuple(report.individual[i].name, report.individual[i].energy / kT));
+            HRMDVec2.push_back(report.individual[i].energy / kT);
         };
         HRMDMat.push_back(HRMDVec2);
         G2 = report.total / kT;
@@ -464,7 +500,7 @@ public:
     void setGMid(const EnergyReport& report){
         HRMDVecMid.clear();
         for(auto i = 0; i < report.individual.size(); i++){
-            HRMDVecMid.push_back(make_tuple(report.individual[i].name, report.individual[i].energy / kT));
+            HRMDVecMid.push_back(report.individual[i].energy / kT);
         };
         HRMDMat.push_back(HRMDVecMid);
         GMid = report.total / kT;
@@ -514,7 +550,7 @@ public:
     void updateCumHRMDMechEnergy(){
         
         for(auto i = 0; i<cumHRMDMechEnergy.size();i++){
-            get<1>(cumHRMDMechEnergy[i]) += get<1>(HRMDVec2[i]) - get<1>(HRMDVec1[i]);
+            cumHRMDMechEnergy[i] += HRMDVec2[i] - HRMDVec1[i];
         }
         
     }
@@ -523,7 +559,7 @@ public:
     void updateCumHRMDMechDiss(){
         
         for(auto i = 0; i<cumHRMDMechEnergy.size();i++){
-            get<1>(cumHRMDMechDiss[i]) += get<1>(HRMDVec2[i]) - get<1>(HRMDVecMid[i]);
+            cumHRMDMechDiss[i] += HRMDVec2[i] - HRMDVecMid[i];
         }
 
     }
@@ -537,25 +573,32 @@ public:
         G1=G2;
         
         for(auto i = 0; i < HRMDVec1.size(); i++){
-            HRMDVecMid[i] = make_tuple(get<0>(HRMDVecMid[i]),0.0);
-            HRMDVec1[i] = make_tuple(get<0>(HRMDVec1[i]),get<1>(HRMDVec2[i]));
+            HRMDVecMid[i] = 0.0;
+            HRMDVec1[i] = HRMDVec2[i];
         };
         
     };
     
     // add the changes in the reactions' chemical energy consumptions
-    void updateHRCDVec(string hrcdid, floatingpoint delG){
-        for(auto i = 0; i<HRCDVec.size(); i++){
-            if(get<0>(HRCDVec[i])==hrcdid){
-                get<1>(HRCDVec[i]) += delG;
-                return;
-            }
-        };
-        HRCDVec.push_back(make_tuple(hrcdid,delG));
+    void updateHRCDVec(Index hrcdid, floatingpoint delG){
+        if(hrcdid >= HRCDDelG.size()){
+            HRCDDelG.resize(hrcdid + 1, 0.0);
+            HRCDRecorded.resize(hrcdid + 1, false);
+        }
+        if(!HRCDRecorded[hrcdid]){
+            HRCDRecorded[hrcdid] = true;
+            HRCDOrder.push_back(hrcdid);
+        }
+        HRCDDelG[hrcdid] += delG;
     }
     
+    // return the HRCD elements with their names, in the order they are first recorded
     vector<tuple<string,floatingpoint>> getHRCDVec(){
-        return HRCDVec;
+        vector<tuple<string,floatingpoint>> res;
+        for(auto hrcdid : HRCDOrder){
+            res.push_back(make_tuple(hrcdidNames().name(hrcdid), HRCDDelG[hrcdid]));
+        }
+        return res;
     }
     
     // store the space time information of a motor walking event to motorWalkData
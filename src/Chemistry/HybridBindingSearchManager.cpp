@@ -25,6 +25,7 @@
 #include "Rand.h"
 
 #include "Controller/CController.h"
+#include "Util/Io/Log.hpp"
 
 namespace medyan {
 
@@ -35,9 +36,7 @@ void HybridBindingSearchManager::setbindingsearchparameter(
 	FilamentBindingManager* fmanager,
 	short bstatepos, short ftype1, short ftype2, float rMax, float rMin) {
 
-    unordered_map<uint32_t, vector<uint32_t>> tempuint;
-    unordered_map<uint32_t, vector<uint32_t>> rtempuint;
-    int tempNbind;
+    int tempNbind = 0;
 
     bool isfound = false;
     vector<short> ftypepairs;
@@ -54,20 +53,14 @@ void HybridBindingSearchManager::setbindingsearchparameter(
             _rMinsqvec[idx].push_back(rMin *rMin);
             fManagervec[idx].push_back(fmanager);
 
-            _possibleBindingsstencilvecuint[idx].push_back(tempuint);
-            _reversepossibleBindingsstencilvecuint[idx].push_back(rtempuint);
+            _possibleBindingPairs[idx].emplace_back();
             bstateposvec[idx].push_back(bstatepos);
             Nbindingpairs[idx].push_back(tempNbind);
             break;
         }
     }
     if(isfound == false){
-        vector<unordered_map<uint32_t, vector<uint32_t>>> temp2uint;
-        vector<unordered_map<uint32_t, vector<uint32_t>>> rtemp2uint;
-
         vector<int> tempNbind2={0};
-        temp2uint.push_back(tempuint);
-        rtemp2uint.push_back(rtempuint);
 
         Nbindingpairs.push_back(tempNbind2);
         vector<float> localrmaxsq ={rMax * rMax};
@@ -79,8 +72,7 @@ void HybridBindingSearchManager::setbindingsearchparameter(
         localfmanager.push_back(fmanager);
         fManagervec.push_back(localfmanager);
         _filamentIDvec.push_back(ftypepairs);
-        _possibleBindingsstencilvecuint.push_back(temp2uint);
-        _reversepossibleBindingsstencilvecuint.push_back(rtemp2uint);
+        _possibleBindingPairs.emplace_back(1);
         bstateposvec.push_back(localbstateposvec);
         vector<floatingpoint> bs1, bs2;
         vector<float> minvec = {(float)*(SysParams::Chemistry().bindingSites[ftypepairs[0]]
@@ -116,6 +108,7 @@ HybridBindingSearchManager::HybridBindingSearchManager(Compartment* compartment)
 
 #ifdef SIMDBINDINGSEARCH
 void HybridBindingSearchManager::initializeSIMDvars(){
+	log::info("Binding site search uses the {} kernel.", dist::isa_name(dist::best_isa()));
 	short count = 0;
 	for (short idx = 0; idx < totaluniquefIDpairs; idx++) {
 		int countbounds = _rMaxsqvec[idx].size();
@@ -174,7 +167,7 @@ bspairsoutSself, short idvec[2]) {
 		bspairsoutSself.reset_counters();
 		if(CROSSCHECK_BS_SWITCH){
             if (C1size >= switchfactor * dist::get_simd_size(t_avx))
-                HybridNeighborList::_crosscheckdumpFileNL << "SELF t_avx" << endl;
+                HybridNeighborList::_crosscheckdumpFileNL << "SELF t_dispatch" << endl;
             else
                 HybridNeighborList::_crosscheckdumpFileNL << "SELF t_serial" << endl;
         }
@@ -183,7 +176,7 @@ bspairsoutSself, short idvec[2]) {
 			if (C1size >= switchfactor * dist::get_simd_size(t_avx))
 				dist::find_distances(bspairsoutSself,
 				                     _compartment->getSIMDcoordsV3<LinkerorMotor>(0, filTypepairs[0]),
-				                     t_avx);
+				                     t_dispatch);
 			else
 				dist::find_distances(bspairsoutSself,
 				                     _compartment->getSIMDcoordsV3<LinkerorMotor>(0, filTypepairs[0]), t_serial);
@@ -196,7 +189,7 @@ bspairsoutSself, short idvec[2]) {
 				dist::find_distances(bspairsoutSself,
 				                     _compartment->getSIMDcoordsV3<LinkerorMotor>(0, filTypepairs[0]),
 				                     _compartment->getSIMDcoordsV3<LinkerorMotor>(0, filTypepairs[1]),
-				                     t_avx);
+				                     t_dispatch);
 
 			} else {
 
@@ -259,7 +252,7 @@ bspairsoutS, dist::dOut<D,SELF>& bspairsoutS2, short idvec[2]){
 		if (CROSSCHECK_BS_SWITCH && C1size > 0 && C2size > 0) {
 			if (C1size >= switchfactor * dist::get_simd_size(t_avx) &&
 			    C2size >= switchfactor * dist::get_simd_size(t_avx))
-				HybridNeighborList::_crosscheckdumpFileNL << "ENCLOSED t_avx" << endl;
+				HybridNeighborList::_crosscheckdumpFileNL << "ENCLOSED t_dispatch" << endl;
 			else
 				HybridNeighborList::_crosscheckdumpFileNL << "ENCLOSED t_serial" << endl;
 		}
@@ -276,7 +269,7 @@ bspairsoutS, dist::dOut<D,SELF>& bspairsoutS2, short idvec[2]){
 				                     _compartment->getSIMDcoordsV3<LinkerorMotor>
 						                     (partitioned_volume_ID[pos], filTypepairs[0]),
 				                     ncmp->getSIMDcoordsV3<LinkerorMotor>
-						                     (partitioned_volume_ID[pos] + 1, filTypepairs[1]), t_avx);
+						                     (partitioned_volume_ID[pos] + 1, filTypepairs[1]), t_dispatch);
 
 			} else {
 
@@ -347,19 +340,16 @@ bspairsoutS, int first, int last, short idvec[2], Compartment* nCmp){
 	bitset<64> randInt = 0;
 	short idx = idvec[0];
 	short idx2 = idvec[1];
+	auto &pbs = _possibleBindingPairs[idx][idx2];
 	auto &nCmppbs = nCmp->getHybridBindingSearchManager()
-			->_possibleBindingsstencilvecuint;
-	auto &nCmprpbs = nCmp->getHybridBindingSearchManager()
-			->_reversepossibleBindingsstencilvecuint;
+			->_possibleBindingPairs[idx][idx2];
 
 	for(uint pid = first; pid < last; pid++) {
 		uint32_t t1 = bspairsoutS.dout[2 * (D - 1)][pid];
 		uint32_t t2 = bspairsoutS.dout[2 * (D - 1) + 1][pid];
 
 		if(SELF == true){
-			_possibleBindingsstencilvecuint[idx][idx2][t1].push_back(t2);
-
-			_reversepossibleBindingsstencilvecuint[idx][idx2][t2].push_back(t1);
+			pbs.insert(t1, t2);
 		}
 		else {
 			//Generate random number of 64 bits
@@ -368,13 +358,10 @@ bspairsoutS, int first, int last, short idvec[2], Compartment* nCmp){
 //				cout<<randInt<<endl;
 			}
 			if(randInt[count64]){
-				_possibleBindingsstencilvecuint[idx][idx2][t1].push_back(t2);
-
-				_reversepossibleBindingsstencilvecuint[idx][idx2][t2].push_back(t1);
+				pbs.insert(t1, t2);
 			}
 			else{
-				nCmppbs[idx][idx2][t2].push_back(t1);
-				nCmprpbs[idx][idx2][t1].push_back(t2);
+				nCmppbs.insert(t2, t1);
 			}
 			//Keep count
 			count64++;
@@ -382,18 +369,6 @@ bspairsoutS, int first, int last, short idvec[2], Compartment* nCmp){
 			//reset if you reach 64 bits
 			if(count64>63)
 				count64=0;
-
-			/*if(t1>t2) {
-				_possibleBindingsstencilvecuint[idvec[0]][idvec[1]][t1].push_back(t2);
-
-				_reversepossibleBindingsstencilvecuint[idvec[0]][idvec[1]][t2].push_back(t1);
-			}
-			else{
-				nCmp->getHybridBindingSearchManager()
-				->_possibleBindingsstencilvecuint[idvec[0]][idvec[1]][t2].push_back(t1);
-				nCmp->getHybridBindingSearchManager()
-				->_reversepossibleBindingsstencilvecuint[idvec[0]][idvec[1]][t1].push_back(t2);
-			}*/
 		}
 	}
 }
@@ -458,9 +433,7 @@ void HybridBindingSearchManager::addPossibleBindingsstencil(short idvec[2],
 			uint32_t t1 = shiftedIndex1|pos;
 			//loop through neighbors
 			//now re add valid based on CCNL
-			vector<Cylinder *> Neighbors;
-
-			Neighbors = _HneighborList->getNeighborsstencil(HNLID, cc->getCylinder());
+			auto Neighbors = _HneighborList->getNeighborsstencil(HNLID, cc->getCylinder());
 
 			for (auto cn : Neighbors) {
 				Cylinder *c = cc->getCylinder();
@@ -519,9 +492,7 @@ void HybridBindingSearchManager::addPossibleBindingsstencil(short idvec[2],
 						uint32_t t2 = shiftedIndex2|k;
 
 						//add in correct order
-//						_mpossibleBindingsstencilvecuint[idx][idx2].emplace(t1,t2);
-						_possibleBindingsstencilvecuint[idx][idx2][t1].push_back(t2);
-						_reversepossibleBindingsstencilvecuint[idx][idx2][t2].push_back(t1);
+						_possibleBindingPairs[idx][idx2].insert(t1, t2);
 					}
 					k = k + bindingsitestep;
 				}
@@ -564,32 +535,9 @@ void HybridBindingSearchManager::removePossibleBindingsstencil(short idvec[2], C
     //Key
     t = t|pos;
 
-    if(CROSSCHECK_BS_SWITCH) {
-        CController::_crosscheckdumpFilechem <<"Removing by key"<<endl;
-    }
-    _possibleBindingsstencilvecuint[idx][idx2].erase(t);
-
-    if(CROSSCHECK_BS_SWITCH) {
-        CController::_crosscheckdumpFilechem <<"Removing by value"<<endl;
-    }
-    //remove all tuples which have this as value
-    //Iterate through the reverse map
-    auto keys = _reversepossibleBindingsstencilvecuint[idx][idx2][t];//keys that contain
-    // t as value in possiblebindings
-
-    for(auto k:keys){
-        //get the iterator range that corresponds to this key.
-        auto range = _possibleBindingsstencilvecuint[idx][idx2].equal_range(k);
-//	    auto range = _mpossibleBindingsstencilvecuint[idx][idx2].equal_range(k);
-        //iterate through the range
-        for(auto it = range.first; it != range.second;){
-            //Go through the value vector and delete entries that match
-            it->second.erase(remove(it->second.begin(), it->second.end(), t), it->second.end());
-            it++;
-        }
-    }
-    //remove from the reverse map.
-	_reversepossibleBindingsstencilvecuint[idx][idx2][t].clear();
+    //remove all pairs which have this binding site, either as the first or the
+    // second site.
+    _possibleBindingPairs[idx][idx2].removeSite(t);
 
     if(CROSSCHECK_BS_SWITCH) {
         CController::_crosscheckdumpFilechem <<"Update rxn"<<endl;
@@ -608,24 +556,8 @@ void HybridBindingSearchManager::removePossibleBindingsstencil(short idvec[2], C
 	            CController::_crosscheckdumpFilechem <<"Remove by value from neighbor "
 												""<<nc->getId()<<" total "<<nencl<<endl;
 
-            //Iterate through the reverse map
-            auto keys = m->_reversepossibleBindingsstencilvecuint[idx][idx2][t];//keys that
-            // contain t as value in possiblebindings
-
-            for(auto k:keys){
-                //get the iterator range that corresponds to this key.
-                auto range = m->_possibleBindingsstencilvecuint[idx][idx2].equal_range(k);
-//	            auto range = m->_mpossibleBindingsstencilvecuint[idx][idx2].equal_range(k);
-                //iterate through the range
-                for(auto it = range.first; it != range.second;){
-                    //Go through the value vector and delete entries that match
-                    it->second.erase(remove(it->second.begin(), it->second.end(), t),
-                            it->second.end());
-	                it++;
-                }
-            }
-            //remove from the reverse map.
-            m->_reversepossibleBindingsstencilvecuint[idx][idx2][t].clear();
+            // Only the pairs containing this site are touched.
+            if(m->_possibleBindingPairs[idx][idx2].removeSite(t) == 0) continue;
             if(CROSSCHECK_BS_SWITCH) {
                 CController::_crosscheckdumpFilechem <<"Update rxn"<<endl;
             }
@@ -660,8 +592,7 @@ void HybridBindingSearchManager::appendPossibleBindingsstencil(short idvec[2],
                     - SysParams::Chemistry().bindingSites[_nfilamentType].begin();
     uint32_t t2 = shiftedIndex2|pos2;
 
-    _possibleBindingsstencilvecuint[idx][idx2][t1].push_back(t2);
-    _reversepossibleBindingsstencilvecuint[idx][idx2][t2].push_back(t1);
+    _possibleBindingPairs[idx][idx2].insert(t1, t2);
 
     countNpairsfound(idvec);
     fManagervec[idx][idx2]->updateBindingReaction(Nbindingpairs[idx][idx2]);
@@ -683,13 +614,12 @@ void HybridBindingSearchManager::checkoccupancySIMD(short idvec[2]){
     for(auto cyl: Cylinder::getCylinders())
         CIDvec[cyl->getStableIndex()] = cyl->getId();
 
-    auto pbs = _possibleBindingsstencilvecuint[idx][idx2];
+    const auto& pbs = _possibleBindingPairs[idx][idx2];
 
-    for(auto pair = pbs.begin(); pair != pbs.end(); pair++){
+    for(auto& pair : pbs){
 
-        //Key
-        uint32_t leg1 = pair->first;
-        vector<uint32_t> leg2 = pair->second;
+        //First site
+        uint32_t leg1 = pair.site1;
 
         uint32_t cIndex1 = leg1 >> SysParams::Chemistry().shiftbybits;
         uint32_t bsite1 = mask & leg1;
@@ -711,8 +641,9 @@ void HybridBindingSearchManager::checkoccupancySIMD(short idvec[2]){
         }
 
 
-        //Values
-        for(auto V:leg2){
+        //Second site
+        {
+            uint32_t V = pair.site2;
             uint32_t cIndex2 = V >> SysParams::Chemistry().shiftbybits;
             uint32_t bsite2 = mask & V;
             CCylinder* ccyl2 = cylinderInfoData[cIndex2].chemCylinder;
@@ -762,8 +693,7 @@ void HybridBindingSearchManager::updateAllPossibleBindingsstencilHYBD() {
     for (int idx = 0; idx < totaluniquefIDpairs; idx++){
         int countbounds = _rMaxsqvec[idx].size();
         for (int idx2 = 0; idx2 < countbounds; idx2++) {
-            _possibleBindingsstencilvecuint[idx][idx2].clear();
-            _reversepossibleBindingsstencilvecuint[idx][idx2].clear();
+            _possibleBindingPairs[idx][idx2].clear();
         }
     }
 
@@ -817,8 +747,8 @@ void HybridBindingSearchManager::updateAllPossibleBindingsstencilHYBD() {
             int cindex = cindexvec[i];
             short complimentaryfID;
             const auto& c = cylinderInfoData[cindex];
-            const auto& x1 = Bead::getStableElement(c.beadIndices[0])->coord;
-            const auto& x2 = Bead::getStableElement(c.beadIndices[1])->coord;
+            const auto& x1 = Bead::getStableElement(c.beadIndices[0])->coordinate();
+            const auto& x2 = Bead::getStableElement(c.beadIndices[1])->coordinate();
             floatingpoint X1X2[3] = {x2[0] - x1[0], x2[1] - x1[1], x2[2] - x1[2]};
             int *cnindices = ncindices[i].data();
 
@@ -837,8 +767,8 @@ void HybridBindingSearchManager::updateAllPossibleBindingsstencilHYBD() {
                 if (c.filamentId == cn.filamentId) continue;
                 if(c.type != complimentaryfID) continue;
 
-                const auto& x3 = Bead::getStableElement(cn.beadIndices[0])->coord;
-                const auto& x4 = Bead::getStableElement(cn.beadIndices[1])->coord;
+                const auto& x3 = Bead::getStableElement(cn.beadIndices[0])->coordinate();
+                const auto& x4 = Bead::getStableElement(cn.beadIndices[1])->coordinate();
                 floatingpoint X1X3[3] = {x3[0] - x1[0], x3[1] - x1[1], x3[2] - x1[2]};
                 floatingpoint X3X4[3] = {x4[0] - x3[0], x4[1] - x3[1], x4[2] - x3[2]};
                 floatingpoint X1X3squared = sqmagnitude(X1X3);
@@ -942,8 +872,7 @@ void HybridBindingSearchManager::updateAllPossibleBindingsstencilHYBD() {
 	                                uint32_t t2 = shiftedIndex2|pos2;
 
 	                                //add in correct order
-	                                _possibleBindingsstencilvecuint[idx][idx2][t1].push_back(t2);
-	                                _reversepossibleBindingsstencilvecuint[idx][idx2][t2].push_back(t1);
+	                                _possibleBindingPairs[idx][idx2].insert(t1, t2);
                                 }
                             }
                         }
@@ -968,15 +897,7 @@ void HybridBindingSearchManager::updateAllPossibleBindingsstencilHYBD() {
 void HybridBindingSearchManager::countNpairsfound(short idvec[2]){
     short idx = idvec[0];
     short idx2 = idvec[1];
-    int N = 0;
-    Nbindingpairs[idx][idx2] = 0;
-
-    for (auto iter = _possibleBindingsstencilvecuint[idx][idx2].begin(); iter !=
-		    _possibleBindingsstencilvecuint[idx][idx2].end(); iter++) {
-        N += iter->second.size();
-    }
-//    cout<<Nbindingpairs[idx][idx2]<<" "<<N<<endl;
-    Nbindingpairs[idx][idx2] = N;
+    Nbindingpairs[idx][idx2] = _possibleBindingPairs[idx][idx2].size();
 }
 
 void HybridBindingSearchManager::updateAllPossibleBindingsstencilSIMDV3() {
@@ -990,6 +911,7 @@ void HybridBindingSearchManager::updateAllPossibleBindingsstencilSIMDV3() {
 			bool LinkerorMotor = false; //Motor
 			if (bstateposvec[idx][idx2] == 1)
 				LinkerorMotor = true;//Linker
+			const auto minsupdate = chrono::high_resolution_clock::now();
 			if(LinkerorMotor) {
 				//Linker
 				calculatebspairsLMselfV3<1,true, true>(getdOut<1U, true>(count), idvec);
@@ -1002,6 +924,8 @@ void HybridBindingSearchManager::updateAllPossibleBindingsstencilSIMDV3() {
 				calculatebspairsLMenclosedV3<1,false, false>(getdOut<1U, false>(count),
 				        bspairsmotor2, idvec);
 			}
+			chrono::duration<floatingpoint> elapsed_update(chrono::high_resolution_clock::now() - minsupdate);
+			(LinkerorMotor ? linkerUpdateTime : motorUpdateTime) += elapsed_update.count();
 			count++;
 //			checkoccupancySIMD(idvec);
 		}
@@ -1071,25 +995,12 @@ HybridBindingSearchManager::chooseBindingSitesstencil(short idvec[2]){
            && "Major bug: Linker/Motor binding manager should not have zero binding \
                    sites when called to choose a binding site.");
     if(true) {
-	    uint randomIndex = Rand::randInteger(1, pbsSize);
-
-	    auto it = _possibleBindingsstencilvecuint[idx][idx2].begin();
-	    uint cumulativesum = 0;
-	    uint prevstepsum = 0;
-
-	    while (it != _possibleBindingsstencilvecuint[idx][idx2].end() &&
-	           cumulativesum < randomIndex) {
-		    prevstepsum = cumulativesum;
-		    cumulativesum += it->second.size();
-		    if (cumulativesum < randomIndex)
-			    it++;
-	    }
+	    // Pairs are stored contiguously, so a pair is chosen uniformly in constant time.
+	    const auto& pair = _possibleBindingPairs[idx][idx2][Rand::randInteger(0, pbsSize - 1)];
 	    Nbindingpairs[idx][idx2]--;
 
-	    uint position = randomIndex - prevstepsum - 1;
-
-	    uint32_t site1 = it->first;
-	    uint32_t site2 = it->second[position];
+	    uint32_t site1 = pair.site1;
+	    uint32_t site2 = pair.site2;
 
 	    uint32_t cIndex1 = site1 >> SysParams::Chemistry().shiftbybits;
 	    uint32_t cIndex2 = site2 >> SysParams::Chemistry().shiftbybits;
@@ -1124,8 +1035,7 @@ HybridBindingSearchManager::chooseBindingSitesstencil(short idvec[2]){
 void HybridBindingSearchManager::clearPossibleBindingsstencil(short idvec[2]){
 	short idx = idvec[0];
 	short idx2 = idvec[1];
-	_possibleBindingsstencilvecuint[idx][idx2].clear();
-	_reversepossibleBindingsstencilvecuint[idx][idx2].clear();
+	_possibleBindingPairs[idx][idx2].clear();
 	countNpairsfound(idvec);
 	fManagervec[idx][idx2]->updateBindingReaction(Nbindingpairs[idx][idx2]);
 }
@@ -1135,22 +1045,12 @@ void HybridBindingSearchManager::printbindingsitesstencil(short idvec[2]) {
     short idx = idvec[0];
     short idx2 = idvec[1];
 
-    auto pbs = _possibleBindingsstencilvecuint[idx][idx2];
-
-    for (auto pair = pbs.begin(); pair != pbs.end(); pair++) {
-
-        //Key
-        uint32_t leg1 = pair->first;
-        vector<uint32_t> leg2 = pair->second;
-
-        uint32_t cIndex1 = leg1 >> SysParams::Chemistry().shiftbybits;
-        uint32_t bsite1 = mask & leg1;
-        //Values
-        for (auto V:leg2) {
-            uint32_t cIndex2 = V >> SysParams::Chemistry().shiftbybits;
-            uint32_t bsite2 = mask & V;
-            cout<<cIndex1<<" "<<cIndex2<<" "<<bsite1<<" "<<bsite2<<endl;
-        }
+    for (auto& pair : _possibleBindingPairs[idx][idx2]) {
+        uint32_t cIndex1 = pair.site1 >> SysParams::Chemistry().shiftbybits;
+        uint32_t bsite1 = mask & pair.site1;
+        uint32_t cIndex2 = pair.site2 >> SysParams::Chemistry().shiftbybits;
+        uint32_t bsite2 = mask & pair.site2;
+        cout<<cIndex1<<" "<<cIndex2<<" "<<bsite1<<" "<<bsite2<<endl;
     }
 }
 
@@ -1188,6 +1088,8 @@ floatingpoint HybridBindingSearchManager::SIMDcountbs = 0.0;
 floatingpoint HybridBindingSearchManager::HYBDappendtime = 0.0;
 floatingpoint HybridBindingSearchManager::SIMDV3appendtime = 0.0;
 floatingpoint HybridBindingSearchManager::findtimeV3 = 0.0;
+floatingpoint HybridBindingSearchManager::linkerUpdateTime = 0.0;
+floatingpoint HybridBindingSearchManager::motorUpdateTime = 0.0;
 #endif
 
 } // namespace medyan
@@ -30,6 +30,7 @@
 #include "SysParams.h"
 #include "Rand.h"
 #include "BindingManager.h"
+#include "Chemistry/BindingPairPool.hpp"
 
 namespace medyan {
 //FORWARD DECLARATIONS
@@ -69,23 +70,8 @@ private:
 
     vector<vector<FilamentBindingManager*>> fManagervec;
 
-    //possible bindings at current state. updated according to neighbor list
     //possible bindings at current state. updated according to neighbor list stencil
-
-//    vector<vector<unordered_multimap<tuple<CCylinder*, short>, tuple<CCylinder*, short>>>>
-//            _possibleBindingsstencilvec;
-
-    /*vector<vector<unordered_multimap<uint32_t, uint32_t>>>
-            _mpossibleBindingsstencilvecuint;*/
-
-    vector<vector<unordered_map<uint32_t, vector<uint32_t>>>>
-            _possibleBindingsstencilvecuint;
-
-//    vector<vector<unordered_map<tuple<CCylinder*, short>, vector<tuple<CCylinder*,
-//    short>>>>>_reversepossibleBindingsstencilvec;
-
-    vector<vector<unordered_map<uint32_t, vector<uint32_t>>>>
-    _reversepossibleBindingsstencilvecuint;
+    vector<vector<BindingPairPool>> _possibleBindingPairs;
 
     vector<uint32_t> linker1, linker2;
     vector<uint32_t> motor1, motor2;
@@ -99,6 +85,7 @@ private:
 #ifdef SIMDBINDINGSEARCH
     static constexpr dist::tag_simd<dist::simd_avx_par,  float>  t_avx_par {};
     static constexpr dist::tag_simd<dist::simd_avx,  float>   t_avx {};
+    static constexpr dist::tag_simd<dist::simd_dispatch, float> t_dispatch {};
     static constexpr dist::tag_simd<dist::simd_no,   float>   t_serial {};
     bool initialized = false;
 
@@ -202,7 +189,7 @@ public:
     void addtoHNeighborList();
     void copyInfotoBindingManagers();
 
-    vector<Cylinder*> getHNeighbors(Cylinder* c, short HNLID){
+    CylinderNeighborListCSR::SpanType getHNeighbors(Cylinder* c, short HNLID) const {
         return _HneighborList->getNeighborsstencil(HNLID, c);
     }
 
@@ -216,8 +203,6 @@ public:
             int countbounds = _rMaxsqvec[idx].size();
             for (idx2 = 0; idx2 < countbounds; idx2++) {
             	cout<<Nbindingpairs[idx][idx2]<<" ";
-//                std::cout<<"Hybrid "<<_possibleBindingsstencilvecuint[idx][idx2].size()<<
-//                " SIMD "<<Nbindingpairs[idx][idx2]<<endl;
             }
             cout<<endl;
         }
@@ -231,9 +216,7 @@ public:
         for(idx = 0; idx<totaluniquefIDpairs; idx++){
             int countbounds = _rMaxsqvec[idx].size();
             for (idx2 = 0; idx2 < countbounds; idx2++) {
-                _possibleBindingsstencilvecuint[idx][idx2].clear();
-//                _mpossibleBindingsstencilvecuint[idx][idx2].clear();
-                _reversepossibleBindingsstencilvecuint[idx][idx2].clear();
+                _possibleBindingPairs[idx][idx2].clear();
             }
         }
 
@@ -280,6 +263,9 @@ public:
     static floatingpoint HYBDappendtime;
     static floatingpoint SIMDV3appendtime;
     static floatingpoint findtimeV3;
+    // Time spent in updating linker and motor binding pairs.
+    static floatingpoint linkerUpdateTime;
+    static floatingpoint motorUpdateTime;
 
 };
 
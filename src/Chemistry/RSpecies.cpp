@@ -15,10 +15,6 @@
 
 #include "Reaction.h"
 
-#ifdef BOOST_MEM_POOL
-    #include <boost/pool/pool.hpp>
-    #include <boost/pool/pool_alloc.hpp>
-#endif
 
 namespace medyan {
 RSpecies::~RSpecies() noexcept{
@@ -32,34 +28,6 @@ ostream& operator<<(ostream& os, const RSpecies& s){
     return os;
 }
 
-#ifdef BOOST_MEM_POOL
-void* RSpeciesReg::operator new(size_t size) {
-    void *ptr = boost::fast_pool_allocator<RSpeciesReg>::allocate();
-    return ptr;
-}
-    
-void RSpeciesReg::operator delete(void* ptr) noexcept {
-    boost::fast_pool_allocator<RSpeciesReg>::deallocate((RSpeciesReg*)ptr);
-}
-
-void* RSpeciesConst::operator new(size_t size) {
-    void *ptr = boost::fast_pool_allocator<RSpeciesConst>::allocate();
-    return ptr;
-}
-
-void RSpeciesConst::operator delete(void* ptr) noexcept {
-    boost::fast_pool_allocator<RSpeciesConst>::deallocate((RSpeciesConst*)ptr);
-}
-
-void* RSpeciesAvg::operator new(size_t size) {
-    void *ptr = boost::fast_pool_allocator<RSpeciesAvg>::allocate();
-    return ptr;
-}
-
-void RSpeciesAvg::operator delete(void* ptr) noexcept {
-    boost::fast_pool_allocator<RSpeciesAvg>::deallocate((RSpeciesAvg*)ptr);
-}
-#endif
     
 string RSpecies::getFullName() const {
     return _species.getFullName();
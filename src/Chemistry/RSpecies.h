@@ -24,6 +24,7 @@
 
 #include "common.h"
 #include "SysParams.h"
+#include "Util/SlabAllocator.hpp"
 
 namespace medyan {
 ///Enumeration for RSpecies types
@@ -69,6 +70,9 @@ protected: //Variables
     vector<ReactionBase *> _as_products = {};  ///< a vector of [Reactions]
                                                ///< (@ref Reaction) where this RSpecies
                                                ///< is a Product
+    std::size_t _reactantReactionsGeneration = 0; ///< Incremented whenever a reaction
+                                               ///< where this RSpecies is a Reactant is
+                                               ///< added, removed, activated or passivated
     Species& _species; ///< reference to the **parent** Species object
     species_copy_t _n; ///< Current copy number of this RSpecies
 #ifdef TRACK_UPPER_COPY_N
@@ -125,7 +129,10 @@ public:
     
     // \internal This methods is called by the Reaction class during construction
     // of the Reaction where this RSpecies is involved as a Reactant
-    void addAsReactant(ReactionBase *r){_as_reactants.push_back(r);}
+    void addAsReactant(ReactionBase *r){
+        _as_reactants.push_back(r);
+        ++_reactantReactionsGeneration;
+    }
     
     // \internal This methods is called by the Reaction class during construction
     // of the Reaction where this RSpecies is involved as a Product    
@@ -138,7 +145,10 @@ public:
         if(!_as_reactants.empty()) {
             auto rxit = find(_as_reactants.begin(),_as_reactants.end(),r);
             if(rxit!=_as_reactants.end()){
-                _as_reactants.erase(rxit);
+                // The order of reactions does not matter, so the last one is moved here.
+                *rxit = _as_reactants.back();
+                _as_reactants.pop_back();
+                ++_reactantReactionsGeneration;
             }
             else {
                 
@@ -154,7 +164,9 @@ public:
         if (!_as_products.empty()) {
             auto rxit = find(_as_products.begin(),_as_products.end(),r);
             if(rxit!=_as_products.end()){
-                _as_products.erase(rxit);
+                // The order of reactions does not matter, so the last one is moved here.
+                *rxit = _as_products.back();
+                _as_products.pop_back();
             }
             else {
                 cout << "Did not find the as_product" << endl;
@@ -206,6 +218,9 @@ public:
             callback(this, delta);
         }
     }
+
+    /// Return whether any callbacks are associated with this RSpecies
+    bool hasCallbacks() const { return !callbacks_.empty(); }
     
     /// return parent Species as a reference
     inline Species& getSpecies() {return _species;}
@@ -223,6 +238,14 @@ public:
     /// Return vector<ReactionBase *>, which contains pointers to all [Reactions](@ref
     /// Reaction) where this RSpecies is involved as a Product
     inline vector<ReactionBase *>& productReactions(){return _as_products;}
+
+    /// Return a counter which changes whenever a [Reaction](@ref Reaction) where this
+    /// RSpecies is involved as a Reactant is added, removed, activated or passivated
+    std::size_t reactantReactionsGeneration() const {return _reactantReactionsGeneration;}
+
+    /// \internal Called by the Reaction class when a Reaction where this RSpecies is
+    /// involved as a Reactant is activated or passivated
+    void touchReactantReactions() {++_reactantReactionsGeneration;}
     
     /// Return vector<ReactionBase *>::iterator, which points to the beginning of all 
     /// [Reactions](@ref Reaction) where this RSpecies is involved as a Reactant
@@ -281,12 +304,10 @@ public:
     /// parent Species
     RSpeciesReg& operator=(RSpeciesReg&) = delete;
     
-#ifdef BOOST_MEM_POOL
-    /// Advanced memory management
-    void* operator new(size_t size);
-    
-    void operator delete(void* ptr) noexcept;
-#endif
+    /// RSpecies are allocated in slab pools.
+    static void* operator new(size_t size) { return slabAllocate< RSpeciesReg >(size); }
+
+    static void operator delete(void* ptr, size_t size) noexcept { slabDeallocate< RSpeciesReg >(ptr, size); }
     
     /// If the copy number changes from 0 to 1, calls a
     /// "callback"-like method to activate previously passivated [Reactions](@ref
@@ -366,12 +387,10 @@ public:
     /// parent Species
     RSpeciesConst& operator=(RSpeciesConst&) = delete;
     
-#ifdef BOOST_MEM_POOL
-    /// Advanced memory management
-    void* operator new(size_t size);
-    
-    void operator delete(void* ptr) noexcept;
-#endif
+    /// RSpecies are allocated in slab pools.
+    static void* operator new(size_t size) { return slabAllocate< RSpeciesConst >(size); }
+
+    static void operator delete(void* ptr, size_t size) noexcept { slabDeallocate< RSpeciesConst >(ptr, size); }
     
     //@{
     /// In constant species, do nothing. Copy numbers do not change.
@@ -468,12 +487,10 @@ public:
     /// parent Species
     RSpeciesAvg& operator=(RSpeciesAvg&) = delete;
     
-#ifdef BOOST_MEM_POOL
-    /// Advanced memory management
-    void* operator new(size_t size);
-    
-    void operator delete(void* ptr) noexcept;
-#endif
+    /// RSpecies are allocated in slab pools.
+    static void* operator new(size_t size) { return slabAllocate< RSpeciesAvg >(size); }
+
+    static void operator delete(void* ptr, size_t size) noexcept { slabDeallocate< RSpeciesAvg >(ptr, size); }
     
     /// Whether we just calculated a new average
     bool newAverage() {return _newAvg;}
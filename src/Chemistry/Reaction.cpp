@@ -16,14 +16,23 @@
 #include "ChemRNode.h"
 #include "SpeciesContainer.h"
 
-#ifdef BOOST_MEM_POOL
-#include <boost/pool/pool.hpp>
-#include <boost/pool/pool_alloc.hpp>
-#endif
-
 #include "CUDAcommon.h"
 
 namespace medyan {
+
+namespace {
+
+// Whether the species is looked up from the first match of the same molecule in
+// a compartment, when a reaction is moved to another compartment.
+bool isForwardSearchSpecies(const Species& s) {
+    return s.getType() == SpeciesType::BULK
+        || s.getType() == SpeciesType::DIFFUSING
+        || s.getType() == SpeciesType::singleBinding
+        || s.getType() == SpeciesType::pairBinding;
+}
+
+} // namespace
+
 template<unsigned short M, unsigned short N>
     void Reaction<M,N>::updatePropensityImpl() {
 
@@ -38,16 +47,20 @@ template<unsigned short M, unsigned short N>
 template <unsigned short M, unsigned short N>
     void Reaction<M,N>::activateReactionUnconditionalImpl(){
 #ifdef TRACK_DEPENDENTS
-    for(auto i=0U; i<M; ++i)
-    {
-        RSpecies *s = _rspecies[i];
-        for(auto r = s->beginReactantReactions();
-                 r!= s->endReactantReactions(); ++r){
-            if(this!=(*r)) (*r)->registerNewDependent(this);
-        }
-        for(auto r = s->beginProductReactions();
-                 r!= s->endProductReactions(); ++r){
-            if(this!=(*r)) (*r)->registerNewDependent(this);
+    // An active reaction is already a dependent of the affected reactions.
+    if(isPassivated()) {
+        for(auto i=0U; i<M; ++i)
+        {
+            RSpecies *s = _rspecies[i];
+            s->touchReactantReactions();
+            for(auto r = s->beginReactantReactions();
+                     r!= s->endReactantReactions(); ++r){
+                if(this!=(*r)) (*r)->registerNewDependent(this);
+            }
+            for(auto r = s->beginProductReactions();
+                     r!= s->endProductReactions(); ++r){
+                if(this!=(*r)) (*r)->registerNewDependent(this);
+            }
         }
     }
 #endif
@@ -65,6 +78,7 @@ void Reaction<M,N>::passivateReactionImpl() {
     for(auto i=0U; i<M; ++i)
     {
         RSpecies *s = _rspecies[i];
+        s->touchReactantReactions();
         for(auto r = s->beginReactantReactions();
                  r!=s->endReactantReactions(); ++r){
             (*r)->unregisterDependent(this);
@@ -93,11 +107,7 @@ Reaction<M,N>* Reaction<M,N>::cloneImpl(const SpeciesPtrContainerVector &spcv)
     for(auto &rs : _rspecies){
         int molec = rs->getSpecies().getMolecule();
         auto speciesptr = &rs->getSpecies();
-        auto status =
-            speciesptr->getType() == SpeciesType::BULK
-            || speciesptr->getType() == SpeciesType::DIFFUSING
-            || speciesptr->getType() == SpeciesType::singleBinding
-            || speciesptr->getType() == SpeciesType::pairBinding;
+        auto status = isForwardSearchSpecies(*speciesptr);
         // status->true, forward search will be used (Diffusing / Bulk / Single binding / Pair binding).
         // status->false, reverse search will be used (Filament / Plus end / Minus end / Bound / Linker / Motor).
         if(status) {
@@ -147,140 +157,130 @@ Reaction<M,N>* Reaction<M,N>::cloneImpl(const SpeciesPtrContainerVector &spcv)
     return newReaction;
 }
 
-void DiffusionReaction::updatePropensityImpl() {
-    
-    //just update the rnode if not passivated
-    if(_rnode!=nullptr && !_passivated) _rnode->activateReaction();
-}
-
-    
-#ifdef BOOST_MEM_POOL
-template <unsigned short M, unsigned short N>
-void* Reaction<M,N>::operator new(size_t size) {
-    void *ptr = boost::fast_pool_allocator<Reaction<M,N>>::allocate();
-    return ptr;
-}
-
 template <unsigned short M, unsigned short N>
-void Reaction<M,N>::operator delete(void* ptr) noexcept {
-    boost::fast_pool_allocator<Reaction<M,N>>::deallocate((Reaction<M,N>*)ptr);
-}
+bool Reaction<M,N>::rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv)
+{
+    // Filament and bound species are moved together with their owner, so only the
+    // species found by the forward search in cloneImpl() are replaced.
+    bool replaced = false;
+    for(auto i = 0U; i < M + N; ++i) {
+        auto& species = _rspecies[i]->getSpecies();
+        if(!isForwardSearchSpecies(species)) continue;
+
+        auto newSpecies = spcv.findSpeciesByMolecule(species.getMolecule());
+        if(newSpecies == nullptr || newSpecies == &species) continue;
+
+        if(!_isProtoCompartment) {
+            if(i < M) _rspecies[i]->removeAsReactant(this);
+            else      _rspecies[i]->removeAsProduct(this);
+        }
+        _rspecies[i] = &newSpecies->getRSpecies();
+        if(!_isProtoCompartment) {
+            if(i < M) _rspecies[i]->addAsReactant(this);
+            else      _rspecies[i]->addAsProduct(this);
+        }
+        replaced = true;
+    }
 
-void* DiffusionReaction::operator new(size_t size) {
-    void *ptr = boost::fast_pool_allocator<DiffusionReaction>::allocate();
-    return ptr;
+#ifdef TRACK_DEPENDENTS
+    if(replaced && !_isProtoCompartment) setDependentReactions();
+#endif
+    return replaced;
 }
 
-void DiffusionReaction::operator delete(void* ptr) noexcept {
-     boost::fast_pool_allocator<DiffusionReaction>::deallocate((DiffusionReaction*)ptr);
-}
-#endif
+void DiffusionReaction::updatePropensityImpl() {
     
-#ifdef BOOST_MEM_POOL
-template void* Reaction<1,1>::operator new(size_t size);
-template void Reaction<1,1>::operator delete(void* ptr);
-template void* Reaction<2,1>::operator new(size_t size);
-template void Reaction<2,1>::operator delete(void* ptr);
-template void* Reaction<1,2>::operator new(size_t size);
-template void Reaction<1,2>::operator delete(void* ptr);
-template void* Reaction<2,2>::operator new(size_t size);
-template void Reaction<2,2>::operator delete(void* ptr);
-template void* Reaction<2,0>::operator new(size_t size);
-template void Reaction<2,0>::operator delete(void* ptr);
-template void* Reaction<1,3>::operator new(size_t size);
-template void Reaction<1,3>::operator delete(void* ptr);
-template void* Reaction<2,3>::operator new(size_t size);
-template void Reaction<2,3>::operator delete(void* ptr);
-template void* Reaction<3,2>::operator new(size_t size);
-template void Reaction<3,2>::operator delete(void* ptr);
-template void* Reaction<3,1>::operator new(size_t size);
-template void Reaction<3,1>::operator delete(void* ptr);
-template void* Reaction<3,0>::operator new(size_t size);
-template void Reaction<3,0>::operator delete(void* ptr);
-template void* Reaction<2,4>::operator new(size_t size);
-template void Reaction<2,4>::operator delete(void* ptr);
-template void* Reaction<2,5>::operator new(size_t size);
-template void Reaction<2,5>::operator delete(void* ptr);
-template void* Reaction<4,0>::operator new(size_t size);
-template void Reaction<4,0>::operator delete(void* ptr);
-template void* Reaction<5,2>::operator new(size_t size);
-template void Reaction<5,2>::operator delete(void* ptr);
-template void* Reaction<4,2>::operator new(size_t size);
-template void Reaction<4,2>::operator delete(void* ptr);
-#endif
+    //just update the rnode if not passivated
+    if(_rnode!=nullptr && !_passivated) _rnode->activateReaction();
+}
 
 template void Reaction<1,1>::updatePropensityImpl();
 template void Reaction<1,1>::activateReactionUnconditionalImpl();
 template void Reaction<1,1>::passivateReactionImpl();
 template Reaction<1,1>* Reaction<1,1>::cloneImpl(const SpeciesPtrContainerVector &spcv);
+template bool Reaction<1,1>::rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv);
 
 template void Reaction<2,1>::updatePropensityImpl();
 template void Reaction<2,1>::activateReactionUnconditionalImpl();
 template void Reaction<2,1>::passivateReactionImpl();
 template Reaction<2,1>* Reaction<2,1>::cloneImpl(const SpeciesPtrContainerVector &spcv);
+template bool Reaction<2,1>::rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv);
 
 template void Reaction<1,2>::updatePropensityImpl();
 template void Reaction<1,2>::activateReactionUnconditionalImpl();
 template void Reaction<1,2>::passivateReactionImpl();
 template Reaction<1,2>* Reaction<1,2>::cloneImpl(const SpeciesPtrContainerVector &spcv);
+template bool Reaction<1,2>::rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv);
 
 template void Reaction<2,2>::updatePropensityImpl();
 template void Reaction<2,2>::activateReactionUnconditionalImpl();
 template void Reaction<2,2>::passivateReactionImpl();
 template Reaction<2,2>* Reaction<2,2>::cloneImpl(const SpeciesPtrContainerVector &spcv);
+template bool Reaction<2,2>::rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv);
 
 template void Reaction<2,0>::updatePropensityImpl();
 template void Reaction<2,0>::activateReactionUnconditionalImpl();
 template void Reaction<2,0>::passivateReactionImpl();
 template Reaction<2,0>* Reaction<2,0>::cloneImpl(const SpeciesPtrContainerVector &spcv);
+template bool Reaction<2,0>::rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv);
 
 template void Reaction<1,3>::updatePropensityImpl();
 template void Reaction<1,3>::activateReactionUnconditionalImpl();
 template void Reaction<1,3>::passivateReactionImpl();
 template Reaction<1,3>* Reaction<1,3>::cloneImpl(const SpeciesPtrContainerVector &spcv);
+template bool Reaction<1,3>::rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv);
 
 template void Reaction<2,3>::updatePropensityImpl();
 template void Reaction<2,3>::activateReactionUnconditionalImpl();
 template void Reaction<2,3>::passivateReactionImpl();
 template Reaction<2,3>* Reaction<2,3>::cloneImpl(const SpeciesPtrContainerVector &spcv);
+template bool Reaction<2,3>::rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv);
 
 template void Reaction<3,2>::activateReactionUnconditionalImpl();
 template void Reaction<3,2>::passivateReactionImpl();
 template Reaction<3,2>* Reaction<3,2>::cloneImpl(const SpeciesPtrContainerVector &spcv);
+template bool Reaction<3,2>::rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv);
 
 template void Reaction<3,1>::updatePropensityImpl();
 template void Reaction<3,1>::activateReactionUnconditionalImpl();
 template void Reaction<3,1>::passivateReactionImpl();
 template Reaction<3,1>* Reaction<3,1>::cloneImpl(const SpeciesPtrContainerVector &spcv);
+template bool Reaction<3,1>::rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv);
 
 template void Reaction<3,0>::updatePropensityImpl();
 template void Reaction<3,0>::activateReactionUnconditionalImpl();
 template void Reaction<3,0>::passivateReactionImpl();
 template Reaction<3,0>* Reaction<3,0>::cloneImpl(const SpeciesPtrContainerVector &spcv);
+template bool Reaction<3,0>::rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv);
 
 template void Reaction<2,4>::updatePropensityImpl();
 template void Reaction<2,4>::activateReactionUnconditionalImpl();
 template void Reaction<2,4>::passivateReactionImpl();
 template Reaction<2,4>* Reaction<2,4>::cloneImpl(const SpeciesPtrContainerVector &spcv);
+template bool Reaction<2,4>::rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv);
 
 template void Reaction<2,5>::updatePropensityImpl();
 template void Reaction<2,5>::activateReactionUnconditionalImpl();
 template void Reaction<2,5>::passivateReactionImpl();
 template Reaction<2,5>* Reaction<2,5>::cloneImpl(const SpeciesPtrContainerVector &spcv);
+template bool Reaction<2,5>::rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv);
 
 template void Reaction<4,0>::updatePropensityImpl();
 template void Reaction<4,0>::activateReactionUnconditionalImpl();
 template void Reaction<4,0>::passivateReactionImpl();
 template Reaction<4,0>* Reaction<4,0>::cloneImpl(const SpeciesPtrContainerVector &spcv);
+template bool Reaction<4,0>::rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv);
 
 template void Reaction<5,2>::updatePropensityImpl();
 template void Reaction<5,2>::activateReactionUnconditionalImpl();
 template void Reaction<5,2>::passivateReactionImpl();
 template Reaction<5,2>* Reaction<5,2>::cloneImpl(const SpeciesPtrContainerVector &spcv);
+template bool Reaction<5,2>::rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv);
 
 template void Reaction<4,2>::updatePropensityImpl();
 template void Reaction<4,2>::activateReactionUnconditionalImpl();
 template void Reaction<4,2>::passivateReactionImpl();
 template Reaction<4,2>* Reaction<4,2>::cloneImpl(const SpeciesPtrContainerVector &spcv);
+template bool Reaction<4,2>::rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv);
 
 } // namespace medyan
@@ -65,12 +65,10 @@ public:
         /// no assignment (including all derived classes)
         Reaction& operator=(Reaction &rb) = delete;
 
-#ifdef BOOST_MEM_POOL
-        /// Advanced memory management
-        void* operator new(size_t size);
-        
-        void operator delete(void* ptr) noexcept;
-#endif
+        /// Reactions are allocated in slab pools.
+        static void* operator new(size_t size) { return slabAllocate< Reaction >(size); }
+
+        static void operator delete(void* ptr, size_t size) noexcept { slabDeallocate< Reaction >(ptr, size); }
         /// Destructor
         /// Tell Rspecies to remove this Reaction from its internal lists of reactions
         /// @note noexcept is important here. Otherwise, gcc flags the constructor as
@@ -97,9 +95,18 @@ public:
                 it != s->endReactantReactions(); it++) {
                 ReactionBase* r = (*it);
                 if(r!=this && !r->isPassivated())
-                    _dependents.insert(r);
+                    _dependents.insertUnchecked(r);
             }
         }
+        // A reaction sharing several species is found more than once.
+        _dependents.removeDuplicates();
+        _dependentsGeneration = computeDependentsGeneration();
+    }
+
+    virtual std::size_t computeDependentsGeneration() const override {
+        std::size_t res = 0;
+        for(int i = 0; i < M + N; i++) res += _rspecies[i]->reactantReactionsGeneration();
+        return res;
     }
 
     virtual void updatePropensityImpl() override;
@@ -233,6 +240,10 @@ protected:
         /// Implementation of  clone()
         virtual Reaction<M,N>* cloneImpl(
             const SpeciesPtrContainerVector &spcv) override;
+
+        /// Implementation of rebindSpecies()
+        virtual bool rebindSpeciesImpl(
+            const SpeciesPtrContainerVector &spcv) override;
         
         virtual bool updateDependencies() override {return true;}
     };
@@ -273,12 +284,10 @@ public:
     //Destructor does nothing new
     virtual ~DiffusionReaction() {}
     
-#ifdef BOOST_MEM_POOL
-    /// Advanced memory management
-    void* operator new(size_t size);
-    
-    void operator delete(void* ptr) noexcept;
-#endif
+    /// Reactions are allocated in slab pools.
+    static void* operator new(size_t size) { return slabAllocate< DiffusionReaction >(size); }
+
+    static void operator delete(void* ptr, size_t size) noexcept { slabDeallocate< DiffusionReaction >(ptr, size); }
     
     /// Implementation of makeStep()
     inline virtual void makeStepImpl() override
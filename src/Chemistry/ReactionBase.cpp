@@ -43,9 +43,14 @@ Composite* ReactionBase::getRoot() {
     return nullptr;
 }
 
-void ReactionBase::registerNewDependent(ReactionBase *r){ _dependents.insert(r);}
+void ReactionBase::registerNewDependent(ReactionBase *r){
+    if(_updatesDeferred) return;
+    // r might be registered just before, through another species shared with this
+    // ReactionBase.
+    if(_dependents.empty() || _dependents.values().back() != r) _dependents.insertUnchecked(r);
+}
 
-void ReactionBase::unregisterDependent(ReactionBase *r){ _dependents.erase(r);}
+void ReactionBase::unregisterDependent(ReactionBase *r){ if(!_updatesDeferred) _dependents.erase(r);}
 
 void ReactionBase::clearSignaling () {
     callbacks_.clear();
@@ -68,6 +73,7 @@ void ReactionBase::printDependents()  {
 
 bool afterchemsiminit = false;
 void ReactionBase::activateReaction() {
+    if(_updatesDeferred) return;
 #ifdef TRACK_ZERO_COPY_N
 	if(areEqual(getProductOfReactants(), 0.0)) // One of the reactants is still at zero copy n,
 		// no need to activate yet...
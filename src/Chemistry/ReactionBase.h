@@ -22,9 +22,13 @@
 #include <set>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common.h"
 #include "Chemistry/Species.h"
+#include "Util/FlatSet.hpp"
+#include "Util/SlabAllocator.hpp"
+#include "Util/StringInterner.hpp"
 
 namespace medyan {
 //FORWARD DECLARATIONS
@@ -78,6 +82,35 @@ constexpr const char* text(ReactionType t) {
     }
 }
 
+/// Interned HRCDID of reactions that are not tracked in dissipation tracking.
+constexpr Index hrcdidDNT = 0;
+
+/// The database of HRCDIDs of reactions. Dissipation tracking accumulates
+/// energies by the interned ids, and the names are only resolved for output.
+inline StringInterner& hrcdidNames() {
+    static StringInterner names { "DNT" };
+    return names;
+}
+
+/// Interned HRCDIDs of unbinding reactions, indexed by the interned HRCDIDs of
+/// the paired binding reactions. Only modified at setup.
+inline std::vector< Index >& hrcdidOffTable() {
+    static std::vector< Index > table;
+    return table;
+}
+
+/// Intern the HRCDID of the unbinding reaction paired with a binding reaction,
+/// which is the HRCDID of the binding reaction followed by "off".
+inline void registerHRCDIDOff(Index onHRCDID) {
+    auto& table = hrcdidOffTable();
+    if(onHRCDID >= table.size()) table.resize(onHRCDID + 1, hrcdidDNT);
+    table[onHRCDID] = hrcdidNames().id(hrcdidNames().name(onHRCDID) + "off");
+}
+
+/// The interned HRCDID of the unbinding reaction paired with a binding
+/// reaction, which must have been registered with registerHRCDIDOff().
+inline Index hrcdidOff(Index onHRCDID) { return hrcdidOffTable().at(onHRCDID); }
+
 
 /// Represents an abstract interface for simple chemical reactions of the form
 /// A + B -> C.
@@ -100,15 +133,13 @@ public:
     using CallbackType = std::function< void(ReactionBase*) >;
 
 protected:
-	#ifdef DEBUGCONSTANTSEED
-	using dependentdatatype = unordered_set<ReactionBase*, HashbyId<ReactionBase*>,
-            customEqualId<ReactionBase*>>;
-	#else
-    using dependentdatatype = unordered_set<ReactionBase*>; ///< Pointers to
-    // ReactionBase objects that depend
-                                               ///< on this ReactionBase being executed
-	#endif
+    /// Pointers to ReactionBase objects that depend on this ReactionBase being
+    /// executed, stored contiguously. The iteration order does not depend on the
+    /// pointer values, so it is reproducible between runs.
+    using dependentdatatype = FlatSet<ReactionBase*>;
     dependentdatatype _dependents;
+    std::size_t _dependentsGeneration = 0; ///< Value of computeDependentsGeneration()
+                                           ///< when the dependents were last set
     RNode* _rnode; ///< A pointer to an RNode object which is used
                    ///< to implement a Gillespie-like algorithm (e.g. NRM)
     
@@ -131,13 +162,16 @@ protected:
     
     bool _isProtoCompartment = false;///< Reaction is in proto compartment
     ///< (Do not copy as a dependent, not in ChemSim)
+
+    bool _updatesDeferred = false; ///< Activation, passivation and changes of
+    ///< dependents are ignored (used when parts of the network run concurrently)
     
     CBound* _cBound = nullptr; ///< CBound that is attached to this reaction
     
     
     float _gnum = 0.0;
     
-    string _hrcdid = "DNT";
+    Index _hrcdid = hrcdidDNT; ///< Interned HRCDID (see hrcdidNames())
     
     float _linkRateForward = 0.0;
     
@@ -209,6 +243,19 @@ public:
     
     /// (Private) implementation of the clone() method to be elaborated in derived classes
     virtual ReactionBase* cloneImpl(const SpeciesPtrContainerVector &spcv) = 0;
+
+    /// Replace the diffusing, bulk and binding species of this reaction in place by
+    /// the analogous Species in SpeciesPtrContainerVector &spcv, which is the same
+    /// lookup as in clone(). Other species are kept.
+    /// @return whether any species was replaced
+    /// @note the reaction should be passivated before, and activated after the call
+    bool rebindSpecies(const SpeciesPtrContainerVector &spcv) {
+        return rebindSpeciesImpl(spcv);
+    }
+
+    /// (Private) implementation of the rebindSpecies() method to be elaborated in
+    /// derived classes
+    virtual bool rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv) = 0;
     
     /// Returns a pointer to the first element of the array<RSpecies*>. This pointer can
     /// be used to iterate over RSpecies* if necessary (also by relying on getM() and
@@ -272,9 +319,13 @@ public:
 
 	floatingpoint getGNumber() {return _gnum;};
     
-    void setHRCDID(string hrcdid) {_hrcdid = hrcdid;};
+    void setHRCDID(const string& hrcdid) {_hrcdid = hrcdidNames().id(hrcdid);};
     
-    string getHRCDID() {return _hrcdid;};
+    const string& getHRCDID() const {return hrcdidNames().name(_hrcdid);};
+
+    /// Set and return the interned HRCDID, used in dissipation tracking
+    void setHRCDIndex(Index hrcdid) {_hrcdid = hrcdid;}
+    Index getHRCDIndex() const {return _hrcdid;}
     
     ///Set CBound
     void setCBound(CBound* cBound) {_cBound = cBound;}
@@ -409,6 +460,9 @@ public:
     /// object to be called (a slot)
     void connect(CallbackType callback);
     
+    /// Returns true if any callback is attached to this reaction.
+    bool hasCallbacks() const { return !callbacks_.empty(); }
+
     /// Broadcasts signal indicating that the ReactionBase event has taken place
     /// This method is only called by the code which runs the chemical dynamics (i.e.
     /// Gillespie-like algorithm)
@@ -471,7 +525,7 @@ public:
     /// other ReactionBase objects that may affect this ReactionBase to stop tracking
     /// this ReactionBase. Eventually, activateReaction() may be called to restart
     /// tracking, if the propensity stops being 0.
-    void passivateReaction() {passivateReactionImpl();}
+    void passivateReaction() { if(!_updatesDeferred) passivateReactionImpl(); }
     
     /// (Private) implementation of the passivateReaction() method to be elaborated in
     /// derived classes.
@@ -481,7 +535,7 @@ public:
     /// tracking it, which can be used to follow ReactionBase objects whose propensities
     /// change upong firing of some ReactionBase. This request is acted upon
     /// unconditionally.
-    void activateReactionUnconditional() {activateReactionUnconditionalImpl();}
+    void activateReactionUnconditional() { if(!_updatesDeferred) activateReactionUnconditionalImpl(); }
     
     virtual void activateReactionUnconditionalImpl() = 0;
     
@@ -493,7 +547,7 @@ public:
     
     /// Performs a simple updating of the propensity of this ReactionBase. Does not change
     /// dependents, only updates the RNode if initialized.
-    void updatePropensity() {updatePropensityImpl();}
+    void updatePropensity() { if(!_updatesDeferred) updatePropensityImpl(); }
     
     virtual void updatePropensityImpl() = 0;
     
@@ -506,9 +560,23 @@ public:
     /// dependencies. Importantly, the copy numbers of molecules do not influence the
     /// result of this function. \sa dependents()
     virtual void setDependentReactions() = 0;
+
+    /// Returns a counter which changes whenever the result of setDependentReactions()
+    /// might change, i.e. when a reaction consuming any of the species is added,
+    /// removed, activated or passivated.
+    virtual std::size_t computeDependentsGeneration() const = 0;
+
+    /// Returns true if the dependents might be outdated, for example because they were
+    /// not updated while updates were deferred.
+    bool areDependentsOutdated() const {
+        return computeDependentsGeneration() != _dependentsGeneration;
+    }
     
     /// Request that the ReactionBase *r adds this ReactionBase to its list of
     /// dependents which it affects.
+    /// @note This takes constant time, so *r must not be a dependent already, unless
+    /// it was the last one added. This holds when a passivated ReactionBase *r is
+    /// activated (see activateReactionUnconditional()).
     void registerNewDependent(ReactionBase *r);
     
     /// Request that the ReactionBase *r removes this ReactionBase from its list of
@@ -516,6 +584,15 @@ public:
     /// This is usually requested when the ReactionBase propensity drops to zero (i.e.
     /// via passivateReactionBase()).
     void unregisterDependent(ReactionBase *r);
+
+    /// Defer all updates of this ReactionBase caused by other parts of the network.
+    /// While deferred, requests to activate or passivate this ReactionBase, to update
+    /// its propensity, and to change its dependents are ignored. This is used when
+    /// parts of the reaction network are simulated concurrently, and the deferring
+    /// code is responsible for bringing the ReactionBase up to date afterwards (e.g.
+    /// via setDependentReactions() and activateReaction()/passivateReaction()).
+    void setUpdatesDeferred(bool deferred) { _updatesDeferred = deferred; }
+    bool areUpdatesDeferred() const { return _updatesDeferred; }
     
     virtual void printToStream(ostream& os) const = 0;
     
@@ -98,6 +98,18 @@ public:
             _reactions.erase(child_iter);
         }
     }
+    /// Remove all reactions satisfying the predicate from this container without
+    /// freeing them. The ownership of the removed reactions is returned.
+    template< typename Pred >
+    vector<unique_ptr<ReactionBase>> releaseReactionsIf(Pred&& pred) {
+        vector<unique_ptr<ReactionBase>> released;
+        for(auto &r : _reactions) {
+            if(pred(r.get())) released.push_back(move(r));
+        }
+        _reactions.erase(remove(_reactions.begin(), _reactions.end(), nullptr), _reactions.end());
+        return released;
+    }
+    
    //aravind June 24, 2016.
     virtual void updatePropensityComprtment()
     {        for(auto &it: _reactions)
@@ -4,10 +4,6 @@
 #include <algorithm>
 #include <stdexcept>
 
-#ifdef BOOST_MEM_POOL
-    #include <boost/pool/pool.hpp>
-    #include <boost/pool/pool_alloc.hpp>
-#endif
 
 #include "Chemistry/ChemRNode.h"
 #include "Chemistry/ReactionBase.h"
@@ -65,17 +61,10 @@ public:
         
     ReactionDy(const ReactionDy &) = delete;
         
-#ifdef BOOST_MEM_POOL
-    /// Advanced memory management
-    void* operator new(size_t size) {
-        void *ptr = boost::fast_pool_allocator< ReactionDy >::allocate();
-        return ptr;
-    }
+    /// Reactions are allocated in slab pools.
+    static void* operator new(size_t size) { return slabAllocate< ReactionDy >(size); }
 
-    void operator delete(void* ptr) noexcept {
-        boost::fast_pool_allocator< ReactionDy >::deallocate((ReactionDy*)ptr);
-    }
-#endif
+    static void operator delete(void* ptr, size_t size) noexcept { slabDeallocate< ReactionDy >(ptr, size); }
 
     virtual ~ReactionDy() noexcept override {
         unregisterInRSpecies_();
@@ -93,10 +82,19 @@ public:
         for(int i = 0; i < repRSpecies_.size(); i++) {
             for(auto r : repRSpecies_[i].prs->reactantReactions()) {
                 if(r != this && !r->isPassivated()) {
-                    _dependents.insert(r);
+                    _dependents.insertUnchecked(r);
                 }
             }
         }
+        // A reaction sharing several species is found more than once.
+        _dependents.removeDuplicates();
+        _dependentsGeneration = computeDependentsGeneration();
+    }
+
+    virtual std::size_t computeDependentsGeneration() const override {
+        std::size_t res = 0;
+        for(auto& rrs : repRSpecies_) res += rrs.prs->reactantReactionsGeneration();
+        return res;
     }
 
     virtual void updatePropensityImpl() override {
@@ -232,14 +230,18 @@ public:
     /// Implementation of activateReactionUnconditional()
     virtual void activateReactionUnconditionalImpl() override {
 #ifdef TRACK_DEPENDENTS
-        for(unsigned short i = 0; i < numReactants_; ++i)
-        {
-            auto& rs = *repRSpecies_[i].prs;
-            for(auto r : rs.reactantReactions()) {
-                if(this != r) r->registerNewDependent(this);
-            }
-            for(auto r : rs.productReactions()) {
-                if(this != r) r->registerNewDependent(this);
+        // An active reaction is already a dependent of the affected reactions.
+        if(isPassivated()) {
+            for(unsigned short i = 0; i < numReactants_; ++i)
+            {
+                auto& rs = *repRSpecies_[i].prs;
+                rs.touchReactantReactions();
+                for(auto r : rs.reactantReactions()) {
+                    if(this != r) r->registerNewDependent(this);
+                }
+                for(auto r : rs.productReactions()) {
+                    if(this != r) r->registerNewDependent(this);
+                }
             }
         }
 #endif
@@ -257,6 +259,7 @@ public:
         for(unsigned short i = 0; i < numReactants_; ++i)
         {
             auto& rs = *repRSpecies_[i].prs;
+            rs.touchReactantReactions();
             for(auto r : rs.reactantReactions()) {
                 r->unregisterDependent(this);
             }
@@ -332,6 +335,12 @@ public:
         throw std::runtime_error("Invalid clone in ReactionDy");
     }
 
+    /// Implementation of rebindSpecies()
+    virtual bool rebindSpeciesImpl(const SpeciesPtrContainerVector &spcv) override {
+        log::error("Virtual rebindSpecies function in ReactionDy is not allowed.");
+        throw std::runtime_error("Invalid rebindSpecies in ReactionDy");
+    }
+
 };
 
 } // namespace medyan
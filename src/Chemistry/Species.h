@@ -321,6 +321,11 @@ public:
     virtual Species* clone() {
         return new Species(*this);
     }
+
+    /// Species are allocated in slab pools.
+    static void* operator new(size_t size) { return slabAllocate< Species >(size); }
+
+    static void operator delete(void* ptr, size_t size) noexcept { slabDeallocate< Species >(ptr, size); }
     
     Composite* getParent() {return _parent;}
     
@@ -459,6 +464,11 @@ public:
     virtual SpeciesBound* clone() {
         return new SpeciesBound(*this);
     }
+
+    /// Species are allocated in slab pools.
+    static void* operator new(size_t size) { return slabAllocate< SpeciesBound >(size); }
+
+    static void operator delete(void* ptr, size_t size) noexcept { slabDeallocate< SpeciesBound >(ptr, size); }
     
     /// Default destructor
     ~SpeciesBound () noexcept {};
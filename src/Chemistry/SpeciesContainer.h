@@ -96,6 +96,19 @@ public:
         return counter;
     }
     
+    /// Remove all species satisfying the predicate from the container without freeing
+    /// them. The order of the remaining species is kept, and the ownership of the
+    /// removed species is returned.
+    template< typename Pred >
+    vector<unique_ptr<Species>> releaseSpeciesIf(Pred&& pred) {
+        vector<unique_ptr<Species>> released;
+        for(auto &s : _species) {
+            if(pred(s.get())) released.push_back(move(s));
+        }
+        _species.erase(remove(_species.begin(), _species.end(), nullptr), _species.end());
+        return released;
+    }
+    
     /// Return a pointer to Species which has a name matching the argument. Otherwise,
     /// return a nullptr.
     /// @note The first match is returned.
@@ -20,9 +20,13 @@
 #include "ChemNRMImpl.h"
 #include "ChemGillespieImpl.h"
 #include "ChemSimpleGillespieImpl.h"
+#include "ChemCRImpl.h"
+#include "ChemPartitionedImpl.h"
+#include "ChemHybridImpl.h"
 
 #include "CCylinder.h"
 #include "Cylinder.h"
+#include "Util/ThreadPool.hpp"
 
 namespace medyan {
 
@@ -49,6 +53,55 @@ void CController::initialize(string& chemAlgorithm, ChemistryData& chem, Dissipa
         _subSystem->pChemSim = std::make_unique<ChemGillespieImpl>();
     }
     
+    else if(chemAlgorithm == "CR") {
+        
+#if !defined(TRACK_DEPENDENTS)
+        cout << "The composition-rejection algorithm relies on tracking dependents. Please set this"
+            << " compilation macro and try again. Exiting." << endl;
+        exit(EXIT_FAILURE);
+#endif
+        _subSystem->pChemSim = std::make_unique<ChemCRImpl>();
+    }
+    
+    else if(chemAlgorithm == "PARTITIONED") {
+        
+#if !defined(TRACK_DEPENDENTS)
+        cout << "The partitioned algorithm relies on tracking dependents. Please set this"
+            << " compilation macro and try again. Exiting." << endl;
+        exit(EXIT_FAILURE);
+#endif
+        const auto& algo = sc.chemParams.chemistryAlgorithm;
+        Size numDomains = algo.partitionNumDomains > 0
+            ? algo.partitionNumDomains
+            : ThreadPool::global().numThreads() + 1;
+        if(sc.chemParams.dissTracking && numDomains > 1) {
+            log::warn("Dissipation tracking is not supported with multiple chemistry sub-domains. Using 1 sub-domain.");
+            numDomains = 1;
+        }
+        auto& grid = *_subSystem->getCompartmentGrid();
+        auto domainOfParent = partitionCompartmentsIntoSlabs(grid, numDomains);
+        numDomains = std::min<Size>(numDomains, *std::max_element(grid.shape.begin(), grid.shape.end()));
+        log::info("Chemistry uses {} sub-domains, synchronized every {} s.", numDomains, algo.partitionSyncTime);
+        _subSystem->pChemSim = std::make_unique<ChemPartitionedImpl>(std::move(domainOfParent), numDomains, algo.partitionSyncTime);
+    }
+    
+    else if(chemAlgorithm == "HYBRID") {
+        
+#if !defined(TRACK_DEPENDENTS)
+        cout << "The hybrid algorithm relies on tracking dependents. Please set this"
+            << " compilation macro and try again. Exiting." << endl;
+        exit(EXIT_FAILURE);
+#endif
+        const auto& algo = sc.chemParams.chemistryAlgorithm;
+        floatingpoint threshold = algo.hybridCopyNumberThreshold;
+        if(sc.chemParams.dissTracking) {
+            log::warn("Dissipation tracking is not supported with tau-leaping. All reactions are simulated exactly.");
+            threshold = std::numeric_limits<floatingpoint>::infinity();
+        }
+        log::info("Chemistry leaps diffusion with reactant copy number above {}, in windows of {} s.", threshold, algo.hybridLeapTime);
+        _subSystem->pChemSim = std::make_unique<ChemHybridImpl>(threshold, algo.hybridLeapTime);
+    }
+    
     else if(chemAlgorithm == "SIMPLEGILLESPIE") {
         _subSystem->pChemSim = std::make_unique<ChemSimpleGillespieImpl>();
     }
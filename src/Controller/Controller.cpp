@@ -41,6 +41,7 @@
 #include "Structure/Linker.h"
 #include "Structure/MotorGhost.h"
 #include "Structure/Movables.hpp"
+#include "Structure/Output/OCheckpoint.hpp"
 #include "Structure/SubSystem.h"
 #include "Structure/SubSystemFunc.hpp"
 #include "Structure/SurfaceMesh/FixedVertexAttachmentInit.hpp"
@@ -51,6 +52,8 @@
 #include "Structure/SurfaceMesh/SurfaceMeshGeneratorPreset.hpp"
 #include "Util/Io/Log.hpp"
 #include "Util/Profiler.hpp"
+#include "Util/SlabAllocator.hpp"
+#include "Util/ThreadPool.hpp"
 
 namespace medyan {
 using namespace mathfunc;
@@ -98,6 +101,9 @@ SimulConfig Controller::initialize(const CommandLineConfig& cmdConfig) {
     cout << endl;
 
 
+    // Initialize the global thread pool. The calling thread also participates in parallel work.
+    ThreadPool::resetGlobal(std::max(cmdConfig.numThreads, 1) - 1);
+
     //----------------------------------
     // Initialize controllers.
     //----------------------------------
@@ -118,6 +124,7 @@ SimulConfig Controller::initialize(const CommandLineConfig& cmdConfig) {
     cout << "---" << endl;
     log::info("Initializing mechanics...");
     _mController.initialize(simulConfig);
+    _mController.ffm.setNumThreads(cmdConfig.numThreads);
     log::info("Done.");
 
     // Initialize special protocols.
@@ -255,7 +262,8 @@ SimulConfig Controller::initialize(const CommandLineConfig& cmdConfig) {
         if(simulConfig.mechParams.hessMatrixPrintBool){
             //Set up HessianMatrix if hessiantracking is enabled
             string hessianmatrix = (cmdConfig.outputDirectory / "hessianmatrix.traj").string();
-            _outputs.push_back(make_unique<HessianMatrix>(hessianmatrix, &_subSystem, _ffm));
+            string hessianmatrixh5 = (cmdConfig.outputDirectory / "hessianmatrix.h5").string();
+            _outputs.push_back(make_unique<HessianMatrix>(hessianmatrix, hessianmatrixh5, &_subSystem, _ffm));
         }
         //Set up HessianSpectra if hessiantracking is enabled
         string hessianspectra = (cmdConfig.outputDirectory / "hessianspectra.traj").string();
@@ -278,6 +286,7 @@ SimulConfig Controller::initialize(const CommandLineConfig& cmdConfig) {
     //Set up datadump output if any
     string datadumpname = (cmdConfig.outputDirectory / "datadump.traj").string();
     _outputdump.push_back(make_unique<Datadump>(datadumpname, &_subSystem, ChemData));
+    checkpointFile_ = cmdConfig.outputDirectory / "checkpoint.h5";
 
     //----------------------------------
     // Finishing initialization.
@@ -495,6 +504,16 @@ void Controller::setupInitialNetwork(const CommandLineConfig& cmdConfig, SimulCo
     log::info("Adjusting compartments by membranes...");
 
     // Deactivate all the compartments outside membrane, and mark boundaries as interesting
+    // Compartments without triangles are tested against the region in one batch.
+    vector< bool > compartmentInMembrane;
+    {
+        vector< Vec< 3, floatingpoint > > coords;
+        for(auto& c : _subSystem.getCompartmentGrid()->getCompartments()) {
+            if(c->getTriangles().empty()) coords.push_back(c->coordinates());
+        }
+        compartmentInMembrane = _regionInMembrane->contains(_subSystem, coords);
+    }
+    Index nextNoTriangle = 0;
     for(auto& c : _subSystem.getCompartmentGrid()->getCompartments()) {
         if(!c->getTriangles().empty()) {
             // Contains triangles, so this compartment is at the boundary.
@@ -504,7 +523,7 @@ void Controller::setupInitialNetwork(const CommandLineConfig& cmdConfig, SimulCo
             c->computeSlicedVolumeArea(_subSystem, Compartment::SliceMethod::membrane);
             _cController.updateActivation(*_subSystem.getCompartmentGrid(), c->getId(), Compartment::ActivateReason::Membrane);
 
-        } else if( ! _regionInMembrane->contains(_subSystem, c->coordinates())) {
+        } else if( ! compartmentInMembrane[nextNoTriangle++]) {
             // Compartment is outside the membrane
             _cController.deactivate(*_subSystem.getCompartmentGrid(), c->getId(), true);
         }
@@ -618,8 +637,19 @@ void Controller::setupInitialNetwork(const CommandLineConfig& cmdConfig, SimulCo
         cout<<endl;
 	    cout<<"RESTART PHASE BEINGS."<<endl;
         //Create the restart pointer
-        const string inputfileName = (cmdConfig.inputDirectory / FSetup.inputFile).string();
-        _restart = new Restart(&_subSystem, simulConfig.chemistryData, inputfileName);
+        const auto inputFile = cmdConfig.inputDirectory / FSetup.inputFile;
+        if(isCheckpointFile(inputFile)) {
+            // The random engine continues from the state stored in the checkpoint.
+            // The rest of the state is rebuilt from the data dump as usual.
+            const auto checkpoint = readCheckpoint(inputFile);
+            log::info("Restarting from checkpoint at time {}.", checkpoint.simulationTime);
+            log::info("The possible bindings and the reaction queue are rebuilt, so the run is not an exact continuation.");
+            Rand::setEngState(checkpoint.rngState);
+            _restart = new Restart(&_subSystem, simulConfig.chemistryData, checkpoint);
+        }
+        else {
+            _restart = new Restart(&_subSystem, simulConfig.chemistryData, inputFile.string());
+        }
         //read set up.
         _restart->readNetworkSetup();
         _restart->setupInitialNetwork();
@@ -879,6 +909,19 @@ void Controller::updateActiveCompartments() {
     // Currently only the 0th membrane will be considered
     if(allMembranes.size()) {
         auto& theMembrane = *allMembranes.begin();
+
+        // Compartments leaving the boundary are tested against the membrane in one batch.
+        vector< bool > leavingInMembrane;
+        if(theMembrane.isClosed()) {
+            vector< Vec< 3, floatingpoint > > coords;
+            for(auto& c: grid.getCompartments()) {
+                if(c->getTriangles().empty() && c->boundaryInteresting) coords.push_back(c->coordinates());
+            }
+            const auto ds = medyan::signedDistance(_subSystem, theMembrane.getMesh(), coords);
+            for(auto d : ds) leavingInMembrane.push_back(d < 0.0);
+        }
+        Index nextLeaving = 0;
+
         // For non empty compartments, we mark them as interesting and update their status
         // For the "interesting" compartments last round but now empty, we fully activate or deactivate them
         // For the rest we do nothing, assuming that the membranes will NOT move across a whole compartment
@@ -894,7 +937,7 @@ void Controller::updateActiveCompartments() {
             } else if(c->boundaryInteresting) { // Interesting last round but now empty
                 bool inMembrane = (
                     (!theMembrane.isClosed()) ||
-                    (medyan::contains(_subSystem, theMembrane.getMesh(), c->coordinates()))
+                    leavingInMembrane[nextLeaving++]
                 );
                 if(inMembrane) {
                     // Fully activate the compartment
@@ -966,12 +1009,12 @@ void Controller::initializeSpecialProtocols(const SimulConfig& conf) {
                     if((plusEndC->getSecondBead() == b) ||
                     (minusEndC->getFirstBead() == b)) {
 
-                        cout << sys.getBoundary()->distance(b->vcoordinate()) << endl;
+                        cout << sys.getBoundary()->distance(b->coordinate()) << endl;
                         cout << conf.mechParams.pinDistance << endl;
 
 
                         //if within dist to boundary, add
-                        if(sys.getBoundary()->distance(b->vcoordinate()) < conf.mechParams.pinDistance) {
+                        if(sys.getBoundary()->distance(b->coordinate()) < conf.mechParams.pinDistance) {
 
                             b->pinnedPosition = b->vcoordinate();
                             b->addAsPinned();
@@ -1004,7 +1047,7 @@ void Controller::initializeSpecialProtocols(const SimulConfig& conf) {
                         auto index = Rand::randfloatingpoint(0,1);
                         //cout << index <<endl;
                         //if within dist to boundary and index > 0.5, add
-                        if(sys.getBoundary()->lowerdistance(b->vcoordinate()) < conf.mechParams.pinDistance
+                        if(sys.getBoundary()->lowerdistance(b->coordinate()) < conf.mechParams.pinDistance
                         && index < conf.mechParams.pinFraction && b->isPinned() == false) {
                             //cout << index << endl;
                             b->pinnedPosition = b->vcoordinate();
@@ -1165,10 +1208,20 @@ void Controller::updatePositions(double& tp) {
 
 
 void Controller::updateReactionRates(const SimulConfig& conf) {
-    SubSystemFunc{}.forEachReactable(_subSystem, reactable::updateReactionRates);
+    // The heap updates of the chemical simulation are batched, and elements
+    // whose forces have not changed beyond the tolerance are skipped.
+    auto chemSim = _subSystem.pChemSim.get();
+    if(chemSim) chemSim->beginRateUpdates();
+
+    SubSystemFunc{}.forEachReactable(
+        _subSystem,
+        reactable::updateReactionRatesIfChanged(conf.dyRateParams.rateUpdateForceTolerance)
+    );
 
     // Update adsorption/desorption reaction rates.
     setAdsorptionDesorptionReactionRates(_subSystem, conf.chemistryData);
+
+    if(chemSim) chemSim->endRateUpdates();
 }
 
 void Controller::updateNeighborLists(const CommandLineConfig& cmdConfig, SimulConfig& conf) {
@@ -1201,6 +1254,93 @@ void Controller::resetCounters() {
     for(Filament* f : Filament::getFilaments()) f->resetCounters();
 }
 
+void Controller::printOutputs(int snapshot, const SimulConfig& conf) {
+    // Read-only outputs write to separate files, so they can be printed concurrently.
+    readOnlyOutputs_.clear();
+    for(auto& o : _outputs) {
+        if(o->isReadOnly()) readOnlyOutputs_.push_back(o.get());
+    }
+    ThreadPool::global().parallelFor(0, readOnlyOutputs_.size(), [&, this](Index i) {
+        readOnlyOutputs_[i]->print(snapshot, conf);
+    });
+
+    // Other outputs are printed in order.
+    for(auto& o : _outputs) {
+        if(!o->isReadOnly()) o->print(snapshot, conf);
+    }
+
+    // Move the printed data to a free buffer, and write them on the writer thread.
+    auto& buffer = trajWriter_.acquire();
+    buffer.texts.resize(_outputs.size());
+    for(Index i = 0; i < _outputs.size(); ++i) {
+        _outputs[i]->takePrinted(buffer.texts[i]);
+    }
+    output_.extractNext(buffer.snapshot, _subSystem, conf);
+
+    trajWriter_.submit([this](SnapshotOutputBuffer& b) {
+        for(Index i = 0; i < _outputs.size(); ++i) {
+            _outputs[i]->write(b.texts[i]);
+        }
+        output_.write(b.snapshot);
+    });
+}
+
+void Controller::printDatadump(const SimulConfig& conf) {
+    const auto interval = conf.outputParams.checkpointInterval;
+    const bool writesCheckpoint = interval > 0 && numDatadumps_ % interval == 0;
+    ++numDatadumps_;
+
+    string text;
+    for(auto& o : _outputdump) {
+        o->print(0);
+        o->takePrinted(text);
+        o->write(text);
+
+        if(writesCheckpoint && dynamic_cast< Datadump* >(o.get())) {
+            OutputStructCheckpoint checkpoint;
+            extract(checkpoint, tau(), std::move(text));
+            // The HDF5 library is not thread-safe, so the trajectory writer
+            // must not be writing at the same time.
+            trajWriter_.flush();
+            writeCheckpoint(checkpointFile_, checkpoint);
+        }
+    }
+    // The data dump rearranges the cylinders, which changes their stable indices.
+    _subSystem.updateNeighborListRowIndices();
+}
+
+void Controller::printThreadPoolStats() {
+    auto& pool = ThreadPool::global();
+    if(pool.numThreads() == 0) return;
+
+    const auto stats = pool.getUsageStats();
+    log::info("Thread pool usage ({} working threads + calling thread):", pool.numThreads());
+    for(Index i = 0; i < stats.threads.size(); ++i) {
+        const auto& ts = stats.threads[i];
+        log::info(
+            "- Thread {}: busy {:.3f}s, idle {:.3f}s, tasks {}, steals {}, contentions {}",
+            i, ts.workTime, ts.idleTime, ts.numTasksDone, ts.numSteals, ts.numContentions
+        );
+    }
+    log::info("- Usage rate: {:.1f}%, contentions outside the pool: {}", 100 * stats.timeUsageRate, stats.numExternalContentions);
+    if(const auto rec = stats.recommendation(); !rec.empty()) {
+        log::info("- Recommendation: {}", rec);
+    }
+}
+
+void Controller::printSlabPoolStats() {
+    const auto stats = SlabPoolRegistry::global().stats();
+    if(stats.empty()) return;
+
+    log::info("Slab pool usage:");
+    for(const auto& ps : stats) {
+        log::info(
+            "- {}: object size {}B, slabs {}, live {}, peak {}, allocations {}",
+            ps.name, ps.objectSize, ps.numSlabs, ps.numLive, ps.peakLive, ps.numAllocations
+        );
+    }
+}
+
 
 void Controller::membraneAdaptiveRemesh() {
     // Requires _meshAdapter to be already initialized
@@ -1488,9 +1628,8 @@ void Controller::run(const CommandLineConfig& cmdConfig, SimulConfig& conf) {
     chrono::duration<floatingpoint> elapsed_runrxn(mine - mins);
     rxnratetime += elapsed_runrxn.count();
 
-    for(auto& o: _outputs) o->print(0, conf);
-    for(auto& o: _outputdump) o->print(0);
-    output_.append(_subSystem, conf);
+    printOutputs(0, conf);
+    printDatadump(conf);
 
     resetCounters();
 
@@ -1583,8 +1722,8 @@ void Controller::run(const CommandLineConfig& cmdConfig, SimulConfig& conf) {
             //print output if chemistry fails.
             mins = chrono::high_resolution_clock::now();
             if(!chemSuccess) {
-                for(auto& o: _outputs) { o->print(snapshotCounter, conf); }
-                output_.append(_subSystem, conf);
+                printOutputs(snapshotCounter, conf);
+                trajWriter_.flush();
                 resetCounters();
                 break;
             }
@@ -1683,8 +1822,7 @@ void Controller::run(const CommandLineConfig& cmdConfig, SimulConfig& conf) {
             //-----------------------------------------------------------------
             if(minimizationCounter%minsPerSnapshot == 0) {
                 mins = chrono::high_resolution_clock::now();
-                for(auto& o: _outputs) o->print(snapshotCounter, conf);
-                output_.append(_subSystem, conf);
+                printOutputs(snapshotCounter, conf);
                 resetCounters();
                 mine= chrono::high_resolution_clock::now();
                 chrono::duration<floatingpoint> elapsed_runout2(mine - mins);
@@ -1694,7 +1832,12 @@ void Controller::run(const CommandLineConfig& cmdConfig, SimulConfig& conf) {
                     log::info("Total time spent until cycle {}:", minimizationCounter);
                     log::info("- Chemistry:            {}", chemistrytime);
                     log::info("- Minimization:         {}", minimizationtime);
-                    log::info("- Neighbor list update: {}", nltime);
+                    log::info(
+                        "- Neighbor list update: {} (cylinder lists rebuilt {}, skipped {})",
+                        nltime,
+                        _subSystem.cylinderNeighborListSkin.stats().numRebuilds,
+                        _subSystem.cylinderNeighborListSkin.stats().numSkips
+                    );
                     log::info("- Position update:      {}", updateposition);
                     log::info("- Reaction rate update: {}", rxnratetime);
                     log::info("- Output:               {}", outputtime);
@@ -1703,7 +1846,7 @@ void Controller::run(const CommandLineConfig& cmdConfig, SimulConfig& conf) {
                 ++snapshotCounter;
             }
             if(minimizationCounter%minsPerDatadump == 0) {
-                for (auto& o: _outputdump) o->print(0);
+                printDatadump(conf);
             }
             if(minimizationCounter%minsPerSnapshot == 0 || conf.outputParams.logSimulationTimeEachCycle) {
                 log::info(
@@ -1748,8 +1891,7 @@ void Controller::run(const CommandLineConfig& cmdConfig, SimulConfig& conf) {
     }
 
     //print last snapshots
-    for(auto& o: _outputs) o->print(snapshotCounter, conf);
-    output_.append(_subSystem, conf);
+    printOutputs(snapshotCounter, conf);
     
     
     
@@ -1765,6 +1907,7 @@ void Controller::run(const CommandLineConfig& cmdConfig, SimulConfig& conf) {
             _rSnapShot = new RockingSnapshot(rockingsnaphot, &_subSystem, _ffm, k);
             _rSnapShot->savePositions();
             _rSnapShot->print(snapshotCounter);
+            _rSnapShot->writePrinted();
             _rSnapShot->resetPositions();
             _rSnapShot->~RockingSnapshot();
          
@@ -1773,21 +1916,33 @@ void Controller::run(const CommandLineConfig& cmdConfig, SimulConfig& conf) {
         
     };
 
+    // Write all pending snapshots before finishing the trajectory.
+    trajWriter_.flush();
     output_.finish();
 	resetCounters();
     chk2 = chrono::high_resolution_clock::now();
     chrono::duration<floatingpoint> elapsed_run(chk2-chk1);
     cout << "Time elapsed for run: dt=" << elapsed_run.count() << endl;
+    printThreadPoolStats();
+    printSlabPoolStats();
+    _subSystem.pChemSim->printStats();
 	#ifdef OPTIMOUT
     cout<<"Restart time for run=" << elapsed_runRestart.count()<<endl;
     cout<< "Chemistry time for run=" << chemistrytime <<endl;
     cout << "Minimization time for run=" << minimizationtime <<endl;
     cout<< "Neighbor-list+Bmgr-time for run="<<nltime<<endl;
     cout<< "Neighbor-list time for run="<<nl2time<<endl;
+    cout<< "Cylinder neighbor-list rebuilds="<<_subSystem.cylinderNeighborListSkin.stats().numRebuilds
+        <<", skipped="<<_subSystem.cylinderNeighborListSkin.stats().numSkips<<endl;
     cout<< "Bmgr-vec time for run="<<bmgrvectime<<endl;
     cout<< "SIMD time for run="<<SubSystem::SIMDtime<<endl;
     cout<< "HYBD time for run="<<SubSystem::HYBDtime<<endl;
     cout<< "Bmgr time for run="<<bmgrtime<<endl;
+    #ifdef SIMDBINDINGSEARCH
+    cout<< "- Linker Bmgr time for run="<<HybridBindingSearchManager::linkerUpdateTime<<endl;
+    cout<< "- Motor Bmgr time for run="<<HybridBindingSearchManager::motorUpdateTime<<endl;
+    cout<< "- Branching Bmgr time for run="<<SubSystem::branchingUpdateTime<<endl;
+    #endif
     cout<<"update-position time for run="<<updateposition<<endl;
     cout<<"rxnrate time for run="<<rxnratetime<<endl;
     cout<<"Output time for run="<<outputtime<<endl;
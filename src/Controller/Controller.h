@@ -14,6 +14,7 @@
 #ifndef MEDYAN_Controller_h
 #define MEDYAN_Controller_h
 
+#include <filesystem>
 #include <memory> // unique_ptr
 
 #include "common.h"
@@ -31,6 +32,7 @@
 #include "Structure/SurfaceMesh/AdaptiveMesh.hpp"
 #include "Structure/SurfaceMesh/Membrane.hpp"
 #include "Structure/SurfaceMesh/MembraneRegion.hpp"
+#include "Util/AsyncBufferedWriter.hpp"
 
 
 namespace medyan {
@@ -59,9 +61,16 @@ private:
     
     vector<std::unique_ptr< Output >> _outputs; ///< Vector of specified outputs
     vector<std::unique_ptr< Output >> _outputdump; ///<Vector of outputs that correspond to a datadump
+    vector<Output*> readOnlyOutputs_; ///< Buffer of outputs that can be printed concurrently
     // Output for snapshots.
     SnapshotOutput output_;
+    // Writes extracted snapshots to the output files on a background thread.
+    // It is declared after the outputs, so that pending snapshots are written before the outputs are destroyed.
+    AsyncBufferedWriter< SnapshotOutputBuffer > trajWriter_ { 2 };
     RockingSnapshot* _rSnapShot;
+    // Restart checkpoint, written every few data dumps.
+    std::filesystem::path checkpointFile_;
+    Size numDatadumps_ = 0;
 
     floatingpoint _runTime;          ///< Total desired runtime for simulation
 
@@ -135,6 +144,22 @@ private:
     /// Reset counters on all elements in the system
     void resetCounters();
 
+    /// Print all outputs for a snapshot, including the snapshot output.
+    /// Read-only outputs are printed concurrently on the global thread pool.
+    /// The printed data are written to files by the trajectory writer
+    /// asynchronously.
+    void printOutputs(int snapshot, const SimulConfig&);
+
+    /// Print and write the data dumps. A restart checkpoint is also written
+    /// every checkpointInterval data dumps.
+    void printDatadump(const SimulConfig&);
+
+    /// Report busy/idle time and contentions of the global thread pool
+    void printThreadPoolStats();
+
+    /// Report the usage of the slab pools of chemistry objects
+    void printSlabPoolStats();
+
     /// Helper function to remesh the membranes
     void membraneAdaptiveRemesh();
     
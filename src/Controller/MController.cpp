@@ -45,6 +45,12 @@ void MController::initializeMinAlgorithm (const MechParams::MechanicsAlgorithm&
             else if (MAlgorithm.ConjugateGradient == "STEEPESTDESCENT") {
                 return medyan::ConjugateGradientDescentSearch::steepest;
             }
+            else if (MAlgorithm.ConjugateGradient == "LBFGS") {
+                return medyan::ConjugateGradientDescentSearch::lbfgs;
+            }
+            else if (MAlgorithm.ConjugateGradient == "FIRE") {
+                return medyan::ConjugateGradientDescentSearch::fire;
+            }
             else {
                 log::error("Conjugate gradient method not recognized. Exiting.");
                 throw std::runtime_error("Unrecognized conjugate gradient method.");
@@ -58,6 +64,9 @@ void MController::initializeMinAlgorithm (const MechParams::MechanicsAlgorithm&
         MAlgorithm.energyChangeRelativeTolerance,
         0, 10000, true,
         MAlgorithm.tryToRecoverInLineSearchError,
+        MAlgorithm.lbfgsNumHistory,
+        MAlgorithm.fireDtInit,
+        MAlgorithm.fireDtMax,
     };
 
 }
@@ -39,6 +39,17 @@ struct CGInterruptSettings {
 template< typename InterruptFunc >
 CGInterruptSettings(int, int, InterruptFunc) -> CGInterruptSettings<InterruptFunc>;
 
+// Statistics of heap memory used by the buffers that persist across energy minimizations.
+struct MinimizationMemoryStats {
+    Size        numMinimizations = 0;
+    // Bytes newly reserved by the persistent buffers in the last minimization.
+    std::size_t lastBytesAllocated = 0;
+    // Bytes newly reserved by the persistent buffers in all minimizations.
+    std::size_t totalBytesAllocated = 0;
+    // Bytes currently reserved by the persistent buffers.
+    std::size_t bytesReserved = 0;
+};
+
 // Default interruption.
 constexpr CGInterruptSettings defaultCGInterruptSettings { 0, 0, [] {} };
 using DefaultCGInterruptFunc = decltype(defaultCGInterruptSettings.func);
@@ -64,6 +75,14 @@ public:
 private:
     SubSystem* _subSystem; ///< A pointer to the subsystem
 
+    // Serialized degrees of freedom and forces are stored in BeadData, after the bead data.
+
+    // Scratch buffers used in recovering from minimization errors.
+    std::vector<floatingpoint> moveDirFull_;
+    std::vector<floatingpoint> coordPrev_;
+
+    MinimizationMemoryStats memStats_;
+
     /// Initialize the force-fields used in the simualtion
     void initializeFF (const SimulConfig&);
     
@@ -114,13 +133,17 @@ public:
         // Energy minimization
         //-------------------------------------------------
 
+        const auto bytesReservedBefore = bufferCapacityBytes_();
+
         // Before minimization, serialize all the system data and prepare force fields.
-        std::vector<floatingpoint> coord;
-        std::vector<floatingpoint> force;
+        // Bead coordinates and forces are minimized in place.
+        // Vectorization in each interrupt iteration reuses the same buffers.
+        auto& coord = Bead::getBeadData().coords;
+        auto& force = Bead::getBeadData().forces;
         FFCoordinateStartingIndex si {};
 
         const auto callMinimization = [&, this](const ConjugateGradientParams& cgParams) {
-            si = serializeDof(*_subSystem, coord);
+            si = serializeDof(*_subSystem);
             ffm.vectorizeAllForceFields(si, conf);
 
             // Minimize mechanical energy
@@ -156,7 +179,7 @@ public:
             }
 
             // Copy the coordinate and force data back to the system
-            deserializeDof(*_subSystem, coord, force);
+            deserializeDof(*_subSystem);
 
             return res;
         };
@@ -205,6 +228,7 @@ public:
         //-------------------------------------------------
         afterMinimization_(conf, si, coord);
 
+        updateMemoryStats_(bytesReservedBefore);
 
         // Return minimization report
         return res;
@@ -212,9 +236,9 @@ public:
 
     // Will vectorize system and compute energy and force once, but no energy minimization is performed.
     void updateMechanics(const SimulConfig& conf) {
-        std::vector<floatingpoint> coord;
-        std::vector<floatingpoint> force;
-        const auto si = serializeDof(*_subSystem, coord);
+        auto& coord = Bead::getBeadData().coords;
+        auto& force = Bead::getBeadData().forces;
+        const auto si = serializeDof(*_subSystem);
         force.assign(coord.size(), 0);
         ffm.vectorizeAllForceFields(si, conf);
 
@@ -223,7 +247,7 @@ public:
         ffm.computeForces(coord.data(), force.data(), force.size());
 
         // Deserialization.
-        deserializeDof(*_subSystem, coord, force);
+        deserializeDof(*_subSystem);
 
         // After minimization.
         afterMinimization_(conf, si, coord);
@@ -234,8 +258,31 @@ public:
         return &ffm;
     }
 
+    const auto& getMinimizationMemoryStats() const { return memStats_; }
+
 
 private:
+    // Heap memory reserved by all buffers reused across minimizations, in bytes.
+    std::size_t bufferCapacityBytes_() const {
+        const auto& beadData = Bead::getBeadDataConst();
+        return sizeof(floatingpoint) * (beadData.coords.capacity() + beadData.forces.capacity() + moveDirFull_.capacity() + coordPrev_.capacity())
+            + cgMinimizer.capacityBytes()
+            + ffm.vectorizedCapacityBytes();
+    }
+    // Record buffer growth in a minimization.
+    // Buffers never shrink, so any increase of reserved memory comes from new allocations.
+    void updateMemoryStats_(std::size_t bytesReservedBefore) {
+        const auto bytesReserved = bufferCapacityBytes_();
+        ++memStats_.numMinimizations;
+        memStats_.lastBytesAllocated = bytesReserved > bytesReservedBefore ? bytesReserved - bytesReservedBefore : 0;
+        memStats_.totalBytesAllocated += memStats_.lastBytesAllocated;
+        memStats_.bytesReserved = bytesReserved;
+        log::debug(
+            "Minimization {}: {} bytes allocated, {} bytes allocated in total, {} bytes reserved.",
+            memStats_.numMinimizations, memStats_.lastBytesAllocated, memStats_.totalBytesAllocated, memStats_.bytesReserved
+        );
+    }
+
     // Auxiliary function to do computations after minimization.
     void afterMinimization_(const SimulConfig& conf, const FFCoordinateStartingIndex& si, const std::vector<floatingpoint>& coord) {
         // compute the Hessian matrix at this point if the feature is enabled.
@@ -278,13 +325,15 @@ private:
     ) {
         using namespace medyan;
 
-        // Create a temporary vector for pushing forward move direction.
-        auto moveDirFull = moveDir;
+        // Use the scratch vector for pushing forward move direction.
+        auto& moveDirFull = moveDirFull_;
+        moveDirFull.assign(moveDir.begin(), moveDir.end());
         moveDirFull.resize(coord.size());
 
         // Make sure that target coordinates have up-to-date dependent coordinates.
         ffm.computeDependentCoordinates(coord.data());
-        const auto debugCoordPrev = coord;
+        auto& debugCoordPrev = coordPrev_;
+        debugCoordPrev.assign(coord.begin(), coord.end());
 
         // Push forward the move direction to all coordinates.
         ffm.pushForwardIndependentTangentVector(coord.data(), moveDirFull.data());
@@ -82,20 +82,20 @@ FilamentData createFilamentsRandomDist(
 
             //check if within cutoff of boundary
             bool outsideCutoff = false;
-            if(b->distance(vec2Vector(p1)) < SysParams::Boundaries().BoundaryCutoff / 4.0 ||
-               b->distance(vec2Vector(p2)) < SysParams::Boundaries().BoundaryCutoff / 4.0) {
+            if(b->distance(p1) < SysParams::Boundaries().BoundaryCutoff / 4.0 ||
+               b->distance(p2) < SysParams::Boundaries().BoundaryCutoff / 4.0) {
                 outsideCutoff = true;
             }
 
             // Check if filaments need to form rings.
             if(filamentSetup.formRings) {
-                if(b->sidedistance(vec2Vector(p1)) > GController::getSize()[0]/8 ||
-                    b->sidedistance(vec2Vector(p2)) > GController::getSize()[0]/8) {
+                if(b->sidedistance(p1) > GController::getSize()[0]/8 ||
+                    b->sidedistance(p2) > GController::getSize()[0]/8) {
                     outsideCutoff = true;
                 }
             }
 
-            if(b->within(vec2Vector(p1)) && b->within(vec2Vector(p2)) && !inBubble && !outsideCutoff) {
+            if(b->within(p1) && b->within(p2) && !inBubble && !outsideCutoff) {
                 fd.filaments.push_back({ filamentType, { p1, p2 } });
                 filamentCounter++;
             }
@@ -123,8 +123,8 @@ FilamentData createFilamentsRandomDist(
 
             //check if within cutoff of boundary
             bool outsideCutoff = mr.getBoundary() && (
-                mr.getBoundary()->distance(vec2Vector(p1)) < SysParams::Boundaries().BoundaryCutoff / 4.0 ||
-                mr.getBoundary()->distance(vec2Vector(p2)) < SysParams::Boundaries().BoundaryCutoff / 4.0
+                mr.getBoundary()->distance(p1) < SysParams::Boundaries().BoundaryCutoff / 4.0 ||
+                mr.getBoundary()->distance(p2) < SysParams::Boundaries().BoundaryCutoff / 4.0
             );
             
             if(mr.contains(sys, p1) && mr.contains(sys, p2) && !inBubble && !outsideCutoff) {
@@ -202,8 +202,8 @@ FilamentData createFilamentsConnectedDist(
         if(
             mr.contains(sys, firstPoint) && mr.contains(sys, secondPoint) && (
                 !mr.getBoundary() || (
-                    mr.getBoundary()->distance(vec2Vector(firstPoint)) > safeDist &&
-                    mr.getBoundary()->distance(vec2Vector(secondPoint)) > safeDist
+                    mr.getBoundary()->distance(firstPoint) > safeDist &&
+                    mr.getBoundary()->distance(secondPoint) > safeDist
                 )
             )
         ) {
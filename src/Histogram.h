@@ -65,7 +65,7 @@ public:
     }
     
     ///Print the histogram
-    void print(ofstream& outputFile) {
+    void print(ostream& outputFile) {
         
         int bin = 0;
         for(auto freq : _frequencies) {
@@ -45,6 +45,69 @@ inline auto vec2Vector(const VecType& a) {
     return vector<typename VecType::float_type>(a.begin(), a.end());
 }
 
+//-----------------------------------------------------------------------------
+// Fixed size versions of the 3D geometry helpers.
+// They accept any Vec-like object (Vec or VecMap) and return Vec by value, so
+// unlike the vector<floatingpoint> versions, no heap allocation is involved.
+//-----------------------------------------------------------------------------
+template< typename VT1, typename VT2, std::enable_if_t< IsVecLike<VT1>::value && IsVecLike<VT2>::value >* = nullptr >
+constexpr auto twoPointDistancesquared(const VT1& v1, const VT2& v2) {
+    return (v2[0] - v1[0]) * (v2[0] - v1[0])
+        + (v2[1] - v1[1]) * (v2[1] - v1[1])
+        + (v2[2] - v1[2]) * (v2[2] - v1[2]);
+}
+template< typename VT1, typename VT2, std::enable_if_t< IsVecLike<VT1>::value && IsVecLike<VT2>::value >* = nullptr >
+inline auto twoPointDistance(const VT1& v1, const VT2& v2) {
+    return std::sqrt(twoPointDistancesquared(v1, v2));
+}
+
+// Unit vector pointing from v1 to v2.
+template< typename VT1, typename VT2, std::enable_if_t< IsVecLike<VT1>::value && IsVecLike<VT2>::value >* = nullptr >
+inline auto twoPointDirection(const VT1& v1, const VT2& v2) {
+    const auto invD = 1 / twoPointDistance(v1, v2);
+    VecLikeVecType<VT1> res {};
+    for(int i = 0; i < 3; ++i) res[i] = invD * (v2[i] - v1[i]);
+    return res;
+}
+
+template< typename VecType, std::enable_if_t< IsVecLike<VecType>::value >* = nullptr >
+inline auto normalizeVector(const VecType& v) {
+    const auto invNorm = 1 / std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    VecLikeVecType<VecType> res {};
+    for(int i = 0; i < 3; ++i) res[i] = v[i] * invNorm;
+    return res;
+}
+
+template< typename VT1, typename VT2, std::enable_if_t< IsVecLike<VT1>::value && IsVecLike<VT2>::value >* = nullptr >
+constexpr auto dotProduct(const VT1& v1, const VT2& v2) {
+    return v1[0] * v2[0] + v1[1] * v2[1] + v1[2] * v2[2];
+}
+
+template< typename VT1, typename VT2, std::enable_if_t< IsVecLike<VT1>::value && IsVecLike<VT2>::value >* = nullptr >
+constexpr auto crossProduct(const VT1& v1, const VT2& v2) {
+    VecLikeVecType<VT1> res {};
+    res[0] = v1[1] * v2[2] - v1[2] * v2[1];
+    res[1] = v1[2] * v2[0] - v1[0] * v2[2];
+    res[2] = v1[0] * v2[1] - v1[1] * v2[0];
+    return res;
+}
+
+// Point at distance d from the coordinate along the direction tau.
+template< typename VT1, typename VT2, typename Float, std::enable_if_t< IsVecLike<VT1>::value && IsVecLike<VT2>::value >* = nullptr >
+constexpr auto nextPointProjection(const VT1& coordinate, Float d, const VT2& tau) {
+    VecLikeVecType<VT1> res {};
+    for(int i = 0; i < 3; ++i) res[i] = coordinate[i] + d * tau[i];
+    return res;
+}
+
+// Point v on the line between v1 and v2, with |v-v1|/|v2-v1| = alpha.
+template< typename VT1, typename VT2, typename Float, std::enable_if_t< IsVecLike<VT1>::value && IsVecLike<VT2>::value >* = nullptr >
+constexpr auto midPointCoordinate(const VT1& v1, const VT2& v2, Float alpha) {
+    VecLikeVecType<VT1> res {};
+    for(int i = 0; i < 3; ++i) res[i] = v1[i] * (1 - alpha) + alpha * v2[i];
+    return res;
+}
+
 #if !defined(__CUDA_ARCH__) || __CUDA_ARCH__ >= 600
 
 #else
@@ -146,8 +146,8 @@ void boundaryCylinderRepulsionLoadForce(
 
         // Projection magnitude ratio on the direction of the cylinder
         // (Effective monomer size) = (monomer size) * proj
-        const auto proj = std::max< floatingpoint >(-dot(vector2Vec< 3 >(be->normal(vec2Vector(newCoord))), dir), 0.0);
-        const auto loadForce = interaction.loadForces(be->distance(vec2Vector(newCoord)), kRep, screenLen);
+        const auto proj = std::max< floatingpoint >(-dot(be->normal(newCoord), dir), 0.0);
+        const auto loadForce = interaction.loadForces(be->distance(newCoord), kRep, screenLen);
 
         // The load force stored in bead also considers effective monomer size.
         loadForces[i] += proj * loadForce;
@@ -197,25 +197,19 @@ void BoundaryCylinderRepulsion<BRepulsionInteractionType>::computeLoadForces() {
 }
 template< typename InteractionType >
 void BoundaryCylinderRepulsion< InteractionType >::computeLoadForce(SubSystem& sys, Cylinder* c, LoadForceEnd end) const {
-    for (auto be : BoundaryElement::getBoundaryElements()) {
-
-        for(auto cyl : _neighborList->getNeighbors(be)) if(c == cyl) {
-
-            floatingpoint kRep = be->getRepulsionConst();
-            floatingpoint screenLength = be->getScreeningLength();
-
-            boundaryCylinderRepulsionLoadForce(
-                _FFType, kRep, screenLength,
-                (end == LoadForceEnd::Plus ? *c->getFirstBead() : *c->getSecondBead()),
-                (end == LoadForceEnd::Plus ? *c->getSecondBead() : *c->getFirstBead()),
-                end,
-                be
-            );
-
-
-            break;
-
-        }
+    // Only the boundary elements having the cylinder as a neighbor are visited.
+    for (auto be : _neighborList->getBoundaryElements(c)) {
+
+        floatingpoint kRep = be->getRepulsionConst();
+        floatingpoint screenLength = be->getScreeningLength();
+
+        boundaryCylinderRepulsionLoadForce(
+            _FFType, kRep, screenLength,
+            (end == LoadForceEnd::Plus ? *c->getFirstBead() : *c->getSecondBead()),
+            (end == LoadForceEnd::Plus ? *c->getSecondBead() : *c->getFirstBead()),
+            end,
+            be
+        );
 
     }
 }
@@ -96,7 +96,7 @@ void bubbleCylinderRepulsionLoadForce(
         // Projection magnitude ratio on the direction of the cylinder
         // (Effective monomer size) = (monomer size) * proj
         const auto proj = std::max< floatingpoint >(dot(normalizedVector(bubbleCoord - newCoord), dir), 0.0);
-        const auto loadForce = interaction.loadForces(bubbleCoord, bd.coord, radius, kRep, screenLen);
+        const auto loadForce = interaction.loadForces(bubbleCoord, bd.coordinate(), radius, kRep, screenLen);
 
         // The load force stored in bead also considers effective monomer size.
         loadForces[i] += proj * loadForce;
@@ -148,29 +148,24 @@ void BubbleCylinderRepulsion::computeLoadForces() {
     }
 }
 void BubbleCylinderRepulsion::computeLoadForce(SubSystem& sys, Cylinder* c, LoadForceEnd end) const {
-    for (auto& bb : sys.bubbles) {
-        
-        //total number of neighbor cylinders
-        int cmax = sys.opBubbleBeadNL.value().getNeighbors(bb.sysIndex).size();
-        for(int ni = 0; ni < cmax; ni++){
-            
-            floatingpoint kRep = bb.getRepulsionConst();
-            floatingpoint screenLength = bb.getScreeningLength();
-            
-            floatingpoint radius = bb.getRadius();
-            
-            Bead* pb = sys.opBubbleBeadNL.value().getNeighbors(bb.sysIndex)[ni];
-            if(end == LoadForceEnd::Plus ? (c->getSecondBead() == pb) : (c->getFirstBead() == pb)) {
-                bubbleCylinderRepulsionLoadForce(
-                    _FFType, radius, kRep, screenLength,
-                    (end == LoadForceEnd::Plus ? *c->getFirstBead() : *c->getSecondBead()),
-                    *pb,
-                    end,
-                    bb.coord
-                );
-                break;
-            }
-        } // End loop neighbor of bb
+    Bead* pb = (end == LoadForceEnd::Plus ? c->getSecondBead() : c->getFirstBead());
+
+    // Only the bubbles having the tip bead as a neighbor are visited.
+    for (auto bbIndex : sys.opBubbleBeadNL.value().getBubbles(pb)) {
+        auto& bb = sys.bubbles[bbIndex];
+
+        floatingpoint kRep = bb.getRepulsionConst();
+        floatingpoint screenLength = bb.getScreeningLength();
+
+        floatingpoint radius = bb.getRadius();
+
+        bubbleCylinderRepulsionLoadForce(
+            _FFType, radius, kRep, screenLength,
+            (end == LoadForceEnd::Plus ? *c->getFirstBead() : *c->getSecondBead()),
+            *pb,
+            end,
+            bb.coord
+        );
     } // End loop bubbles
 }
 
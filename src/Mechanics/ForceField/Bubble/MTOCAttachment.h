@@ -62,9 +62,9 @@ public:
 
             for(auto pf : mtoc.getFilaments()) {
                 auto& bead = *pf->getMinusEndCylinder()->getFirstBead();
-                coordset[3] = bead.coord[0];
-                coordset[4] = bead.coord[1];
-                coordset[5] = bead.coord[2];
+                coordset[3] = bead.coordinate()[0];
+                coordset[4] = bead.coordinate()[1];
+                coordset[5] = bead.coordinate()[2];
 
                 impl.forces(
                     coordset, forceset,
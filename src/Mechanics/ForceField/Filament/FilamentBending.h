@@ -60,6 +60,12 @@ public:
     virtual void computeForces(FP *coord, FP *f) override;
     
     virtual std::string getName() override {return "FilamentBending";}
+
+    virtual std::size_t vectorizedCapacityBytes() const override {
+        return ForceField::vectorizedCapacityBytes()
+            + beadSet.capacity() * sizeof(int)
+            + (kbend.capacity() + eqt.capacity()) * sizeof(FP);
+    }
 };
 
 } // namespace medyan
@@ -138,6 +138,12 @@ void FilamentStretching<FStretchingInteractionType>::computeForces(FP *coord, FP
 #endif
 }
 
+template <class FStretchingInteractionType>
+bool FilamentStretching<FStretchingInteractionType>::addHessian(const FP* coord, std::vector< Eigen::Triplet<double> >& triplets) const {
+    _FFType.hessian(coord, beadSet.data(), kstr.data(), eql.data(), kstr.size(), triplets);
+    return true;
+}
+
 ///Temlate specializations
 template class FilamentStretching<FilamentStretchingHarmonic>;
 
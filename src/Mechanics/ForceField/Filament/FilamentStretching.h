@@ -55,9 +55,16 @@ public:
     
     virtual FP computeEnergy(FP *coord) override;
     virtual void computeForces(FP *coord, FP *f) override;
+    virtual bool addHessian(const FP* coord, std::vector< Eigen::Triplet<double> >& triplets) const override;
     
     virtual std::string getName() override {return "FilamentStretching";}
 
+    virtual std::size_t vectorizedCapacityBytes() const override {
+        return ForceField::vectorizedCapacityBytes()
+            + beadSet.capacity() * sizeof(int)
+            + (kstr.capacity() + eql.capacity()) * sizeof(FP);
+    }
+
 };
 
 } // namespace medyan
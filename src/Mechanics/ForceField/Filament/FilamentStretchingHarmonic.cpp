@@ -20,6 +20,7 @@
 #include "Bead.h"
 
 #include "MathFunctions.h"
+#include "Mechanics/ForceField/Hessian.hpp"
 
 #ifdef CUDAACCL
 #include "nvToolsExt.h"
@@ -274,4 +275,20 @@ void FilamentStretchingHarmonic::forces(floatingpoint *coord, floatingpoint *f,
     }
 }
 
+void FilamentStretchingHarmonic::hessian(const floatingpoint *coord, const int *beadSet, const floatingpoint *kstr,
+                                         const floatingpoint *eql, int nint,
+                                         std::vector< Eigen::Triplet<double> >& triplets) const {
+
+    const int n = FilamentStretching<FilamentStretchingHarmonic>::n;
+
+    for(int i = 0; i < nint; i += 1) {
+        addHarmonicBondHessian<2>(
+            triplets, coord,
+            { beadSet[n * i], beadSet[n * i + 1] },
+            { -1.0, 1.0 },
+            kstr[i], eql[i]
+        );
+    }
+}
+
 } // namespace medyan
@@ -14,6 +14,10 @@
 #ifndef MEDYAN_FilamentStretchingHarmonic_h
 #define MEDYAN_FilamentStretchingHarmonic_h
 
+#include <vector>
+
+#include <Eigen/SparseCore>
+
 #include "common.h"
 
 namespace medyan {
@@ -29,6 +33,10 @@ public:
 
     void forces(floatingpoint *coord, floatingpoint *f, int *beadSet,
                 floatingpoint *kstr, floatingpoint *eql);
+
+    // Append the Hessian entries of nint interactions to the triplet list.
+    void hessian(const floatingpoint *coord, const int *beadSet, const floatingpoint *kstr,
+                 const floatingpoint *eql, int nint, std::vector< Eigen::Triplet<double> >& triplets) const;
 #ifdef CUDAACCL
     void optimalblocksnthreads(int nint, cudaStream_t stream);
 
@@ -16,6 +16,8 @@
 
 #include <vector>
 
+#include <Eigen/SparseCore>
+
 #include "common.h"
 #include "Mechanics/ForceField/Types.hpp"
 #include "Structure/SubSystem.h"
@@ -59,6 +61,30 @@ public:
     /// forces accordingly.
     virtual void computeForces(floatingpoint *coord, floatingpoint *f) = 0;
 
+    // Ranged evaluation, used for splitting a force field into parts that can be computed on different threads.
+    // Notes:
+    // - A force field supporting ranged evaluation returns the number of interactions, indexed from 0. Otherwise, 0 is returned and the force field can only be evaluated as a whole.
+    // - Ranged evaluations of disjoint ranges may run concurrently. They must only accumulate onto the force array, and must not modify any state shared between ranges.
+    // - Requires valid vectorization.
+    virtual Size numRangedInteractions() const { return 0; }
+    // Compute energy of interactions in [begin, end).
+    virtual floatingpoint computeEnergyRange(floatingpoint* coord, Index begin, Index end) {
+        throw std::runtime_error("Ranged energy computation is not supported in " + getName());
+    }
+    // Compute forces of interactions in [begin, end).
+    virtual void computeForcesRange(floatingpoint* coord, floatingpoint* f, Index begin, Index end) {
+        throw std::runtime_error("Ranged force computation is not supported in " + getName());
+    }
+    // Called after all ranges were evaluated, with the total energy of the force field, to record diagnostics that need all interactions. Not called concurrently.
+    virtual void finishEnergyRanges(floatingpoint* coord, floatingpoint energy) {}
+
+    // Append the analytic Hessian of the energy at coord to the triplet list, as entries (row, column, value). Entries at the same position are summed.
+    // Notes:
+    // - Returns false without adding any entry if the force field does not provide an analytic Hessian, in which case the Hessian is estimated using finite differences of the forces.
+    // - Only used when all coordinates are independent variables.
+    // - Requires valid vectorization.
+    virtual bool addHessian(const floatingpoint* coord, std::vector< Eigen::Triplet<double> >& triplets) const { return false; }
+
     // Some force fields have the knowledge of computing specific dependent variables necessary for this or other force fields to use.
     virtual void computeDependentCoordinates(floatingpoint* coord) const {}
     // Propagate the forces accumulated on dependent coordinates onto independent coordinates using the chain rule.
@@ -85,6 +111,10 @@ public:
     // Force buffer accessor
     const auto& getForceBuffer() const { return forceBuffer_; }
 
+    // Heap memory reserved by the vectorized data of this force field, in bytes.
+    // Vectorized data should be stored in capacity-retaining buffers, so that repeated vectorization does not allocate once the buffers are large enough.
+    virtual std::size_t vectorizedCapacityBytes() const { return forceBuffer_.capacity() * sizeof(floatingpoint); }
+
     /// Get all neighbor lists associated with a ForceField
     virtual std::vector<NeighborList*> getNeighborLists() { return {}; }
 
@@ -27,9 +27,140 @@
 
 namespace medyan {
 
+void ForceFieldManager::setNumThreads(int numThreads) {
+    numThreads_ = std::max(numThreads, 1);
+    threadForceBuffers_.clear();
+    log::debug("Force field evaluation uses {} thread(s).", numThreads_);
+}
 
+void ForceFieldManager::buildParallelWork_() const {
+    parallelWork_.clear();
+    threadWork_.resize(numThreads_);
+    for(auto& tw : threadWork_) tw.clear();
+
+    // Work items are assigned to threads in a round-robin fashion. The assignment only depends on the vectorized system, so that the summation order is reproducible.
+    Index curThread = 0;
+    const auto addWork = [&, this](const ParallelWorkItem_& item) {
+        threadWork_[curThread].push_back(parallelWork_.size());
+        parallelWork_.push_back(item);
+        curThread = (curThread + 1) % numThreads_;
+    };
+    for(Index ffi = 0; ffi < forceFields.size(); ++ffi) {
+        const Size nint = forceFields[ffi]->numRangedInteractions();
+        const Size numParts = std::clamp< Size >(nint / std::max< Size >(minInteractionsPerPart, 1), 1, numThreads_);
+        if(numParts > 1) {
+            for(Index p = 0; p < numParts; ++p) {
+                addWork({ ffi, true, nint * p / numParts, nint * (p + 1) / numParts });
+            }
+        }
+        else {
+            addWork({ ffi, false, 0, 0 });
+        }
+    }
 
+    workEnergies_.assign(parallelWork_.size(), 0);
+}
 
+template< typename Func >
+void ForceFieldManager::runOnAllThreads_(Func&& func) const {
+    ThreadPool::global().parallelFor(0, numThreads_, func);
+}
+
+floatingpoint ForceFieldManager::computeEnergyParallel_(floatingpoint* coord, bool verbose) const {
+    buildParallelWork_();
+
+    runOnAllThreads_([&, this](Index ti) {
+        for(auto wi : threadWork_[ti]) {
+            const auto& w = parallelWork_[wi];
+            auto& ff = *forceFields[w.ffIndex];
+            workEnergies_[wi] = w.ranged ? ff.computeEnergyRange(coord, w.begin, w.end) : ff.computeEnergy(coord);
+        }
+    });
+
+    // Sum up energies in the order of force fields.
+    #ifdef TRACKDIDNOTMINIMIZE
+    SysParams::Mininimization().tempEnergyvec.clear();
+    #endif
+    floatingpoint energy = 0.0;
+    Index wi = 0;
+    for(Index ffi = 0; ffi < forceFields.size(); ++ffi) {
+        auto& ff = *forceFields[ffi];
+        floatingpoint tempEnergy = 0.0;
+        bool invalid = false;
+        bool ranged = false;
+        for(; wi < parallelWork_.size() && parallelWork_[wi].ffIndex == ffi; ++wi) {
+            if(workEnergies_[wi] <= -1) invalid = true;
+            ranged = ranged || parallelWork_[wi].ranged;
+            tempEnergy += workEnergies_[wi];
+        }
+
+        if (verbose) cout << ff.getName() << " energy = " << tempEnergy << endl;
+        if(invalid) {
+            log::error("Energy of system became infinite. Try adjusting minimization parameters.");
+            log::error("The culprit was ... {}", ff.getName());
+
+            ff.whoIsCulprit();
+            return numeric_limits<floatingpoint>::infinity();
+        }
+        else {
+            if(ranged) ff.finishEnergyRanges(coord, tempEnergy);
+            #ifdef TRACKDIDNOTMINIMIZE
+            SysParams::Mininimization().tempEnergyvec.push_back(tempEnergy);
+            #endif
+            energy += tempEnergy;
+        }
+    }
+
+    #ifdef TRACKDIDNOTMINIMIZE
+    SysParams::Mininimization().Energyvec.push_back(SysParams::Mininimization().tempEnergyvec);
+    #endif
+    return energy;
+}
+
+void ForceFieldManager::computeForcesParallel_(floatingpoint* coord, floatingpoint* force, int numVar) {
+    buildParallelWork_();
+    workDurations_.assign(parallelWork_.size(), 0);
+    threadForceBuffers_.resize(numThreads_);
+
+    runOnAllThreads_([&, this](Index ti) {
+        // The calling thread accumulates directly onto the force array, which is already zeroed.
+        floatingpoint* f = force;
+        if(ti > 0) {
+            auto& buffer = threadForceBuffers_[ti];
+            buffer.assign(numVar, 0.0);
+            f = buffer.data();
+        }
+
+        for(auto wi : threadWork_[ti]) {
+            const auto& w = parallelWork_[wi];
+            auto& ff = *forceFields[w.ffIndex];
+            const auto tbegin = chrono::high_resolution_clock::now();
+            if(w.ranged) ff.computeForcesRange(coord, f, w.begin, w.end);
+            else         ff.computeForces(coord, f);
+            const chrono::duration<floatingpoint> elapsed(chrono::high_resolution_clock::now() - tbegin);
+            workDurations_[wi] = elapsed.count();
+        }
+    });
+
+    // Reduce the thread buffers in a fixed order. Each thread works on a contiguous block of variables.
+    runOnAllThreads_([&, this](Index ti) {
+        const Index begin = Index(numVar) * ti / numThreads_;
+        const Index end   = Index(numVar) * (ti + 1) / numThreads_;
+        for(Index bi = 1; bi < numThreads_; ++bi) {
+            const auto& buffer = threadForceBuffers_[bi];
+            for(Index i = begin; i < end; ++i) {
+                force[i] += buffer[i];
+            }
+        }
+    });
+
+    // Record the accumulated time of each force field.
+    auto& individualforces = CUDAcommon::tmin.individualforces;
+    individualforces.resize(forceFields.size(), 0.0);
+    for(Index wi = 0; wi < parallelWork_.size(); ++wi) {
+        individualforces[parallelWork_[wi].ffIndex] += workDurations_[wi];
+    }
+}
 
 
 void ForceFieldManager::vectorizeAllForceFields(const FFCoordinateStartingIndex& si, const SimulConfig& conf) {
@@ -131,6 +262,9 @@ floatingpoint ForceFieldManager::computeEnergy(floatingpoint *coord, bool verbos
 
     short count = 0;
     CUDAcommon::tmin.computeenergycalls++;
+    if(numThreads_ > 1) {
+        return computeEnergyParallel_(coord, verbose);
+    }
     #ifdef TRACKDIDNOTMINIMIZE
     SysParams::Mininimization().tempEnergyvec.clear();
 	#endif
@@ -160,6 +294,9 @@ floatingpoint ForceFieldManager::computeEnergy(floatingpoint *coord, bool verbos
             return numeric_limits<floatingpoint>::infinity();
         }
         else energy += tempEnergy;
+        #ifdef TRACKDIDNOTMINIMIZE
+        SysParams::Mininimization().tempEnergyvec.push_back(tempEnergy);
+        #endif
 #ifdef SERIAL_CUDACROSSCHECK
         cudaDeviceSynchronize();
         resetfloatingpointvariableCUDA<<<1,1,0, streamF>>>(gpu_Uvec);
@@ -267,21 +404,26 @@ void ForceFieldManager::computeForces(floatingpoint *coord, floatingpoint* force
 //    floatingpoint *F_i = new floatingpoint[CGMethod::N];
     short count = 0;
     CUDAcommon::tmin.computeforcescalls++;
-    for (auto &ff : forceFields) {
-        tbegin = chrono::high_resolution_clock::now();
-        ff->computeForces(coord, force);
-        tend = chrono::high_resolution_clock::now();
-        chrono::duration<floatingpoint> elapsed_energy(tend - tbegin);
-        if(CUDAcommon::tmin.individualforces.size() == forceFields.size())
-            CUDAcommon::tmin.individualforces[count]+= elapsed_energy.count();
-        else
-            CUDAcommon::tmin.individualforces.push_back(elapsed_energy.count());
-        count++;
+    if(numThreads_ > 1) {
+        computeForcesParallel_(coord, force, numVar);
+    }
+    else {
+        for (auto &ff : forceFields) {
+            tbegin = chrono::high_resolution_clock::now();
+            ff->computeForces(coord, force);
+            tend = chrono::high_resolution_clock::now();
+            chrono::duration<floatingpoint> elapsed_energy(tend - tbegin);
+            if(CUDAcommon::tmin.individualforces.size() == forceFields.size())
+                CUDAcommon::tmin.individualforces[count]+= elapsed_energy.count();
+            else
+                CUDAcommon::tmin.individualforces.push_back(elapsed_energy.count());
+            count++;
 
 #ifdef ALLSYNC
-        cudaDeviceSynchronize();
+            cudaDeviceSynchronize();
 #endif
 
+        }
     }
 
     // After force computation, propagate all forces accumulated on dependent variables onto the independent variables using the chain rule.
@@ -351,63 +493,110 @@ void ForceFieldManager::assignallforcemags() {
 }
 
 
-void ForceFieldManager::computeHessian(const std::vector<floatingpoint>& allCoord, int total_DOF, float delta) {
-    // store the minimization time and initialize the matrix
-    tauVector.push_back(tau());
-
-    chrono::high_resolution_clock::time_point t0 = chrono::high_resolution_clock::now();
-
-    vector<vector<floatingpoint> > hessianMatrix(total_DOF, vector<floatingpoint>(total_DOF));
-
-    vector<Triplet> tripletList;
-
+void ForceFieldManager::computeForcesOf_(floatingpoint* coord, floatingpoint* force, int numVar, const std::vector<Index>& ffIndices) {
+    if(ffIndices.size() == forceFields.size()) {
+        computeForces(coord, force, numVar);
+        return;
+    }
 
-    // loop through all the coordinates
-    for (auto i = 0; i < total_DOF; i++) {
-        cout<<"i "<<i<<" total_DOF "<<total_DOF<<endl;
+    std::fill(force, force + numVar, 0.0);
+    computeDependentCoordinates(coord);
+    for(auto& m : ps->membranes) {
+        updateGeometryValueWithDerivative(m.getMesh(), coord, surfaceGeometrySettings);
+    }
+    for(auto ffi : ffIndices) {
+        forceFields[ffi]->computeForces(coord, force);
+    }
+    propagateDependentForces(coord, force);
+}
 
-        // create new vectors for the foorces and coordinates
-        vector<floatingpoint> forces_copy_p(allCoord.size());
-        vector<floatingpoint> coord_copy_p = allCoord;
+ForceFieldManager::HessianOperator::HessianOperator(
+    ForceFieldManager& ffm, const std::vector<floatingpoint>& coord, int numDof, floatingpoint delta, bool assembleMatrix
+) :
+    pffm_(&ffm), coord_(coord), numDof_(numDof), delta_(delta), assembled_(assembleMatrix)
+{
+    // Analytic Hessians are in terms of all variables, so they are only used when all variables are independent.
+    const bool allowAnalytic = coord.size() == numDof;
+
+    std::vector<Triplet> triplets;
+    for(Index ffi = 0; ffi < ffm.forceFields.size(); ++ffi) {
+        if(!(allowAnalytic && ffm.forceFields[ffi]->addHessian(coord.data(), triplets))) {
+            fdForceFields_.push_back(ffi);
+        }
+    }
 
-        vector<floatingpoint> forces_copy_m(allCoord.size());
-        vector<floatingpoint> coord_copy_m = allCoord;
+    const int numVar = coord.size();
+    coordBuffer_ = coord;
+    forceP_.resize(numVar);
+    forceM_.resize(numVar);
+
+    if(assembled_ && !fdForceFields_.empty()) {
+        for(Index i = 0; i < numDof_; ++i) {
+            // Perturb the coordinate i.
+            coordBuffer_[i] = coord[i] + delta;
+            ffm.computeForcesOf_(coordBuffer_.data(), forceP_.data(), numVar, fdForceFields_);
+            coordBuffer_[i] = coord[i] - delta;
+            ffm.computeForcesOf_(coordBuffer_.data(), forceM_.data(), numVar, fdForceFields_);
+            coordBuffer_[i] = coord[i];
+
+            // Forces not depending on the coordinate i are computed from the same values, so their differences are exactly zero.
+            for(Index j = 0; j < numDof_; ++j) {
+                const double hij = -(forceP_[j] - forceM_[j]) / (2 * delta);
+                if(hij != 0) triplets.emplace_back(i, j, hij);
+            }
+        }
+    }
 
-        // perturb the coordinate i
-        coord_copy_p[i] += delta;
-        coord_copy_m[i] -= delta;
+    // The finite difference estimate is not exactly symmetric.
+    Eigen::SparseMatrix<double> hessMat(numDof_, numDof_);
+    hessMat.setFromTriplets(triplets.begin(), triplets.end());
+    matrix_ = 0.5 * (Eigen::SparseMatrix<double>(hessMat.transpose()) + hessMat);
+}
 
-        // calculate the new forces based on perturbation
-        computeForces(coord_copy_p.data(), forces_copy_p.data(), forces_copy_p.size());
-        computeForces(coord_copy_m.data(), forces_copy_m.data(), forces_copy_p.size());
+void ForceFieldManager::HessianOperator::perform_op(const Scalar* x, Scalar* y) const {
+    Eigen::Map<Eigen::VectorXd>(y, numDof_).noalias() = matrix_ * Eigen::Map<const Eigen::VectorXd>(x, numDof_);
+    if(assembled_ || fdForceFields_.empty()) return;
+
+    // Directional derivative of the forces along x. The step is scaled such that
+    // the largest perturbation of a coordinate is delta, as in the assembled matrix.
+    double maxAbs = 0;
+    for(Index i = 0; i < numDof_; ++i) maxAbs = std::max(maxAbs, std::abs(x[i]));
+    if(maxAbs == 0) return;
+    const double h = delta_ / maxAbs;
+
+    const int numVar = coord_.size();
+    for(Index i = 0; i < numDof_; ++i) coordBuffer_[i] = coord_[i] + h * x[i];
+    pffm_->computeForcesOf_(coordBuffer_.data(), forceP_.data(), numVar, fdForceFields_);
+    for(Index i = 0; i < numDof_; ++i) coordBuffer_[i] = coord_[i] - h * x[i];
+    pffm_->computeForcesOf_(coordBuffer_.data(), forceM_.data(), numVar, fdForceFields_);
+
+    for(Index i = 0; i < numDof_; ++i) {
+        y[i] -= (forceP_[i] - forceM_[i]) / (2 * h);
+    }
+}
 
-        for (auto j = 0; j < total_DOF; j++) {
+void ForceFieldManager::computeHessian(const std::vector<floatingpoint>& allCoord, int total_DOF, float delta) {
+    // store the minimization time
+    tauVector.push_back(tau());
 
-            // store the derivative of the force on each coordinate j
-            float h_i_j = -(forces_copy_p[j] - forces_copy_m[j]) / (2 * delta);
-            hessianMatrix[i][j] = h_i_j;
-            tripletList.push_back(Triplet(i, j, h_i_j));
+    const auto& mechParams = SysParams::Mechanics();
+    chrono::high_resolution_clock::time_point t0 = chrono::high_resolution_clock::now();
 
-        }
+    // The matrix is only assembled if it is printed or used by the dense eigen solver.
+    const bool assembleMatrix = mechParams.hessMatrixPrintBool || (mechParams.eigenTracking && mechParams.denseEstimationBool);
+    HessianOperator hessOp(*this, allCoord, total_DOF, delta, assembleMatrix);
+    log::debug("Hessian: {} of {} force fields use finite differences.", hessOp.numFiniteDifferenceForceFields(), forceFields.size());
 
+    const auto& hessMatSym = hessOp.matrix();
+    if(mechParams.hessMatrixPrintBool) {
+        hessianVector.push_back(hessMatSym);
     }
 
-
-    // store the full matrix in list
-    hessianVector.push_back(hessianMatrix);
-
-    if(SysParams::Mechanics().eigenTracking) {
-        // create symmetrized sparse matrix object
-        Eigen::SparseMatrix<double> hessMat(total_DOF, total_DOF), hessMatSym;
-        hessMat.setFromTriplets(tripletList.begin(), tripletList.end());
-        hessMatSym = 0.5 * (Eigen::SparseMatrix<double>(hessMat.transpose()) + hessMat);
-
+    if(mechParams.eigenTracking) {
         chrono::high_resolution_clock::time_point t1 = chrono::high_resolution_clock::now();
         chrono::duration<floatingpoint> elapsed_vecmat(t1 - t0);
 
-        bool denseEstimationBool = SysParams::Mechanics().denseEstimationBool;
-
-        if (denseEstimationBool) {
+        if (mechParams.denseEstimationBool) {
 
             Eigen::MatrixXd denseHessMatSym;
             denseHessMatSym = Eigen::MatrixXd(hessMatSym);
@@ -417,34 +606,27 @@ void ForceFieldManager::computeHessian(const std::vector<floatingpoint>& allCoor
 
         } else {
 
-            Spectra::SparseSymShiftSolve<double> op(hessMatSym);
-            //Spectra::SparseSymMatProd<double> op(hessMatSym);
-            int numEigs = total_DOF - 1;
-            Spectra::SymEigsShiftSolver<Spectra::SparseSymShiftSolve<double>> eigs(op,
-                                                                                                                   numEigs,
-                                                                                                                   total_DOF,
-                                                                                                                   10000);
-            //Spectra::SymEigsSolver<double, Spectra::LARGEST_MAGN, Spectra::SparseSymMatProd<double>> eigs(&op, numEigs, numEigs+1);
-            /*
-            if(evectors.size()!=0){
-                //const Eigen::Matrix<double, Eigen::Dynamic, 1> init_vec = evectors.col(0).real();
-                const Eigen::Matrix<double, Eigen::Dynamic, 1> init_vec = evectors.real().rowwise().sum();
-                if(init_vec.size() == total_DOF){
-                    const double * arg = init_vec.data();
-                    eigs.init(arg);
-                    //eigs.init();
-                }else{
-                    eigs.init();
-                };
-            }else{
-                eigs.init();
-            }*/
+            // Only a bounded number of the smallest eigenpairs are computed, so that
+            // the Krylov subspace and the eigenvectors take O(DOF) memory per vector
+            // instead of O(DOF^2).
+            //
+            // The Lanczos iterations only use Hessian-vector products, so the matrix
+            // is not assembled unless it is printed. Unlike the former shift-invert
+            // mode (with sigma = 10000), this needs no factorization of the matrix,
+            // but the smallest eigenvalues may take more iterations to converge, so
+            // the number of iterations is bounded explicitly.
+            const int numEigs = std::max(1, std::min(mechParams.hessNumEigs, total_DOF - 1));
+            const int numKrylov = std::min(total_DOF, std::max(2 * numEigs + 1, 20));
+            Spectra::SymEigsSolver<HessianOperator> eigs(hessOp, numEigs, numKrylov);
 
             eigs.init();
-            int nconv = eigs.compute(Spectra::SortRule::SmallestAlge);
+            const int nconv = eigs.compute(Spectra::SortRule::SmallestAlge, hessEigsMaxIterations);
+            if(eigs.info() != Spectra::CompInfo::Successful) {
+                log::warn("Hessian: only {} of {} eigenpairs converged.", nconv, numEigs);
+            }
             evalues = eigs.eigenvalues();
             //columns of evectors matrix are the normalized eigenvectors
-            evectors = eigs.eigenvectors(numEigs);
+            evectors = eigs.eigenvectors();
         };
 
         chrono::high_resolution_clock::time_point t2 = chrono::high_resolution_clock::now();
@@ -473,12 +655,8 @@ void ForceFieldManager::computeHessian(const std::vector<floatingpoint>& allCoor
         chrono::high_resolution_clock::time_point t3 = chrono::high_resolution_clock::now();
         chrono::duration<floatingpoint> elapsed_vecPR(t3 - t2);
 
-        cout << "DOF is " << total_DOF << endl;
-        std::cout << "Matrix time " << elapsed_vecmat.count() << endl;
-        std::cout << "Compute time " << elapsed_veceigs.count() << endl;
-        std::cout << "PR time " << elapsed_vecPR.count() << endl;
-
-
+        log::debug("Hessian: DOF is {}. Matrix time {}, compute time {}, PR time {}.",
+            total_DOF, elapsed_vecmat.count(), elapsed_veceigs.count(), elapsed_vecPR.count());
 
         // store the eigenvalues in list
         IPRIVector.push_back(IPRI);
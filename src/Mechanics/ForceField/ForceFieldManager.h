@@ -20,9 +20,6 @@
 #include <Eigen/SparseCore>
 #include <Eigen/Dense>
 #include <Spectra/SymEigsSolver.h>
-#include <Spectra/MatOp/SparseSymMatProd.h>
-#include <Spectra/SymEigsShiftSolver.h>
-#include <Spectra/MatOp/SparseSymShiftSolve.h>
 #include <unordered_map>
 
 #include "common.h"
@@ -30,6 +27,7 @@
 #include "Mechanics/ForceField/Types.hpp"
 #include "Structure/SubSystem.h"
 #include "Structure/SurfaceMesh/FuncMembraneGeo.hpp"
+#include "Util/ThreadPool.hpp"
 
 
 namespace medyan {
@@ -60,9 +58,27 @@ public:
     // Accessors to force fields.
     auto& getForceFields() const { return forceFields; }
 
+    // Set the number of threads used in energy and force computations.
+    // With more than 1 thread, force fields are distributed among the threads, and large force fields supporting ranged evaluation are further split into parts.
+    // Each thread accumulates forces in its own buffer, and the buffers are reduced in a fixed order, so the results are deterministic for a given number of threads.
+    // The work is run on the global thread pool.
+    void setNumThreads(int numThreads);
+    int getNumThreads() const { return numThreads_; }
+
+    // Minimum number of interactions in each part, when a force field is split for parallel evaluation.
+    Size minInteractionsPerPart = 512;
+
     /// Vectorize all interactions involved in calculation
     void vectorizeAllForceFields(const FFCoordinateStartingIndex&, const SimulConfig&);
 
+    // Heap memory reserved by the vectorized data of all force fields and the parallel evaluation buffers, in bytes.
+    std::size_t vectorizedCapacityBytes() const {
+        std::size_t res = 0;
+        for(auto& pff : forceFields) res += pff->vectorizedCapacityBytes();
+        for(auto& buffer : threadForceBuffers_) res += buffer.capacity() * sizeof(floatingpoint);
+        return res;
+    }
+
     // Auxiliary function to update dependent coordinates.
     void computeDependentCoordinates(floatingpoint* coord) const {
         for(auto& pff : forceFields) {
@@ -122,7 +138,57 @@ public:
     // numVar is the number of all variables, including independent and dependent variables.
     void computeForces(floatingpoint *coord, floatingpoint* force, int numVar);
     
+    // The Hessian of the total energy at given coordinates, as a linear operator on the independent variables.
+    //
+    // Force fields providing analytic Hessians contribute a sparse matrix. For other force fields, there are two modes:
+    // - If the matrix is assembled, their Hessian is estimated column by column from central differences of their forces, which costs 2 evaluations of these force fields per degree of freedom, and the total matrix is symmetrized.
+    // - Otherwise, the products with their Hessian are estimated from central differences of their forces along the vector, which costs 2 evaluations of these force fields per product regardless of the number of degrees of freedom. The product is symmetric up to the truncation error of the central differences, which is of second order in delta.
+    // The operator can be used by the Spectra eigen solvers.
+    class HessianOperator {
+    public:
+        using Scalar = double;
+
+        // Requires valid vectorization.
+        HessianOperator(ForceFieldManager& ffm, const std::vector<floatingpoint>& coord, int numDof, floatingpoint delta, bool assembleMatrix = true);
+
+        Eigen::Index rows() const { return numDof_; }
+        Eigen::Index cols() const { return numDof_; }
+
+        // Compute y = H x.
+        void perform_op(const Scalar* x, Scalar* y) const;
+
+        // Whether the full matrix is assembled.
+        bool isAssembled() const { return assembled_; }
+        // The symmetrized sparse matrix. Entries of the finite difference part that are exactly zero are not stored.
+        // If the matrix is not assembled, only the analytic part is included.
+        const Eigen::SparseMatrix<double>& matrix() const { return matrix_; }
+
+        // Number of force fields whose Hessian is estimated using finite differences.
+        Size numFiniteDifferenceForceFields() const { return fdForceFields_.size(); }
+
+    private:
+        ForceFieldManager* pffm_ = nullptr;
+        std::vector<floatingpoint> coord_;
+        int numDof_ = 0;
+        floatingpoint delta_ = 0;
+        bool assembled_ = true;
+
+        // Symmetrized sum of the analytic and (if assembled) finite difference Hessians.
+        Eigen::SparseMatrix<double> matrix_;
+        // Indices of force fields without analytic Hessians.
+        std::vector<Index> fdForceFields_;
+
+        // Buffers for the matrix-free products.
+        mutable std::vector<floatingpoint> coordBuffer_;
+        mutable std::vector<floatingpoint> forceP_;
+        mutable std::vector<floatingpoint> forceM_;
+    };
+
+    // Max number of restarts of the Lanczos iterations for the Hessian eigenpairs.
+    static constexpr int hessEigsMaxIterations = 1000;
+
     // Compute the Hessian matrix if the feature is enabled.
+    // The sparse matrix is stored if it is to be printed, and the eigenvalues are computed if eigen tracking is enabled.
     // Requires valid vectorization.
     void computeHessian(const std::vector<floatingpoint>& coord, int total_DOF, float delta);
     
@@ -148,7 +214,8 @@ public:
     
     vector<floatingpoint> HRMDenergies;
     
-    vector<vector<vector<floatingpoint>>> hessianVector;
+    // Symmetrized sparse Hessian matrices.
+    vector<Eigen::SparseMatrix<double>> hessianVector;
     
     vector<Eigen::VectorXcd> evaluesVector;
     vector<Eigen::VectorXcd> IPRIVector;
@@ -212,7 +279,38 @@ public:
     void assignallforcemags();
 
 private:
+    // A unit of work in parallel evaluation.
+    struct ParallelWorkItem_ {
+        Index ffIndex = 0;
+        // Whether only interactions in [begin, end) are evaluated. Otherwise, the whole force field is evaluated.
+        bool  ranged = false;
+        Index begin = 0;
+        Index end = 0;
+    };
+
     chrono::high_resolution_clock::time_point tbegin, tend;
+
+    // Parallel evaluation.
+    int numThreads_ = 1;
+    // Work items sorted by force field index, and the indices of work items assigned to each thread.
+    mutable std::vector< ParallelWorkItem_ > parallelWork_;
+    mutable std::vector< std::vector< Index > > threadWork_;
+    mutable std::vector< floatingpoint > workEnergies_;
+    std::vector< floatingpoint > workDurations_;
+    // Force accumulation buffers for threads other than the calling thread.
+    std::vector< std::vector< floatingpoint > > threadForceBuffers_;
+
+    // Distribute force field evaluations to all threads.
+    void buildParallelWork_() const;
+    // Run func(threadIndex) for every thread index on the global thread pool, and wait for all of them to finish.
+    template< typename Func >
+    void runOnAllThreads_(Func&& func) const;
+
+    floatingpoint computeEnergyParallel_(floatingpoint* coord, bool verbose) const;
+    void computeForcesParallel_(floatingpoint* coord, floatingpoint* force, int numVar);
+
+    // Compute the forces of the force fields with given indices only, including the dependent variable computation and force propagation.
+    void computeForcesOf_(floatingpoint* coord, floatingpoint* force, int numVar, const std::vector<Index>& ffIndices);
 };
 
 } // namespace medyan
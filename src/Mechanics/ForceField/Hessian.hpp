@@ -0,0 +1,64 @@
+#ifndef MEDYAN_Mechanics_ForceField_Hessian_hpp
+#define MEDYAN_Mechanics_ForceField_Hessian_hpp
+
+// Defines auxiliary functions for force fields to provide analytic Hessian matrices.
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <Eigen/SparseCore>
+
+#include "common.h"
+
+namespace medyan {
+
+// Add the Hessian of a harmonic bond U = k/2 (|r| - l)^2 to the triplet list.
+//
+// The bond vector is r = sum_a c_a x_a, where x_a is the 3D point starting at
+// coordinate index indices[a], and c_a is its coefficient. For example, a bond
+// between 2 beads has coefficients (-1, 1), and a bond between points on 2
+// cylinders has coefficients (-(1-pos1), -pos1, 1-pos2, pos2).
+//
+// With u = r / |r|, the Hessian with respect to r is
+//     K = k [ (l / |r|) u u^T + (1 - l / |r|) I ],
+// and the block for points a and b is c_a c_b K.
+template< std::size_t n >
+inline void addHarmonicBondHessian(
+    std::vector< Eigen::Triplet<double> >& triplets,
+    const floatingpoint*                   coord,
+    const std::array< int, n >&            indices,
+    const std::array< double, n >&         coeffs,
+    double                                 k,
+    double                                 l
+) {
+    double r[3] {};
+    for(std::size_t a = 0; a < n; ++a) {
+        for(int dim = 0; dim < 3; ++dim) r[dim] += coeffs[a] * coord[indices[a] + dim];
+    }
+    const double dist = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+    const double ratio = l / dist;
+
+    double mat[3][3];
+    for(int i = 0; i < 3; ++i) {
+        for(int j = 0; j < 3; ++j) {
+            mat[i][j] = k * (ratio * r[i] * r[j] / (dist * dist) + (i == j ? 1 - ratio : 0));
+        }
+    }
+
+    for(std::size_t a = 0; a < n; ++a) {
+        for(std::size_t b = 0; b < n; ++b) {
+            const double cc = coeffs[a] * coeffs[b];
+            if(cc == 0) continue;
+            for(int i = 0; i < 3; ++i) {
+                for(int j = 0; j < 3; ++j) {
+                    triplets.emplace_back(indices[a] + i, indices[b] + j, cc * mat[i][j]);
+                }
+            }
+        }
+    }
+}
+
+} // namespace medyan
+
+#endif
@@ -184,6 +184,12 @@ void LinkerStretching<LStretchingInteractionType>::computeForces(FP *coord, FP *
 }
 
 
+template <class LStretchingInteractionType>
+bool LinkerStretching<LStretchingInteractionType>::addHessian(const FP* coord, std::vector< Eigen::Triplet<double> >& triplets) const {
+    _FFType.hessian(coord, beadSet.data(), kstr.data(), eql.data(), pos1.data(), pos2.data(), kstr.size(), triplets);
+    return true;
+}
+
 // Explicit instantiation.
 template class LinkerStretching<LinkerStretchingHarmonic>;
 
@@ -19,6 +19,7 @@
 #include "Bead.h"
 
 #include "MathFunctions.h"
+#include "Mechanics/ForceField/Hessian.hpp"
 #include "Cylinder.h"
 #ifdef CUDAACCL
 #include <cuda.h>
@@ -335,4 +336,21 @@ floatingpoint LinkerStretchingHarmonic::energy(floatingpoint *coord, int *beadSe
         delete [] v2;
     }
 
+void LinkerStretchingHarmonic::hessian(const floatingpoint *coord, const int *beadSet, const floatingpoint *kstr,
+                    const floatingpoint *eql, const floatingpoint *pos1, const floatingpoint *pos2, int nint,
+                    std::vector< Eigen::Triplet<double> >& triplets) const {
+
+    const int n = LinkerStretching<LinkerStretchingHarmonic>::n;
+
+    for(int i = 0; i < nint; i += 1) {
+        // The bond connects the points at pos1 on the first cylinder and at pos2 on the second cylinder.
+        addHarmonicBondHessian<4>(
+            triplets, coord,
+            { beadSet[n * i], beadSet[n * i + 1], beadSet[n * i + 2], beadSet[n * i + 3] },
+            { -(1 - pos1[i]), -pos1[i], 1 - pos2[i], pos2[i] },
+            kstr[i], eql[i]
+        );
+    }
+}
+
 } // namespace medyan
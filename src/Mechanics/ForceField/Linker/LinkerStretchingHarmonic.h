@@ -14,6 +14,10 @@
 #ifndef MEDYAN_LinkerStretchingHarmonic_h
 #define MEDYAN_LinkerStretchingHarmonic_h
 
+#include <vector>
+
+#include <Eigen/SparseCore>
+
 #include "common.h"
 
 namespace medyan {
@@ -30,6 +34,11 @@ public:
     void forces(floatingpoint *coord, floatingpoint *f, int *beadSet,
                 floatingpoint *kstr, floatingpoint *eql, floatingpoint *pos1, floatingpoint *pos2, floatingpoint
                 *stretchforce);
+
+    // Append the Hessian entries of nint interactions to the triplet list.
+    void hessian(const floatingpoint *coord, const int *beadSet, const floatingpoint *kstr,
+                 const floatingpoint *eql, const floatingpoint *pos1, const floatingpoint *pos2, int nint,
+                 std::vector< Eigen::Triplet<double> >& triplets) const;
 #ifdef CUDAACCL
     void optimalblocksnthreads(int nint, cudaStream_t stream);
 
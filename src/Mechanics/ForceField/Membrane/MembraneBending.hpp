@@ -29,6 +29,9 @@ struct MembraneBending : public ForceField {
     bool diminishBorderCurvatureMismatch = true;
     double molDiffuseDistance = 25;
 
+    // Total number of vertices in all membranes, found during vectorization.
+    Size numVerticesTotal = 0;
+
 
     virtual std::string getName() override { return "MembraneBending"; }
 
@@ -42,6 +45,7 @@ struct MembraneBending : public ForceField {
         for(auto& m : ps->membranes) {
             numVertices += m.getMesh().numVertices();
         }
+        numVerticesTotal = numVertices;
 
         const int numCMSpecies = ps->proteinCurvatureMismatchParams.size();
         ps->allVertexCurvatureMismatchParams.resize(numCMSpecies, numVertices);
@@ -141,12 +145,23 @@ struct MembraneBending : public ForceField {
     }
 
     virtual FP computeEnergy(FP *coord) override {
+        return computeEnergyRange(coord, 0, numVerticesTotal);
+    }
+
+    virtual void computeForces(FP *coord, FP *force) override {
+        computeForcesRange(coord, force, 0, numVerticesTotal);
+    }
+
+    // Ranged evaluation over vertices of all membranes.
+    virtual Size numRangedInteractions() const override { return numVerticesTotal; }
+
+    virtual FP computeEnergyRange(FP *coord, Index begin, Index end) override {
         using namespace std;
 
         auto& cmParams = ps->allVertexCurvatureMismatchParams;
 
         double en = 0;
-        int vertexIndex = 0;
+        Index vertexOffset = 0;
 
         for (auto& m : ps->membranes) {
             const auto &mesh = m.getMesh();
@@ -155,7 +170,14 @@ struct MembraneBending : public ForceField {
             const auto kBending = m.mMembrane.kBending;
             const auto eqCurv   = m.mMembrane.eqCurv;
 
-            for (const auto &v : mesh.getVertices()) {
+            // Only vertices within the range are evaluated.
+            const Size numVertices = mesh.numVertices();
+            const Index ibegin = std::clamp< Index >(begin - vertexOffset, 0, numVertices);
+            const Index iend   = std::clamp< Index >(end   - vertexOffset, 0, numVertices);
+
+            for (Index i = ibegin; i < iend; ++i) {
+                const auto& v = mesh.getVertices()[i];
+                const Index vertexIndex = vertexOffset + i;
                 double enVertex = 0;
 
                 if (v.numTargetingBorderHalfEdges == 0) {
@@ -220,22 +242,22 @@ struct MembraneBending : public ForceField {
                 else {
                     en += enVertex;
                 }
-
-                ++vertexIndex;
             }
 
+            vertexOffset += numVertices;
+
         } // End for membrane
 
         return en;
     }
 
-    virtual void computeForces(FP *coord, FP *force) override {
+    virtual void computeForcesRange(FP *coord, FP *force, Index begin, Index end) override {
         using namespace std;
         using MT = Membrane::MeshType;
 
         auto& cmParams = ps->allVertexCurvatureMismatchParams;
 
-        int vertexIndex = 0;
+        Index vertexOffset = 0;
 
         for (auto& m : ps->membranes) {
 
@@ -248,9 +270,14 @@ struct MembraneBending : public ForceField {
             const auto kBending = m.mMembrane.kBending;
             const auto eqCurv   = m.mMembrane.eqCurv;
 
+            // Only vertices within the range are evaluated.
             const Size numVertices = mesh.numVertices();
-            for (Index i = 0; i < numVertices; ++i) {
+            const Index ibegin = std::clamp< Index >(begin - vertexOffset, 0, numVertices);
+            const Index iend   = std::clamp< Index >(end   - vertexOffset, 0, numVertices);
+
+            for (Index i = ibegin; i < iend; ++i) {
                 MT::VertexIndex vi {i};
+                const Index vertexIndex = vertexOffset + i;
                 if (!mesh.isVertexOnBorder(vi)) {
                     const auto &va = mesh.attribute(vi);
 
@@ -341,10 +368,10 @@ struct MembraneBending : public ForceField {
                         }
                     }
                 }
-
-                ++vertexIndex;
             }
 
+            vertexOffset += numVertices;
+
         } // End for membrane
 
     }
@@ -81,11 +81,22 @@ struct MembraneStretchingLocal : public ForceField {
     }
 
     virtual FP computeEnergy(FP* coord) override {
+        return computeEnergyRange(coord, 0, vertexSet.size());
+    }
+
+    virtual void computeForces(FP* coord, FP* force) override {
+        computeForcesRange(coord, force, 0, vertexSet.size());
+    }
+
+    // Ranged evaluation over the entries of vertexSet, which skips triangles touching a reservoir border.
+    virtual Size numRangedInteractions() const override { return vertexSet.size(); }
+
+    virtual FP computeEnergyRange(FP* coord, Index begin, Index end) override {
         using namespace std;
 
         double en = 0;
 
-        for(Index i = 0; i < vertexSet.size(); ++i) {
+        for(Index i = begin; i < end; ++i) {
             const auto& vs = vertexSet[i];
             const auto enTriangle = impl.energy(
                 medyan::area(
@@ -111,10 +122,10 @@ struct MembraneStretchingLocal : public ForceField {
         return en;
     }
 
-    virtual void computeForces(FP* coord, FP* force) override {
+    virtual void computeForcesRange(FP* coord, FP* force, Index begin, Index end) override {
         using namespace std;
 
-        for(Index i = 0; i < vertexSet.size(); ++i) {
+        for(Index i = begin; i < end; ++i) {
             const auto& vs = vertexSet[i];
             const auto rv0 = makeRefVec<3>(coord + vs[0]);
             const auto rv1 = makeRefVec<3>(coord + vs[1]);
@@ -194,6 +194,12 @@ void MotorGhostStretching<MStretchingInteractionType>::computeForces(FP *coord,
 #endif
 }
 
+template <class MStretchingInteractionType>
+bool MotorGhostStretching<MStretchingInteractionType>::addHessian(const FP* coord, std::vector< Eigen::Triplet<double> >& triplets) const {
+    _FFType.hessian(coord, beadSet.data(), kstr.data(), eql.data(), pos1.data(), pos2.data(), kstr.size(), triplets);
+    return true;
+}
+
 // Explicit instantiation.
 template class MotorGhostStretching<MotorGhostStretchingHarmonic>;
 
@@ -64,10 +64,17 @@ public:
     
     virtual FP computeEnergy(FP *coord) override;
     virtual void computeForces(FP *coord, FP *f) override;
+    virtual bool addHessian(const FP* coord, std::vector< Eigen::Triplet<double> >& triplets) const override;
 
 
     virtual std::string getName() override { return "MotorStretching"; }
 
+    virtual std::size_t vectorizedCapacityBytes() const override {
+        return ForceField::vectorizedCapacityBytes()
+            + beadSet.capacity() * sizeof(int)
+            + (kstr.capacity() + eql.capacity() + pos1.capacity() + pos2.capacity() + stretchforce.capacity()) * sizeof(FP);
+    }
+
     virtual void assignforcemags() override;
 
 };
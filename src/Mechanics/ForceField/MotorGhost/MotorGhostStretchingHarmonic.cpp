@@ -17,6 +17,7 @@
 #include "MotorGhostStretchingHarmonicCUDA.h"
 #include "Bead.h"
 #include "MathFunctions.h"
+#include "Mechanics/ForceField/Hessian.hpp"
 #include "common.h"
 #include "Cylinder.h"
 #include "Filament.h"
@@ -388,4 +389,21 @@ void MotorGhostStretchingHarmonic::forces(floatingpoint *coord, floatingpoint *f
 
 }
 
+void MotorGhostStretchingHarmonic::hessian(const floatingpoint *coord, const int *beadSet, const floatingpoint *kstr,
+                    const floatingpoint *eql, const floatingpoint *pos1, const floatingpoint *pos2, int nint,
+                    std::vector< Eigen::Triplet<double> >& triplets) const {
+
+    const int n = MotorGhostStretching<MotorGhostStretchingHarmonic>::n;
+
+    for(int i = 0; i < nint; i += 1) {
+        // The bond connects the points at pos1 on the first cylinder and at pos2 on the second cylinder.
+        addHarmonicBondHessian<4>(
+            triplets, coord,
+            { beadSet[n * i], beadSet[n * i + 1], beadSet[n * i + 2], beadSet[n * i + 3] },
+            { -(1 - pos1[i]), -pos1[i], 1 - pos2[i], pos2[i] },
+            kstr[i], eql[i]
+        );
+    }
+}
+
 } // namespace medyan
@@ -30,7 +30,7 @@ struct BeadMoveConstraintFF : ForceField {
         initPos.reserve(Bead::getBeads().size());
         for(auto pb : Bead::getBeads()) {
             beadSet.push_back(findBeadCoordIndex(*pb, si));
-            initPos.push_back(pb->coord);
+            initPos.push_back(pb->coordinate());
         }
     }
 
@@ -31,6 +31,7 @@
 
 #include "CylinderExclVolRepulsion.h"
 #include "CylinderExclVolRepulsionCUDA.h"
+#include "CylinderExclVolRepulsionSIMD.h"
 #include "CylinderExclVolume.h"
 
 #include "Bead.h"
@@ -327,7 +328,140 @@ void CylinderExclVolRepulsion::checkforculprit() {
 }
 
 #endif
-floatingpoint CylinderExclVolRepulsion::energy(floatingpoint *coord, const int *beadSet, const floatingpoint *krep, const floatingpoint* eqLengths, int nint) {
+
+namespace {
+
+// Batched kernel functions, with zero width for the scalar kernel.
+struct SimdKernelFuncs {
+    int                              width = 0;
+    cyl_excl_vol_simd::EnergiesFunc  energies = nullptr;
+    cyl_excl_vol_simd::ForcesFunc    forces = nullptr;
+};
+
+SimdKernelFuncs simdKernelFuncs(CylinderExclVolRepulsion::Kernel kernel) {
+    using Kernel = CylinderExclVolRepulsion::Kernel;
+    switch(kernel) {
+#ifdef MEDYAN_CYLINDER_EXCL_VOL_SIMD
+        case Kernel::avx2:
+            return { cyl_excl_vol_simd::avx2::width, cyl_excl_vol_simd::avx2::energies, cyl_excl_vol_simd::avx2::forces };
+        case Kernel::avx512:
+            return { cyl_excl_vol_simd::avx512::width, cyl_excl_vol_simd::avx512::energies, cyl_excl_vol_simd::avx512::forces };
+#endif
+        default:
+            return {};
+    }
+}
+
+} // namespace
+
+bool CylinderExclVolRepulsion::isKernelSupported(Kernel kernel) {
+    switch(kernel) {
+        case Kernel::scalar: return true;
+#ifdef MEDYAN_CYLINDER_EXCL_VOL_SIMD
+        case Kernel::avx2:   return cyl_excl_vol_simd::cpuSupportsAVX2();
+        case Kernel::avx512: return cyl_excl_vol_simd::cpuSupportsAVX512();
+#endif
+        default:             return false;
+    }
+}
+
+CylinderExclVolRepulsion::Kernel CylinderExclVolRepulsion::bestKernel() {
+    static const Kernel best =
+        isKernelSupported(Kernel::avx512) ? Kernel::avx512 :
+        isKernelSupported(Kernel::avx2)   ? Kernel::avx2   :
+        Kernel::scalar;
+    return best;
+}
+
+floatingpoint CylinderExclVolRepulsion::energy(floatingpoint *coord, const int *beadSet, const floatingpoint *krep, const floatingpoint* eqLengths, int nint, bool recordCylEnergies) {
+	const auto simd = simdKernelFuncs(kernel);
+	if(simd.width == 0) {
+		return energyScalar(coord, beadSet, krep, eqLengths, nint, recordCylEnergies);
+	}
+
+	const int n = CylinderExclVolume<CylinderExclVolRepulsion>::n;
+	const int nintBatched = nint - nint % simd.width;
+
+	vector<tuple<floatingpoint*,floatingpoint*,floatingpoint*,floatingpoint*,floatingpoint>> tempCylEnergies;
+	double energies[cyl_excl_vol_simd::maxWidth];
+	floatingpoint U = 0.0;
+
+	for (int i = 0; i < nint; i++) {
+		floatingpoint U_i = 0.0;
+		bool accepted = false;
+		if(i < nintBatched) {
+			if(i % simd.width == 0) simd.energies(coord, beadSet, krep, eqLengths, i, energies);
+			U_i = energies[i % simd.width];
+			accepted = !(fabs(U_i) == numeric_limits<floatingpoint>::infinity() || U_i != U_i || U_i < -1.0);
+		}
+		if(!accepted) {
+			// Use the scalar implementation, which also handles the failures.
+			U_i = energyScalar(coord, beadSet + n * i, krep + i, eqLengths + 2 * i, 1, false);
+			if(U_i == -1) return -1;
+		}
+
+		U += U_i;
+		if(recordCylEnergies) {
+			tempCylEnergies.push_back(make_tuple(
+				&coord[beadSet[n * i]], &coord[beadSet[n * i + 1]], &coord[beadSet[n * i + 2]], &coord[beadSet[n * i + 3]],
+				U_i
+			));
+		}
+	}
+
+	if(recordCylEnergies && U > SysParams::Mechanics().cylThresh){
+		if(!(find(uniqueTimes.begin(), uniqueTimes.end(), tau()) != uniqueTimes.end())) {
+			uniqueTimes.push_back(tau());
+			cylEnergies.push_back(make_tuple(tau(), tempCylEnergies.size(), tempCylEnergies));
+		}
+	}
+
+	return U;
+}
+
+void CylinderExclVolRepulsion::forces(floatingpoint *coord, floatingpoint *f, const int *beadSet, const floatingpoint *krep, const floatingpoint* eqLengths, int nint) {
+	const auto simd = simdKernelFuncs(kernel);
+	if(simd.width == 0) {
+		forcesScalar(coord, f, beadSet, krep, eqLengths, nint);
+		return;
+	}
+
+	const int n = CylinderExclVolume<CylinderExclVolRepulsion>::n;
+	const int nintBatched = nint - nint % simd.width;
+
+	double batchForces[12 * cyl_excl_vol_simd::maxWidth];
+	for (int i = 0; i < nintBatched; i += simd.width) {
+		simd.forces(coord, beadSet, krep, eqLengths, i, batchForces);
+
+		// Beads may be shared by interactions in the same batch, so forces are accumulated one lane at a time.
+		for(int lane = 0; lane < simd.width; ++lane) {
+			const int ii = i + lane;
+			double forces[4][3];
+			for(int bi = 0; bi < 4; ++bi) {
+				for(int dim = 0; dim < 3; ++dim) {
+					forces[bi][dim] = batchForces[(3 * bi + dim) * simd.width + lane];
+				}
+			}
+
+			if(checkNaN_INF<doubleprecision>(forces[0], 0, 2)||checkNaN_INF<doubleprecision>(forces[1],0,2)
+			||checkNaN_INF<doubleprecision>(forces[2], 0, 2)||checkNaN_INF<doubleprecision>(forces[3],0, 2)) {
+				// Use the scalar implementation, which falls back to numerical integration.
+				forcesScalar(coord, f, beadSet + n * ii, krep + ii, eqLengths + 2 * ii, 1);
+			}
+			else {
+				for(int bi = 0; bi < 4; ++bi) {
+					for(int dim = 0; dim < 3; ++dim) {
+						f[beadSet[n * ii + bi] + dim] += forces[bi][dim];
+					}
+				}
+			}
+		}
+	}
+
+	forcesScalar(coord, f, beadSet + n * nintBatched, krep + nintBatched, eqLengths + 2 * nintBatched, nint - nintBatched);
+}
+
+floatingpoint CylinderExclVolRepulsion::energyScalar(floatingpoint *coord, const int *beadSet, const floatingpoint *krep, const floatingpoint* eqLengths, int nint, bool recordCylEnergies) {
 	floatingpoint *c1, *c2, *c3, *c2temp, *c4, *newc1, *newc2, d;
 
 	doubleprecision a, b, c, e, F, AA, BB, CC, DD, EE, FF, GG, HH, JJ;
@@ -555,7 +689,7 @@ floatingpoint CylinderExclVolRepulsion::energy(floatingpoint *coord, const int *
 //        }
 	}
     
-    if(U > SysParams::Mechanics().cylThresh){
+    if(recordCylEnergies && U > SysParams::Mechanics().cylThresh){
         
         if(!(find(uniqueTimes.begin(), uniqueTimes.end(), tau()) != uniqueTimes.end())) {
             uniqueTimes.push_back(tau());
@@ -575,7 +709,7 @@ floatingpoint CylinderExclVolRepulsion::energy(floatingpoint *coord, const int *
 }
 
 
-void CylinderExclVolRepulsion::forces(floatingpoint *coord, floatingpoint *f, const int *beadSet, const floatingpoint *krep, const floatingpoint* eqLengths, int nint) {
+void CylinderExclVolRepulsion::forcesScalar(floatingpoint *coord, floatingpoint *f, const int *beadSet, const floatingpoint *krep, const floatingpoint* eqLengths, int nint) {
 
 	floatingpoint *c1, *c2, *c3, *c4, d, U;
     floatingpoint newc2[3] {};
@@ -25,9 +25,23 @@ class Bead;
 class CylinderExclVolRepulsion {
     
 public:
-    
+    // Implementations of energy and force evaluation.
+    // - scalar: one interaction at a time, which is the reference.
+    // - avx2, avx512: batches of 4 or 8 interactions in SIMD lanes. The
+    //   interactions with non-finite results fall back to the scalar
+    //   implementation.
+    enum class Kernel { scalar, avx2, avx512 };
+
+    // Whether the kernel can run on this CPU.
+    static bool isKernelSupported(Kernel);
+    // The fastest kernel supported by this CPU, detected at runtime.
+    static Kernel bestKernel();
 
-    floatingpoint energy(floatingpoint *coord, const int *beadSet, const floatingpoint *krep, const floatingpoint* eqLengths, int nint);
+    Kernel kernel = bestKernel();
+
+    // If recordCylEnergies is true, the interaction energies will be recorded when the total energy exceeds the threshold.
+    // The recording is not thread-safe, and should be disabled when evaluating parts of the interactions concurrently.
+    floatingpoint energy(floatingpoint *coord, const int *beadSet, const floatingpoint *krep, const floatingpoint* eqLengths, int nint, bool recordCylEnergies = true);
 
     void forces(floatingpoint *coord, floatingpoint *f, const int *beadSet, const floatingpoint *krep, const floatingpoint* eqLengths, int nint);
     
@@ -44,6 +58,9 @@ public:
 
 private:
 
+	floatingpoint energyScalar(floatingpoint *coord, const int *beadSet, const floatingpoint *krep, const floatingpoint* eqLengths, int nint, bool recordCylEnergies);
+	void forcesScalar(floatingpoint *coord, floatingpoint *f, const int *beadSet, const floatingpoint *krep, const floatingpoint* eqLengths, int nint);
+
 	floatingpoint energyN(floatingpoint *coord, const int *beadSet,
 	                      const floatingpoint *krep, const floatingpoint* eqLengths, int intID, bool movebeads = false);
 
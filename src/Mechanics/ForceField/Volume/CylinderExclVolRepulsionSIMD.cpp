@@ -0,0 +1,128 @@
+#include "Mechanics/ForceField/Volume/CylinderExclVolRepulsionSIMD.h"
+
+#ifdef MEDYAN_CYLINDER_EXCL_VOL_SIMD
+
+#include <cmath>
+
+#include <immintrin.h>
+
+namespace medyan::cyl_excl_vol_simd {
+
+bool cpuSupportsAVX2()   { return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"); }
+bool cpuSupportsAVX512() { return cpuSupportsAVX2() && __builtin_cpu_supports("avx512f"); }
+
+//-----------------------------------------------------------------------------
+// AVX2: 4 interactions per batch.
+//-----------------------------------------------------------------------------
+namespace avx2 {
+
+#define MEDYAN_SIMD_TARGET __attribute__((target("avx2,fma")))
+
+struct VD {
+    static constexpr int width = 4;
+    using Mask = __m256d;
+
+    __m256d v;
+
+    VD() = default;
+    MEDYAN_SIMD_TARGET VD(__m256d v) : v(v) {}
+    MEDYAN_SIMD_TARGET VD(double x) : v(_mm256_set1_pd(x)) {}
+
+    MEDYAN_SIMD_TARGET void store(double* p) const { _mm256_storeu_pd(p, v); }
+    MEDYAN_SIMD_TARGET static VD load(const double* p) { return _mm256_loadu_pd(p); }
+
+    // Gathers base[idx[lane]].
+    // The masked forms with a zero source are used, because gcc warns that the
+    // source of the unmasked forms is uninitialized.
+    MEDYAN_SIMD_TARGET static VD gather(const floatingpoint* base, const int* idx) {
+        const __m128i vidx = _mm_loadu_si128(reinterpret_cast< const __m128i* >(idx));
+#ifdef FLOAT_PRECISION
+        return _mm256_cvtps_pd(_mm_mask_i32gather_ps(_mm_setzero_ps(), base, vidx, _mm_castsi128_ps(_mm_set1_epi32(-1)), 4));
+#else
+        return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, vidx, _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8);
+#endif
+    }
+};
+
+MEDYAN_SIMD_TARGET inline VD operator+(VD a, VD b) { return _mm256_add_pd(a.v, b.v); }
+MEDYAN_SIMD_TARGET inline VD operator-(VD a, VD b) { return _mm256_sub_pd(a.v, b.v); }
+MEDYAN_SIMD_TARGET inline VD operator*(VD a, VD b) { return _mm256_mul_pd(a.v, b.v); }
+MEDYAN_SIMD_TARGET inline VD operator/(VD a, VD b) { return _mm256_div_pd(a.v, b.v); }
+MEDYAN_SIMD_TARGET inline VD operator-(VD a) { return _mm256_xor_pd(a.v, _mm256_set1_pd(-0.0)); }
+MEDYAN_SIMD_TARGET inline VD::Mask operator>(VD a, VD b) { return _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ); }
+MEDYAN_SIMD_TARGET inline VD::Mask operator<(VD a, VD b) { return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ); }
+
+MEDYAN_SIMD_TARGET inline VD vsqrt(VD a) { return _mm256_sqrt_pd(a.v); }
+// Returns b if any of them is NaN.
+MEDYAN_SIMD_TARGET inline VD vmax(VD a, VD b) { return _mm256_max_pd(a.v, b.v); }
+MEDYAN_SIMD_TARGET inline VD vabs(VD a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v); }
+// mask ? a : b
+MEDYAN_SIMD_TARGET inline VD select(VD::Mask mask, VD a, VD b) { return _mm256_blendv_pd(b.v, a.v, mask); }
+
+#include "Mechanics/ForceField/Volume/CylinderExclVolRepulsionSIMDKernel.hpp"
+
+static_assert(VD::width == width);
+
+#undef MEDYAN_SIMD_TARGET
+
+} // namespace avx2
+
+//-----------------------------------------------------------------------------
+// AVX-512: 8 interactions per batch.
+//-----------------------------------------------------------------------------
+namespace avx512 {
+
+#define MEDYAN_SIMD_TARGET __attribute__((target("avx512f,avx2,fma")))
+
+struct VD {
+    static constexpr int width = 8;
+    using Mask = __mmask8;
+
+    __m512d v;
+
+    VD() = default;
+    MEDYAN_SIMD_TARGET VD(__m512d v) : v(v) {}
+    MEDYAN_SIMD_TARGET VD(double x) : v(_mm512_set1_pd(x)) {}
+
+    MEDYAN_SIMD_TARGET void store(double* p) const { _mm512_storeu_pd(p, v); }
+    MEDYAN_SIMD_TARGET static VD load(const double* p) { return _mm512_loadu_pd(p); }
+
+    // Gathers base[idx[lane]], using the masked forms as in the AVX2 version.
+    MEDYAN_SIMD_TARGET static VD gather(const floatingpoint* base, const int* idx) {
+        const __m256i vidx = _mm256_loadu_si256(reinterpret_cast< const __m256i* >(idx));
+#ifdef FLOAT_PRECISION
+        return _mm512_mask_cvtps_pd(_mm512_setzero_pd(), 0xff, _mm256_mask_i32gather_ps(_mm256_setzero_ps(), base, vidx, _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4));
+#else
+        return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xff, vidx, base, 8);
+#endif
+    }
+};
+
+MEDYAN_SIMD_TARGET inline VD operator+(VD a, VD b) { return _mm512_add_pd(a.v, b.v); }
+MEDYAN_SIMD_TARGET inline VD operator-(VD a, VD b) { return _mm512_sub_pd(a.v, b.v); }
+MEDYAN_SIMD_TARGET inline VD operator*(VD a, VD b) { return _mm512_mul_pd(a.v, b.v); }
+MEDYAN_SIMD_TARGET inline VD operator/(VD a, VD b) { return _mm512_div_pd(a.v, b.v); }
+MEDYAN_SIMD_TARGET inline VD operator-(VD a) { return _mm512_sub_pd(_mm512_set1_pd(-0.0), a.v); }
+MEDYAN_SIMD_TARGET inline VD::Mask operator>(VD a, VD b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ); }
+MEDYAN_SIMD_TARGET inline VD::Mask operator<(VD a, VD b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ); }
+
+// The masked forms with a zero source are used, because the unmasked forms use
+// an undefined source, which gcc warns about.
+MEDYAN_SIMD_TARGET inline VD vsqrt(VD a) { return _mm512_mask_sqrt_pd(_mm512_setzero_pd(), 0xff, a.v); }
+// Returns b if any of them is NaN.
+MEDYAN_SIMD_TARGET inline VD vmax(VD a, VD b) { return _mm512_mask_max_pd(_mm512_setzero_pd(), 0xff, a.v, b.v); }
+MEDYAN_SIMD_TARGET inline VD vabs(VD a) { return _mm512_abs_pd(a.v); }
+// mask ? a : b
+MEDYAN_SIMD_TARGET inline VD select(VD::Mask mask, VD a, VD b) { return _mm512_mask_blend_pd(mask, b.v, a.v); }
+
+#include "Mechanics/ForceField/Volume/CylinderExclVolRepulsionSIMDKernel.hpp"
+
+static_assert(VD::width == width);
+
+#undef MEDYAN_SIMD_TARGET
+
+} // namespace avx512
+
+} // namespace medyan::cyl_excl_vol_simd
+
+#endif // MEDYAN_CYLINDER_EXCL_VOL_SIMD
@@ -0,0 +1,50 @@
+#ifndef MEDYAN_Mechanics_ForceField_Volume_CylinderExclVolRepulsionSIMD_h
+#define MEDYAN_Mechanics_ForceField_Volume_CylinderExclVolRepulsionSIMD_h
+
+#include "common.h"
+
+// The SIMD kernels are compiled with function level target attributes, and
+// are selected at runtime by CylinderExclVolRepulsion.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define MEDYAN_CYLINDER_EXCL_VOL_SIMD
+#endif
+
+namespace medyan::cyl_excl_vol_simd {
+
+// Batched kernels evaluating the interactions [i, i + width) in double
+// precision, which must all exist in beadSet.
+//
+// Note:
+// - Like the scalar implementation, the force kernel moves the second bead
+//   slightly if the 4 beads are almost coplanar.
+// - No validity check is done on the results. Non-finite results must be
+//   handled by the scalar implementation.
+// - Energies are written to energies[lane].
+// - Forces on bead bi in dimension dim are written to
+//   forces[(3 * bi + dim) * width + lane].
+using EnergiesFunc = void(*)(const floatingpoint* coord, const int* beadSet, const floatingpoint* krep, const floatingpoint* eqLengths, int i, double* energies);
+using ForcesFunc   = void(*)(const floatingpoint* coord, const int* beadSet, const floatingpoint* krep, const floatingpoint* eqLengths, int i, double* forces);
+
+inline constexpr int maxWidth = 8;
+
+#ifdef MEDYAN_CYLINDER_EXCL_VOL_SIMD
+namespace avx2 {
+    inline constexpr int width = 4;
+    void energies(const floatingpoint* coord, const int* beadSet, const floatingpoint* krep, const floatingpoint* eqLengths, int i, double* energies);
+    void forces  (const floatingpoint* coord, const int* beadSet, const floatingpoint* krep, const floatingpoint* eqLengths, int i, double* forces);
+} // namespace avx2
+
+namespace avx512 {
+    inline constexpr int width = 8;
+    void energies(const floatingpoint* coord, const int* beadSet, const floatingpoint* krep, const floatingpoint* eqLengths, int i, double* energies);
+    void forces  (const floatingpoint* coord, const int* beadSet, const floatingpoint* krep, const floatingpoint* eqLengths, int i, double* forces);
+} // namespace avx512
+
+// Whether the CPU and the OS support the instruction sets.
+bool cpuSupportsAVX2();
+bool cpuSupportsAVX512();
+#endif
+
+} // namespace medyan::cyl_excl_vol_simd
+
+#endif
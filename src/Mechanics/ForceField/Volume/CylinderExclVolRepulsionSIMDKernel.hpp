@@ -0,0 +1,266 @@
+// Batched kernels of CylinderExclVolRepulsion, written once for all
+// instruction sets.
+//
+// This file has no include guard. It is included by
+// CylinderExclVolRepulsionSIMD.cpp once for each instruction set, inside a
+// namespace that provides
+// - MEDYAN_SIMD_TARGET: the function attribute enabling the instruction set.
+// - VD: a pack of VD::width doubles, with arithmetic operators, comparisons
+//   and the functions vsqrt, vmax, vabs and select.
+//
+// The formulas and their variable names follow the scalar implementation in
+// CylinderExclVolRepulsion.cpp.
+
+struct V3 { VD x, y, z; };
+
+MEDYAN_SIMD_TARGET inline V3 operator-(const V3& a, const V3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+MEDYAN_SIMD_TARGET inline VD dot(const V3& a, const V3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+MEDYAN_SIMD_TARGET inline V3 cross(const V3& a, const V3& b) {
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+
+// Arc tangent following the Cephes implementation, with about 1 ulp error.
+MEDYAN_SIMD_TARGET inline VD vatan(VD x) {
+    const VD ax = vabs(x);
+    // Reduce the argument to [0, 0.66].
+    const auto big = ax > VD(2.41421356237309504880); // tan(3 pi / 8)
+    const auto mid = ax > VD(0.66);
+    const VD y0 = select(big, VD(M_PI_2), select(mid, VD(M_PI_4), VD(0.0)));
+    const VD morebits = select(big, VD(6.123233995736765886130e-17), select(mid, VD(0.5 * 6.123233995736765886130e-17), VD(0.0)));
+    const VD xr = select(big, VD(-1.0) / ax, select(mid, (ax - VD(1.0)) / (ax + VD(1.0)), ax));
+
+    const VD z = xr * xr;
+    const VD p = (((VD(-8.750608600031904122785e-1) * z - VD(1.615753718733365076637e1)) * z - VD(7.500855792314704667340e1)) * z - VD(1.228866684490136173410e2)) * z - VD(6.485021904942025371773e1);
+    const VD q = ((((z + VD(2.485846490142306297962e1)) * z + VD(1.650270098316988542046e2)) * z + VD(4.328810604912902668951e2)) * z + VD(4.853903996359136964868e2)) * z + VD(1.945506571482613964425e2);
+    const VD y = y0 + ((xr * (z * p / q) + xr) + morebits);
+
+    return select(x < VD(0.0), -y, y);
+}
+
+// Intermediate variables of the energy.
+struct Terms {
+    // v1 = c2 - c1, v2 = c4 - c3, v3 = c1 - c3.
+    V3 v1, v2, v3;
+    VD a, b, c, d, e, F;
+    VD AA, BB, CC, DD, EE, FF, GG, HH, JJ;
+    VD ATG1, ATG2, ATG3, ATG4;
+    VD kRepScaled;
+};
+
+// Gathers the coordinates of the 4 beads and the scaled repulsion constants.
+MEDYAN_SIMD_TARGET inline void gatherInteractions(
+    const floatingpoint* coord, const int* beadSet, const floatingpoint* krep, const floatingpoint* eqLengths, int i,
+    V3* beads, VD& kRepScaledOut
+) {
+    constexpr int w = VD::width;
+
+    alignas(64) int idx[4][w];
+    alignas(64) double kRepScaled[w];
+    for(int lane = 0; lane < w; ++lane) {
+        for(int bi = 0; bi < 4; ++bi) idx[bi][lane] = beadSet[4 * (i + lane) + bi];
+        kRepScaled[lane] = krep[i + lane] * eqLengths[2 * (i + lane)] * eqLengths[2 * (i + lane) + 1];
+    }
+    for(int bi = 0; bi < 4; ++bi) {
+        beads[bi] = { VD::gather(coord, idx[bi]), VD::gather(coord + 1, idx[bi]), VD::gather(coord + 2, idx[bi]) };
+    }
+    kRepScaledOut = VD::load(kRepScaled);
+}
+
+// If the beads are almost coplanar, moves c2 slightly out of the plane, as
+// areInPlane and movePointOutOfPlane do in the scalar implementation.
+MEDYAN_SIMD_TARGET inline void moveOutOfPlane(V3* beads) {
+    const V3 n = cross(beads[1] - beads[0], beads[2] - beads[0]);
+    const V3 v = beads[3] - beads[0];
+    const VD nNorm = vsqrt(dot(n, n));
+    const VD vNorm = vsqrt(dot(v, v));
+    const auto inPlane = vabs(dot(n, v) / (nNorm * vNorm)) < VD(0.1);
+    const VD moveFactor = select(inPlane, VD(0.01) / nNorm, VD(0.0));
+    beads[1].x = beads[1].x + n.x * moveFactor;
+    beads[1].y = beads[1].y + n.y * moveFactor;
+    beads[1].z = beads[1].z + n.z * moveFactor;
+}
+
+MEDYAN_SIMD_TARGET inline Terms computeTerms(const V3* beads, VD kRepScaled) {
+    Terms t;
+    t.kRepScaled = kRepScaled;
+    t.v1 = beads[1] - beads[0];
+    t.v2 = beads[3] - beads[2];
+    t.v3 = beads[0] - beads[2];
+    const V3 vD = beads[3] - beads[0];
+    const V3 vE = beads[1] - beads[2];
+
+    const VD a = t.a = dot(t.v1, t.v1);
+    const VD b = t.b = dot(t.v2, t.v2);
+    const VD c = t.c = dot(t.v3, t.v3);
+    const VD d = t.d = dot(t.v1, t.v2);
+    const VD e = t.e = dot(t.v1, t.v3);
+    const VD F = t.F = dot(t.v2, t.v3);
+
+    const VD g = dot(t.v1, vD);
+    const VD h = dot(t.v2, vE);
+    const VD I = dot(t.v2, vD);
+    const VD sqmag_D = dot(vD, vD);
+    const VD sqmag_E = dot(vE, vE);
+
+    const VD ac = vsqrt(a * c);
+    const VD bc = vsqrt(b * c);
+    const VD aD = vsqrt(a * sqmag_D);
+    const VD bE = vsqrt(b * sqmag_E);
+
+    t.AA = vsqrt(vmax((ac + e) * (ac - e), VD(0.0)));
+    t.BB = vsqrt(vmax((bc + F) * (bc - F), VD(0.0)));
+    t.CC = d * e - a * F;
+    t.DD = b * e - d * F;
+    t.EE = vsqrt(vmax((aD + g) * (aD - g), VD(0.0)));
+    t.FF = vsqrt(vmax((bE + h) * (bE - h), VD(0.0)));
+    t.GG = d * g - a * I;
+    t.HH = t.CC + t.GG - t.DD;
+    const VD tp = dot(cross(t.v1, t.v2), t.v3);
+    t.JJ = -(tp * tp);
+
+    t.ATG1 = vatan((a + e) / t.AA) - vatan(e / t.AA);
+    t.ATG2 = vatan((a + e - d) / t.EE) - vatan((e - d) / t.EE);
+    t.ATG3 = vatan(F / t.BB) - vatan((F - b) / t.BB);
+    t.ATG4 = vatan((d + F) / t.FF) - vatan((d + F - b) / t.FF);
+
+    return t;
+}
+
+MEDYAN_SIMD_TARGET inline void energiesImpl(
+    const floatingpoint* coord, const int* beadSet, const floatingpoint* krep, const floatingpoint* eqLengths, int i, double* energies
+) {
+    V3 beads[4];
+    VD kRepScaled;
+    gatherInteractions(coord, beadSet, krep, eqLengths, i, beads, kRepScaled);
+
+    const Terms t = computeTerms(beads, kRepScaled);
+    const VD U = VD(0.5) * t.kRepScaled / t.JJ * (t.CC / t.AA * t.ATG1 + t.GG / t.EE * t.ATG2 + t.DD / t.BB * t.ATG3 + t.HH / t.FF * t.ATG4);
+    U.store(energies);
+}
+
+MEDYAN_SIMD_TARGET inline void forcesImpl(
+    const floatingpoint* coord, const int* beadSet, const floatingpoint* krep, const floatingpoint* eqLengths, int i, double* forces
+) {
+    V3 beads[4];
+    VD kRepScaled;
+    gatherInteractions(coord, beadSet, krep, eqLengths, i, beads, kRepScaled);
+    moveOutOfPlane(beads);
+
+    const Terms t = computeTerms(beads, kRepScaled);
+    const VD a = t.a, b = t.b, c = t.c, d = t.d, e = t.e, F = t.F;
+    const VD AA = t.AA, BB = t.BB, CC = t.CC, DD = t.DD, EE = t.EE, FF = t.FF, GG = t.GG, HH = t.HH;
+    const VD ATG1 = t.ATG1, ATG2 = t.ATG2, ATG3 = t.ATG3, ATG4 = t.ATG4;
+    const VD invJJ = VD(1.0) / t.JJ;
+    const VD two(2.0);
+
+    const VD sumBlock = CC/AA*ATG1 + GG/EE*ATG2 + DD/BB*ATG3 + HH/FF*ATG4;
+    const VD enFactor = t.kRepScaled * invJJ / two;
+
+    // Derivatives of the arctan functions.
+    const VD A1 = AA*AA/(AA*AA + (a + e)*(a + e));
+    const VD A2 = AA*AA/(AA*AA + e*e);
+    const VD E1 = EE*EE/(EE*EE + (a + e - d)*(a + e - d));
+    const VD E2 = EE*EE/(EE*EE + (e - d)*(e - d));
+    const VD B1 = BB*BB/(BB*BB + F*F);
+    const VD B2 = BB*BB/(BB*BB + (F - b)*(F - b));
+    const VD F1 = FF*FF/(FF*FF + (d + F)*(d + F));
+    const VD F2 = FF*FF/(FF*FF + (d + F - b)*(d + F - b));
+
+    // Partial derivatives of blocks.
+    const VD blockA_C = ATG1/AA;
+    const VD blockA_A = -(ATG1*CC)/(AA*AA) + (-A1 * (a+e) + A2 * e) * CC/(AA*AA*AA);
+    const VD blockA_e = ((A1 - A2)*CC)/(AA*AA);
+    const VD blockA_a = (A1*CC)/(AA*AA);
+
+    const VD blockE_G = ATG2/EE;
+    const VD blockE_E = -(ATG2*GG)/(EE*EE) + (-E1 * (a+e-d) + E2 * (e-d)) * GG/(EE*EE*EE);
+    const VD blockE_e_minus_d = ((E1 - E2)*GG)/(EE*EE);
+    const VD blockE_a = (E1*GG)/(EE*EE);
+
+    const VD blockB_D = ATG3/BB;
+    const VD blockB_B = -(ATG3*DD)/(BB*BB) + (-B1 * F + B2 * (F-b)) * DD/(BB*BB*BB);
+    const VD blockB_f_minus_b = ((B1 - B2)*DD)/(BB*BB);
+    const VD blockB_b = (B1*DD)/(BB*BB);
+
+    const VD blockF_H = ATG4/FF;
+    const VD blockF_F = -(ATG4*HH)/(FF*FF) + (-F1 * (d+F) + F2 * (d+F-b)) * HH/(FF*FF*FF);
+    const VD blockF_d_plus_f_minus_b = ((F1 - F2)*HH)/(FF*FF);
+    const VD blockF_b = (F1*HH)/(FF*FF);
+
+    // block_xy means component along v_y, of derivative of sum of blocks on v_x.
+    // The matrix is symmetric.
+    const VD block_11
+        = blockA_C * (-two*F) + blockA_A * (c/AA) + blockA_a * two
+        + blockE_G * (two*(F-b)) + blockE_E * ((b+c-two*F)/EE) + blockE_a * two
+        + blockF_H * (-two*b) + blockF_F * (b/FF);
+    const VD block_12
+        = blockA_C * e
+        + blockE_G * (two*d-e) + blockE_E * ((e-d)/EE) - blockE_e_minus_d
+        + blockB_D * (-F)
+        + blockF_H * (two*d+F) + blockF_F * (-(d+F)/FF) + blockF_d_plus_f_minus_b;
+    const VD block_13
+        = blockA_C * d + blockA_A * (-e/AA) + blockA_e
+        + blockE_G * (-d) + blockE_E * (-(e-d)/EE) + blockE_e_minus_d
+        + blockB_D * b
+        + blockF_H * (-b) + blockF_F * (b/FF);
+    const VD block_22
+        = blockE_G * (-two*a) + blockE_E * (a/EE)
+        + blockB_D * (two*e) + blockB_B * (c/BB) + blockB_f_minus_b * (-two) + blockB_b * two
+        + blockF_H * (-two*(a+e)) + blockF_F * ((a+c+two*e)/FF) + blockF_d_plus_f_minus_b * (-two) + blockF_b * two;
+    const VD block_23
+        = blockA_C * (-a)
+        + blockE_G * a + blockE_E * (-a/EE)
+        + blockB_D * (-d) + blockB_B * (-F/BB) + blockB_f_minus_b
+        + blockF_H * d + blockF_F * (-(d+F)/FF) + blockF_d_plus_f_minus_b;
+    const VD block_33
+        = blockA_A * (a/AA)
+        + blockE_E * (a/EE)
+        + blockB_B * (b/BB)
+        + blockF_F * (b/FF);
+    const VD& block_21 = block_12;
+    const VD& block_31 = block_13;
+    const VD& block_32 = block_23;
+
+    // Derivatives of JJ, which is also symmetric.
+    const VD JJ_11 = two * (-b*c+F*F);
+    const VD JJ_12 = two * (c*d-e*F);
+    const VD JJ_13 = two * (b*e-d*F);
+    const VD JJ_22 = two * (-a*c+e*e);
+    const VD JJ_23 = two * (-d*e+a*F);
+    const VD JJ_33 = two * (d*d-a*b);
+    const VD& JJ_21 = JJ_12;
+    const VD& JJ_31 = JJ_13;
+    const VD& JJ_32 = JJ_23;
+
+    // Final derivatives: (i,j) -> gradient of energy on c_i, component along v_j
+    const VD s = -invJJ * sumBlock;
+    VD deriv[4][3];
+    deriv[0][0] = enFactor * (s * (JJ_31 - JJ_11) + (block_31 - block_11));
+    deriv[0][1] = enFactor * (s * (JJ_32 - JJ_12) + (block_32 - block_12));
+    deriv[0][2] = enFactor * (s * (JJ_33 - JJ_13) + (block_33 - block_13));
+    deriv[1][0] = enFactor * (s * JJ_11 + block_11);
+    deriv[1][1] = enFactor * (s * JJ_12 + block_12);
+    deriv[1][2] = enFactor * (s * JJ_13 + block_13);
+    deriv[2][0] = enFactor * (s * (-JJ_31 - JJ_21) + (-block_31 - block_21));
+    deriv[2][1] = enFactor * (s * (-JJ_32 - JJ_22) + (-block_32 - block_22));
+    deriv[2][2] = enFactor * (s * (-JJ_33 - JJ_23) + (-block_33 - block_23));
+    deriv[3][0] = enFactor * (s * JJ_21 + block_21);
+    deriv[3][1] = enFactor * (s * JJ_22 + block_22);
+    deriv[3][2] = enFactor * (s * JJ_23 + block_23);
+
+    constexpr int w = VD::width;
+    for(int bi = 0; bi < 4; ++bi) {
+        (-(deriv[bi][0] * t.v1.x + deriv[bi][1] * t.v2.x + deriv[bi][2] * t.v3.x)).store(forces + (3 * bi    ) * w);
+        (-(deriv[bi][0] * t.v1.y + deriv[bi][1] * t.v2.y + deriv[bi][2] * t.v3.y)).store(forces + (3 * bi + 1) * w);
+        (-(deriv[bi][0] * t.v1.z + deriv[bi][1] * t.v2.z + deriv[bi][2] * t.v3.z)).store(forces + (3 * bi + 2) * w);
+    }
+}
+
+// Entry points, which are compiled for the default target and can be called
+// without enabling the instruction set.
+void energies(const floatingpoint* coord, const int* beadSet, const floatingpoint* krep, const floatingpoint* eqLengths, int i, double* energies) {
+    energiesImpl(coord, beadSet, krep, eqLengths, i, energies);
+}
+void forces(const floatingpoint* coord, const int* beadSet, const floatingpoint* krep, const floatingpoint* eqLengths, int i, double* forces) {
+    forcesImpl(coord, beadSet, krep, eqLengths, i, forces);
+}
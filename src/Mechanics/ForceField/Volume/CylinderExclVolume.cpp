@@ -32,6 +32,13 @@ using namespace mathfunc;
 
 template <class CVolumeInteractionType>
 void CylinderExclVolume<CVolumeInteractionType>::vectorize(const FFCoordinateStartingIndex& si, const SimulConfig& conf) {
+    // Neighbor lists built with a skin may contain cylinders beyond the cutoff.
+    const bool checkCutoff = conf.chemParams.chemistryAlgorithm.neighborListSkin > 0;
+    const auto isInteracting = [&](Cylinder* ci, Cylinder* cn) {
+        if(cn->getBranchingCylinder() == ci) return false;
+        return !checkCutoff || cylindersWithinCutoff(*ci, *cn, conf.mechParams.VolumeCutoff);
+    };
+
     //count interactions
     int nint = 0;
 
@@ -39,20 +46,20 @@ void CylinderExclVolume<CVolumeInteractionType>::vectorize(const FFCoordinateSta
 
 #if defined(HYBRID_NLSTENCILLIST) || defined(SIMDBINDINGSEARCH)
         for (int ID = 0; ID < _HnlIDvec.size(); ID ++){
-            auto neighbors = _HneighborList->getNeighborsstencil(_HnlIDvec[ID], ci);
+            const auto& neighbors = _HneighborList->getNeighborsstencil(_HnlIDvec[ID], ci);
             for(auto &cn : neighbors)
             {
-                if(cn->getBranchingCylinder() == ci) continue;
+                if(!isInteracting(ci, cn)) continue;
                 nint++;
             }
         }
 #else
-        auto neighbors = _neighborList->getNeighbors(ci);
+        const auto& neighbors = _neighborList->getNeighbors(ci);
 
         for(auto &cn : neighbors)
         {
 
-            if(cn->getBranchingCylinder() == ci) continue;
+            if(!isInteracting(ci, cn)) continue;
 
             nint++;
         }
@@ -76,13 +83,13 @@ void CylinderExclVolume<CVolumeInteractionType>::vectorize(const FFCoordinateSta
 #if defined(HYBRID_NLSTENCILLIST) || defined(SIMDBINDINGSEARCH)
         
         for (int ID = 0; ID < _HnlIDvec.size(); ID ++){
-            auto neighbors = _HneighborList->getNeighborsstencil(_HnlIDvec[ID], ci);
+            const auto& neighbors = _HneighborList->getNeighborsstencil(_HnlIDvec[ID], ci);
             int nn = neighbors.size();
             //        std::cout<<"Cylinder "<<i<<" "<<nn<<endl;
             for (int ni = 0; ni < nn; ni++) {
                 
                 auto cin = neighbors[ni];
-                if(cin->getBranchingCylinder() == ci) continue;
+                if(!isInteracting(ci, cin)) continue;
                 beadSet[n * (Cumnc)] = findBeadCoordIndex(*ci->getFirstBead(), si);
                 beadSet[n * (Cumnc) + 1] = findBeadCoordIndex(*ci->getSecondBead(), si);
                 beadSet[n * (Cumnc) + 2] = findBeadCoordIndex(*cin->getFirstBead(), si);
@@ -106,14 +113,14 @@ void CylinderExclVolume<CVolumeInteractionType>::vectorize(const FFCoordinateSta
         }
                 
 #else
-        auto neighbors = _neighborList->getNeighbors(ci);
+        const auto& neighbors = _neighborList->getNeighbors(ci);
         
         int nn = neighbors.size();
 //        std::cout<<"Cylinder "<<i<<" "<<nn<<endl;
         for (int ni = 0; ni < nn; ni++) {
 
             auto cin = neighbors[ni];
-            if(cin->getBranchingCylinder() == ci) continue;
+            if(!isInteracting(ci, cin)) continue;
             beadSet[n * (Cumnc)] = findBeadCoordIndex(*ci->getFirstBead(), si);
             beadSet[n * (Cumnc) + 1] = findBeadCoordIndex(*ci->getSecondBead(), si);
             beadSet[n * (Cumnc) + 2] = findBeadCoordIndex(*cin->getFirstBead(), si);
@@ -240,6 +247,25 @@ void CylinderExclVolume<CVolumeInteractionType>::computeForces(FP *coord, FP *f)
 #endif
 }
 
+template <class CVolumeInteractionType>
+FP CylinderExclVolume<CVolumeInteractionType>::computeEnergyRange(FP *coord, Index begin, Index end) {
+    // High energy interactions are not recorded, because parts may be evaluated concurrently. See finishEnergyRanges.
+    return _FFType.energy(coord, beadSet.data() + n * begin, krep.data() + begin, vecEqLength.data() + 2 * begin, end - begin, false);
+}
+
+template <class CVolumeInteractionType>
+void CylinderExclVolume<CVolumeInteractionType>::computeForcesRange(FP *coord, FP *f, Index begin, Index end) {
+    _FFType.forces(coord, f, beadSet.data() + n * begin, krep.data() + begin, vecEqLength.data() + 2 * begin, end - begin);
+}
+
+template <class CVolumeInteractionType>
+void CylinderExclVolume<CVolumeInteractionType>::finishEnergyRanges(FP *coord, FP energy) {
+    // High energy interactions are recorded by a full evaluation, which only happens above the threshold.
+    if(energy > SysParams::Mechanics().cylThresh) {
+        _FFType.energy(coord, beadSet.data(), krep.data(), vecEqLength.data(), numInteractions);
+    }
+}
+
 // Explicit instantiation.
 template class CylinderExclVolume<CylinderExclVolRepulsion>;
 
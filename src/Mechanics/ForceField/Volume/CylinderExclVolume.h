@@ -84,6 +84,19 @@ public:
     /// This repulsive force calculation also updates load forces
     /// on beads within the interaction range.
     virtual void computeForces(FP *coord, FP *f) override;
+    //@}
+
+    // Ranged evaluation over the vectorized interactions.
+    virtual Size numRangedInteractions() const override { return numInteractions; }
+    virtual FP computeEnergyRange(FP* coord, Index begin, Index end) override;
+    virtual void computeForcesRange(FP* coord, FP* f, Index begin, Index end) override;
+    virtual void finishEnergyRanges(FP* coord, FP energy) override;
+
+    virtual std::size_t vectorizedCapacityBytes() const override {
+        return ForceField::vectorizedCapacityBytes()
+            + beadSet.capacity() * sizeof(int)
+            + (krep.capacity() + vecEqLength.capacity()) * sizeof(FP);
+    }
 
     /// Get the neighbor list for this interaction
     virtual std::vector<NeighborList*> getNeighborLists() override {
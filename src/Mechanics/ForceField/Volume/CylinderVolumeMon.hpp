@@ -131,8 +131,11 @@ struct CylinderVolumeMon : ForceField {
         ps = si.ps;
         interactions.clear();
 
-        const auto judgeNeighbor = [](const Cylinder& c1, const Cylinder& c2) {
-            return !(c1.getBranchingCylinder() == &c2 || c2.getBranchingCylinder() == &c1);
+        // Neighbor lists built with a skin may contain cylinders beyond the cutoff.
+        const bool checkCutoff = SysParams::Chemistry().chemistryAlgorithm.neighborListSkin > 0;
+        const auto judgeNeighbor = [&](const Cylinder& c1, const Cylinder& c2) {
+            if(c1.getBranchingCylinder() == &c2 || c2.getBranchingCylinder() == &c1) return false;
+            return !checkCutoff || cylindersWithinCutoff(c1, c2, mechParams.VolumeCutoff);
         };
         const auto judgeAndAddInteraction = [&, this](const Cylinder& c1, const Cylinder& c2) {
             if(!judgeNeighbor(c1, c2)) return;
@@ -166,7 +169,7 @@ struct CylinderVolumeMon : ForceField {
         for(auto pc : Cylinder::getCylinders()) {
             if(neighborList) {
                 // Use original neighbor list.
-                auto neighbors = neighborList->getNeighbors(pc);
+                const auto& neighbors = neighborList->getNeighbors(pc);
                 for(auto pnc : neighbors) {
                     judgeAndAddInteraction(*pc, *pnc);
                 }
@@ -175,7 +178,7 @@ struct CylinderVolumeMon : ForceField {
                 // Use hybrid neighbor list.
                 auto phnl = ps->getHNeighborList();
                 for(auto id : hnlIdVec) {
-                    auto neighbors = phnl->getNeighborsstencil(id, pc);
+                    const auto& neighbors = phnl->getNeighborsstencil(id, pc);
                     for(auto pnc : neighbors) {
                         judgeAndAddInteraction(*pc, *pnc);
                     }
@@ -359,6 +359,82 @@ void CGMethod::shiftSearchDir(double d)
         searchDir[i] = force[i] + d * searchDir[i];
 }
 
+void CGMethod::resetLbfgsHistory(int numHistory) {
+    numHistory = std::max(numHistory, 1);
+    // Resizing the outer vectors keeps the inner buffers that are still in use.
+    lbfgsS.resize(numHistory);
+    lbfgsY.resize(numHistory);
+    lbfgsRho.assign(numHistory, 0);
+    lbfgsAlpha.assign(numHistory, 0);
+    lbfgsHistoryStart = 0;
+    lbfgsHistorySize = 0;
+}
+
+void CGMethod::updateLbfgsHistory(floatingpoint d) {
+    const int numHistory = lbfgsS.size();
+    const int index = (lbfgsHistoryStart + lbfgsHistorySize) % numHistory;
+    auto& s = lbfgsS[index];
+    auto& y = lbfgsY[index];
+    s.resize(numDof);
+    y.resize(numDof);
+
+    double yDotS = 0, yDotY = 0;
+    for(std::size_t i = 0; i < numDof; ++i) {
+        s[i] = d * searchDir[i];
+        y[i] = forcePrev[i] - force[i];
+        yDotS += y[i] * s[i];
+        yDotY += y[i] * y[i];
+    }
+
+    // Skip the pair if the curvature condition is not satisfied, so that the inverse Hessian approximation stays positive definite.
+    if(yDotS <= 1e-10 * yDotY || yDotY == 0) return;
+
+    lbfgsRho[index] = 1.0 / yDotS;
+    if(lbfgsHistorySize < numHistory) {
+        ++lbfgsHistorySize;
+    } else {
+        lbfgsHistoryStart = (lbfgsHistoryStart + 1) % numHistory;
+    }
+}
+
+void CGMethod::computeLbfgsSearchDir() {
+    const int numHistory = lbfgsS.size();
+
+    for(std::size_t i = 0; i < numDof; ++i) searchDir[i] = force[i];
+
+    // First loop, from the newest to the oldest pair.
+    for(int k = lbfgsHistorySize - 1; k >= 0; --k) {
+        const int index = (lbfgsHistoryStart + k) % numHistory;
+        const auto& s = lbfgsS[index];
+        const auto& y = lbfgsY[index];
+        double sDotQ = 0;
+        for(std::size_t i = 0; i < numDof; ++i) sDotQ += s[i] * searchDir[i];
+        lbfgsAlpha[index] = lbfgsRho[index] * sDotQ;
+        for(std::size_t i = 0; i < numDof; ++i) searchDir[i] -= lbfgsAlpha[index] * y[i];
+    }
+
+    // Scale with the initial inverse Hessian approximation, using the newest pair.
+    if(lbfgsHistorySize > 0) {
+        const int index = (lbfgsHistoryStart + lbfgsHistorySize - 1) % numHistory;
+        const auto& y = lbfgsY[index];
+        double yDotY = 0;
+        for(std::size_t i = 0; i < numDof; ++i) yDotY += y[i] * y[i];
+        const double gamma = 1.0 / (lbfgsRho[index] * yDotY);
+        for(std::size_t i = 0; i < numDof; ++i) searchDir[i] *= gamma;
+    }
+
+    // Second loop, from the oldest to the newest pair.
+    for(int k = 0; k < lbfgsHistorySize; ++k) {
+        const int index = (lbfgsHistoryStart + k) % numHistory;
+        const auto& s = lbfgsS[index];
+        const auto& y = lbfgsY[index];
+        double yDotR = 0;
+        for(std::size_t i = 0; i < numDof; ++i) yDotR += y[i] * searchDir[i];
+        const double beta = lbfgsRho[index] * yDotR;
+        for(std::size_t i = 0; i < numDof; ++i) searchDir[i] += (lbfgsAlpha[index] - beta) * s[i];
+    }
+}
+
 void CGMethod::startMinimization() {
 
     // Reset backup coordinates with minimum Energy
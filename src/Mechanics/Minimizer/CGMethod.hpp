@@ -39,6 +39,10 @@ enum class ConjugateGradientDescentSearch {
     steepest,
     fletcherRieves,
     polakRibiere,
+    // Limited-memory BFGS. Search directions come from the quasi-Newton approximation, and the line searches are shared with conjugate gradient methods.
+    lbfgs,
+    // Fast inertial relaxation engine. It uses damped dynamics with an adaptive time step instead of line searches, so no energy is computed during iterations.
+    fire,
 };
 
 struct ConjugateGradientParams {
@@ -60,6 +64,14 @@ struct ConjugateGradientParams {
 
     // If true, safe mode kicks in to try to restore line search errors.
     bool tryToRecoverInLineSearchError = true;
+
+    // Number of correction pairs kept in L-BFGS.
+    int           lbfgsNumHistory = 10;
+
+    // Time steps in FIRE. With unit mass, a step moves coordinates by dt^2 times the force.
+    // Bead moves in each step are still limited by maxDist.
+    floatingpoint fireDtInit = 0.05;
+    floatingpoint fireDtMax  = 0.5;
 };
 
 
@@ -90,6 +102,17 @@ public:
     std::vector< floatingpoint > searchDir; // The current search direction in conjugate gradient method
     std::vector< floatingpoint > forceTol; // The force tolerance (in each dimension); must be positive
 
+    // L-BFGS history, stored in ring buffers.
+    // lbfgsS holds coordinate changes, lbfgsY holds gradient changes (i.e. negative force changes), and lbfgsRho holds 1 / (y . s).
+    std::vector< std::vector< floatingpoint > > lbfgsS;
+    std::vector< std::vector< floatingpoint > > lbfgsY;
+    std::vector< double >                       lbfgsRho;
+    std::vector< double >                       lbfgsAlpha; // Temporary values in two-loop recursion.
+    int                                         lbfgsHistoryStart = 0;
+    int                                         lbfgsHistorySize = 0;
+
+    std::vector< floatingpoint > velocity; // Velocities used in FIRE
+
     chrono::high_resolution_clock::time_point tbegin, tend;
 
 
@@ -106,6 +129,15 @@ public:
     const floatingpoint LAMBDAQUADTOL = 1e-3; //if values change less than 0.1% between
     // successive runs, consider it converged.
 
+    //@{
+    /// Parameters used in FIRE, following Bitzek et al. (2006)
+    static constexpr int           FIRE_NMIN       = 5;    ///< Number of steps with positive power before the time step can grow
+    static constexpr floatingpoint FIRE_FINC       = 1.1;  ///< Time step increase factor
+    static constexpr floatingpoint FIRE_FDEC       = 0.5;  ///< Time step decrease factor
+    static constexpr floatingpoint FIRE_ALPHASTART = 0.1;  ///< Initial velocity mixing factor
+    static constexpr floatingpoint FIRE_FALPHA     = 0.99; ///< Velocity mixing factor decrease factor
+    //@}
+
     //additional parameters to help store additional parameters
     floatingpoint minimumE = (floatingpoint) 1e10;
     floatingpoint TotalEnergy = (floatingpoint)0.0;
@@ -211,6 +243,27 @@ public:
         return magMax;
     }
 
+    // Heap memory reserved by the data vectors, in bytes.
+    std::size_t capacityBytes() const {
+        std::size_t res = sizeof(floatingpoint) * (
+            coordLineSearch.capacity() + coordMinE.capacity()
+            + force.capacity() + forcePrev.capacity() + searchDir.capacity() + forceTol.capacity()
+            + velocity.capacity()
+        );
+        for(auto& s : lbfgsS) res += sizeof(floatingpoint) * s.capacity();
+        for(auto& y : lbfgsY) res += sizeof(floatingpoint) * y.capacity();
+        return res;
+    }
+
+    /// Get the max magnitude of search direction components
+    floatingpoint maxSearchDir() const {
+        floatingpoint magMax = 0;
+        for(Index i = 0; i < numDof; ++i) {
+            magMax = std::max(magMax, std::abs(searchDir[i]));
+        }
+        return magMax;
+    }
+
     /// Transfers data to lightweight arrays for min
     void startMinimization();
     /// Transfers updated coordinates and force to bead members
@@ -222,6 +275,17 @@ public:
     /// shift the gradient by d
     void shiftSearchDir(double d);
 
+    //@{
+    /// L-BFGS helpers
+    // Clear the history, keeping the allocated buffers.
+    void resetLbfgsHistory(int numHistory);
+    // Record the last step, which moved the coordinates by d along the search direction, using the current and previous forces.
+    // Pairs violating the curvature condition are skipped.
+    void updateLbfgsHistory(floatingpoint d);
+    // Set the search direction to the force multiplied by the inverse Hessian approximation, using two-loop recursion.
+    void computeLbfgsSearchDir();
+    //@}
+
 
 #ifdef CUDAACCL
     //@{
@@ -965,9 +1029,12 @@ public:
             if constexpr(method == ConjugateGradientDescentSearch::fletcherRieves || method == ConjugateGradientDescentSearch::polakRibiere) {
                 lastFDotF = forceDotForce();
             }
-            if constexpr(method == ConjugateGradientDescentSearch::polakRibiere) {
+            if constexpr(method == ConjugateGradientDescentSearch::polakRibiere || method == ConjugateGradientDescentSearch::lbfgs) {
                 forcePrev = force;
             }
+            if constexpr(method == ConjugateGradientDescentSearch::lbfgs) {
+                resetLbfgsHistory(cgParams.lbfgsNumHistory);
+            }
         };
         resetCGParams();
 
@@ -1100,8 +1167,8 @@ public:
         long i = 0;
         long index = 0;
         for(auto b:Bead::getBeads()){
-            std::cout<<b->getId()<<" "<< b->coord <<" "
-                    "" << b->force <<endl;
+            std::cout<<b->getId()<<" "<< b->coordinate() <<" "
+                    "" <<b->force() <<endl;
         }
         std::cout<<"printed beads & forces"<<endl;
 #endif
@@ -1316,18 +1383,22 @@ public:
             medyan::LambdaRunningAverageManager lambdaAvg;
             lambdaAvg.lambdaRunningAverageProbability = cgParams.lambdaRunningAverageProbability;
             medyan::LineSearchResult lsr;
+            // For L-BFGS, the bead move limit applies to the search direction itself. Once some history is available, the search direction already has the scale of a full step, so the natural step size is 1.
+            const bool useLbfgsStep = method == ConjugateGradientDescentSearch::lbfgs && lbfgsHistorySize > 0;
+            const auto maxDirForLineSearch = method == ConjugateGradientDescentSearch::lbfgs ? maxSearchDir() : result.gradInfNorm;
+            const auto lambdaMax = useLbfgsStep ? (floatingpoint)1.0 : cgParams.lambdaMax;
             if (cgParams.lineSearchAlgorithm == "BACKTRACKING") {
-                lsr = backtrackingLineSearch(coord, energyFunc, cgParams.maxDist, result.gradInfNorm, cgParams.lambdaMax, &lambdaAvg, safeMode ? 0 : BACKTRACKSLOPE);
+                lsr = backtrackingLineSearch(coord, energyFunc, cgParams.maxDist, maxDirForLineSearch, lambdaMax, &lambdaAvg, safeMode ? 0 : BACKTRACKSLOPE);
 
             } else if (cgParams.lineSearchAlgorithm == "QUADRATIC") {
                 lsr = safeMode
-                    ? backtrackingLineSearch(coord, energyFunc, cgParams.maxDist, result.gradInfNorm, cgParams.lambdaMax, &lambdaAvg, 0)
-                    : quadraticLineSearchV2(coord, energyFunc, cgParams.maxDist, result.gradInfNorm, cgParams.lambdaMax);
+                    ? backtrackingLineSearch(coord, energyFunc, cgParams.maxDist, maxDirForLineSearch, lambdaMax, &lambdaAvg, 0)
+                    : quadraticLineSearchV2(coord, energyFunc, cgParams.maxDist, maxDirForLineSearch, lambdaMax);
 
             } else {
                 lsr = safeMode
-                    ? backtrackingLineSearch(coord, energyFunc, cgParams.maxDist, result.gradInfNorm, cgParams.lambdaMax, &lambdaAvg, 0)
-                    : quadraticLineSearchV2(coord, energyFunc, cgParams.maxDist, result.gradInfNorm, cgParams.lambdaMax);
+                    ? backtrackingLineSearch(coord, energyFunc, cgParams.maxDist, maxDirForLineSearch, lambdaMax, &lambdaAvg, 0)
+                    : quadraticLineSearchV2(coord, energyFunc, cgParams.maxDist, maxDirForLineSearch, lambdaMax);
 
             }
             const auto lambda = lsr.lambda;
@@ -1499,7 +1570,13 @@ public:
                 cout<<"betaPR "<<betaPR<<" betaFR "<<betaFR<<" beta "<<beta<<endl;*/
 
                 // Shift gradient.
-                shiftSearchDir(beta);
+                if constexpr(method == ConjugateGradientDescentSearch::lbfgs) {
+                    updateLbfgsHistory(lambda);
+                    computeLbfgsSearchDir();
+                }
+                else {
+                    shiftSearchDir(beta);
+                }
 
                 // Reset search direction if conjugacy is lost.
                 if(searchDirDotForce() <= 0) {
@@ -1529,7 +1606,7 @@ public:
 #endif
 
                 //@@@{ STEP 10 vectorized copy
-                if constexpr(method == ConjugateGradientDescentSearch::polakRibiere) {
+                if constexpr(method == ConjugateGradientDescentSearch::polakRibiere || method == ConjugateGradientDescentSearch::lbfgs) {
                     tbegin = chrono::high_resolution_clock::now();
                     forcePrev = force;
                     tend = chrono::high_resolution_clock::now();
@@ -1718,9 +1795,10 @@ public:
         #endif
 
 
-        // Move the forces to the output if required.
+        // Copy the forces to the output if required.
+        // The force vector is copied rather than moved, so that both buffers keep their capacity for the next minimization.
         if(ptrOutForce) {
-            *ptrOutForce = std::move(force);
+            ptrOutForce->assign(force.begin(), force.end());
         }
 
         tend = chrono::high_resolution_clock::now();
@@ -1731,8 +1809,8 @@ public:
 #ifdef DETAILEDOUTPUT
         std::cout<<"printing beads & forces"<<endl;
         for(auto b:Bead::getBeads()){
-            std::cout<<b->getId()<<" "<< b->coord <<" "
-                    ""<<b->force <<endl;
+            std::cout<<b->getId()<<" "<< b->coordinate() <<" "
+                    ""<<b->force() <<endl;
         }
         std::cout<<"printed beads & forces"<<endl;
 #endif
@@ -1742,6 +1820,125 @@ public:
 
     } // minimize(...)
 
+    /// Minimize the system using the fast inertial relaxation engine (FIRE)
+    // The implementation follows Bitzek et al. (2006), with the uphill correction of Guénolé et al. (2020).
+    // Note:
+    //   - Only force computations are used during iterations, so the energy relative change criterion does not apply.
+    //   - No line search is performed, so funcRecoveryOnError is never called.
+    //   - The function signatures are the same as in the conjugate gradient minimize function.
+    template< typename EnergyFunc, typename ForceFunc, typename EnergyFuncIndividual, typename FuncRecoveryOnError >
+    MinimizationResult minimizeFire(
+        const ConjugateGradientParams& cgParams,
+        std::vector< floatingpoint >&  coord,
+        int                            numDof,
+        EnergyFunc&&                   energyFunc,
+        ForceFunc&&                    forceFunc,
+        EnergyFuncIndividual&&         energyFuncIndividual,
+        FuncRecoveryOnError&&          funcRecoveryOnError,
+        std::vector< floatingpoint >*  ptrOutForce
+    ) {
+        using namespace std;
+
+        MinimizationResult result;
+        result.energyCallLimit = cgParams.energyCallLimit;
+        result.gradTol         = cgParams.gradTol;
+        result.energyRelTol    = cgParams.energyRelTol;
+
+        {
+            int beadMaxStep = 3 * Bead::numBeads();
+            result.forceCallLimit = std::max<int>(cgParams.forceCallLimit, beadMaxStep);
+        }
+
+        startMinimization();
+
+        this->numDof = numDof;
+        forceTol.resize(numDof, cgParams.gradTol);
+        velocity.assign(numDof, 0);
+
+        const auto nvar = coord.size();
+        force.assign(nvar, 0);
+
+        // Initial energy and force computation.
+        result.energiesBefore = energyFuncIndividual(coord.data());
+        ++result.numEnergyCall;
+        forceFunc(coord.data(), force.data(), force.size());
+        ++result.numForceCall;
+        result.gradInfNorm = maxF();
+
+        floatingpoint dt = cgParams.fireDtInit;
+        floatingpoint alpha = FIRE_ALPHASTART;
+        int numStepsPositivePower = 0;
+        // The last coordinate change is lastStepFactor * velocity.
+        floatingpoint lastStepFactor = 0;
+
+        while(
+            !result.callLimitExceeded() &&
+            !result.converged()
+        ) {
+            // Adapt the time step according to the power of the force.
+            double power = 0;
+            for(Index i = 0; i < numDof; ++i) power += force[i] * velocity[i];
+
+            if(power > 0) {
+                ++numStepsPositivePower;
+                if(numStepsPositivePower > FIRE_NMIN) {
+                    dt = std::min(dt * FIRE_FINC, cgParams.fireDtMax);
+                    alpha *= FIRE_FALPHA;
+                }
+            }
+            else {
+                numStepsPositivePower = 0;
+                dt *= FIRE_FDEC;
+                alpha = FIRE_ALPHASTART;
+                // Step back half of the last move, which went uphill.
+                for(Index i = 0; i < numDof; ++i) coord[i] -= 0.5 * lastStepFactor * velocity[i];
+                std::fill(velocity.begin(), velocity.end(), 0);
+            }
+
+            // Semi-implicit Euler integration, with velocity mixed towards the force direction.
+            for(Index i = 0; i < numDof; ++i) velocity[i] += dt * force[i];
+            {
+                double vDotV = 0, fDotF = 0;
+                for(Index i = 0; i < numDof; ++i) {
+                    vDotV += velocity[i] * velocity[i];
+                    fDotF += force[i] * force[i];
+                }
+                const auto mix = fDotF > 0 ? alpha * std::sqrt(vDotV / fDotF) : 0.0;
+                for(Index i = 0; i < numDof; ++i) velocity[i] = (1 - alpha) * velocity[i] + mix * force[i];
+            }
+
+            // Limit the bead moves by maxDist.
+            {
+                floatingpoint maxVelocity = 0;
+                for(Index i = 0; i < numDof; ++i) maxVelocity = std::max(maxVelocity, std::abs(velocity[i]));
+                lastStepFactor = maxVelocity * dt > cgParams.maxDist ? cgParams.maxDist / maxVelocity : dt;
+            }
+            for(Index i = 0; i < numDof; ++i) coord[i] += lastStepFactor * velocity[i];
+
+            forceFunc(coord.data(), force.data(), force.size());
+            ++result.numForceCall;
+            result.gradInfNorm = maxF();
+        }
+
+        if (cgParams.reportOnCallLimit && result.callLimitExceeded()) {
+            log::warn("Did not minimize in limited steps.");
+            log::info("{} energy calls, {} force calls, max force = {}.",
+                result.numEnergyCall, result.numForceCall, result.gradInfNorm);
+            log::info("System energy... {}", energyFuncIndividual(coord.data()));
+        }
+
+        result.energiesAfter = energyFuncIndividual(coord.data());
+        ++result.numEnergyCall;
+
+        endMinimization();
+
+        if(ptrOutForce) {
+            ptrOutForce->assign(force.begin(), force.end());
+        }
+
+        return result;
+    } // minimizeFire(...)
+
     // Select the correct version to run.
     template< typename... Args >
     auto minimize(const ConjugateGradientParams& cgParams, Args&&... args) {
@@ -1752,6 +1949,10 @@ public:
                 return minimize<ConjugateGradientDescentSearch::fletcherRieves>(cgParams, std::forward<Args>(args)...);
             case ConjugateGradientDescentSearch::polakRibiere:
                 return minimize<ConjugateGradientDescentSearch::polakRibiere  >(cgParams, std::forward<Args>(args)...);
+            case ConjugateGradientDescentSearch::lbfgs:
+                return minimize<ConjugateGradientDescentSearch::lbfgs         >(cgParams, std::forward<Args>(args)...);
+            case ConjugateGradientDescentSearch::fire:
+                return minimizeFire(cgParams, std::forward<Args>(args)...);
             default:
                 log::error("Unrecognized descent search method: {}", medyan::underlying(cgParams.descentSearchMethod));
                 throw std::runtime_error("Unrecognized descent search method");
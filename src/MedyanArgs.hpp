@@ -57,7 +57,7 @@ inline auto medyanInitFromCommandLine(int argc, char** argv) {
                 res.cmdConfig.guiEnabled = true;
             }
         ));
-        cmdMain.addOption(makeOptionWithVar('t', "", "int", "Thread count (0 for auto)", false, res.cmdConfig.numThreads));
+        cmdMain.addOption(makeOptionWithVar('t', "threads", "int", "Thread count (0 for auto)", false, res.cmdConfig.numThreads));
         cmdMain.addOption(Option(0, "trap-fp-invalid", "Enable trapping of floating point invalid operations", false,
             [&](const Command&) {
                 res.cmdConfig.trapInvalidFP = true;
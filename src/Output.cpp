@@ -12,6 +12,7 @@
 //------------------------------------------------------------------
 #include <cmath>
 #include <algorithm>
+#include <limits>
 
 #include "Output.h"
 #include "Chemistry/ChemNRMImpl.h"
@@ -346,10 +347,11 @@ void WallTensions::print(int snapshot) {
             Bead* b = cylinder->getFirstBead();
 
             if(b->isPinned()) {
-                auto norm = _subSystem->getBoundary()->normal(b->pinnedPosition);
-                auto dirL = twoPointDirection(b->pinnedPosition, b->vcoordinate());
+                const auto pinned = vector2Vec<3, floatingpoint>(b->pinnedPosition);
+                auto norm = _subSystem->getBoundary()->normal(pinned);
+                auto dirL = twoPointDirection(pinned, b->coordinate());
                 
-                floatingpoint deltaL = twoPointDistance(b->vcoordinate(), b->pinnedPosition);
+                floatingpoint deltaL = twoPointDistance(b->coordinate(), pinned);
                 
                 _outputFile<< k * deltaL * dotProduct(norm, dirL) << " ";
             }
@@ -363,10 +365,11 @@ void WallTensions::print(int snapshot) {
         Bead* b = cylinder->getSecondBead();
 
         if(b->isPinned()) {
-            auto norm = _subSystem->getBoundary()->normal(b->pinnedPosition);
-            auto dirL = twoPointDirection(b->pinnedPosition, b->vcoordinate());
+            const auto pinned = vector2Vec<3, floatingpoint>(b->pinnedPosition);
+            auto norm = _subSystem->getBoundary()->normal(pinned);
+            auto dirL = twoPointDirection(pinned, b->coordinate());
             
-            floatingpoint deltaL = twoPointDistance(b->vcoordinate(), b->pinnedPosition);
+            floatingpoint deltaL = twoPointDistance(b->coordinate(), pinned);
             
             _outputFile<< k * deltaL * dotProduct(norm, dirL) << " ";
         }
@@ -1040,15 +1043,21 @@ void LinkerBindingEvents::print(int snapshot) {
 }
 
 
-void Datadump::print(int snapshot) {
-    _outputFile.close();
-    _outputFile.open(_outputFileName, std::ofstream::trunc);
-	_outputFile.precision(15);
-    if(!_outputFile.is_open()) {
+void Datadump::write(const string& text) {
+    _file.close();
+    _file.open(_outputFileName, std::ofstream::trunc);
+    if(!_file.is_open()) {
         cout << "There was an error opening file " << _outputFileName
              << " for output. Exiting." << endl;
         exit(EXIT_FAILURE);
     }
+    _file << text;
+    _file.flush();
+}
+
+void Datadump::print(int snapshot) {
+    // Full precision, so that a restart reads back exactly the same values.
+	_outputFile.precision(std::numeric_limits<double>::max_digits10);
     //Rearrange bead and cylinder data to create a continuous array.
     Bead::rearrange();
 	Cylinder::updateAllData();
@@ -1070,8 +1079,8 @@ void Datadump::print(int snapshot) {
         auto bidx = b->getStableIndex();
         Filament* f = static_cast<Filament*>(b->getParent());
         _outputFile <<bidx<<" "<<f->getId()<<" "<<b->getPosition()<<" "
-            << b->coord[0] << ' ' << b->coord[1] << ' ' << b->coord[2] << ' '
-            << b->force[0] << ' ' << b->force[1] << ' ' << b->force[2] << endl;
+            << b->coordinate()[0] << ' ' << b->coordinate()[1] << ' ' << b->coordinate()[2] << ' '
+            << b->force()[0] << ' ' << b->force()[1] << ' ' << b->force()[2] << endl;
 
     }
     _outputFile <<endl;
@@ -1316,30 +1325,40 @@ void Datadump::print(int snapshot) {
 }
 
 void HessianMatrix::print(int snapshot){
-    _outputFile.precision(10);
-    vector<vector<vector<floatingpoint > > > hVec = _ffm->hessianVector;
-    vector<floatingpoint> tauVector = _ffm-> tauVector;
-    // Outputs a sparse representation of the Hessian matrix, where only elements with appreciable size (>0.00001) are
-    // output along with their indices.  Currently this outputs for each minimization, however to reduce the file size this could be changed.
+    const auto& hVec = _ffm->hessianVector;
+    const auto& tauVector = _ffm->tauVector;
+    // Outputs the Hessian matrix in compressed sparse row format, where only elements with appreciable size (>0.00001) are
+    // stored.  Currently this outputs for each minimization, however to reduce the file size this could be changed.
     
-    if(counter % SysParams::Mechanics().hessSkip == 0){
+    if(counter % SysParams::Mechanics().hessSkip == 0 && !hVec.empty()){
         int k = 0;
-        vector<vector<floatingpoint > > hMat = hVec[k];
-        int total_DOF = hMat.size();
-        vector<tuple<int, int, floatingpoint>> elements;
+        const Eigen::SparseMatrix<double, Eigen::RowMajor> hMat = hVec[k];
+        const int total_DOF = hMat.rows();
+
+        PendingHessian h;
+        h.index = _numWritten;
+        h.tau = tauVector[k];
+        h.numDof = total_DOF;
+        h.indptr.reserve(total_DOF + 1);
+        h.indptr.push_back(0);
         for(auto i = 0; i < total_DOF; i++){
-            for(auto j = 0; j < total_DOF; j++){
-                if(std::abs(hMat[i][j]) > 0.00001){
-                    elements.push_back(std::make_tuple(i,j,hMat[i][j]));
+            for(Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(hMat, i); it; ++it){
+                if(std::abs(it.value()) > 0.00001){
+                    h.indices.push_back(it.col());
+                    h.data.push_back(it.value());
                 }
             }
+            h.indptr.push_back(h.indices.size());
         }
-        _outputFile << tauVector[k] << "     "<< total_DOF<< "     " << elements.size()<<endl;
-        for(auto i = 0; i < elements.size(); i++){
-            tuple<int, int, floatingpoint> element = elements[i];
-            _outputFile<< get<0>(element) << "     "<< get<1>(element)<<"     "<< get<2>(element)<<endl;
+
+        _outputFile.precision(10);
+        _outputFile << tauVector[k] << "     "<< total_DOF<< "     " << h.data.size() << "     " << _numWritten << endl;
+        ++_numWritten;
+
+        {
+            std::lock_guard<std::mutex> lock(_pendingMutex);
+            _pending.push_back(std::move(h));
         }
-    _outputFile<<endl;
 
     _ffm->clearHessian(0);
     };
@@ -1348,6 +1367,29 @@ void HessianMatrix::print(int snapshot){
     
 }
 
+void HessianMatrix::write(const string& text) {
+    Output::write(text);
+
+    vector<PendingHessian> pending;
+    {
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        pending.swap(_pending);
+    }
+    if(pending.empty()) return;
+
+    h5::File file(_h5FileName, h5::File::ReadWrite);
+    for(const auto& h : pending) {
+        h5::Group grpHessian = file.getGroup("hessians").createGroup(to_string(h.index));
+        h5::writeDataSet(grpHessian, "tau", h.tau);
+        h5::writeDataSet(grpHessian, "numDof", h.numDof);
+        h5::writeDataSet(grpHessian, "indptr", h.indptr);
+        h5::writeDataSet(grpHessian, "indices", h.indices);
+        h5::writeDataSet(grpHessian, "data", h.data);
+    }
+    h5::Group grpHeader = file.getGroup("header");
+    h5::writeDataSet(grpHeader, "count", pending.back().index + 1);
+}
+
 
 void HessianSpectra::print(int snapshot){
     _outputFile.precision(10);
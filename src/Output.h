@@ -15,6 +15,8 @@
 #define MEDYAN_Output_h
 
 #include <fstream>
+#include <mutex>
+#include <sstream>
 
 #include "common.h"
 #include "MedyanMeta.hpp"
@@ -34,12 +36,15 @@ namespace medyan {
 /*!
  *  An output object, initialized by the Controller, can print a number of specific
  *  output formats, including current snapshot, forces, tensions, and birth times.
+ *  Printing only reads the system and stores the text in a buffer. The buffered
+ *  text is then written to the file by write(), which may run on another thread.
  *  Upon destruction, the output file is closed.
  */
 
 class Output {
 protected:
-    ofstream _outputFile; ///< The output file being used
+    ostringstream _outputFile; ///< The text printed for the current snapshot
+    ofstream _file; ///< The output file being used
 
     SubSystem* _subSystem = nullptr;
 
@@ -47,8 +52,8 @@ public:
     string _outputFileName;
     /// Constructor, which opens the output file
     Output(string outputFileName, SubSystem* s) {
-        _outputFile.open(outputFileName);
-        if(!_outputFile.is_open()) {
+        _file.open(outputFileName);
+        if(!_file.is_open()) {
             cout << "There was an error opening file " << outputFileName
             << " for output. Exiting." << endl;
             exit(EXIT_FAILURE);
@@ -59,13 +64,37 @@ public:
         _outputFileName = outputFileName;
     }
     /// Destructor, which closes the output file
-    virtual ~Output() {_outputFile.close();}
+    virtual ~Output() {_file.close();}
 
     /// To be implemented in sub classes
     virtual void print(int snapshot) = 0;
     virtual void print(int snapshot, const SimulConfig& conf) {
         print(snapshot);
     }
+
+    /// Whether printing only reads the system, in which case this output
+    /// can be printed concurrently with other read-only outputs.
+    virtual bool isReadOnly() const { return false; }
+
+    /// Move the printed text to the buffer, and clear the printed text.
+    void takePrinted(string& buffer) {
+        buffer = _outputFile.str();
+        _outputFile.str({});
+    }
+
+    /// Write the text to the output file. It does not access the system, so
+    /// it can run on a background writer thread.
+    virtual void write(const string& text) {
+        _file << text;
+        _file.flush();
+    }
+
+    /// Write the printed text to the output file on the calling thread.
+    void writePrinted() {
+        string text;
+        takePrinted(text);
+        write(text);
+    }
 };
 
 /// Print basic information about all Filament, Linker,
@@ -78,6 +107,7 @@ public:
 
     virtual void print(int snapshot) override {}
     virtual void print(int snapshot, const SimulConfig& conf) override;
+    virtual bool isReadOnly() const override { return true; }
 };
 
 /// Print birth times of beads for each Filament, Linker,
@@ -89,6 +119,7 @@ public:
     ~BirthTimes() {}
 
     virtual void print(int snapshot);
+    virtual bool isReadOnly() const override { return true; }
 };
 
 /// Print forces on beads for each Filament
@@ -99,6 +130,7 @@ public:
     ~Forces() {}
 
     virtual void print(int snapshot);
+    virtual bool isReadOnly() const override { return true; }
 };
 
 /// Print tension for each Filament, Linker, and MotorGhost
@@ -113,6 +145,7 @@ public:
     ~Tensions() {}
 
     virtual void print(int snapshot);
+    virtual bool isReadOnly() const override { return true; }
 };
 
 /// Print wall tension for each pinned filament:
@@ -214,6 +247,7 @@ public:
     ~PlusEnd() {}
 
     virtual void print(int snapshot);
+    virtual bool isReadOnly() const override { return true; }
 };
 
 
@@ -225,6 +259,7 @@ public:
     ~ReactionOut() {}
     
     virtual void print(int snapshot);
+    virtual bool isReadOnly() const override { return true; }
 };
 
 
@@ -299,6 +334,7 @@ public:
     ~BRForces() {}
 
     virtual void print(int snapshot);
+    virtual bool isReadOnly() const override { return true; }
 };
 
 
@@ -315,6 +351,7 @@ public:
     ~Concentrations() {}
 
     virtual void print(int snapshot);
+    virtual bool isReadOnly() const override { return true; }
 };
 
 /// Print total, chemdiss, mechdiss, chem, and mech
@@ -376,20 +413,50 @@ public:
 
 
 
+/// Prints the sparse Hessian matrices.
+/*!
+ *  The matrices are written to an HDF5 file in compressed sparse row format,
+ *  where the group "hessians/<index>" contains "tau", "numDof", "indptr",
+ *  "indices" and "data". The text output lists the time, the number of degrees
+ *  of freedom, the number of stored entries and the index of each matrix.
+ */
 class HessianMatrix : public Output {
     
     ForceFieldManager* _ffm;
     
     int counter = 0;
-    
-public:
-    HessianMatrix(string outputFileName, SubSystem* s, ForceFieldManager* ffm)
-    
-    : Output(outputFileName, s), _ffm(ffm) {}
+
+    string _h5FileName;
+    std::int64_t _numWritten = 0;
+
+    // Hessian in compressed sparse row format, printed but not yet written.
+    struct PendingHessian {
+        std::int64_t              index = 0;
+        double                    tau = 0;
+        std::int64_t              numDof = 0;
+        std::vector<std::int64_t> indptr;
+        std::vector<std::int64_t> indices;
+        std::vector<double>       data;
+    };
+    // The HDF5 file is written in write() on the writer thread, which may
+    // still be writing while the next Hessian is printed.
+    std::mutex                  _pendingMutex;
+    std::vector<PendingHessian> _pending;
+    
+public:
+    HessianMatrix(string outputFileName, string h5FileName, SubSystem* s, ForceFieldManager* ffm)
+    
+    : Output(outputFileName, s), _ffm(ffm), _h5FileName(std::move(h5FileName)) {
+        h5::File file(_h5FileName, h5::File::ReadWrite | h5::File::Create | h5::File::Truncate);
+        h5::Group grpHeader = file.createGroup("header");
+        h5::writeDataSet(grpHeader, "count", std::int64_t(0));
+        file.createGroup("hessians");
+    }
     
     ~HessianMatrix() {}
     
     virtual void print(int snapshot);
+    virtual void write(const string& text) override;
 };
 
 
@@ -453,6 +520,9 @@ public:
 
 public:
     virtual void print(int snapshot);
+
+    /// The data dump only keeps the latest snapshot, so the file is truncated before writing.
+    virtual void write(const string& text) override;
 };
 
 
@@ -528,40 +598,59 @@ inline void createSnapshotHeader(h5::Group& grpHeader, const SimulConfig& conf,
 
 
 // Auxiliary structure for managing snapshot output in controller.
+//
+// Appending a snapshot is split into extraction and writing. Extraction reads
+// the system, while writing only accesses the extracted data and the file, so
+// that writing can run on a background writer thread.
 struct SnapshotOutput {
     std::filesystem::path filename;
+    OutputParams          params;
+    // Number of snapshots extracted.
+    std::int64_t numExtracted = 0;
 
     void init(const std::filesystem::path& filename, const SimulConfig& conf, const ForceFieldManager& ffm) {
         using namespace h5;
         this->filename = filename;
+        params = conf.outputParams;
+        numExtracted = 0;
         File file(filename.string(), File::ReadWrite | File::Create | File::Truncate);
         Group grpHeader = file.createGroup("header");
 
         createSnapshotHeader(grpHeader, conf, ffm);
+        writeDataSet(grpHeader, "layout", toString(params.trajLayout));
+
+        if(params.trajLayout == TrajectoryLayout::packed) {
+            params.trajCompression = availableTrajCompression(params.trajCompression);
+            file.createGroup("frames");
+        }
     }
 
-    void append(const SubSystem& sys, const SimulConfig& conf) const {
+    // Extract data of the next snapshot from system.
+    void extractNext(OutputStructSnapshot& outSnapshot, const SubSystem& sys, const SimulConfig& conf) {
+        extract(outSnapshot, sys, conf, numExtracted);
+        ++numExtracted;
+    }
+
+    // Write an extracted snapshot to file. Snapshots must be written in the order of extraction.
+    void write(const OutputStructSnapshot& outSnapshot) const {
         using namespace h5;
         File file(filename.string(), File::ReadWrite);
 
-        // Get header snapshot count.
-        Group grpHeader = file.getGroup("header");
-        std::int64_t count = 0;
-        readDataSet(count, grpHeader, "count");
-
-        // Extract data from system.
-        OutputStructSnapshot outSnapshot;
-        extract(outSnapshot, sys, conf, count);
-
         // Write to file.
-        Group grpSnapshots = file.exist("snapshots")
-            ? file.getGroup("snapshots")
-            : file.createGroup("snapshots");
-        write(grpSnapshots, outSnapshot);
+        if(params.trajLayout == TrajectoryLayout::packed) {
+            Group grpFrames = file.getGroup("frames");
+            writePacked(grpFrames, outSnapshot, params);
+        }
+        else {
+            Group grpSnapshots = file.exist("snapshots")
+                ? file.getGroup("snapshots")
+                : file.createGroup("snapshots");
+            medyan::write(grpSnapshots, outSnapshot);
+        }
 
         // Update header snapshot count.
-        ++count;
-        writeDataSet(grpHeader, "count", count);
+        Group grpHeader = file.getGroup("header");
+        writeDataSet(grpHeader, "count", std::int64_t(outSnapshot.snapshot + 1));
     }
 
     void finish() const {
@@ -571,6 +660,14 @@ struct SnapshotOutput {
     }
 };
 
+// Data of a snapshot extracted from the system, to be written by the trajectory writer.
+struct SnapshotOutputBuffer {
+    // Printed text of each output.
+    std::vector< std::string > texts;
+    // Data for the snapshot output.
+    OutputStructSnapshot       snapshot;
+};
+
 } // namespace medyan
 
 #endif
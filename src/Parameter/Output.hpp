@@ -1,12 +1,89 @@
 #ifndef MEDYAN_Parameter_Output_hpp
 #define MEDYAN_Parameter_Output_hpp
 
+#include <stdexcept>
+#include <string>
+
+#include "Util/Parser/StringParser.hpp"
+
 namespace medyan {
 
+// Layout of snapshots in the trajectory file.
+enum class TrajectoryLayout {
+    group,   // Each snapshot is stored in its own group.
+    packed,  // Snapshots are concatenated in extendible, chunked datasets.
+};
+
+// Compression filter of the packed trajectory datasets.
+enum class TrajectoryCompression {
+    none,
+    gzip,
+    szip,
+    lzf,     // Requires the LZF filter plugin for HDF5.
+};
+
 struct OutputParams {
     // Controls some of the logging behavior.
     bool logBriefProfilingEachSnapshot = false;
     bool logSimulationTimeEachCycle = false;
+
+    // Trajectory file layout.
+    TrajectoryLayout      trajLayout = TrajectoryLayout::group;
+    TrajectoryCompression trajCompression = TrajectoryCompression::gzip;
+    // Compression level for gzip, from 0 to 9.
+    int                   trajCompressionLevel = 4;
+
+    // Write a restart checkpoint every this many data dumps. 0 disables checkpoints.
+    Size checkpointInterval = 0;
+};
+
+
+template<>
+struct StringSerializerTrait<TrajectoryLayout> {
+    auto parse(std::string_view sv) const {
+        if (sv == "group") {
+            return TrajectoryLayout::group;
+        } else if (sv == "packed") {
+            return TrajectoryLayout::packed;
+        } else {
+            throw std::invalid_argument("Invalid trajectory layout.");
+        }
+    }
+
+    std::string toString(TrajectoryLayout val) const {
+        switch(val) {
+            case TrajectoryLayout::group:  return "group";
+            case TrajectoryLayout::packed: return "packed";
+            default:                       return "error";
+        }
+    }
+};
+
+template<>
+struct StringSerializerTrait<TrajectoryCompression> {
+    auto parse(std::string_view sv) const {
+        if (sv == "none") {
+            return TrajectoryCompression::none;
+        } else if (sv == "gzip") {
+            return TrajectoryCompression::gzip;
+        } else if (sv == "szip") {
+            return TrajectoryCompression::szip;
+        } else if (sv == "lzf") {
+            return TrajectoryCompression::lzf;
+        } else {
+            throw std::invalid_argument("Invalid trajectory compression.");
+        }
+    }
+
+    std::string toString(TrajectoryCompression val) const {
+        switch(val) {
+            case TrajectoryCompression::none: return "none";
+            case TrajectoryCompression::gzip: return "gzip";
+            case TrajectoryCompression::szip: return "szip";
+            case TrajectoryCompression::lzf:  return "lzf";
+            default:                          return "error";
+        }
+    }
 };
 
 } // namespace medyan
@@ -692,6 +692,18 @@ KeyValueParser<SimulConfig> buildSystemParser() {
             "adapt-mesh-during-minimization",
             [](auto&& conf) -> auto& { return conf.mechParams.mechanicsAlgorithm.adaptMeshDuringMinimization; }
         );
+        sysParser.addSingleArg(
+            "lbfgs-num-history",
+            [](auto&& conf) -> auto& { return conf.mechParams.mechanicsAlgorithm.lbfgsNumHistory; }
+        );
+        sysParser.addSingleArg(
+            "fire-dt-init",
+            [](auto&& conf) -> auto& { return conf.mechParams.mechanicsAlgorithm.fireDtInit; }
+        );
+        sysParser.addSingleArg(
+            "fire-dt-max",
+            [](auto&& conf) -> auto& { return conf.mechParams.mechanicsAlgorithm.fireDtMax; }
+        );
         sysParser.addEmptyLine();
 
         sysParser.addComment("====== Force fields ======");
@@ -1804,6 +1816,11 @@ KeyValueParser<SimulConfig> buildSystemParser() {
                 return res;
             }
         );
+        sysParser.addComment(" Number of the smallest Hessian eigenpairs computed, if the dense estimation is off.");
+        sysParser.addSingleArg(
+            "hessian-num-eigs",
+            [](auto&& conf) -> auto& { return conf.mechParams.hessNumEigs; }
+        );
 
         sysParser.addEmptyLine();
 
@@ -2033,6 +2050,22 @@ KeyValueParser<SimulConfig> buildSystemParser() {
                 return vector<string> { sc.chemParams.chemistryAlgorithm.algorithm };
             }
         );
+        sysParser.addSingleArg(
+            "chem-partition-num-domains",
+            [](auto&& conf) -> auto& { return conf.chemParams.chemistryAlgorithm.partitionNumDomains; }
+        );
+        sysParser.addSingleArg(
+            "chem-partition-sync-time",
+            [](auto&& conf) -> auto& { return conf.chemParams.chemistryAlgorithm.partitionSyncTime; }
+        );
+        sysParser.addSingleArg(
+            "chem-hybrid-copy-number-threshold",
+            [](auto&& conf) -> auto& { return conf.chemParams.chemistryAlgorithm.hybridCopyNumberThreshold; }
+        );
+        sysParser.addSingleArg(
+            "chem-hybrid-leap-time",
+            [](auto&& conf) -> auto& { return conf.chemParams.chemistryAlgorithm.hybridLeapTime; }
+        );
         sysParser.addEmptyLine();
 
         sysParser.addComment(" Use either time mode or step mode");
@@ -2207,6 +2240,11 @@ KeyValueParser<SimulConfig> buildSystemParser() {
                 return vector<string> { toString(sc.chemParams.chemistryAlgorithm.neighborListSteps) };
             }
         );
+        sysParser.addComment(" Cylinder neighbor lists are rebuilt only after cylinders move by half the skin");
+        sysParser.addSingleArg(
+            "neighbor-list-skin",
+            [](auto&& conf) -> auto& { return conf.chemParams.chemistryAlgorithm.neighborListSkin; }
+        );
         sysParser.addEmptyLine();
 
         sysParser.addComment("====== Chemistry setup ======");
@@ -2655,6 +2693,23 @@ KeyValueParser<SimulConfig> buildSystemParser() {
             }
         );
         sysParser.addEmptyLine();
+
+        sysParser.addComment(" Force tolerance (pN) for updating rates after minimization.");
+        sysParser.addComment(" - The rates of an element are only updated if a force they depend on");
+        sysParser.addComment("   has changed by more than this value. 0 updates on any change.");
+        sysParser.addEmptyLine();
+        sysParser.addStringArgsWithAliases(
+            "RATEUPDATEFORCETOL", { "RATEUPDATEFORCETOL:" },
+            [] (SimulConfig& sc, const vector<string>& lineVector) {
+                if (lineVector.size() >= 2) {
+                    sc.dyRateParams.rateUpdateForceTolerance = atof((lineVector[1].c_str()));
+                }
+            },
+            [] (const SimulConfig& sc) {
+                return vector<string> { toString(sc.dyRateParams.rateUpdateForceTolerance) };
+            }
+        );
+        sysParser.addEmptyLine();
     }
 
     //--------------------------------------------------------------------------
@@ -17,6 +17,9 @@
 #include <cmath>
 #include <limits>
 #include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <type_traits>
 
 #include "common.h"
@@ -35,6 +38,20 @@ public:
         inline static int chemistrycounter = 0;
 	#endif
 
+    // Save and restore the state of the engine, using its standard text representation.
+    static std::string engState() {
+        std::ostringstream oss;
+        oss << eng;
+        return oss.str();
+    }
+    static void setEngState(const std::string& state) {
+        std::istringstream iss(state);
+        iss >> eng;
+        if(iss.fail()) {
+            throw std::runtime_error("Invalid random engine state.");
+        }
+    }
+
     // Get a random floatingpoint between low and high.
     static inline floatingpoint randfloatingpoint(floatingpoint low, floatingpoint high) {
         #ifdef DEBUGCONSTANTSEED
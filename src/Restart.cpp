@@ -335,7 +335,7 @@ void Restart::setupInitialNetwork() {
         auto pBead = _subSystem->addTrackable<Bead>(tempcoord, filptr, _rBData.filpos[b]);
         //Copy Forces
         for(unsigned int dim = 0; dim < 3; dim++)
-            pBead->force[dim] = _rBData.forceAuxvec.data()[3*bID+dim];
+            pBead->force()[dim] = _rBData.forceAuxvec.data()[3*bID+dim];
     }
     cout<<"Num beads created "<<Bead::getBeads().size()<<endl;
 
@@ -348,6 +348,7 @@ void Restart::setupInitialNetwork() {
         Cylinder* c0 = _subSystem->addTrackable<Cylinder> (filptr, b1, b2, _filType,
                                                            cyl.filpos, false, false,
                                                            true, cyl.eqlen);
+        _subSystem->cylinderNeighborListSkin.markTopologyChanged();
         cyl.cylinderpointer = c0;
 
         //set minusend or plusend
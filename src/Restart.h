@@ -17,6 +17,8 @@
 #include "common.h"
 #include <random>
 #include <chrono>
+#include <fstream>
+#include <sstream>
 
 #include "SubSystem.h"
 #include "Boundary.h"
@@ -35,6 +37,7 @@
 #include "MathFunctions.h"
 #include "Cylinder.h"
 #include "RestartParams.h"
+#include "Structure/OutputStruct.hpp"
 #include <unordered_set>
 #include <unordered_map>
 #include <algorithm>
@@ -57,7 +60,7 @@ private:
     vector<floatingpoint> CopyNumbers;
     int  _numChemSteps=0;
 
-	fstream _inputFile; ///< input file being used
+	stringstream _inputFile; ///< contents of the input data dump
 	restartSystemData _rsystemdata;
 	restartBeadData _rBData;
 	vector<restartFilData> _rFDatavec;
@@ -104,16 +107,18 @@ private:
 public:
     Restart(SubSystem* s, ChemistryData _cd, const string inputFileName)
             : _subSystem(s), _chemData(_cd) {
-	    _inputFile.open(inputFileName);
-	    if(!_inputFile.is_open()) {
+	    ifstream inputFile(inputFileName);
+	    if(!inputFile.is_open()) {
 		    cout << "There was an error parsing file " << inputFileName
 		         << ". Exiting." << endl;
 		    exit(EXIT_FAILURE);
 	    }
-
+	    _inputFile << inputFile.rdbuf();
     }
 
-    ~Restart(){_inputFile.close();}
+    /// Restart from the data dump text stored in a checkpoint.
+    Restart(SubSystem* s, ChemistryData _cd, const OutputStructCheckpoint& checkpoint)
+            : _subSystem(s), _chemData(_cd), _inputFile(checkpoint.datadump) {}
 
     void readNetworkSetup();
 
@@ -28,12 +28,12 @@ std::vector<Bead*> Bead::_pinnedBeads;
 Bead::Bead (vector<floatingpoint> v, Composite* parent, int position)
 //add brforce, pinforce
     : Trackable(true, false, true, false),
-      coord(vector2Vec<3>(v)),
-      force{},
       coordinateP(v),
       brforce(3, 0), pinforce(3,0),
       _position(position), _birthTime(tau()) {
 
+    beadData_.pushBack(vector2Vec<3>(v));
+
     parent->addChild(unique_ptr<Component>(this));
           
     loadForcesP = vector<floatingpoint>(SysParams::Geometry().cylinderNumMon[getType()], 0.0);
@@ -58,15 +58,34 @@ Bead::Bead (vector<floatingpoint> v, Composite* parent, int position)
 Bead::Bead(Composite* parent, int position)
 //add brforce, pinforce
     : Trackable(true, false, true, false),
-    coord{},
-    force{},
     coordinateP(3, 0),
     brforce(3, 0), pinforce(3,0), _position(position) {
-    
+
+    beadData_.pushBack({});
+
     parent->addChild(unique_ptr<Component>(this));
 
 }
 
+Bead::Bead(const Bead& rhs)
+    : Component(rhs), Trackable(rhs), Movable(rhs), DynamicNeighbor(rhs), DatabaseType(rhs),
+      coordinateP(rhs.coordinateP),
+      brforce(rhs.brforce), pinforce(rhs.pinforce),
+      loadForcesP(rhs.loadForcesP), loadForcesM(rhs.loadForcesM),
+      lfip(rhs.lfip), lfim(rhs.lfim),
+      monomerSerial(rhs.monomerSerial),
+      pinnedPosition(rhs.pinnedPosition),
+      isStatic(rhs.isStatic),
+      _compartment(rhs._compartment),
+      _position(rhs._position), _birthTime(rhs._birthTime), _isPinned(rhs._isPinned) {
+
+    // The data of rhs might be relocated by push back.
+    const auto rhsCoord = rhs.coordinate();
+    const auto rhsForce = rhs.force();
+    beadData_.pushBack(rhsCoord);
+    force() = rhsForce;
+}
+
 void Bead::updatePosition() {
     
     try {GController::getCompartment(vec2Vector(coordinate()));}
@@ -91,7 +110,7 @@ void Bead::printSelf()const {
     cout << "Bead: ptr = " << this << endl;
     cout << "Coordinates = " << coordinate()[0] << ", " << coordinate()[1] << ", " << coordinate()[2] << endl;
     cout << "Previous coordinates before minimization = " << coordinateP[0] << ", " << coordinateP[1] << ", " << coordinateP[2] << endl;
-    cout << "Forces = " << force[0] << ", " << force[1] << ", " << force[2] << endl;
+    cout << "Forces = " << force()[0] << ", " << force()[1] << ", " << force()[2] << endl;
 
     cout << "Position on structure = " << _position << endl;
     cout << "Birth time = " << _birthTime << endl;
@@ -20,6 +20,7 @@
 
 #include "common.h"
 #include "MathFunctions.h" // vec2Vector
+#include "Structure/BeadData.hpp"
 #include "Structure/Database.h"
 #include "Component.h"
 #include "Composite.h"
@@ -40,8 +41,8 @@ class Filament;
 /*!
  *  Beads are the "hinges" between [Cylinders](@ref Cylinder). In the minimization 
  *  algorithms, beads are moved corresponding to external forces, for example, Filament 
- *  stretching and bending. The bead class contains currernt coordinates and forces, and 
- *  has functions to calculate dot products for the minimization algorithms.
+ *  stretching and bending. The current coordinates and forces of all beads are stored
+ *  contiguously in BeadData, and each bead accesses them using its database index.
  *
  *  Extending the Movable class, the positions of all instances can 
  *  be updated by the SubSystem.
@@ -56,9 +57,6 @@ class Bead : public Component, public Trackable, public Movable, public DynamicN
 public:
     using DatabaseType = Database< Bead, true >;
 
-    medyan::Vec< 3, floatingpoint > coord;
-    medyan::Vec< 3, floatingpoint > force;
-
     ///@note - all vectors are in x,y,z coordinates.
     vector<floatingpoint> coordinateP; ///< Prev coordinates of bead in CG minimization
 
@@ -117,10 +115,22 @@ public:
     ///Default constructor
     Bead(Composite* parent, int position);
 
-    auto& coordinate() { return coord; }
-    const auto& coordinate() const { return coord; }
+    /// Copy constructor also copies the coordinates and forces.
+    Bead(const Bead& rhs);
+
+    ~Bead() { beadData_.removeBySwapWithLast(getIndex()); }
+
+    // Coordinates and forces of all beads.
+    static auto&       getBeadData()      { return beadData_; }
+    static const auto& getBeadDataConst() { return beadData_; }
+
+    auto& coordinate() { return beadData_.coord(getIndex()); }
+    const auto& coordinate() const { return beadData_.coord(getIndex()); }
     // Temporary compromise
-    auto vcoordinate() const { return mathfunc::vec2Vector(coord); }
+    auto vcoordinate() const { return mathfunc::vec2Vector(coordinate()); }
+
+    auto& force() { return beadData_.force(getIndex()); }
+    const auto& force() const { return beadData_.force(getIndex()); }
 
     /// Get Compartment
     Compartment* getCompartment() {return _compartment;}
@@ -195,7 +205,7 @@ public:
     //@{
     /// Auxiliary method for CG minimization
     inline double FDotF() {
-        return magnitude2(force);
+        return magnitude2(force());
     }
 //    inline double FDotF() {
 //        return force1[0]*force1[0] +
@@ -264,6 +274,9 @@ private:
     
     static std::vector<Bead*> _pinnedBeads; ///< Collection of pinned beads in SubSystem
                                          ///< (attached to some element in SubSystem)
+
+    // Indexed by getIndex(), which is kept in sync on bead construction and destruction.
+    inline static BeadData beadData_;
 };
 
 } // namespace medyan
@@ -0,0 +1,66 @@
+#ifndef MEDYAN_Structure_BeadData_hpp
+#define MEDYAN_Structure_BeadData_hpp
+
+#include <type_traits>
+#include <vector>
+
+#include "common.h"
+#include "Util/Math/Vec.hpp"
+
+namespace medyan {
+
+// Stores the coordinates and forces of all beads in contiguous arrays,
+// indexed by the (non-stable) database index of beads.
+//
+// The first 3 * numBeads entries of coords and forces are the flattened bead
+// coordinates and forces, in the same order as Bead::getBeads(). This is also
+// the layout of bead degrees of freedom in energy minimization, so the
+// minimizer directly works on these vectors.
+//
+// Note:
+// - Entries after the bead data are not owned by any bead. During energy
+//   minimization, they hold the other degrees of freedom (see DofSerializer).
+//   They are discarded whenever a bead is added or removed.
+// - References to bead coordinates or forces are invalidated when any bead is
+//   added or removed.
+struct BeadData {
+    using CoordType = Vec< 3, floatingpoint >;
+
+    // Bead coordinates are viewed as Vec in place.
+    static_assert(sizeof(CoordType) == 3 * sizeof(floatingpoint) && std::is_standard_layout_v< CoordType >);
+
+    std::vector< floatingpoint > coords;
+    std::vector< floatingpoint > forces;
+    Size                         numBeads = 0;
+
+    auto&       coord(Index i)       { return *reinterpret_cast<       CoordType* >(coords.data() + 3 * i); }
+    const auto& coord(Index i) const { return *reinterpret_cast< const CoordType* >(coords.data() + 3 * i); }
+    auto&       force(Index i)       { return *reinterpret_cast<       CoordType* >(forces.data() + 3 * i); }
+    const auto& force(Index i) const { return *reinterpret_cast< const CoordType* >(forces.data() + 3 * i); }
+
+    // Append the data of a new bead with zero force.
+    void pushBack(const CoordType& coord) {
+        coords.resize(3 * numBeads);
+        forces.resize(3 * numBeads);
+        coords.insert(coords.end(), coord.begin(), coord.end());
+        forces.insert(forces.end(), 3, 0);
+        ++numBeads;
+    }
+
+    // Remove the data of bead i, by moving the data of the last bead to i.
+    // This follows the index change of removing an element from Database.
+    void removeBySwapWithLast(Index i) {
+        const Index last = numBeads - 1;
+        if(i != last) {
+            coord(i) = coord(last);
+            force(i) = force(last);
+        }
+        --numBeads;
+        coords.resize(3 * numBeads);
+        forces.resize(3 * numBeads);
+    }
+};
+
+} // namespace medyan
+
+#endif
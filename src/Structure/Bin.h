@@ -177,6 +177,8 @@ public:
     vector<int> getcindices(){
         updatecindices();
         return cindicesvector;}
+    // Get cylinder indices without updating them. Can be used concurrently.
+    const vector<int>& getcindicesnoupdate() const { return cindicesvector; }
 
 };
 
@@ -22,6 +22,7 @@
 #include "Trackable.h"
 #include "Neighbor.h"
 #include "Component.h"
+#include "Util/Math/Vec.hpp"
 
 namespace medyan {
 
@@ -76,13 +77,18 @@ public:
     /// @return - 1) positive number if point is within boundary element
     ///           2) Negative number if point is outside boundary element
     ///           3) Infinity if point is not in domain of this boundary element
-    virtual floatingpoint distance(const vector<floatingpoint>& point) = 0;
-    virtual floatingpoint distance(floatingpoint const *point) = 0;
+    floatingpoint distance(floatingpoint const *point) { return distanceImpl(point); }
+    floatingpoint distance(const vector<floatingpoint>& point) { return distanceImpl(point.data()); }
+    floatingpoint distance(const Vec<3, floatingpoint>& point) { return distanceImpl(point.data()); }
     //@}
 
     //@{
-    virtual floatingpoint lowerdistance(const vector<floatingpoint>& point) = 0;
-    virtual floatingpoint sidedistance(const vector<floatingpoint>& point) = 0;
+    floatingpoint lowerdistance(floatingpoint const *point) { return lowerdistanceImpl(point); }
+    floatingpoint lowerdistance(const vector<floatingpoint>& point) { return lowerdistanceImpl(point.data()); }
+    floatingpoint lowerdistance(const Vec<3, floatingpoint>& point) { return lowerdistanceImpl(point.data()); }
+    floatingpoint sidedistance(floatingpoint const *point) { return sidedistanceImpl(point); }
+    floatingpoint sidedistance(const vector<floatingpoint>& point) { return sidedistanceImpl(point.data()); }
+    floatingpoint sidedistance(const Vec<3, floatingpoint>& point) { return sidedistanceImpl(point.data()); }
 
     /// Returns stretched distance, similar to distance above
     virtual floatingpoint stretchedDistance(const vector<floatingpoint>& point,
@@ -96,11 +102,20 @@ public:
 
     //@{
     /// Returns normal vector of point to plane
-    virtual const vector<floatingpoint> normal(const vector<floatingpoint> &point) = 0;
-    virtual const vector<floatingpoint> normal(const floatingpoint *point) = 0;
+    Vec<3, floatingpoint> normal(floatingpoint const *point) { return normalImpl(point); }
+    Vec<3, floatingpoint> normal(const Vec<3, floatingpoint>& point) { return normalImpl(point.data()); }
     virtual const void elementeqn(floatingpoint* var) = 0;
     //@}
 
+    //@{
+    /// (Private) implementations of the distance and normal functions, to be
+    /// elaborated in derived classes
+    virtual floatingpoint distanceImpl(floatingpoint const *point) = 0;
+    virtual floatingpoint lowerdistanceImpl(floatingpoint const *point) = 0;
+    virtual floatingpoint sidedistanceImpl(floatingpoint const *point) = 0;
+    virtual Vec<3, floatingpoint> normalImpl(floatingpoint const *point) = 0;
+    //@}
+
     //@{
     /// Getter for mechanical parameters
     virtual floatingpoint getRepulsionConst() {return _kRep;}
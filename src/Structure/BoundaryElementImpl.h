@@ -26,6 +26,12 @@
 namespace medyan {
 using namespace mathfunc;
 // IF USING CUDA VERSION, MAKE SURE TO ADD RELEVANT DISTANCE, STRETCHED DISTANCE AND NORMAL FUNCTIONS IN MATHFUNCTIONS.H
+
+/// Distance between the projections of 2 points on the xy plane.
+inline floatingpoint xyDistance(const vector<floatingpoint>& v1, floatingpoint const *v2) {
+    return sqrt((v2[0] - v1[0]) * (v2[0] - v1[0]) + (v2[1] - v1[1]) * (v2[1] - v1[1]));
+}
+
 /// A plane implementation of a BoundaryElement.
 class PlaneBoundaryElement : public BoundaryElement {
 
@@ -49,18 +55,17 @@ public:
         _d = -_a * _coords[0] - _b * _coords[1] - _c * _coords[2];
     }
 
-    virtual floatingpoint distance(const vector<floatingpoint>& point) {
-
+    virtual floatingpoint distanceImpl(floatingpoint const *point) {
         return (_a * point[0] + _b * point[1] + _c * point[2] + _d) /
-                sqrt(pow(_a, 2) + pow(_b, 2) + pow(_c, 2));
+        sqrt(pow(_a, 2) + pow(_b, 2) + pow(_c, 2));
     }
 
     //lower distance is the z axis
-    virtual floatingpoint lowerdistance(const vector<floatingpoint>& point) {
+    virtual floatingpoint lowerdistanceImpl(floatingpoint const *point) {
         return point[2];
     }
     //side distance is either x or y axis
-    virtual floatingpoint sidedistance(const vector<floatingpoint>& point) {
+    virtual floatingpoint sidedistanceImpl(floatingpoint const *point) {
         if(point[0] > point[1]) {
             return point[1];
         }
@@ -68,41 +73,27 @@ public:
             return point[0];
     }
 
-    virtual floatingpoint distance(floatingpoint const *point) {
-        return (_a * point[0] + _b * point[1] + _c * point[2] + _d) /
-        sqrt(pow(_a, 2) + pow(_b, 2) + pow(_c, 2));
-    }
-
     virtual floatingpoint stretchedDistance(const vector<floatingpoint>& point,
                                      const vector<floatingpoint>& force,
                                      floatingpoint d) {
 
-
-        vector<floatingpoint> movedPoint = {point[0] + d*float(force[0]),
-                                     point[1] + d*float(force[1]),
-                                     point[2] + d*float(force[2])};
-        return distance(movedPoint);
-
+        return stretchedDistance(point.data(), force.data(), d);
     }
     virtual floatingpoint stretchedDistance(floatingpoint const *point,
                                      floatingpoint const *force,
                                      floatingpoint d) {
 
 
-        vector<floatingpoint> movedPoint = {point[0] + d*float(force[0]),
-                                     point[1] + d*float(force[1]),
-                                     point[2] + d*float(force[2])};
+        Vec<3, floatingpoint> movedPoint {point[0] + d*float(force[0]),
+                                          point[1] + d*float(force[1]),
+                                          point[2] + d*float(force[2])};
         return distance(movedPoint);
 
     }
 
-    virtual const vector<floatingpoint> normal(const vector<floatingpoint>& point) {
+    virtual Vec<3, floatingpoint> normalImpl(floatingpoint const *point) {
 
-        return vector<floatingpoint>{_a, _b, _c};
-    }
-    virtual const vector<floatingpoint> normal(floatingpoint const *point) {
-
-        return vector<floatingpoint>{_a, _b, _c};
+        return Vec<3, floatingpoint>{_a, _b, _c};
     }
 
     virtual const void elementeqn(floatingpoint* var){
@@ -136,11 +127,7 @@ public:
         : BoundaryElement(coords, repulsConst, screenLength),
           _radius(radius) {}
 
-    virtual floatingpoint distance(const vector<floatingpoint>& point) {
-
-        return _radius - twoPointDistance(_coords, point);
-    }
-    virtual floatingpoint distance(floatingpoint const *point) {
+    virtual floatingpoint distanceImpl(floatingpoint const *point) {
 
         return _radius - twoPointDistance(_coords, point);
     }
@@ -149,11 +136,11 @@ public:
         var[0] = _radius;
     }
     //the same as distance
-    virtual floatingpoint lowerdistance(const vector<floatingpoint>& point) {
+    virtual floatingpoint lowerdistanceImpl(floatingpoint const *point) {
 
         return _radius - twoPointDistance(_coords, point);
     }
-    virtual floatingpoint sidedistance(const vector<floatingpoint>& point) {
+    virtual floatingpoint sidedistanceImpl(floatingpoint const *point) {
 
         return _radius - twoPointDistance(_coords, point);
     }
@@ -162,32 +149,23 @@ public:
                                      const vector<floatingpoint>& force,
                                      floatingpoint d) {
 
-        vector<floatingpoint> movedPoint{point[0] + d * float(force[0]),
-                                  point[1] + d * float(force[1]),
-                                  point[2] + d * float(force[2])};
-
-        return distance(movedPoint);
-
+        return stretchedDistance(point.data(), force.data(), d);
     }
     virtual floatingpoint stretchedDistance(floatingpoint const *point,
                                             floatingpoint const *force,
                                      floatingpoint d) {
 
-        vector<floatingpoint> movedPoint{point[0] + d * float(force[0]),
-                                  point[1] + d * float(force[1]),
-                                  point[2] + d * float(force[2])};
+        Vec<3, floatingpoint> movedPoint {point[0] + d * float(force[0]),
+                                          point[1] + d * float(force[1]),
+                                          point[2] + d * float(force[2])};
 
         return distance(movedPoint);
 
     }
 
-    virtual const vector<floatingpoint> normal(const vector<floatingpoint>& point) {
-
-        return twoPointDirection(point, _coords);
-    }
-    virtual const vector<floatingpoint> normal(floatingpoint const *point) {
+    virtual Vec<3, floatingpoint> normalImpl(floatingpoint const *point) {
 
-        return twoPointDirection(point, _coords);
+        return twoPointDirection(makeConstRefVec<3>(point), makeConstRefVec<3>(_coords.data()));
     }
 
     virtual void updateCoords(const vector<floatingpoint> newCoords) {
@@ -216,23 +194,16 @@ public:
         : BoundaryElement(coords, repulsConst, screenLength),
           _radius(radius), _height(height) {}
 
-    virtual floatingpoint distance(const vector<floatingpoint>& point) {
-        return _radius - twoPointDistance({_coords[0],_coords[1], 0},
-                                          {  point[0],  point[1], 0});
+    virtual floatingpoint distanceImpl(floatingpoint const *point) {
+        return _radius - xyDistance(_coords, point);
     }
-    //TODO
-    virtual floatingpoint distance(floatingpoint const *point) {
-        cout<<"Distance not implemented for Boundary Element of CylinderZ type. "
-                "Exiting"<<endl;
-        exit(EXIT_FAILURE);
-        return 0.0; }
 
     virtual const void elementeqn(floatingpoint* var){
         var[0] = _radius; var[1] = _height;
     }
 
     //find the distance for the lower boundary
-    virtual floatingpoint lowerdistance(const vector<floatingpoint>& point) {
+    virtual floatingpoint lowerdistanceImpl(floatingpoint const *point) {
 
 
         ///check z coordinate.
@@ -241,11 +212,9 @@ public:
 
 
     //find the distance for the side boundary
-    virtual floatingpoint sidedistance(const vector<floatingpoint>& point) {
+    virtual floatingpoint sidedistanceImpl(floatingpoint const *point) {
 
-        auto dxy = _radius - twoPointDistance({_coords[0],_coords[1], 0},
-                                              {  point[0],  point[1], 0});
-        return dxy;
+        return _radius - xyDistance(_coords, point);
     }
 
 
@@ -253,9 +222,9 @@ public:
                                             const vector<floatingpoint>& force,
                                             floatingpoint d) {
 
-        vector<floatingpoint> movedPoint{point[0] + d * force[0],
-                                         point[1] + d * force[1],
-                                         point[2] + d * force[2]};
+        Vec<3, floatingpoint> movedPoint {point[0] + d * force[0],
+                                          point[1] + d * force[1],
+                                          point[2] + d * force[2]};
 
         return distance(movedPoint);
 
@@ -269,10 +238,9 @@ public:
         exit(EXIT_FAILURE);
         return 0.0;}
 
-    virtual const vector<floatingpoint> normal(const vector<floatingpoint>& point) {
+    virtual Vec<3, floatingpoint> normalImpl(floatingpoint const *point) {
 
-        auto dxy = _radius - twoPointDistance({_coords[0],_coords[1], 0},
-                                              {  point[0],  point[1], 0});
+        auto dxy = _radius - xyDistance(_coords, point);
 
         floatingpoint dzz = point[2];
         if((_coords[2] * 2 - point[2]) < dzz) {
@@ -283,21 +251,15 @@ public:
         }
 
         if(dxy > dzz) {
-            return twoPointDirection({0,  0, point[2]},
-                                     {0,0, _coords[2]});
+            return twoPointDirection(Vec<3, floatingpoint>{0, 0, point[2]},
+                                     Vec<3, floatingpoint>{0, 0, _coords[2]});
         }
         else {
-            return twoPointDirection({point[0],  point[1], 0},
-                 {_coords[0],_coords[1], 0});
+            return twoPointDirection(Vec<3, floatingpoint>{point[0], point[1], 0},
+                                     Vec<3, floatingpoint>{_coords[0], _coords[1], 0});
       }
     }
 
-    //TODO
-    virtual const vector<floatingpoint> normal(floatingpoint const *point) {cout<<"Function not "
-                                                                    "implemented. Exiting."<<endl;
-    exit(EXIT_FAILURE);
-    return vector<floatingpoint>{};};
-
     virtual void updateCoords(const vector<floatingpoint> newCoords) {
 
         _coords = newCoords;
@@ -323,24 +285,17 @@ public:
         : BoundaryElement(coords, repulsConst, screenLength),
           _radius(radius), _up(up){}
 
-    virtual floatingpoint distance(const vector<floatingpoint>& point) {
+    virtual floatingpoint distanceImpl(floatingpoint const *point) {
 
         return _radius - twoPointDistance(_coords, point);
     }
 
-    //TODO
-    virtual floatingpoint distance(floatingpoint const *point) {
-        cout<<"Distance not implemented for Boundary Element of HalfSphereZ type. "
-                "Exiting"<<endl;
-        exit(EXIT_FAILURE);
-        return 0.0; }
-
     //Qin, the same as distance
-    virtual floatingpoint lowerdistance(const vector<floatingpoint>& point) {
+    virtual floatingpoint lowerdistanceImpl(floatingpoint const *point) {
 
         return _radius - twoPointDistance(_coords, point);
     }
-    virtual floatingpoint sidedistance(const vector<floatingpoint>& point) {
+    virtual floatingpoint sidedistanceImpl(floatingpoint const *point) {
 
         return _radius - twoPointDistance(_coords, point);
     }
@@ -349,9 +304,9 @@ public:
                                             const vector<floatingpoint>& force,
                                             floatingpoint d) {
 
-        vector<floatingpoint> movedPoint{point[0] + d * float(force[0]),
-                                         point[1] + d * float(force[1]),
-                                         point[2] + d * float(force[2])};
+        Vec<3, floatingpoint> movedPoint {point[0] + d * float(force[0]),
+                                          point[1] + d * float(force[1]),
+                                          point[2] + d * float(force[2])};
 
         return distance(movedPoint);
 
@@ -370,18 +325,11 @@ public:
         exit(EXIT_FAILURE);
         return 0.0;}
 
-    virtual const vector<floatingpoint> normal(const vector<floatingpoint>& point) {
+    virtual Vec<3, floatingpoint> normalImpl(floatingpoint const *point) {
 
-        return twoPointDirection(point, _coords);
+        return twoPointDirection(makeConstRefVec<3>(point), makeConstRefVec<3>(_coords.data()));
     }
 
-    //TODO
-    virtual const vector<floatingpoint> normal(floatingpoint const *point) {
-        cout<<"normal not implemented for HalfSphereZBoundaryElement. Exiting."<<endl;
-        exit(EXIT_FAILURE);
-        return
-        vector<floatingpoint>{};};
-
     virtual void updateCoords(const vector<floatingpoint> newCoords) {
 
         _coords = newCoords;
@@ -409,42 +357,16 @@ public:
             : BoundaryElement(coords, repulsConst, screenLength),
               _radius(radius), _height(height) {}
 
-    virtual floatingpoint distance(const vector<floatingpoint>& point) {
-
-        auto dxy = _radius - twoPointDistance({_coords[0],_coords[1], 0},
-                                              {  point[0],  point[1], 0});
-
-        floatingpoint dzz = point[2];
-        if((_coords[2] * 2 - point[2]) < dzz) {
-            dzz = _coords[2]*2 - point[2];
-        }
-        else {
-            dzz = point[2];
-        }
-
-
-        if(dxy > dzz) {
-            return dzz;
-        }
-        else {
-            return dxy;
-        }
-    }
-
     //find the distance for the lower boundary
-    virtual floatingpoint lowerdistance(const vector<floatingpoint>& point) {
+    virtual floatingpoint lowerdistanceImpl(floatingpoint const *point) {
 
         return point[2];
     }
 
     //find the distance for the side boundary
-    virtual floatingpoint sidedistance(const vector<floatingpoint>& point) {
-
-
-        auto dxy = _radius - twoPointDistance({_coords[0],_coords[1], 0},
-                                              {  point[0],  point[1], 0});
-        return dxy;
+    virtual floatingpoint sidedistanceImpl(floatingpoint const *point) {
 
+        return _radius - xyDistance(_coords, point);
     }
 
 
@@ -452,63 +374,22 @@ public:
                                             const vector<floatingpoint>& force,
                                             floatingpoint d) {
 
-        vector<floatingpoint> movedPoint{point[0] + d * float(force[0]),
-                                         point[1] + d * float(force[1]),
-                                         point[2] + d * float(force[2])};
+        Vec<3, floatingpoint> movedPoint {point[0] + d * float(force[0]),
+                                          point[1] + d * float(force[1]),
+                                          point[2] + d * float(force[2])};
 
         return distance(movedPoint);
 
     }
 
-    virtual const vector<floatingpoint> normal(const vector<floatingpoint>& point) {
-
-        auto dxy = _radius - twoPointDistance({_coords[0],_coords[1], 0.0},
-                                              {  point[0],  point[1], 0.0});
-
-        floatingpoint dzz = point[2];
-        if((_coords[2] * 2 - point[2]) < dzz) {
-            dzz = _coords[2]*2 - point[2];
-        }
-        else {
-            dzz = point[2];
-        }
-
-        if(dxy > dzz) {
-
-            // when the Z coordinate is located at geometry center
-            if(areEqual(point[2],_coords[2])) {
-                return vector<floatingpoint> {0.0, 0.0, 0.0};
-            }
-            else {
-                return twoPointDirection({0.0,  0.0, point[2]},
-                                         {0.0, 0.0, _coords[2]});;
-            }
-
-        }
-        else {
-
-            // when the Z coordinate is located at geometry center
-            if(areEqual(point[0],_coords[0]) && areEqual(point[1],_coords[1])) {
-                return vector<floatingpoint> {0.0, 0.0, 0.0};
-            }
-            else {
-                return twoPointDirection({point[0],  point[1], 0.0},
-                                         {_coords[0],_coords[1], 0.0});;
-            }
-        }
-        //return twoPointDirection({point[0],  point[1], 0},
-        //                         {_coords[0],_coords[1], 0});
-    }
-
     virtual void updateCoords(const vector<floatingpoint> newCoords) {
 
         _coords = newCoords;
     }
 
-    virtual floatingpoint distance(floatingpoint const *point) {
+    virtual floatingpoint distanceImpl(floatingpoint const *point) {
 
-        auto dxy = _radius - twoPointDistance({_coords[0],_coords[1], 0},
-                                              {  point[0],  point[1], 0});
+        auto dxy = _radius - xyDistance(_coords, point);
 
         floatingpoint dzz = point[2];
         if((_coords[2] * 2 - point[2]) < dzz) {
@@ -529,17 +410,16 @@ public:
     virtual floatingpoint stretchedDistance(floatingpoint const *point,
                                             floatingpoint const *force, floatingpoint d) {
 
-        vector<floatingpoint> movedPoint{point[0] + d * force[0],
-                                         point[1] + d * force[1],
-                                         point[2] + d * force[2]};
+        Vec<3, floatingpoint> movedPoint {point[0] + d * force[0],
+                                          point[1] + d * force[1],
+                                          point[2] + d * force[2]};
 
         return distance(movedPoint);
 
     };
 
-    virtual const vector<floatingpoint> normal(const floatingpoint *point) {
-        auto dxy = _radius - twoPointDistance({_coords[0],_coords[1], 0.0},
-                                              {  point[0],  point[1], 0.0});
+    virtual Vec<3, floatingpoint> normalImpl(floatingpoint const *point) {
+        auto dxy = _radius - xyDistance(_coords, point);
 
         floatingpoint dzz = point[2];
         if((_coords[2] * 2 - point[2]) < dzz) {
@@ -553,11 +433,11 @@ public:
 
             // when the Z coordinate is located at geometry center
             if(areEqual(point[2],_coords[2])) {
-                return vector<floatingpoint> {0.0, 0.0, 0.0};
+                return Vec<3, floatingpoint> {0.0, 0.0, 0.0};
             }
             else {
-                return twoPointDirection({0.0,  0.0, point[2]},
-                                          {0.0, 0.0, _coords[2]});;
+                return twoPointDirection(Vec<3, floatingpoint>{0.0, 0.0, point[2]},
+                                         Vec<3, floatingpoint>{0.0, 0.0, _coords[2]});
             }
 
         }
@@ -565,11 +445,11 @@ public:
 
             // when the X, Y coordinate is located at geometry center
             if(areEqual(point[0],_coords[0]) && areEqual(point[1],_coords[1])) {
-                return vector<floatingpoint> {0.0, 0.0, 0.0};
+                return Vec<3, floatingpoint> {0.0, 0.0, 0.0};
             }
             else {
-                return twoPointDirection({point[0],  point[1], 0.0},
-                                         {_coords[0],_coords[1], 0.0});;
+                return twoPointDirection(Vec<3, floatingpoint>{point[0], point[1], 0.0},
+                                         Vec<3, floatingpoint>{_coords[0], _coords[1], 0.0});
             }
         }
 
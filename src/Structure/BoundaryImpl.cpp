@@ -59,7 +59,7 @@ bool BoundaryCubic::within(Compartment* C) {
         auto be = bs->boundaryElements()[0].get();
         
         //go half a compartment dist in the direction of normal
-        auto coordinate = mathfunc::vec2Vector(C->coordinates());
+        const auto& coordinate = C->coordinates();
         
         //initial check of coord
         if(be->distance(coordinate) > 0) continue;
@@ -67,7 +67,7 @@ bool BoundaryCubic::within(Compartment* C) {
         //if not, see if any part is in bounds
         auto normal = be->normal(coordinate);
         
-        auto effCoordinate =
+        Vec<3, floatingpoint> effCoordinate
         {coordinate[0] + SysParams::Geometry().compartmentSizeX * normal[0] / 2,
          coordinate[1] + SysParams::Geometry().compartmentSizeY * normal[1] / 2,
          coordinate[2] + SysParams::Geometry().compartmentSizeZ * normal[2] / 2};
@@ -81,7 +81,7 @@ bool BoundaryCubic::within(Compartment* C) {
 }
 
 
-bool BoundaryCubic::within(const vector<floatingpoint>& coordinates) {
+bool BoundaryCubic::within(const Vec<3, floatingpoint>& coordinates) {
     
     // check if all planes return positive distance
     // (means in front of plane, relative to normal)
@@ -95,7 +95,7 @@ bool BoundaryCubic::within(const vector<floatingpoint>& coordinates) {
     return true;
 }
 
-floatingpoint BoundaryCubic::distance(const vector<floatingpoint>& coordinates) {
+floatingpoint BoundaryCubic::distance(const Vec<3, floatingpoint>& coordinates) {
     
     // loop through, get smallest distance
     floatingpoint smallestDist = numeric_limits<floatingpoint>::infinity();
@@ -112,7 +112,7 @@ floatingpoint BoundaryCubic::distance(const vector<floatingpoint>& coordinates)
     return smallestDist;
 }
 
-floatingpoint BoundaryCubic::lowerdistance(const vector<floatingpoint>& coordinates) {
+floatingpoint BoundaryCubic::lowerdistance(const Vec<3, floatingpoint>& coordinates) {
     
     // loop through, get smallest distance
     floatingpoint smallestDist = numeric_limits<floatingpoint>::infinity();
@@ -130,7 +130,7 @@ floatingpoint BoundaryCubic::lowerdistance(const vector<floatingpoint>& coordina
 }
 
 //Qin, the same as lowerdistance for now
-floatingpoint BoundaryCubic::sidedistance(const vector<floatingpoint>& coordinates) {
+floatingpoint BoundaryCubic::sidedistance(const Vec<3, floatingpoint>& coordinates) {
     
     // loop through, get smallest distance
     floatingpoint smallestDist = numeric_limits<floatingpoint>::infinity();
@@ -147,7 +147,7 @@ floatingpoint BoundaryCubic::sidedistance(const vector<floatingpoint>& coordinat
     return smallestDist;
 }
 
-vector<floatingpoint> BoundaryCubic::normal(vector<floatingpoint>& coordinates) {
+Vec<3, floatingpoint> BoundaryCubic::normal(const Vec<3, floatingpoint>& coordinates) {
     
     // loop through, get smallest distance
     BoundaryElement* closestPlane = nullptr;
@@ -381,7 +381,7 @@ bool BoundarySpherical::within(Compartment* C) {
         auto be = bs->boundaryElements()[0].get();
         
         //go half a compartment dist in the direction of normal
-        auto coordinate = mathfunc::vec2Vector(C->coordinates());
+        const auto& coordinate = C->coordinates();
         
         //initial check of coord
         if(be->distance(coordinate) > 0) continue;
@@ -389,7 +389,7 @@ bool BoundarySpherical::within(Compartment* C) {
         //if not, see if any part is in bounds
         auto normal = be->normal(coordinate);
         
-        auto effCoordinate =
+        Vec<3, floatingpoint> effCoordinate
         {coordinate[0] + SysParams::Geometry().compartmentSizeX * normal[0] / 2,
          coordinate[1] + SysParams::Geometry().compartmentSizeY * normal[1] / 2,
          coordinate[2] + SysParams::Geometry().compartmentSizeZ * normal[2] / 2};
@@ -402,7 +402,7 @@ bool BoundarySpherical::within(Compartment* C) {
     return true;
 }
 
-bool BoundarySpherical::within(const vector<floatingpoint>& coordinates) {
+bool BoundarySpherical::within(const Vec<3, floatingpoint>& coordinates) {
     
     //check if the boundary element returns a positive distance
     auto be = _boundarySurfaces[0]->boundaryElements()[0].get();
@@ -411,7 +411,7 @@ bool BoundarySpherical::within(const vector<floatingpoint>& coordinates) {
     
 }
 
-floatingpoint BoundarySpherical::distance(const vector<floatingpoint>& coordinates) {
+floatingpoint BoundarySpherical::distance(const Vec<3, floatingpoint>& coordinates) {
     
     auto be = _boundarySurfaces[0]->boundaryElements()[0].get();
     
@@ -422,7 +422,7 @@ floatingpoint BoundarySpherical::distance(const vector<floatingpoint>& coordinat
 }
 
 //the same as distance
-floatingpoint BoundarySpherical::lowerdistance(const vector<floatingpoint>& coordinates) {
+floatingpoint BoundarySpherical::lowerdistance(const Vec<3, floatingpoint>& coordinates) {
     
     auto be = _boundarySurfaces[0]->boundaryElements()[0].get();
     
@@ -432,7 +432,7 @@ floatingpoint BoundarySpherical::lowerdistance(const vector<floatingpoint>& coor
     else return numeric_limits<floatingpoint>::infinity();
 }
 
-floatingpoint BoundarySpherical::sidedistance(const vector<floatingpoint>& coordinates) {
+floatingpoint BoundarySpherical::sidedistance(const Vec<3, floatingpoint>& coordinates) {
     
     auto be = _boundarySurfaces[0]->boundaryElements()[0].get();
     
@@ -443,7 +443,7 @@ floatingpoint BoundarySpherical::sidedistance(const vector<floatingpoint>& coord
 }
 
 
-vector<floatingpoint> BoundarySpherical::normal(vector<floatingpoint>& coordinates) {
+Vec<3, floatingpoint> BoundarySpherical::normal(const Vec<3, floatingpoint>& coordinates) {
     
     auto be = _boundarySurfaces[0]->boundaryElements()[0].get();
     return be->normal(coordinates);
@@ -478,11 +478,11 @@ BoundaryCapsule::BoundaryCapsule(SubSystem* s, floatingpoint diameter, vector<Bo
 bool BoundaryCapsule::within(Compartment* C) {
     
     //just calls regular within for now
-    return within(mathfunc::vec2Vector(C->coordinates()));
+    return within(C->coordinates());
 }
 
 
-bool BoundaryCapsule::within(const vector<floatingpoint>& coordinates) {
+bool BoundaryCapsule::within(const Vec<3, floatingpoint>& coordinates) {
     
     //check if the boundary elements return a positive distance
     for(auto &bs : _boundarySurfaces) {
@@ -495,7 +495,7 @@ bool BoundaryCapsule::within(const vector<floatingpoint>& coordinates) {
     return true;
 }
 
-floatingpoint BoundaryCapsule::distance(const vector<floatingpoint>& coordinates) {
+floatingpoint BoundaryCapsule::distance(const Vec<3, floatingpoint>& coordinates) {
     
     // loop through, get smallest distance
     floatingpoint smallestDist = numeric_limits<floatingpoint>::infinity();
@@ -513,7 +513,7 @@ floatingpoint BoundaryCapsule::distance(const vector<floatingpoint>& coordinates
 }
 
 //Do not use it for now
-floatingpoint BoundaryCapsule::lowerdistance(const vector<floatingpoint>& coordinates) {
+floatingpoint BoundaryCapsule::lowerdistance(const Vec<3, floatingpoint>& coordinates) {
     
     // loop through, get smallest distance
     floatingpoint smallestDist = numeric_limits<floatingpoint>::infinity();
@@ -530,7 +530,7 @@ floatingpoint BoundaryCapsule::lowerdistance(const vector<floatingpoint>& coordi
     return smallestDist;
 }
 
-floatingpoint BoundaryCapsule::sidedistance(const vector<floatingpoint>& coordinates) {
+floatingpoint BoundaryCapsule::sidedistance(const Vec<3, floatingpoint>& coordinates) {
     
     // loop through, get smallest distance
     floatingpoint smallestDist = numeric_limits<floatingpoint>::infinity();
@@ -596,7 +596,7 @@ bool BoundaryCylinder::within(Compartment* C) {
 }
 
 
-bool BoundaryCylinder::within(const vector<floatingpoint>& coordinates) {
+bool BoundaryCylinder::within(const Vec<3, floatingpoint>& coordinates) {
     
     //check if the boundary elements return a positive distance
     for(auto &bs : _boundarySurfaces) {
@@ -609,7 +609,7 @@ bool BoundaryCylinder::within(const vector<floatingpoint>& coordinates) {
     return true;
 }
 
-floatingpoint BoundaryCylinder::distance(const vector<floatingpoint>& coordinates) {
+floatingpoint BoundaryCylinder::distance(const Vec<3, floatingpoint>& coordinates) {
     
     // loop through, get smallest distance
     floatingpoint smallestDist = numeric_limits<floatingpoint>::infinity();
@@ -628,7 +628,7 @@ floatingpoint BoundaryCylinder::distance(const vector<floatingpoint>& coordinate
 
 //Qin
 //lower distance should only return the distance between beads and the lower boundary
-floatingpoint BoundaryCylinder::lowerdistance(const vector<floatingpoint>& coordinates) {
+floatingpoint BoundaryCylinder::lowerdistance(const Vec<3, floatingpoint>& coordinates) {
     
     auto be = _boundarySurfaces[0]->boundaryElements()[0].get();
     
@@ -638,7 +638,7 @@ floatingpoint BoundaryCylinder::lowerdistance(const vector<floatingpoint>& coord
     else return numeric_limits<floatingpoint>::infinity();
 }
 
-floatingpoint BoundaryCylinder::sidedistance(const vector<floatingpoint>& coordinates) {
+floatingpoint BoundaryCylinder::sidedistance(const Vec<3, floatingpoint>& coordinates) {
     
     auto be = _boundarySurfaces[0]->boundaryElements()[0].get();
     
@@ -36,12 +36,12 @@ public:
     BoundaryCubic(SubSystem* s, vector<BoundaryMove> move);
     
     virtual bool within(Compartment* C);
-    virtual bool within(const vector<floatingpoint>& coordinates);
+    virtual bool within(const Vec<3, floatingpoint>& coordinates);
 
-    virtual floatingpoint distance(const vector<floatingpoint>& coordinates);
+    virtual floatingpoint distance(const Vec<3, floatingpoint>& coordinates);
 
-    virtual floatingpoint lowerdistance(const vector<floatingpoint>& coordinates);
-    virtual floatingpoint sidedistance(const vector<floatingpoint>& coordinates);
+    virtual floatingpoint lowerdistance(const Vec<3, floatingpoint>& coordinates);
+    virtual floatingpoint sidedistance(const Vec<3, floatingpoint>& coordinates);
 
     virtual floatingpoint getboundaryelementcoord(int i);
 
@@ -49,7 +49,7 @@ public:
     
     ///Returns the normal inward at this coordinate
     //rule - takes the closest wall's normal inward.
-    virtual vector<floatingpoint> normal(vector<floatingpoint>& coordinates);
+    virtual Vec<3, floatingpoint> normal(const Vec<3, floatingpoint>& coordinates);
 
     virtual void volume();
 };
@@ -65,13 +65,13 @@ public:
     ///@note - not yet implemented correctly. Essentially checks
     ///        if the midpoint of the compartment is within the boundary.
     virtual bool within(Compartment* C);
-    virtual bool within(const vector<floatingpoint>& coordinates);
+    virtual bool within(const Vec<3, floatingpoint>& coordinates);
 
-    virtual floatingpoint distance(const vector<floatingpoint>& coordinates);
+    virtual floatingpoint distance(const Vec<3, floatingpoint>& coordinates);
     
     //Qin
-    virtual floatingpoint lowerdistance(const vector<floatingpoint>& coordinates);
-    virtual floatingpoint sidedistance(const vector<floatingpoint>& coordinates);
+    virtual floatingpoint lowerdistance(const Vec<3, floatingpoint>& coordinates);
+    virtual floatingpoint sidedistance(const Vec<3, floatingpoint>& coordinates);
     virtual floatingpoint getboundaryelementcoord(int i) {
         LOG(ERROR) << "Function is not implemented.";
         throw std::logic_error("Function not implemented");
@@ -80,7 +80,7 @@ public:
     virtual void move(vector<floatingpoint> dist) {}
     
     ///Returns the normal inward at this coordinate
-    virtual vector<floatingpoint> normal(vector<floatingpoint>& coordinate);
+    virtual Vec<3, floatingpoint> normal(const Vec<3, floatingpoint>& coordinate);
 
     virtual void volume();
 };
@@ -98,23 +98,23 @@ public:
     ///@note - not yet implemented correctly. Essentially checks
     ///        if the midpoint of the compartment is within the boundary.
     virtual bool within(Compartment* C);
-    virtual bool within(const vector<floatingpoint>& coordinates);
+    virtual bool within(const Vec<3, floatingpoint>& coordinates);
 
-    virtual floatingpoint distance(const vector<floatingpoint>& coordinates);
+    virtual floatingpoint distance(const Vec<3, floatingpoint>& coordinates);
     virtual floatingpoint getboundaryelementcoord(int i) {
         LOG(ERROR) << "Function is not implemented.";
         throw std::logic_error("Function not implemented");
     }
 
-    virtual floatingpoint lowerdistance(const vector<floatingpoint>& coordinates);
-    virtual floatingpoint sidedistance(const vector<floatingpoint>& coordinates);
+    virtual floatingpoint lowerdistance(const Vec<3, floatingpoint>& coordinates);
+    virtual floatingpoint sidedistance(const Vec<3, floatingpoint>& coordinates);
     
     ///@note - Not yet implemented.
     virtual void move(vector<floatingpoint> dist) {}
     
     ///Returns the normal inward at this coordinate
     //@note - Not yet implemented.
-    virtual vector<floatingpoint> normal(vector<floatingpoint>& coordinate) {return vector<floatingpoint>{0,0,0};}
+    virtual Vec<3, floatingpoint> normal(const Vec<3, floatingpoint>& coordinate) {return Vec<3, floatingpoint>{0,0,0};}
 
     virtual void volume();
 };
@@ -132,26 +132,26 @@ public:
     ///@note - not yet implemented correctly. Essentially checks
     ///        if the midpoint of the compartment is within the boundary.
     virtual bool within(Compartment* C);
-    virtual bool within(const vector<floatingpoint>& coordinates);
+    virtual bool within(const Vec<3, floatingpoint>& coordinates);
 
-    virtual floatingpoint distance(const vector<floatingpoint>& coordinates);
+    virtual floatingpoint distance(const Vec<3, floatingpoint>& coordinates);
     virtual floatingpoint getboundaryelementcoord(int i) {
         LOG(ERROR) << "getboundaryelementcoord Function is not implemented.";
         throw std::logic_error("getboundaryelementcoord Function not implemented");
     }
     //Qin
-    virtual floatingpoint lowerdistance(const vector<floatingpoint>& coordinates);
-    virtual floatingpoint sidedistance(const vector<floatingpoint>& coordinates);
+    virtual floatingpoint lowerdistance(const Vec<3, floatingpoint>& coordinates);
+    virtual floatingpoint sidedistance(const Vec<3, floatingpoint>& coordinates);
     
     ///@note - Not yet implemented.
     virtual void move(vector<floatingpoint> dist) {}
     
     ///Returns the normal inward at this coordinate
     //@note - Not yet implemented.
-    virtual vector<floatingpoint> normal(vector<floatingpoint>& coordinate) {
+    virtual Vec<3, floatingpoint> normal(const Vec<3, floatingpoint>& coordinate) {
         LOG(ERROR) << "normal Function is not implemented.";
         throw std::logic_error("normal Function not implemented");
-        return vector<floatingpoint>{0,0,0};}
+        return Vec<3, floatingpoint>{0,0,0};}
 
     virtual void volume();
 };
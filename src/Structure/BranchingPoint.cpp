@@ -30,9 +30,10 @@ using namespace mathfunc;
 
 void BranchingPoint::updateCoordinate() {
     
-    coordinate = midPointCoordinate(_c1->getFirstBead()->vcoordinate(),
-                                    _c1->getSecondBead()->vcoordinate(),
-                                    _c1->adjustedrelativeposition(_position));
+    const auto mid = midPointCoordinate(_c1->getFirstBead()->coordinate(),
+                                        _c1->getSecondBead()->coordinate(),
+                                        _c1->adjustedrelativeposition(_position));
+    coordinate.assign(mid.begin(), mid.end());
 }
 
 BranchingPoint::BranchingPoint(Cylinder* c1, Cylinder* c2,
@@ -211,6 +212,15 @@ void BranchingPoint::updateReactionRates() {
             offRxn->setRateMulFactor(factor, ReactionBase::mechanochemical);
             offRxn->updatePropensity();
         }
+        _rateInputs.record({ force }, SysParams::RUNSTATE);
+}
+
+void BranchingPoint::updateReactionRatesIfChanged(floatingpoint forceTolerance) {
+
+    floatingpoint force = max<floatingpoint>((floatingpoint)0.0, magnitude(_mBranchingPoint->branchForce));
+
+    if(_rateInputs.changed({ force }, SysParams::RUNSTATE, forceTolerance))
+        updateReactionRates();
 }
             
 void BranchingPoint::printSelf()const {
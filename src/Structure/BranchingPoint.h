@@ -65,6 +65,9 @@ private:
     ///For dynamic rate unbinding
     static vector<BranchRateChanger*> _unbindingChangers;
 
+    /// Branch force used in the last rate update
+    RateInputs<1> _rateInputs;
+
     string diffusingactinspeciesname = "";
     
 public:
@@ -137,6 +140,7 @@ public:
     //Qin ------
     /// Update the reaction rates, inherited from Reactable
     virtual void updateReactionRates();
+    virtual void updateReactionRatesIfChanged(floatingpoint forceTolerance);
 
     void initializerestart(floatingpoint eqLength){ _mBranchingPoint->initializerestart
                 (eqLength);};
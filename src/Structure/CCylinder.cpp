@@ -202,6 +202,57 @@ CCylinder::CCylinder(const CCylinder& rhs, Compartment* c)
 #endif
 }
 
+void CCylinder::moveToCompartment(Compartment* c) {
+    if(c == _compartment) return;
+
+    //transfer all monomer species
+    unordered_set<Species*> monomerSpecies;
+    for(auto &m : _monomers) {
+        for(int i = 0; i < CMonomer::_numFSpecies[_pCylinder->getType()]; i++) {
+            Species* s = m->speciesFilament(i);
+            if(s != nullptr) monomerSpecies.insert(s);
+        }
+        for(int i = 0; i < CMonomer::_numBSpecies[_pCylinder->getType()]; i++) {
+            Species* s = m->speciesBound(i);
+            if(s != nullptr) monomerSpecies.insert(s);
+        }
+    }
+    auto species = _compartment->getSpeciesContainer().releaseSpeciesIf(
+        [&](Species* s) { return monomerSpecies.find(s) != monomerSpecies.end(); });
+    for(auto &s : species)
+        c->addSpeciesUnique(move(s));
+
+    //transfer all owned reactions
+    unordered_set<ReactionBase*> ownedReactions(
+        _internalReactions.begin(), _internalReactions.end());
+    for(auto &it : _crossCylinderReactions)
+        ownedReactions.insert(it.second.begin(), it.second.end());
+    auto reactions = _compartment->getInternalReactionContainer().releaseReactionsIf(
+        [&](ReactionBase* r) { return ownedReactions.find(r) != ownedReactions.end(); });
+    for(auto &r : reactions)
+        c->addInternalReaction(move(r));
+
+    //update the species and volume fraction of the reactions in place. As in clone(),
+    //the reactions owned by reacting cylinders also use the new compartment.
+    const auto rehome = [&](ReactionBase* r) {
+        r->passivateReaction();
+        r->rebindSpecies(c->getSpeciesContainer());
+        r->setVolumeFrac(c->getVolumeFrac());
+        _chemSim->updateReaction(r);
+        r->activateReaction();
+    };
+    for(auto r : _internalReactions) rehome(r);
+    for(auto &it : _crossCylinderReactions)
+        for(auto r : it.second) rehome(r);
+    for(auto ccyl : _reactingCylinders) {
+        auto it = ccyl->_crossCylinderReactions.find(this);
+        if(it == ccyl->_crossCylinderReactions.end()) continue;
+        for(auto r : it->second) rehome(r);
+    }
+
+    _compartment = c;
+}
+
 void CCylinder::addInternalReaction(ReactionBase* r) {
     
     //add to compartment and chemsim
@@ -112,6 +112,14 @@ public:
     CCylinder* clone(Compartment* c) {
         return new CCylinder(*this, c);
     }
+
+    /// Move this CCylinder to another Compartment in place.
+    /// @note Unlike clone(), the species and [Reactions](@ref Reaction) are kept.
+    /// The monomer species and owned reactions are transferred to the new
+    /// Compartment, and the diffusing species and volume fractions of all reactions
+    /// involving this CCylinder are updated, so the cost does not depend on the
+    /// number of monomers in the reactions.
+    void moveToCompartment(Compartment* c);
     
     /// Get compartment
     Compartment* getCompartment() {return _compartment;}
@@ -90,9 +90,8 @@ void CLinker::createOffReaction(ReactionBase* onRxn, SubSystem* ps) {
     if(SysParams::Chemistry().dissTracking){
         floatingpoint gnum = onRxn->getGNumber();
         offRxn->setGNumber(-gnum);
-        //set hrcdid of offreaction
-        string hrcdid = onRxn->getHRCDID();
-        offRxn->setHRCDID(hrcdid + "off");
+        //set hrcdid of offreaction, interned at setup
+        offRxn->setHRCDIndex(hrcdidOff(onRxn->getHRCDIndex()));
     }
 
     //Attach the callback to the off reaction, add it
@@ -88,9 +88,8 @@ void CMotorGhost::createOffReaction(ReactionBase* onRxn, SubSystem* ps) {
     floatingpoint gnum = onRxn->getGNumber();
     offRxn->setGNumber(gnum);
     
-    //set hrcdid of offreaction
-    string hrcdid = onRxn->getHRCDID();
-    offRxn->setHRCDID(hrcdid + "off");
+    //set hrcdid of offreaction, interned at setup
+    offRxn->setHRCDIndex(hrcdidOff(onRxn->getHRCDIndex()));
     }
     //Attach the callback to the off reaction, add it
     MotorUnbindingCallback mcallback(_pMotorGhost, ps);
@@ -114,10 +113,11 @@ void CMotorGhost::moveMotorHead(CCylinder* cc,
     ReactionBase* newOffRxn;
     
     // Dissipation
-    string hrcdid = "NA";
+    static const Index hrcdidNA = hrcdidNames().id("NA");
+    Index hrcdid = hrcdidNA;
     floatingpoint gnum = 0.0;
     if(SysParams::Chemistry().dissTracking){
-        hrcdid = _offRxn->getHRCDID();
+        hrcdid = _offRxn->getHRCDIndex();
         gnum = _offRxn->getGNumber();
     }
     
@@ -165,7 +165,7 @@ void CMotorGhost::moveMotorHead(CCylinder* cc,
     
     //set hrcdid of offreaction
     
-    newOffRxn->setHRCDID(hrcdid);
+    newOffRxn->setHRCDIndex(hrcdid);
     }
     
     //attach signal
@@ -198,10 +198,11 @@ void CMotorGhost::moveMotorHead(CCylinder* oldCC,
     
     
     // Dissipation
-    string hrcdid = "NA";
+    static const Index hrcdidNA = hrcdidNames().id("NA");
+    Index hrcdid = hrcdidNA;
     floatingpoint gnum = 0.0;
     if(SysParams::Chemistry().dissTracking){
-    hrcdid = _offRxn->getHRCDID();
+    hrcdid = _offRxn->getHRCDIndex();
     gnum = _offRxn->getGNumber();
     }
     if(getFirstSpecies() == smOld) {
@@ -260,7 +261,7 @@ void CMotorGhost::moveMotorHead(CCylinder* oldCC,
     
     //set hrcdid of offreaction
     
-    newOffRxn->setHRCDID(hrcdid);
+    newOffRxn->setHRCDIndex(hrcdid);
     }
     //attach signal
     MotorUnbindingCallback mcallback(_pMotorGhost, ps);
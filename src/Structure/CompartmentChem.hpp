@@ -285,6 +285,28 @@ inline void shareSpecies(CompartmentGrid& grid, int cindex, int i) {
 
 
 
+// Partition the compartment grid into slabs along the axis with the most
+// compartments, which are used as sub-domains in parallel chemistry.
+// Returns the sub-domain index of each compartment.
+inline auto partitionCompartmentsIntoSlabs(const CompartmentGrid& grid, Size numDomains) {
+    std::unordered_map<const Composite*, Index> res;
+
+    const Index axis = std::max_element(grid.shape.begin(), grid.shape.end()) - grid.shape.begin();
+    const Size numSlices = grid.shape[axis];
+    // There cannot be more sub-domains than slices of compartments.
+    numDomains = std::max<Size>(1, std::min(numDomains, numSlices));
+
+    for(Index ix = 0; ix < grid.shape[0]; ++ix)
+        for(Index iy = 0; iy < grid.shape[1]; ++iy)
+            for(Index iz = 0; iz < grid.shape[2]; ++iz) {
+                const std::array<Index, 3> index3 { ix, iy, iz };
+                res[&grid.getCompartment(index3)] = index3[axis] * numDomains / numSlices;
+            }
+
+    return res;
+}
+
+
 //-----------------------------------------------------------------------------
 // Compartment status update.
 //-----------------------------------------------------------------------------
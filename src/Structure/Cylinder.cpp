@@ -43,9 +43,10 @@ void Cylinder::updateData() {
 }
 
 void Cylinder::updateCoordinate() {
-    coordinate = midPointCoordinate(_b1->vcoordinate(), _b2->vcoordinate(), 0.5);
+    const auto mid = midPointCoordinate(_b1->coordinate(), _b2->coordinate(), 0.5);
+    coordinate.assign(mid.begin(), mid.end());
     //update the coordiante in cylinder structure.
-    Cylinder::getDbData()[getStableIndex()].coord = 0.5 * (_b1->coordinate() + _b2->coordinate());
+    Cylinder::getDbData()[getStableIndex()].coord = mid;
 }
 
 Cylinder::Cylinder(Composite* parent, Bead* b1, Bead* b2, short type, int position,
@@ -94,7 +95,7 @@ Cylinder::Cylinder(Composite* parent, Bead* b1, Bead* b2, short type, int positi
     _cCylinder->setCylinder(this);
 
     if(SysParams::RUNSTATE) {
-        eqLength = twoPointDistance(b1->vcoordinate(), b2->vcoordinate());
+        eqLength = twoPointDistance(b1->coordinate(), b2->coordinate());
 
         //init using chem manager
         _chemManager->initializeCCylinder(_cCylinder.get(), extensionFront,
@@ -186,19 +187,15 @@ void Cylinder::updatePosition() {
 #endif
         }*/
 
-            //clone and set new ccylinder
-            CCylinder *clone = _cCylinder->clone(c);
-            setCCylinder(clone);
+            //move ccylinder to the new compartment in place
+            _cCylinder->moveToCompartment(c);
 #ifdef CROSSCHECK_CYLINDER
-            _crosscheckdumpFile <<"Clone CCyl "<<getId()<<endl;
+            _crosscheckdumpFile <<"Move CCyl "<<getId()<<endl;
 #endif
 
-//			auto newCCylinder = _cCylinder.get();
-
-            //change both CCylinder and Compartment ID in the vector
+            //change Compartment ID in the vector. The CCylinder is unchanged.
             auto& data = getDbData()[getStableIndex()];
             data.compartmentId = c->getId();
-            data.chemCylinder = _cCylinder.get();
 #ifdef CROSSCHECK_CYLINDER
             _crosscheckdumpFile <<"Update CylinderData "<<getId()<<endl;
 #endif
@@ -211,7 +208,7 @@ void Cylinder::updatePosition() {
         }
 
         //update length
-        _mCylinder->setLength(twoPointDistance(_b1->vcoordinate(), _b2->vcoordinate()));
+        _mCylinder->setLength(twoPointDistance(_b1->coordinate(), _b2->coordinate()));
 
         #ifdef CROSSCHECK_CYLINDER
         _crosscheckdumpFile <<"MCylinder updated "<<getId()<<endl;
@@ -305,6 +302,27 @@ void Cylinder::updateReactionRates() {
             }
         }
     }
+
+    _rateInputs.record(
+        { _plusEnd ? _b2->getLoadForcesP() : 0, _minusEnd ? _b1->getLoadForcesM() : 0 },
+        rateInputFlags_());
+}
+
+unsigned Cylinder::rateInputFlags_() {
+    // The number of internal reactions is included, so that reactions added
+    // after the last update also get their rates.
+    return (unsigned)_plusEnd
+        | (unsigned)_minusEnd << 1
+        | (unsigned)(tau() > SysParams::DRParams.manualCharStartTime) << 2
+        | (unsigned)_cCylinder->getInternalReactions().size() << 3;
+}
+
+void Cylinder::updateReactionRatesIfChanged(floatingpoint forceTolerance) {
+
+    if(_rateInputs.changed(
+        { _plusEnd ? _b2->getLoadForcesP() : 0, _minusEnd ? _b1->getLoadForcesM() : 0 },
+        rateInputFlags_(), forceTolerance))
+        updateReactionRates();
 }
 
 bool Cylinder::isFullLength() {
@@ -357,8 +375,8 @@ bool Cylinder::within(Cylinder* other, floatingpoint dist) {
         return true;
 
     //briefly check endpoints of other
-    if(twoPointDistancesquared(coordinate, other->_b1->vcoordinate()) <= (dist * dist) ||
-       twoPointDistancesquared(coordinate, other->_b2->vcoordinate()) <= (dist * dist))
+    if(twoPointDistancesquared(coordinate.data(), other->_b1->coordinate().data()) <= (dist * dist) ||
+       twoPointDistancesquared(coordinate.data(), other->_b2->coordinate().data()) <= (dist * dist))
         return true;
 
     return false;
@@ -372,8 +390,8 @@ floatingpoint Cylinder::adjustedrelativeposition(floatingpoint _alpha, bool verb
     if(isFullLength())
         return _alpha;
     floatingpoint _alphacorr = (floatingpoint)0.0;
-    auto x1 = _b1->vcoordinate();
-    auto x2 = _b2->vcoordinate();
+    const auto& x1 = _b1->coordinate();
+    const auto& x2 = _b2->coordinate();
     floatingpoint L = twoPointDistance(x1, x2);
     short filamentType = _type;
     short minusendmonomer = 0;
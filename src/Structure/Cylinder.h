@@ -31,6 +31,7 @@
 #include "Bead.h"
 #include "Structure/CellList.hpp"
 #include "Util/Math/Vec.hpp"
+#include "Util/ThreadPool.hpp"
 #include <fstream>
 
 namespace medyan {
@@ -100,6 +101,12 @@ private:
     ///For dynamic polymerization rate
     static vector<FilamentRateChanger*> _polyChanger;
 
+    /// Load forces at the ends used in the last rate update
+    RateInputs<2> _rateInputs;
+
+    /// Discrete inputs of the polymerization rates, packed as flags
+    unsigned rateInputFlags_();
+
     inline static medyan::ChemManager* _chemManager = nullptr; ///< A pointer to the ChemManager,
                                       ///< intiailized by CController
 
@@ -125,7 +132,11 @@ public:
     // Update CylinderInfoData using newest information in the system
     static void updateAllData() {
         // Update data for all cylinders
-        for(auto c : getCylinders()) c->updateData();
+        // Each cylinder only writes to its own entry in the database, so the update can run in parallel.
+        const auto& cylinders = getCylinders();
+        ThreadPool::global().parallelFor(0, cylinders.size(), [&](Index i) {
+            cylinders[i]->updateData();
+        }, 256);
     }
     void updateData(); // Update data for this cylinder. TODO: make it const
 
@@ -208,6 +219,7 @@ public:
 
     /// Update the reaction rates, inherited from Reactable
     virtual void updateReactionRates();
+    virtual void updateReactionRatesIfChanged(floatingpoint forceTolerance);
 
     /// Check if this cylinder is grown to full length
     bool isFullLength();
@@ -57,6 +57,7 @@ class DatabaseBase {
 private:
     inline static std::vector<T*> elems_;  // Pointer to the elements in the collection
     inline static std::size_t nextId_ = 0; // Next unique id
+    inline static std::size_t numIndexChanges_ = 0; // Number of times any index is changed
 
     std::size_t id_;
     std::size_t index_;
@@ -64,6 +65,8 @@ private:
 public:
     static const auto& getElements() { return elems_; }
     static auto numElements() { return elems_.size(); }
+    // Counter which changes whenever the index of any existing element changes.
+    static auto getNumIndexChanges() { return numIndexChanges_; }
 
     // Add element on construction
     DatabaseBase() : id_(nextId_++), index_(elems_.size()) {
@@ -77,6 +80,7 @@ public:
         std::swap(id_, rhs.id_);
         std::swap(index_, rhs.index_);
         std::swap(elems_[index_], elems_[rhs.index_]);
+        ++numIndexChanges_;
     }
 
     // Remove element on destruction
@@ -86,6 +90,7 @@ public:
             elems_[index_] = elems_.back();
             // Updata _index of the original last element
             elems_[index_] -> DatabaseBase< T >::index_ = index_;
+            ++numIndexChanges_;
         }
 
         // Pop the last element
@@ -186,6 +191,7 @@ class Database< T, true, DatabaseData > : public DatabaseBase<T>,
                                           public DatabaseDataManager<DatabaseData> {
     inline static std::vector<T*> stableElems_;
     inline static std::vector<std::size_t> deletedIndices_;
+    inline static std::size_t numStableIndexChanges_ = 0; // Number of times any stable index is changed
 
     std::size_t stableIndex_ = 0;
 
@@ -215,6 +221,8 @@ public:
     static auto rawNumStableElements() { return stableElems_.size(); }
     // Getting information for debug purposes
     static const auto& getDeletedIndices() { return deletedIndices_; }
+    // Counter which changes whenever the stable index of any existing element changes.
+    static auto getNumStableIndexChanges() { return numStableIndexChanges_; }
 
     // Calling this function may change the stable indices.
     static void rearrange() {
@@ -244,6 +252,8 @@ public:
             }
         }
 
+        if(numDeleted > 0) ++numStableIndexChanges_;
+
         // Remove garbage
         stableElems_.resize(finalSize);
         DbDataType::getDbData().resize(finalSize);
@@ -290,6 +300,7 @@ public:
         );
         std::swap(stableIndex_, rhs.stableIndex_);
         std::swap(stableElems_[stableIndex_], stableElems_[rhs.stableIndex_]);
+        ++numStableIndexChanges_;
     }
 
     ~Database() {
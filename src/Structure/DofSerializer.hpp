@@ -9,7 +9,11 @@
 //   - serializeDof(...)
 //
 //     Copy the degree-of-freedom data from all system elements (such as the
-//     bead coordinates) to the coordinate array.
+//     bubble coordinates) to the coordinate array.
+//
+//     Bead coordinates are not copied. They are stored at the beginning of
+//     the coordinate array (see BeadData), which is used by the minimizer in
+//     place.
 //
 //     Returns the starting indices of different types of elements, which is
 //     useful when building interactions in force fields.
@@ -17,7 +21,7 @@
 //   - deserializeDof(...)
 //
 //     Copy the vectorized coordinate and force data to all the element
-//     instances in the system.
+//     instances in the system, except for beads.
 
 #include <algorithm>
 
@@ -60,15 +64,14 @@ inline void updateVertexPinning(SubSystem& sys) {
     }
 }
 
-// Copies all the system data to the CGMethod data vector
-inline FFCoordinateStartingIndex serializeDof(
-    SubSystem&         sys,
-    std::vector< FP >& coord
-) {
+// Copies all the system data to the CGMethod data vector, which is the bead
+// coordinate vector in BeadData.
+inline FFCoordinateStartingIndex serializeDof(SubSystem& sys) {
     FFCoordinateStartingIndex si {};
     si.ps = &sys;
     Index curIdx = 0;
-    coord.clear();
+    auto& beadData = Bead::getBeadData();
+    auto& coord = beadData.coords;
 
     updateVertexPinning(sys);
 
@@ -76,13 +79,10 @@ inline FFCoordinateStartingIndex serializeDof(
     // Copy all the coordinate information here
     // Also initializes the force tolerance vector
 
-    // Bead coord
+    // Bead coord, already in place.
     si.bead = curIdx;
-    coord.reserve(coord.size() + 3 * Bead::getBeads().size());
-    for(auto pb : Bead::getBeads()) {
-        coord.insert(coord.end(), pb->coord.begin(), pb->coord.end());
-        curIdx += 3;
-    }
+    coord.resize(3 * beadData.numBeads);
+    curIdx += coord.size();
 
     // (Moveble) bubbles.
     si.movableBubble = curIdx;
@@ -186,24 +186,17 @@ inline FFCoordinateStartingIndex serializeDof(
     return si;
 }
 
-// Copies all the CGMethod data back to the system
+// Copies all the CGMethod data in BeadData back to the system
 //
 // Note:
-//   - The copying must be in the same order with the initCGMethodData
-//     function.
-inline void deserializeDof(
-    SubSystem&               sys,
-    const std::vector< FP >& coord,
-    const std::vector< FP >& force
-) {
-    std::size_t curIdx = 0;
-
-    // Copy coord and force data to beads
-    for(auto pb : Bead::getBeads()) {
-        std::copy(coord.begin() + curIdx, coord.begin() + curIdx + 3, pb->coord.begin());
-        std::copy(force.begin() + curIdx, force.begin() + curIdx + 3, pb->force.begin());
-        curIdx += 3;
-    }
+//   - The copying must be in the same order with the serializeDof function.
+inline void deserializeDof(SubSystem& sys) {
+    const auto& beadData = Bead::getBeadDataConst();
+    const auto& coord = beadData.coords;
+    const auto& force = beadData.forces;
+
+    // Bead coord and force data are already in place.
+    std::size_t curIdx = 3 * beadData.numBeads;
 
     // Copy coord and force data to movable bubbles
     for(auto& b : sys.bubbles) {
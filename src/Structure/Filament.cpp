@@ -78,6 +78,7 @@ Filament::Filament(SubSystem* s, short filamentType, const vector<floatingpoint>
     
     //create cylindera
     Cylinder* c0 = _subSystem->addTrackable<Cylinder>(this, b1, b2, _filType, 0);
+    _subSystem->cylinderNeighborListSkin.markTopologyChanged();
     
     c0->setPlusEnd(true);
     c0->setMinusEnd(true);
@@ -134,6 +135,7 @@ Filament::Filament(SubSystem* s, short filamentType, const std::vector<Vec<3, FP
 
     Cylinder* c0 = _subSystem->addTrackable<Cylinder>(this, b1, b2, _filType, 0,
                                                       false, false, true);
+    _subSystem->cylinderNeighborListSkin.markTopologyChanged();
         
     c0->setPlusEnd(true);
     c0->setMinusEnd(true);
@@ -175,6 +177,7 @@ Filament::~Filament() {
         cout<<"RemoveTrackable Cylinder "<<c->getId()<<" "<<c->getStableIndex() <<endl;
         #endif
         _subSystem->removeTrackable<Cylinder>(c);
+        _subSystem->cylinderNeighborListSkin.markTopologyChanged();
     }
 }
 
@@ -198,6 +201,7 @@ void Filament::extendPlusEnd(const Vec<3, FP>& coordinates) {
 
     Cylinder* c0 = _subSystem->addTrackable<Cylinder> (this, b2, bNew, _filType,
                                                        lpf + 1, false, false, true);
+    _subSystem->cylinderNeighborListSkin.markTopologyChanged();
     c0->setPlusEnd(true);
     _cylinderVector.push_back(c0);
     
@@ -230,6 +234,7 @@ void Filament::extendMinusEnd(const Vec<3, FP>& coordinates) {
 
     Cylinder* c0 = _subSystem->addTrackable<Cylinder>(this, bNew, b2, _filType,
                                                   lpf - 1, false, false, true);
+    _subSystem->cylinderNeighborListSkin.markTopologyChanged();
     c0->setMinusEnd(true);
     _cylinderVector.push_front(c0);
     
@@ -306,6 +311,7 @@ void Filament::extendPlusEnd(short plusEnd) {
     
     Cylinder* c0 = _subSystem->addTrackable<Cylinder>(this, b2, bNew, _filType,
                                                       lpf + 1, true);
+    _subSystem->cylinderNeighborListSkin.markTopologyChanged();
 
     mins = chrono::high_resolution_clock::now();
     _cylinderVector.back()->setPlusEnd(false);
@@ -379,6 +385,7 @@ void Filament::extendMinusEnd(short minusEnd) {
     
     Cylinder* c0 = _subSystem->addTrackable<Cylinder>(this, bNew, b2, _filType,
                                                       lpf - 1, false, true);
+    _subSystem->cylinderNeighborListSkin.markTopologyChanged();
     _cylinderVector.front()->setMinusEnd(false);
     _cylinderVector.push_front(c0);
     _cylinderVector.front()->setMinusEnd(true);
@@ -438,6 +445,7 @@ void Filament::retractPlusEnd() {
                                                              ""<<retCylinder->getStableIndex()<<endl;
     #endif
     _subSystem->removeTrackable<Cylinder>(retCylinder);
+    _subSystem->cylinderNeighborListSkin.markTopologyChanged();
     removeChild(retCylinder);
     
     _cylinderVector.back()->setPlusEnd(true);
@@ -473,6 +481,7 @@ void Filament::retractMinusEnd() {
     cout<<"RemoveTrackable Cylinder "<<retCylinder->getId()<<" "<<retCylinder->getStableIndex() <<endl;
     #endif
     _subSystem->removeTrackable<Cylinder>(retCylinder);
+    _subSystem->cylinderNeighborListSkin.markTopologyChanged();
     removeChild(retCylinder);
     
     _cylinderVector.front()->setMinusEnd(true);
@@ -723,8 +732,8 @@ Filament* Filament::sever(int cylinderPosition) {
         (Rand::randInteger(0,1) ? -1 : +1) * Rand::randfloatingpoint(msize, 2 * msize),
     };
     
-    oldB->coord += offsetCoord;
-    newB->coord -= offsetCoord;
+    oldB->coordinate() += offsetCoord;
+    newB->coordinate() -= offsetCoord;
     
     //add bead
     c1->setSecondBead(newB);
@@ -762,6 +771,9 @@ Filament* Filament::sever(int cylinderPosition) {
     cc1->removeCrossCylinderReactions(cc2);
     cc2->removeCrossCylinderReactions(cc1);
 
+    // Cylinders now belong to a different filament.
+    _subSystem->cylinderNeighborListSkin.markTopologyChanged();
+
     _severingReaction++;
     _severingID.push_back(newFilament->getId());
     return newFilament;
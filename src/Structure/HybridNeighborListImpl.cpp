@@ -23,6 +23,7 @@
 #include "Controller/GController.h"
 #include "MathFunctions.h"
 #include "CUDAcommon.h"
+#include "Util/ThreadPool.hpp"
 
 namespace medyan {
 using namespace mathfunc;
@@ -335,21 +336,31 @@ void HybridCylinderCylinderNL::updateNeighborsbin(Cylinder* currcylinder, bool r
         _crosscheckdumpFileNL<<"Updating neighbors for  cylinder ID "<<currcylinder->getId()
         <<endl;
 
-    //clear existing neighbors of currcylinder from all neighborlists
-    for(int idx = 0; idx < totaluniquefIDpairs; idx++) {
-        int countbounds = _rMaxsqvec[idx].size();
-        for (int idx2 = 0; idx2 < countbounds; idx2++) {
-            auto HNLID = HNLIDvec[idx][idx2];
-            _list4mbinvec[HNLID][currcylinder].clear();
-        }
+    //find neighbors of currcylinder in all neighborlists
+    _rowBuffers.resize(_list4mbinvec.size());
+    vector<vector<Cylinder*>*> lists(_list4mbinvec.size(), nullptr);
+    for(int HNLID = 0; HNLID < _list4mbinvec.size(); HNLID++) {
+        _rowBuffers[HNLID].clear();
+        lists[HNLID] = &_rowBuffers[HNLID];
+    }
+    //Check if the cylinder has been assigned a bin. If not, assign.
+    if(currcylinder->hbin == nullptr)
+        assignbin(currcylinder);
+
+    findNeighborsbin(currcylinder, lists.data(), false);
+
+    //replace existing neighbors of currcylinder
+    for(int HNLID = 0; HNLID < _list4mbinvec.size(); HNLID++) {
+        _list4mbinvec[HNLID].assignRow(currcylinder, _rowBuffers[HNLID]);
     }
+}
+
+void HybridCylinderCylinderNL::findNeighborsbin(
+    Cylinder* currcylinder, vector<Cylinder*>* const* lists, bool cindicesupdated
+) {
     //get necessary variables
     auto binvec = currcylinder->hbin;//The different hybrid bins that this cylinder
     // belongs to.
-    //Check if the cylinder has been assigned a bin. If not, assign.
-    if(binvec == nullptr)
-        assignbin(currcylinder);
-    binvec = currcylinder->hbin;
     //get parent bin corresponding to this hybrid neighbor list.
     auto parentbin =  binvec;
     //get neighboring bins
@@ -379,7 +390,8 @@ void HybridCylinderCylinderNL::updateNeighborsbin(Cylinder* currcylinder, bool r
                                                         _largestrMax);
             nbincount++;
             if (isbinneeded) {
-                auto cindicesvec = bin->getcindices();
+                if(!cindicesupdated) bin->updatecindices();
+                const auto& cindicesvec = bin->getcindicesnoupdate();
 
                 if(CROSSCHECK_NL_SWITCH && _crosscheckdumpFileNL.is_open())
                     _crosscheckdumpFileNL<<"Cindices obtained in bin "<<bin->_ID<<" n "
@@ -440,7 +452,7 @@ void HybridCylinderCylinderNL::updateNeighborsbin(Cylinder* currcylinder, bool r
                             short HNLID = HNLIDvec[idx][idx2];
                             //If we got through all of this, add it!
                             Cylinder *Ncylinder = Cylinder::getStableElement(ncindex);
-                            _list4mbinvec[HNLID][currcylinder].push_back(Ncylinder);
+                            lists[HNLID]->push_back(Ncylinder);
 
                             //Full list was needed to remove possible bindings. To remove
                             // by value, we had to look for keys that might have the
@@ -470,12 +482,6 @@ void HybridCylinderCylinderNL::updateNeighborsbin(Cylinder* currcylinder, bool r
 
 }
 
-vector<Cylinder*> HybridCylinderCylinderNL::getNeighborsstencil(short HNLID, Cylinder*
-                                                                cylinder) {
-
-    return _list4mbinvec[HNLID][cylinder];
-}
-
 void HybridCylinderCylinderNL::addNeighbor(Neighbor* n) {
 
     //return if not a cylinder!
@@ -500,21 +506,10 @@ void HybridCylinderCylinderNL::removeNeighbor(Neighbor* n) {
                           cylinder->getStableIndex()<<" and ID "<<cylinder->getId() <<
                           " from NL " <<HNLID << endl;*/
             //Remove from NeighborList
-            _list4mbinvec[HNLID].erase(cylinder);
+            _list4mbinvec[HNLID].removeRow(cylinder);
             //TODO if the list is a full list, searching through a subset of the neighborlist is enough to get all entries with n as value.
             //remove from other lists
-//            std::cout << "Removed from cylinders ";
-            for (auto it = _list4mbinvec[HNLID].begin();
-                 it != _list4mbinvec[HNLID].end(); it++) {
-                auto cit = find(it->second.begin(), it->second.end(), cylinder);
-                {
-                    if (cit != it->second.end()) {
-/*                        cout<<"Deleted "<<*(cit)<<" from list corresponding to cylinder "
-                        <<it->first<<" from position "<<cit-it->second.begin()<<endl;*/
-                        it->second.erase(cit);
-                    }
-                }
-            }
+            _list4mbinvec[HNLID].removeNeighborInAllRows(cylinder);
 
 //            std::cout<<endl;
         }
@@ -524,6 +519,12 @@ void HybridCylinderCylinderNL::removeNeighbor(Neighbor* n) {
     unassignbin(cylinder, cylinder->hbin);
 }
 
+void HybridCylinderCylinderNL::updateBins() {
+    updateallcylinderstobin();
+    _binGrid->updatecindices();
+    updateRowIndices();
+}
+
 void HybridCylinderCylinderNL::reset() {
 
     //loop through all neighbor keys
@@ -532,8 +533,19 @@ void HybridCylinderCylinderNL::reset() {
 //        std::cout<<"Hybrid rmin rmax "<<_rMinsqvec[idx]<<" "<<_rMaxsqvec[idx]<<endl;
     }
     //check and reassign cylinders to different bins if needed.
-    updateallcylinderstobin();
-    _binGrid->updatecindices();
+    updateBins();
+
+    if(!CROSSCHECK_NL_SWITCH) {
+        // Neighbors of all cylinders are found in parallel, and all the lists
+        // are rebuilt at once.
+        vector<CylinderNeighborListCSR*> lists;
+        for(auto& l : _list4mbinvec) lists.push_back(&l);
+        CylinderNeighborListCSR::buildAll(lists, Cylinder::getCylinders(), [this](Cylinder* c, vector<Cylinder*>* const* outputs) {
+            findNeighborsbin(c, outputs, true);
+        });
+        return;
+    }
+
     for(auto cylinder: Cylinder::getCylinders()) {
 
         if(CROSSCHECK_NL_SWITCH && _crosscheckdumpFileNL.is_open())
@@ -545,7 +557,7 @@ void HybridCylinderCylinderNL::reset() {
             _crosscheckdumpFileNL<<"Updated neighbors bin "<<cylinder->getId()
                                  <<" "<<cylinder->getStableIndex()<<endl;
         for (int idx = 0; idx < totalhybridNL; idx++) {
-            for(auto cn:_list4mbinvec[idx][cylinder]) {
+            for(auto cn:_list4mbinvec[idx].getNeighbors(cylinder)) {
                 _crosscheckdumpFileNL<<cn->getId()<<" ";
             }
             _crosscheckdumpFileNL<<"|";
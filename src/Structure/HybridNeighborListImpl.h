@@ -24,6 +24,7 @@
 #include "DynamicNeighbor.h"
 #include "BinGrid.h"
 #include "SysParams.h"
+#include "Structure/NeighborListImpl.h"
 
 namespace medyan {
 //FORWARD DECLARATIONS
@@ -37,7 +38,8 @@ class HybridCylinderCylinderNL : public HybridNeighborList {
 private:
     static const bool CROSSCHECK_NL_SWITCH = false;
 
-    vector<unordered_map<Cylinder*, vector<Cylinder*>>> _list4mbinvec;
+    vector<CylinderNeighborListCSR> _list4mbinvec; ///< Neighbor lists in CSR format, indexed by HNLID
+    vector<vector<Cylinder*>> _rowBuffers; ///< Buffers for the neighbors of a cylinder in each list
 //    unordered_map<Cylinder*, vector<Cylinder*>> _list4mbin;
     ///Helper function to update neighbors
     ///@param runtime - specifying whether the cylinder is being
@@ -66,7 +68,14 @@ public:
     void updateallcylinderstobin();//updates bin associations of all cylinders
     void updatebin(Cylinder* cyl);//updates bin association of a cylinder.
     void updateNeighborsbin(Cylinder* cylinder, bool runtime = false);
-    vector<Cylinder*> getNeighborsstencil(short HNLID, Cylinder* cylinder);//Each unique neighborList in the HybridNeighborList has an associated ID HNLID.
+    // Find neighbors of a cylinder, and append them to lists[HNLID] for each neighbor list.
+    // If cindicesupdated is true, cylinder indices in all bins must be up to date, and
+    // neighbors of different cylinders can be found concurrently.
+    void findNeighborsbin(Cylinder* cylinder, vector<Cylinder*>* const* lists, bool cindicesupdated);
+    CylinderNeighborListCSR::SpanType getNeighborsstencil(short HNLID, Cylinder* cylinder) const {//Each unique neighborList in the HybridNeighborList has an associated ID HNLID.
+        return _list4mbinvec[HNLID].getNeighbors(cylinder);
+    }
+    const CylinderNeighborListCSR& getList(short HNLID) const { return _list4mbinvec[HNLID]; }
     //This ID is assigned when the parameters are set.
 
     //For any pair wise cylinder map requested, additional parameters such as fullstatus and uniquestatus are required.
@@ -76,6 +85,11 @@ public:
         short returnHNLID = -1;//Each unique neighborList in the HybridNeighborList has an associated ID HNLID.
         //This ID is assigned when the parameters are set.
         vector<short> ftypepairs;
+        //Cutoffs are extended by the skin, so the lists remain valid for small
+        //displacements of cylinders.
+        const float skin = SysParams::Chemistry().chemistryAlgorithm.neighborListSkin;
+        rMin = max<float>(rMin - skin, 0);
+        rMax = rMax + skin;
         float localrMinsq = rMin * rMin;
         float localrMaxsq = rMax * rMax;
         if(ftype1 < ftype2)
@@ -103,7 +117,6 @@ public:
             //search through the vectors to find if the non-unique NL
             //If it is not found, add.
             bool isfound = false;
-            unordered_map<Cylinder*, vector<Cylinder*>> _nlstbin;
             for(short idx = 0; idx <totaluniquefIDpairs; idx++) {
                 vector<short> fIDpair = _filamentIDvec[idx];
                 if (isfound|| fIDpair[0] != ftypepairs[0] || fIDpair[1] != ftypepairs[1])
@@ -121,7 +134,7 @@ public:
                         _maxcylsize= max(localmaxcylsize,_maxcylsize);
                         HNLIDvec[idx].push_back(totalhybridNL); // assign ID
                         returnHNLID = totalhybridNL;
-                        _list4mbinvec.push_back(_nlstbin);
+                        _list4mbinvec.emplace_back();
                         totalhybridNL++;
                         break;
                     } else {
@@ -148,7 +161,7 @@ public:
                     _fullstatusvec[idx].push_back(fullstatus);
                     _smallestrMinsq = min(localrMinsq, _smallestrMinsq);
                     _largestrMaxsq = max(localrMaxsq, _largestrMaxsq);
-                    _list4mbinvec.push_back(_nlstbin);
+                    _list4mbinvec.emplace_back();
                      isfound = true;
                     break;
                 }
@@ -159,9 +172,8 @@ public:
                 vector<short> totalhybridNLvec = {totalhybridNL};
                 vector<bool> localuniquestatusvec ={uniquestatus};
                 vector<bool> localfullstatusvec ={fullstatus};
-                unordered_map<Cylinder*, vector<Cylinder*>> _nlstbin;
 //                if(uniquestatus){
-                _list4mbinvec.push_back(_nlstbin);
+                _list4mbinvec.emplace_back();
                 _rMaxsqvec.push_back(localrMaxsqvec);
                 _rMinsqvec.push_back(localrMinsqvec);
                 _filamentIDvec.push_back(ftypepairs);
@@ -217,6 +229,13 @@ public:
     virtual void removeDynamicNeighbor(DynamicNeighbor* n) {removeNeighbor(n);}
     //@}
     virtual void reset();
+    /// Update the neighbor lists after the stable indices of cylinders change
+    void updateRowIndices() {
+        for(auto& l : _list4mbinvec) l.updateRowIndices();
+    }
+    /// Reassign cylinders to bins and update the cylinder indices in bins,
+    /// without rebuilding the neighbor lists
+    void updateBins();
 
     /// Get all cylinder neighbors
     vector<Cylinder*> getNeighbors(Cylinder* cylinder);
@@ -30,15 +30,16 @@ using namespace mathfunc;
 
 void Linker::updateCoordinate() {
     
-    auto x1 = _c1->getFirstBead()->vcoordinate();
-    auto x2 = _c1->getSecondBead()->vcoordinate();
-    auto x3 = _c2->getFirstBead()->vcoordinate();
-    auto x4 = _c2->getSecondBead()->vcoordinate();
+    const auto& x1 = _c1->getFirstBead()->coordinate();
+    const auto& x2 = _c1->getSecondBead()->coordinate();
+    const auto& x3 = _c2->getFirstBead()->coordinate();
+    const auto& x4 = _c2->getSecondBead()->coordinate();
     
     auto m1 = midPointCoordinate(x1, x2, _c1->adjustedrelativeposition(_position1));
     auto m2 = midPointCoordinate(x3, x4, _c2->adjustedrelativeposition(_position2));
     
-    coordinate = midPointCoordinate(m1, m2, 0.5);
+    const auto mid = midPointCoordinate(m1, m2, 0.5);
+    coordinate.assign(mid.begin(), mid.end());
 }
 
 Linker::Linker(
@@ -61,10 +62,10 @@ Linker::Linker(
         mLinker_.kStretch = SysParams::Mechanics().LStretchingK[linkerType];
 
     // Set equilibrium length.
-    auto x1 = _c1->getFirstBead()->vcoordinate();
-    auto x2 = _c1->getSecondBead()->vcoordinate();
-    auto x3 = _c2->getFirstBead()->vcoordinate();
-    auto x4 = _c2->getSecondBead()->vcoordinate();
+    const auto& x1 = _c1->getFirstBead()->coordinate();
+    const auto& x2 = _c1->getSecondBead()->coordinate();
+    const auto& x3 = _c2->getFirstBead()->coordinate();
+    const auto& x4 = _c2->getSecondBead()->coordinate();
 
     auto m1 = midPointCoordinate(x1, x2, c1->adjustedrelativeposition(position1));
     auto m2 = midPointCoordinate(x3, x4, c2->adjustedrelativeposition(position2));
@@ -146,10 +147,10 @@ void Linker::updatePosition() {
     }
     
     if(SysParams::RUNSTATE) {
-        auto x1 = _c1->getFirstBead()->vcoordinate();
-        auto x2 = _c1->getSecondBead()->vcoordinate();
-        auto x3 = _c2->getFirstBead()->vcoordinate();
-        auto x4 = _c2->getSecondBead()->vcoordinate();
+        const auto& x1 = _c1->getFirstBead()->coordinate();
+        const auto& x2 = _c1->getSecondBead()->coordinate();
+        const auto& x3 = _c2->getFirstBead()->coordinate();
+        const auto& x4 = _c2->getSecondBead()->coordinate();
 
         auto m1 = midPointCoordinate(x1, x2, _c1->adjustedrelativeposition(_position1));
         auto m2 = midPointCoordinate(x3, x4, _c2->adjustedrelativeposition(_position2));
@@ -189,6 +190,15 @@ void Linker::updateReactionRates() {
         offRxn->setRateMulFactor(factor, ReactionBase::mechanochemical);
         offRxn->updatePropensity();
     }
+    _rateInputs.record({ force }, SysParams::RUNSTATE);
+}
+
+void Linker::updateReactionRatesIfChanged(floatingpoint forceTolerance) {
+
+    floatingpoint force = max<floatingpoint>((floatingpoint)0.0, mLinker_.stretchForce);
+
+    if(_rateInputs.changed({ force }, SysParams::RUNSTATE, forceTolerance))
+        updateReactionRates();
 }
 
 
@@ -71,6 +71,9 @@ private:
     
     ///For dynamic rate unbinding
     static vector<LinkerRateChanger*> _unbindingChangers;
+
+    /// Stretching force used in the last rate update
+    RateInputs<1> _rateInputs;
     
     ///Helper to get coordinate
     void updateCoordinate();
@@ -145,6 +148,7 @@ public:
     
     /// Update the reaction rates, inherited from Reactable
     virtual void updateReactionRates();
+    virtual void updateReactionRatesIfChanged(floatingpoint forceTolerance);
     
     virtual void printSelf()const;
     
@@ -31,15 +31,16 @@ using namespace mathfunc;
 
 void MotorGhost::updateCoordinate() {
     
-    auto x1 = _c1->getFirstBead()->vcoordinate();
-    auto x2 = _c1->getSecondBead()->vcoordinate();
-    auto x3 = _c2->getFirstBead()->vcoordinate();
-    auto x4 = _c2->getSecondBead()->vcoordinate();
+    const auto& x1 = _c1->getFirstBead()->coordinate();
+    const auto& x2 = _c1->getSecondBead()->coordinate();
+    const auto& x3 = _c2->getFirstBead()->coordinate();
+    const auto& x4 = _c2->getSecondBead()->coordinate();
     
     auto m1 = midPointCoordinate(x1, x2, _c1->adjustedrelativeposition(_position1));
     auto m2 = midPointCoordinate(x3, x4, _c2->adjustedrelativeposition(_position2));
     
-    coordinate = midPointCoordinate(m1, m2, 0.5);
+    const auto mid = midPointCoordinate(m1, m2, 0.5);
+    coordinate.assign(mid.begin(), mid.end());
 }
 
 
@@ -79,10 +80,10 @@ MotorGhost::MotorGhost(
 #endif
 
     // Set equilibrium length.
-    auto x1 = _c1->getFirstBead()->vcoordinate();
-    auto x2 = _c1->getSecondBead()->vcoordinate();
-    auto x3 = _c2->getFirstBead()->vcoordinate();
-    auto x4 = _c2->getSecondBead()->vcoordinate();
+    const auto& x1 = _c1->getFirstBead()->coordinate();
+    const auto& x2 = _c1->getSecondBead()->coordinate();
+    const auto& x3 = _c2->getFirstBead()->coordinate();
+    const auto& x4 = _c2->getSecondBead()->coordinate();
 
     auto m1 = midPointCoordinate(x1, x2, c1->adjustedrelativeposition(position1));
     auto m2 = midPointCoordinate(x3, x4, c2->adjustedrelativeposition(position2));
@@ -171,10 +172,10 @@ void MotorGhost::updatePosition() {
     }
     
     if(SysParams::RUNSTATE) {
-        auto x1 = _c1->getFirstBead()->vcoordinate();
-        auto x2 = _c1->getSecondBead()->vcoordinate();
-        auto x3 = _c2->getFirstBead()->vcoordinate();
-        auto x4 = _c2->getSecondBead()->vcoordinate();
+        const auto& x1 = _c1->getFirstBead()->coordinate();
+        const auto& x2 = _c1->getSecondBead()->coordinate();
+        const auto& x3 = _c2->getFirstBead()->coordinate();
+        const auto& x4 = _c2->getSecondBead()->coordinate();
 
         auto m1 = midPointCoordinate(x1, x2, _c1->adjustedrelativeposition(_position1));
         auto m2 = midPointCoordinate(x3, x4, _c2->adjustedrelativeposition(_position2));
@@ -206,9 +207,9 @@ void MotorGhost::updatePosition() {
 /// consider compression forces, only stretching.
 void MotorGhost::updateReactionRates() {
 
-    //current force
-    floatingpoint force = max<floatingpoint>((floatingpoint)0.0,
-            mMotorGhost_.stretchForce);
+    //current force, and its components in the direction of forward walk for C1, C2
+    auto rateInputForces = rateInputForces_();
+    floatingpoint force = rateInputForces[0];
     
     //update number of bound heads
     if(!_unbindingChangers.empty())
@@ -218,11 +219,6 @@ void MotorGhost::updateReactionRates() {
     
     //walking rate changer
     if(!_walkingChangers.empty()) {
-        auto x1 = _c1->getFirstBead()->vcoordinate();
-        auto x2 = _c1->getSecondBead()->vcoordinate();
-        auto x3 = _c2->getFirstBead()->vcoordinate();
-        auto x4 = _c2->getSecondBead()->vcoordinate();
-
 	    const auto& cylinderInfoData = Cylinder::getDbData();
 
 	    auto c1struct = cylinderInfoData[_c1->getStableIndex()];
@@ -248,21 +244,8 @@ void MotorGhost::updateReactionRates() {
 		    isc1leftofc2 = c1posonFil < c2posonFil;
 	    }
 
-        auto mp1 = midPointCoordinate(x1, x2, _c1->adjustedrelativeposition(_position1));
-        auto mp2 = midPointCoordinate(x3, x4, _c2->adjustedrelativeposition(_position2));
-
-        //get component of force in direction of forward walk for C1, C2
-        vector<floatingpoint> motorC1Direction =
-        twoPointDirection(mp1, mp2);
-        
-        vector<floatingpoint> motorC2Direction =
-        twoPointDirection(mp2, mp1);
-        
-        vector<floatingpoint> c1Direction = twoPointDirection(x2,x1);
-        vector<floatingpoint> c2Direction = twoPointDirection(x4,x3);
-        
-        floatingpoint forceDotDirectionC1 = force * dotProduct(motorC1Direction, c1Direction);
-        floatingpoint forceDotDirectionC2 = force * dotProduct(motorC2Direction, c2Direction);
+        floatingpoint forceDotDirectionC1 = rateInputForces[1];
+        floatingpoint forceDotDirectionC2 = rateInputForces[2];
         
         //WALKING REACTIONS
         Species* s1 = _cMotorGhost->getFirstSpecies();
@@ -427,6 +410,66 @@ void MotorGhost::updateReactionRates() {
         offRxn->setBareRate(newRate);
         offRxn->activateReaction();
     }
+
+    _rateInputs.record(rateInputForces, rateInputFlags_());
+}
+
+std::array< floatingpoint, 2 > MotorGhost::walkingDirectionCosines_() {
+
+    const auto& x1 = _c1->getFirstBead()->coordinate();
+    const auto& x2 = _c1->getSecondBead()->coordinate();
+    const auto& x3 = _c2->getFirstBead()->coordinate();
+    const auto& x4 = _c2->getSecondBead()->coordinate();
+
+    auto mp1 = midPointCoordinate(x1, x2, _c1->adjustedrelativeposition(_position1));
+    auto mp2 = midPointCoordinate(x3, x4, _c2->adjustedrelativeposition(_position2));
+
+    auto motorC1Direction = twoPointDirection(mp1, mp2);
+    auto motorC2Direction = twoPointDirection(mp2, mp1);
+
+    auto c1Direction = twoPointDirection(x2,x1);
+    auto c2Direction = twoPointDirection(x4,x3);
+
+    return {
+        dotProduct(motorC1Direction, c1Direction),
+        dotProduct(motorC2Direction, c2Direction)
+    };
+}
+
+MotorGhost::RateInputsType::ForceArray MotorGhost::rateInputForces_() {
+
+    floatingpoint force = max<floatingpoint>((floatingpoint)0.0,
+            mMotorGhost_.stretchForce);
+
+    if(_walkingChangers.empty()) return { force, 0, 0 };
+
+    auto walkingCosines = walkingDirectionCosines_();
+    return { force, force * walkingCosines[0], force * walkingCosines[1] };
+}
+
+unsigned MotorGhost::rateInputFlags_() {
+
+    if(_walkingChangers.empty()) return (unsigned)SysParams::RUNSTATE;
+
+    // The number of walking reactions is included, so that walking reactions
+    // added after the last update (e.g. onto a new cylinder) also get their
+    // rates, even if the forces did not change.
+    unsigned numWalking = 0;
+    for(auto s : { _cMotorGhost->getFirstSpecies(), _cMotorGhost->getSecondSpecies() }) {
+        for(auto r : s->getRSpecies().reactantReactions()) {
+            const auto type = r->getReactionType();
+            if(type == ReactionType::MOTORWALKINGFORWARD ||
+               type == ReactionType::MOTORWALKINGBACKWARD)
+                ++numWalking;
+        }
+    }
+    return (unsigned)SysParams::RUNSTATE | numWalking << 1;
+}
+
+void MotorGhost::updateReactionRatesIfChanged(floatingpoint forceTolerance) {
+
+    if(_rateInputs.changed(rateInputForces_(), rateInputFlags_(), forceTolerance))
+        updateReactionRates();
 }
 
 void MotorGhost::moveMotorHead(Cylinder* c,
@@ -455,6 +498,9 @@ void MotorGhost::moveMotorHead(Cylinder* c,
     _cMotorGhost->moveMotorHead(c->getCCylinder(), oldpos, newpos,
                                 speciesMotorIndex, boundType, ps);
 
+    // The walking reactions now belong to other species.
+    _rateInputs.reset();
+
     
 }
 
@@ -481,6 +527,8 @@ void MotorGhost::moveMotorHead(Cylinder* oldC, Cylinder* newC,
     
     _cMotorGhost->moveMotorHead(oldC->getCCylinder(), newC->getCCylinder(),
                                 oldpos, newpos, speciesMotorIndex, boundType, ps);
+
+    _rateInputs.reset();
 }
 
 
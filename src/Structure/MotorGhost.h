@@ -105,6 +105,19 @@ private:
     ///For dynamic rate walking
     static vector<MotorRateChanger*> _walkingChangers;
 
+    /// Stretching force and its components along the walking directions of
+    /// both heads, used in the last rate update
+    using RateInputsType = RateInputs<3>;
+    RateInputsType _rateInputs;
+
+    ///Helper to get the cosines between the motor and the walking directions
+    ///on both cylinders
+    std::array< floatingpoint, 2 > walkingDirectionCosines_();
+    ///Helper to get the current forces that the rates depend on
+    RateInputsType::ForceArray rateInputForces_();
+    ///Helper to get the current flags that the rates depend on
+    unsigned rateInputFlags_();
+
 
 
 public:
@@ -203,6 +216,7 @@ public:
 
     /// Update the reaction rates, inherited from Reactable
     virtual void updateReactionRates();
+    virtual void updateReactionRatesIfChanged(floatingpoint forceTolerance);
     
     ///Move a motor head forward
     ///@note - Updates chemical binding and mechanical parameters accordingly
@@ -67,6 +67,10 @@ public:
     /// Re-initialize the neighborlist
     virtual void reset() = 0;
 
+    /// Update the neighborlist after the indices of elements change, without
+    /// searching for neighbors
+    virtual void updateRowIndices() {}
+
 };
 
 } // namespace medyan
@@ -0,0 +1,344 @@
+#ifndef MEDYAN_Structure_NeighborListCSR_hpp
+#define MEDYAN_Structure_NeighborListCSR_hpp
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "common.h"
+#include "Util/Span.hpp"
+#include "Util/ThreadPool.hpp"
+
+namespace medyan {
+
+// Neighbor list stored in the compressed sparse row (CSR) format.
+//
+// Each key (for example, a cylinder) owns a row, which is a segment of one
+// contiguous array of neighbors. Rows are indexed by an integer index of the
+// key (for example, the stable index of the cylinder) given by RowIndexOf, so
+// no hashing is needed to find the neighbors.
+//
+// Template parameters:
+// - Key:        a nullable handle of the element owning the row, such as a pointer.
+// - T:          type of the neighbors.
+// - RowIndexOf: function object with
+//     - Index operator()(Key), which returns the row index of the key, and
+//     - std::size_t version(), which changes whenever the row index of any
+//       existing key changes.
+//
+// Note:
+// - After a full build, rows are packed in the order of the keys.
+// - Rows can be modified at runtime. A row that outgrows its segment is moved
+//   to the end of the array, leaving a gap which is reclaimed on the next
+//   full build.
+// - The key of each row is also recorded. If the row indices of the keys
+//   change (for example, after Database::rearrange()), the rows are remapped
+//   by updateRowIndices(), which is also called by all modifiers. Lookups do
+//   not modify the list; before the rows are remapped, they fall back to a
+//   linear search of the keys. Keys must be removed from the list before they
+//   are invalidated.
+// - Concurrent lookups are thread-safe, but modifications are not. Building
+//   the list runs in parallel on the global thread pool.
+template< typename Key, typename T, typename RowIndexOf >
+class NeighborListCSR {
+public:
+    using KeyType     = Key;
+    using ElementType = T;
+    using SpanType    = Span< const T >;
+
+    // Build several lists at once, for all the keys.
+    //
+    // Parameters:
+    // - lists: the lists to be rebuilt.
+    // - keys:  a random access range of keys, with distinct row indices.
+    // - func:  (Key, std::vector<T>* const* outputs) -> void, which appends
+    //          the neighbors of the key in lists[i] to *outputs[i].
+    template< typename KeyRange, typename Func >
+    static void buildAll(const std::vector< NeighborListCSR* >& lists, const KeyRange& keys, Func&& func) {
+        const Size numLists = lists.size();
+        const Size numKeys  = keys.size();
+        if(numLists == 0) return;
+
+        Size numRows = 0;
+        for(Index i = 0; i < numKeys; ++i) {
+            numRows = std::max< Size >(numRows, lists[0]->rowIndexOf_(keys[i]) + 1);
+        }
+        for(auto pl : lists) {
+            pl->clear();
+            pl->resizeRows_(numRows);
+            pl->version_ = pl->rowIndexOf_.version();
+        }
+
+        // Neighbors are first gathered in chunks of keys, and then copied to
+        // the contiguous array.
+        auto& pool = ThreadPool::global();
+        const Size numChunks = std::min< Size >(numKeys, 4 * (pool.numThreads() + 1));
+        std::vector< std::vector< std::vector< T > > > chunkData(numChunks, std::vector< std::vector< T > >(numLists));
+        const auto chunkBegin = [&](Index c) { return numKeys * c / numChunks; };
+
+        pool.parallelFor(0, numChunks, [&](Index c) {
+            auto& data = chunkData[c];
+            std::vector< std::vector< T >* > outputs(numLists);
+            for(Index li = 0; li < numLists; ++li) outputs[li] = &data[li];
+
+            for(Index i = chunkBegin(c); i < chunkBegin(c + 1); ++i) {
+                const Key key = keys[i];
+                const Index row = lists[0]->rowIndexOf_(key);
+                for(Index li = 0; li < numLists; ++li) {
+                    lists[li]->rowBegin_[row] = data[li].size();
+                }
+                func(key, outputs.data());
+                for(Index li = 0; li < numLists; ++li) {
+                    auto& l = *lists[li];
+                    l.rowKeys_[row] = key;
+                    l.rowSize_[row] = data[li].size() - l.rowBegin_[row];
+                    l.rowCapacity_[row] = l.rowSize_[row];
+                }
+            }
+        });
+
+        for(Index li = 0; li < numLists; ++li) {
+            auto& l = *lists[li];
+            std::vector< Index > chunkOffset(numChunks + 1);
+            for(Index c = 0; c < numChunks; ++c) {
+                chunkOffset[c + 1] = chunkOffset[c] + chunkData[c][li].size();
+            }
+            l.data_.resize(chunkOffset[numChunks]);
+            l.numNeighbors_ = chunkOffset[numChunks];
+
+            pool.parallelFor(0, numChunks, [&](Index c) {
+                auto& data = chunkData[c][li];
+                std::copy(data.begin(), data.end(), l.data_.begin() + chunkOffset[c]);
+                for(Index i = chunkBegin(c); i < chunkBegin(c + 1); ++i) {
+                    l.rowBegin_[l.rowIndexOf_(keys[i])] += chunkOffset[c];
+                }
+            });
+        }
+    }
+
+    // Build the list for all the keys.
+    // Func: (Key, std::vector<T>& output) -> void, which appends the neighbors of the key to output.
+    template< typename KeyRange, typename Func >
+    void build(const KeyRange& keys, Func&& func) {
+        buildAll({ this }, keys, [&](Key key, std::vector< T >* const* outputs) {
+            func(key, *outputs[0]);
+        });
+    }
+
+    // Accessors.
+    //----------------------------------
+
+    // Get all neighbors of the key. Returns an empty span if the key has no row.
+    SpanType getNeighbors(Key key) const {
+        const auto row = findRow_(key);
+        if(row == noRow) return {};
+        return SpanType(data_.data() + rowBegin_[row], rowSize_[row]);
+    }
+    bool hasRow(Key key) const { return findRow_(key) != noRow; }
+
+    // Whether the rows are at the current row indices of their keys, so that
+    // lookups do not need to search the keys.
+    bool rowIndicesUpdated() const { return rowIndexOf_.version() == version_; }
+
+    // Number of rows, including those with no keys.
+    Size numRows() const { return rowKeys_.size(); }
+    // Total number of neighbors in all rows.
+    Size numNeighbors() const { return numNeighbors_; }
+    // Approximate number of bytes allocated.
+    Size memoryUsage() const {
+        return rowKeys_.capacity() * sizeof(Key)
+            + (rowBegin_.capacity() + rowSize_.capacity() + rowCapacity_.capacity()) * sizeof(Index)
+            + data_.capacity() * sizeof(T);
+    }
+
+    // Loop over all rows with keys.
+    // Func: (Key, SpanType) -> void
+    template< typename Func >
+    void forEachRow(Func&& func) const {
+        for(Index row = 0; row < numRows(); ++row) {
+            if(rowKeys_[row] != Key{}) {
+                func(rowKeys_[row], SpanType(data_.data() + rowBegin_[row], rowSize_[row]));
+            }
+        }
+    }
+
+    // Modifiers.
+    //----------------------------------
+
+    // Move rows to the current row indices of their keys, if they have changed.
+    void updateRowIndices() {
+        if(!rowIndicesUpdated()) remapRows_();
+    }
+
+    void clear() {
+        rowKeys_.clear();
+        rowBegin_.clear();
+        rowSize_.clear();
+        rowCapacity_.clear();
+        data_.clear();
+        numNeighbors_ = 0;
+    }
+
+    // Replace the neighbors of the key, creating the row if necessary.
+    template< typename Range >
+    void assignRow(Key key, const Range& neighbors) {
+        const auto row = findOrCreateRow_(key);
+        const Size size = std::distance(std::begin(neighbors), std::end(neighbors));
+        reserveRow_(row, size);
+        std::copy(std::begin(neighbors), std::end(neighbors), data_.begin() + rowBegin_[row]);
+        numNeighbors_ += size - rowSize_[row];
+        rowSize_[row] = size;
+    }
+
+    // Append a neighbor to the row of the key, creating the row if necessary.
+    void pushBack(Key key, T neighbor) {
+        const auto row = findOrCreateRow_(key);
+        reserveRow_(row, rowSize_[row] + 1);
+        data_[rowBegin_[row] + rowSize_[row]] = std::move(neighbor);
+        ++rowSize_[row];
+        ++numNeighbors_;
+    }
+
+    // Remove the row of the key.
+    void removeRow(Key key) {
+        updateRowIndices();
+        const auto row = findRow_(key);
+        if(row == noRow) return;
+        numNeighbors_ -= rowSize_[row];
+        rowKeys_[row] = Key{};
+        rowSize_[row] = 0;
+    }
+
+    // Remove the first occurrence of the neighbor in the row of the key,
+    // preserving the order of other neighbors.
+    void removeNeighbor(Key key, const T& neighbor) {
+        updateRowIndices();
+        const auto row = findRow_(key);
+        if(row != noRow) removeNeighborInRow_(row, neighbor);
+    }
+
+    // Remove the first occurrence of the neighbor in every row.
+    void removeNeighborInAllRows(const T& neighbor) {
+        for(Index row = 0; row < numRows(); ++row) {
+            removeNeighborInRow_(row, neighbor);
+        }
+    }
+
+private:
+    static constexpr Index noRow = -1;
+
+    Index findRow_(Key key) const {
+        if(!rowIndicesUpdated()) {
+            // Rows are not remapped yet.
+            const auto it = std::find(rowKeys_.begin(), rowKeys_.end(), key);
+            return it == rowKeys_.end() ? noRow : it - rowKeys_.begin();
+        }
+        const Index row = rowIndexOf_(key);
+        return row < numRows() && rowKeys_[row] == key ? row : noRow;
+    }
+    Index findOrCreateRow_(Key key) {
+        updateRowIndices();
+        auto row = findRow_(key);
+        if(row == noRow) {
+            row = rowIndexOf_(key);
+            if(row >= numRows()) resizeRows_(row + 1);
+            rowKeys_[row] = key;
+            rowSize_[row] = 0;
+        }
+        return row;
+    }
+
+    void resizeRows_(Size numRows) {
+        rowKeys_.resize(numRows, Key{});
+        rowBegin_.resize(numRows, 0);
+        rowSize_.resize(numRows, 0);
+        rowCapacity_.resize(numRows, 0);
+    }
+
+    // Make sure that the row can hold the given number of neighbors.
+    void reserveRow_(Index row, Size size) {
+        if(size <= rowCapacity_[row]) return;
+
+        // Reclaim the gaps before the array grows too much.
+        if(data_.size() > 2 * numNeighbors_ + 1024) compact_();
+
+        const Size newCapacity = std::max< Size >(size, 2 * rowCapacity_[row]);
+        if(rowBegin_[row] + rowCapacity_[row] == data_.size()) {
+            // The row is already at the end.
+            data_.resize(rowBegin_[row] + newCapacity);
+        }
+        else {
+            const Index newBegin = data_.size();
+            data_.resize(newBegin + newCapacity);
+            std::copy_n(data_.begin() + rowBegin_[row], rowSize_[row], data_.begin() + newBegin);
+            rowBegin_[row] = newBegin;
+        }
+        rowCapacity_[row] = newCapacity;
+    }
+
+    void removeNeighborInRow_(Index row, const T& neighbor) {
+        const auto first = data_.begin() + rowBegin_[row];
+        const auto last  = first + rowSize_[row];
+        const auto it = std::find(first, last, neighbor);
+        if(it != last) {
+            std::move(it + 1, last, it);
+            --rowSize_[row];
+            --numNeighbors_;
+        }
+    }
+
+    // Pack all rows in row order, removing the gaps.
+    void compact_() {
+        std::vector< T > newData;
+        newData.reserve(numNeighbors_);
+        for(Index row = 0; row < numRows(); ++row) {
+            const Index newBegin = newData.size();
+            newData.insert(newData.end(), data_.begin() + rowBegin_[row], data_.begin() + rowBegin_[row] + rowSize_[row]);
+            rowBegin_[row] = newBegin;
+            rowCapacity_[row] = rowSize_[row];
+        }
+        data_ = std::move(newData);
+    }
+
+    // Move rows to the current row indices of their keys.
+    void remapRows_() {
+        version_ = rowIndexOf_.version();
+
+        Size newNumRows = 0;
+        for(Index row = 0; row < numRows(); ++row) {
+            if(rowKeys_[row] != Key{}) {
+                newNumRows = std::max< Size >(newNumRows, rowIndexOf_(rowKeys_[row]) + 1);
+            }
+        }
+
+        std::vector< Key >   newKeys(newNumRows, Key{});
+        std::vector< Index > newBegin(newNumRows, 0), newSize(newNumRows, 0), newCapacity(newNumRows, 0);
+        for(Index row = 0; row < numRows(); ++row) {
+            if(rowKeys_[row] != Key{}) {
+                const Index newRow = rowIndexOf_(rowKeys_[row]);
+                newKeys[newRow]     = rowKeys_[row];
+                newBegin[newRow]    = rowBegin_[row];
+                newSize[newRow]     = rowSize_[row];
+                newCapacity[newRow] = rowCapacity_[row];
+            }
+        }
+        rowKeys_     = std::move(newKeys);
+        rowBegin_    = std::move(newBegin);
+        rowSize_     = std::move(newSize);
+        rowCapacity_ = std::move(newCapacity);
+    }
+
+    RowIndexOf           rowIndexOf_;
+    std::vector< Key >   rowKeys_;     // Key owning each row, or Key{} if none.
+    std::vector< Index > rowBegin_;    // Starting position of each row in data_.
+    std::vector< Index > rowSize_;     // Number of neighbors in each row.
+    std::vector< Index > rowCapacity_; // Size of the segment reserved for each row.
+    std::vector< T >     data_;        // Neighbors of all rows.
+    Size                 numNeighbors_ = 0;
+    std::size_t          version_ = 0;     // Version of row indices used by the rows.
+};
+
+} // namespace medyan
+
+#endif
@@ -343,17 +343,14 @@ void CylinderCylinderNL::updateNeighborsbin(Cylinder* cylinder, bool runtime){
     }
 }
 
-vector<Cylinder*> CylinderCylinderNL::getNeighborsstencil(Cylinder* cylinder) {
+const vector<Cylinder*>& CylinderCylinderNL::getNeighborsstencil(Cylinder* cylinder) {
 
 
     return _list4mbin[cylinder];
 }
 #endif
 
-void CylinderCylinderNL::updateNeighbors(Cylinder* cylinder, bool runtime) {
-
-    //clear existing
-    _list[cylinder].clear();
+void CylinderCylinderNL::findNeighbors(Cylinder* cylinder, vector<Cylinder*>& neighbors) const {
 
     //Find surrounding compartments (For now its conservative)
     vector<Compartment*> compartments;
@@ -362,10 +359,7 @@ void CylinderCylinderNL::updateNeighbors(Cylinder* cylinder, bool runtime) {
     GController::findCompartments(mathfunc::vector2Vec<3>(cylinder->coordinate),
                                   cylinder->getCompartment(),
                                   searchDist + _rMax, compartments);
-//    std::cout<<" neighboring cmps "<<compartments.size()<<endl;
-//    int tcyl = 0;
     for(auto &comp : compartments) {
-//        tcyl += comp->getCylinders().size();
         for(auto &ncylinder : comp->getCylinders()) {
             //Don't add the same cylinder!
             if(cylinder == ncylinder) continue;
@@ -388,14 +382,22 @@ void CylinderCylinderNL::updateNeighbors(Cylinder* cylinder, bool runtime) {
             if(distsq > (_rMax * _rMax) || distsq < (_rMin * _rMin)) continue;
 
             //If we got through all of this, add it!
-            _list[cylinder].push_back(ncylinder);
-
-            //if runtime, add to other list as well if full
-            if(runtime && _full)
-                _list[ncylinder].push_back(cylinder);
+            neighbors.push_back(ncylinder);
         }
     }
-//    std::cout<<"Total cyls "<<tcyl<<endl;
+}
+
+void CylinderCylinderNL::updateNeighbors(Cylinder* cylinder, bool runtime) {
+
+    vector<Cylinder*> neighbors;
+    findNeighbors(cylinder, neighbors);
+    _list.assignRow(cylinder, neighbors);
+
+    //if runtime, add to other list as well if full
+    if(runtime && _full) {
+        for(auto ncylinder : neighbors)
+            _list.pushBack(ncylinder, cylinder);
+    }
 }
 
 void CylinderCylinderNL::addNeighbor(Neighbor* n) {
@@ -418,14 +420,10 @@ void CylinderCylinderNL::removeNeighbor(Neighbor* n) {
     Cylinder* cylinder;
     if(!(cylinder = dynamic_cast<Cylinder*>(n))) return;
 #ifdef NLORIGINAL
-    _list.erase(cylinder);
+    _list.removeRow(cylinder);
 
     //remove from other lists
-    for(auto it = _list.begin(); it != _list.end(); it++) {
-
-        auto cit = find(it->second.begin(), it->second.end(), cylinder);
-        if(cit != it->second.end()) it->second.erase(cit);
-    }
+    _list.removeNeighborInAllRows(cylinder);
 #endif
 #ifdef NLSTENCILLIST
 //    std::cout<<"Removing neighbors of "<<cylinder<<" from NL "<<_ID<<endl;
@@ -493,11 +491,9 @@ void CylinderCylinderNL::reset() {
 #ifdef CUDA_TIMETRACK
     mins = chrono::high_resolution_clock::now();
 #endif
-    _list.clear();
-
-    for(auto cylinder: Cylinder::getCylinders()) {
-        updateNeighbors(cylinder);
-    }
+    _list.build(Cylinder::getCylinders(), [this](Cylinder* cylinder, vector<Cylinder*>& neighbors) {
+        findNeighbors(cylinder, neighbors);
+    });
 
 #endif
 
@@ -644,7 +640,7 @@ void CylinderCylinderNL::reset() {
 
         //set neighborlist.
         for(auto c:Cylinder::getCylinders()){
-            _list[c].clear();
+            _list.assignRow(c, vector<Cylinder*>{});
         }
         for(auto id = 0; id < numpairs[0]; id++){
             Cylinder *cylinder = NULL;
@@ -668,7 +664,7 @@ void CylinderCylinderNL::reset() {
                 exit(EXIT_FAILURE);
             }
             else{
-                _list[cylinder].push_back(ncylinder);
+                _list.pushBack(cylinder, ncylinder);
             }
         }
         if(cudacpyforces) {
@@ -729,16 +725,9 @@ void CylinderCylinderNL::reset() {
 #endif
 }
 
-vector<Cylinder*> CylinderCylinderNL::getNeighbors(Cylinder* cylinder) {
-    return _list[cylinder];
-}
-
 //BOUNDARYELEMENT - CYLINDER
 
-void BoundaryCylinderNL::updateNeighbors(BoundaryElement* be) {
-
-    //clear existing
-    _list[be].clear();
+void BoundaryCylinderNL::findNeighbors(BoundaryElement* be, vector<Cylinder*>& neighbors) const {
 
     //loop through beads, add as neighbor
     for (auto &c : Cylinder::getCylinders()) {
@@ -747,10 +736,26 @@ void BoundaryCylinderNL::updateNeighbors(BoundaryElement* be) {
         floatingpoint dist = be->distance(c->coordinate);
 
         //If within range, add it
-        if(dist < _rMax) _list[be].push_back(c);
+        if(dist < _rMax) neighbors.push_back(c);
     }
 }
 
+void BoundaryCylinderNL::removeReverse(BoundaryElement* be) {
+
+    for(auto c : _list.getNeighbors(be))
+        _reverseList.removeNeighbor(c, be);
+}
+
+void BoundaryCylinderNL::updateNeighbors(BoundaryElement* be) {
+
+    removeReverse(be);
+
+    vector<Cylinder*> neighbors;
+    findNeighbors(be, neighbors);
+    _list.assignRow(be, neighbors);
+    for(auto c : neighbors) _reverseList.pushBack(c, be);
+}
+
 void BoundaryCylinderNL::addNeighbor(Neighbor* n) {
 
     //return if not a boundary element!
@@ -766,7 +771,8 @@ void BoundaryCylinderNL::removeNeighbor(Neighbor* n) {
     BoundaryElement* be;
     if(!(be = dynamic_cast<BoundaryElement*>(n))) return;
 
-    _list.erase(be);
+    removeReverse(be);
+    _list.removeRow(be);
 }
 
 void BoundaryCylinderNL::addDynamicNeighbor(DynamicNeighbor* n) {
@@ -776,12 +782,14 @@ void BoundaryCylinderNL::addDynamicNeighbor(DynamicNeighbor* n) {
 
     if(!(c = dynamic_cast<Cylinder*>(n))) return;
 
-    for(auto it = _list.begin(); it != _list.end(); it++) {
-
+    vector<BoundaryElement*> inRange;
+    _list.forEachRow([&](BoundaryElement* be, auto&&) {
         //if within range, add it
-        if(it->first->distance(c->coordinate) < _rMax)
-            it->second.push_back(c);
-    }
+        if(be->distance(c->coordinate) < _rMax)
+            inRange.push_back(be);
+    });
+    for(auto be : inRange) _list.pushBack(be, c);
+    _reverseList.assignRow(c, inRange);
 }
 
 void BoundaryCylinderNL::removeDynamicNeighbor(DynamicNeighbor* n) {
@@ -791,25 +799,23 @@ void BoundaryCylinderNL::removeDynamicNeighbor(DynamicNeighbor* n) {
 
     if(!(c = dynamic_cast<Cylinder*>(n))) return;
 
-    for(auto it = _list.begin(); it != _list.end(); it++) {
-
-        auto cit = find(it->second.begin(), it->second.end(), c);
-        if(cit != it->second.end()) it->second.erase(cit);
-    }
+    // Only the rows of boundary elements having the cylinder are searched.
+    for(auto be : _reverseList.getNeighbors(c))
+        _list.removeNeighbor(be, c);
+    _reverseList.removeRow(c);
 }
 
 void BoundaryCylinderNL::reset() {
 
-    _list.clear();
-
     //loop through all neighbor keys
-    for(auto boundary: BoundaryElement::getBoundaryElements()) {
-        updateNeighbors(boundary);
-    }
-}
-
-vector<Cylinder*> BoundaryCylinderNL::getNeighbors(BoundaryElement* be) {
-    return _list[be];
+    _list.build(BoundaryElement::getBoundaryElements(), [this](BoundaryElement* be, vector<Cylinder*>& neighbors) {
+        findNeighbors(be, neighbors);
+    });
+
+    _reverseList.clear();
+    _list.forEachRow([this](BoundaryElement* be, auto&& neighbors) {
+        for(auto c : neighbors) _reverseList.pushBack(c, be);
+    });
 }
 
 
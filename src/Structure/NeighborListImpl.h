@@ -34,6 +34,7 @@
 #include "Structure/CellList.hpp"
 #include "Structure/Cylinder.h"
 #include "Structure/Filament.h"
+#include "Structure/NeighborListCSR.hpp"
 #include "Structure/SurfaceMesh/Triangle.hpp"
 #include "SysParams.h"
 #include "Util/StableVector.hpp"
@@ -171,13 +172,34 @@ struct NeighborListCellList3D {
 };
 
 
+// Row indices of neighbor lists of cylinders, using the stable indices.
+struct CylinderRowIndex {
+    Index operator()(const Cylinder* c) const { return c->getStableIndex(); }
+    auto version() const { return Cylinder::getNumStableIndexChanges(); }
+};
+using CylinderNeighborListCSR = NeighborListCSR< Cylinder*, Cylinder*, CylinderRowIndex >;
+
+// Whether two cylinders are within the cutoff, using the same criterion as the
+// neighbor list search. Neighbor lists built with a skin also contain cylinders
+// slightly beyond the cutoff, which must be filtered out by interactions that
+// do not have cutoffs by themselves.
+inline bool cylindersWithinCutoff(const Cylinder& c1, const Cylinder& c2, floatingpoint rMax) {
+    return mathfunc::twoPointDistancesquared(c1.coordinate, c2.coordinate) <= rMax * rMax;
+}
+
+// Row indices of neighbor lists of boundary elements.
+struct BoundaryElementRowIndex {
+    Index operator()(const BoundaryElement* be) const { return be->getIndex(); }
+    auto version() const { return BoundaryElement::getNumIndexChanges(); }
+};
+
 /// An implementation of NeighborList for Cylinder-Cylinder interactions
 /// This can be a half or full list depending on the usage.
 class CylinderCylinderNL : public NeighborList {
 
 private:
-    unordered_map<Cylinder*, vector<Cylinder*>> _list;
-    ///< The neighbors list, as a hash map
+    CylinderNeighborListCSR _list;
+    ///< The neighbors list, in CSR format indexed by cylinder stable indices
 
     bool _full; ///<Specifying whether this is a full or half list
     unordered_map<Cylinder*, vector<Cylinder*>> _list4mbin;
@@ -200,6 +222,9 @@ private:
     ///created/destroyed at runtime vs at a full neighbor list update.
     void updateNeighbors(Cylinder* cylinder, bool runtime = false);
 
+    ///Helper function to find neighbors of a cylinder, appending them to neighbors.
+    void findNeighbors(Cylinder* cylinder, vector<Cylinder*>& neighbors) const;
+
 public:
 #ifdef CUDAACCL_NL
     bool cudacpyforces = false;
@@ -242,7 +267,7 @@ public:
     void updateallcylinderstobin();//Checks cylinder coordinates and reassigns bins
     void updatebin(Cylinder* cyl);
     void updateNeighborsbin(Cylinder* cylinder, bool runtime = false);
-    vector<Cylinder*> getNeighborsstencil(Cylinder* cylinder);
+    const vector<Cylinder*>& getNeighborsstencil(Cylinder* cylinder);
 //    void setbinvars(){
 //        initializeBinGrid();
 //        assignallcylinderstobin();
@@ -264,8 +289,13 @@ public:
 #endif
     //While Excluded volume neighborlist is not a full list, linker and motor
     // neighborlists are.
+    /// The cutoffs are extended by the neighbor list skin, so the list
+    /// remains valid for small displacements of cylinders.
     CylinderCylinderNL(float rMax, float rMin = 0.0, bool full = false, short ID = 0)
-            : NeighborList(rMax, rMin), _full(full) {
+            : NeighborList(
+                rMax + SysParams::Chemistry().chemistryAlgorithm.neighborListSkin,
+                std::max<float>(rMin - SysParams::Chemistry().chemistryAlgorithm.neighborListSkin, 0)),
+              _full(full) {
 #ifdef NLSTENCILLIST
         //Right now only two cylinders of same type can be considered for NL.
         NLcyltypes[0] = 0;
@@ -295,9 +325,15 @@ public:
     //@}
 
     virtual void reset();
+    virtual void updateRowIndices() { _list.updateRowIndices(); }
 
     /// Get all cylinder neighbors
-    vector<Cylinder*> getNeighbors(Cylinder* cylinder);
+    CylinderNeighborListCSR::SpanType getNeighbors(Cylinder* cylinder) const {
+        return _list.getNeighbors(cylinder);
+    }
+
+    /// Get the underlying neighbor list
+    const CylinderNeighborListCSR& getList() const { return _list; }
 
 };
 
@@ -306,11 +342,18 @@ public:
 class BoundaryCylinderNL : public NeighborList {
 
 private:
-    unordered_map<BoundaryElement*, vector<Cylinder*>> _list;
-    ///< The neighbors list, as a hash map
+    NeighborListCSR<BoundaryElement*, Cylinder*, BoundaryElementRowIndex> _list;
+    ///< The neighbors list, in CSR format indexed by boundary element indices
+    NeighborListCSR<Cylinder*, BoundaryElement*, CylinderRowIndex> _reverseList;
+    ///< The boundary elements having each cylinder as a neighbor, indexed by cylinder stable indices
 
     ///Helper function to update neighbors
     void updateNeighbors(BoundaryElement* be);
+    ///Helper function to remove the boundary element from the reverse list
+    void removeReverse(BoundaryElement* be);
+
+    ///Helper function to find neighbors of a boundary element, appending them to neighbors.
+    void findNeighbors(BoundaryElement* be, vector<Cylinder*>& neighbors) const;
 
 public:
     BoundaryCylinderNL(float rMax): NeighborList(rMax) {}
@@ -322,9 +365,21 @@ public:
     virtual void removeDynamicNeighbor(DynamicNeighbor* n);
 
     virtual void reset();
+    virtual void updateRowIndices() {
+        _list.updateRowIndices();
+        _reverseList.updateRowIndices();
+    }
 
     /// Get all Cylinder neighbors of a boundary element
-    vector<Cylinder*> getNeighbors(BoundaryElement* be);
+    Span<Cylinder* const> getNeighbors(BoundaryElement* be) const {
+        return _list.getNeighbors(be);
+    }
+
+    /// Get all boundary elements having the cylinder as a neighbor, without
+    /// searching the neighbors of every boundary element
+    Span<BoundaryElement* const> getBoundaryElements(Cylinder* c) const {
+        return _reverseList.getNeighbors(c);
+    }
 };
 
 
@@ -346,7 +401,7 @@ private:
         listbe.clear();
         // Loop through all bubbles and add as neighbor.
         for(auto& b : sys.bubbles) {
-            floatingpoint dist = be->distance(mathfunc::vec2Vector(b.coord));
+            floatingpoint dist = be->distance(b.coord);
             // If within cutoff, add as neighbor.
             if(dist < rMax_) {
                 listbe.push_back(b.sysIndex);
@@ -368,7 +423,7 @@ public:
     template< typename Context >
     void addDynamicNeighbor(Context& sys, BubbleElement b) {
         for(auto& [be, neighbors] : list_) {
-            if(be->distance(mathfunc::vec2Vector(sys.bubbles[b].coord)) < rMax_) {
+            if(be->distance(sys.bubbles[b].coord) < rMax_) {
                 neighbors.push_back(b);
             }
         }
@@ -467,17 +522,31 @@ private:
     floatingpoint rMax_ = 0;
     std::unordered_map<BubbleElement, std::vector<BeadElement>, StableVectorIndexHash<Bubble>> list_;
     ///< The neighbors list, as a hash map
+    std::unordered_map<BeadElement, std::vector<BubbleElement>> reverseList_;
+    ///< The bubbles having each bead as a neighbor
+
+    ///Helper function to remove a bubble from the reverse list of a bead
+    void removeReverse_(BeadElement b, BubbleElement bbIndex) {
+        auto it = reverseList_.find(b);
+        if(it == reverseList_.end()) return;
+        auto& bubbles = it->second;
+        auto itbb = std::find(bubbles.begin(), bubbles.end(), bbIndex);
+        if(itbb != bubbles.end()) bubbles.erase(itbb);
+        if(bubbles.empty()) reverseList_.erase(it);
+    }
 
     ///Helper function to update neighbors
     template< typename Context >
     void updateNeighbors(Context& sys, BubbleElement bbIndex) {
         auto& listbb = list_[bbIndex];
         // Clear existing.
+        for(auto b : listbb) removeReverse_(b, bbIndex);
         listbb.clear();
         // Loop through all cylinders and add as neighbor.
         for(auto& b: Bead::getBeads()) {
             if(shouldBeNeighbors(sys, bbIndex, b)) {
                 listbb.push_back(b);
+                reverseList_[b].push_back(bbIndex);
             }
         }
     }
@@ -494,26 +563,36 @@ public:
         for(auto& [bbIndex, neighbors] : list_) {
             if(shouldBeNeighbors(sys, bbIndex, b)) {
                 neighbors.push_back(b);
+                reverseList_[b].push_back(bbIndex);
             }
         }
     }
     template< typename Context >
     void removeDynamicNeighbor(Context& sys, BubbleElement bbIndex) {
-        list_.erase(bbIndex);
+        auto it = list_.find(bbIndex);
+        if(it == list_.end()) return;
+        for(auto b : it->second) removeReverse_(b, bbIndex);
+        list_.erase(it);
     }
     template< typename Context >
     void removeDynamicNeighbor(Context& sys, BeadElement b) {
-        for(auto& [bbIndex, neighbors] : list_) {
+        auto itb = reverseList_.find(b);
+        if(itb == reverseList_.end()) return;
+        // Only the lists of bubbles having the bead are searched.
+        for(auto bbIndex : itb->second) {
+            auto& neighbors = list_.at(bbIndex);
             auto it = std::find(neighbors.begin(), neighbors.end(), b);
             if(it != neighbors.end()) {
                 neighbors.erase(it);
             }
         }
+        reverseList_.erase(itb);
     }
 
     template< typename Context >
     void reset(Context& sys) {
         list_.clear();
+        reverseList_.clear();
         for(auto& bb : sys.bubbles) {
             updateNeighbors(sys, bb.sysIndex);
         }
@@ -524,6 +603,13 @@ public:
         return list_.at(bbIndex);
     }
 
+    /// Get all bubbles having the bead as a neighbor
+    const std::vector<BubbleElement>& getBubbles(BeadElement b) const {
+        static const std::vector<BubbleElement> empty;
+        auto it = reverseList_.find(b);
+        return it == reverseList_.end() ? empty : it->second;
+    }
+
     // Filters pairs and find whether they should be neighbors.
     template< typename Context >
     bool shouldBeNeighbors(Context& sys, BubbleElement bbIndex, BeadElement pb) const {
@@ -542,7 +628,7 @@ public:
                 return false;
             }
         }
-        const auto dist2 = distance2(pb->coord, bb.coord);
+        const auto dist2 = distance2(pb->coordinate(), bb.coord);
         // If within cutoff, add as neighbor.
         return dist2 < rMax_ * rMax_;
     }
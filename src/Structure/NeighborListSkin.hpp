@@ -0,0 +1,74 @@
+#ifndef MEDYAN_Structure_NeighborListSkin_hpp
+#define MEDYAN_Structure_NeighborListSkin_hpp
+
+#include <vector>
+
+#include "common.h"
+#include "MathFunctions.h"
+#include "Structure/Cylinder.h"
+#include "Util/Math/Vec.hpp"
+
+namespace medyan {
+
+// Decides when the cylinder neighbor lists need to be rebuilt.
+//
+// With a positive skin, cylinder neighbor lists are built with the cutoffs
+// extended by the skin distance. Since the neighbor search compares the
+// center coordinates of cylinders, the lists remain valid until some
+// cylinder center has moved by more than half of the skin since the last
+// build. Cylinder centers move no further than their beads.
+//
+// Note:
+// - Adding, removing or reconnecting cylinders (such as filament
+//   polymerization and severing) requires a rebuild, which must be signaled
+//   by markTopologyChanged().
+// - A non-positive skin disables this, and neighbor lists are always rebuilt.
+class CylinderNeighborListSkin {
+public:
+    struct Stats {
+        Size numRebuilds = 0;
+        Size numSkips    = 0;
+    };
+
+    void markTopologyChanged() { topologyChanged_ = true; }
+
+    // Check whether the neighbor lists built with the given skin are outdated.
+    bool needsRebuild(floatingpoint skin) const {
+        if(skin <= 0 || topologyChanged_) return true;
+
+        const auto& cylinders = Cylinder::getCylinders();
+        if(cylinders.size() != refCylinders_.size()) return true;
+
+        const floatingpoint maxDisplacement2 = skin * skin / 4;
+        for(Index i = 0; i < cylinders.size(); ++i) {
+            if(cylinders[i] != refCylinders_[i]) return true;
+            if(distance2(mathfunc::vector2Vec<3>(cylinders[i]->coordinate), refCoords_[i]) > maxDisplacement2) return true;
+        }
+        return false;
+    }
+
+    // Record the cylinder positions used by the new neighbor lists.
+    void recordRebuild() {
+        const auto& cylinders = Cylinder::getCylinders();
+        refCylinders_.assign(cylinders.begin(), cylinders.end());
+        refCoords_.resize(cylinders.size());
+        for(Index i = 0; i < cylinders.size(); ++i) {
+            refCoords_[i] = mathfunc::vector2Vec<3>(cylinders[i]->coordinate);
+        }
+        topologyChanged_ = false;
+        ++stats_.numRebuilds;
+    }
+    void recordSkip() { ++stats_.numSkips; }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    bool                                      topologyChanged_ = true;
+    std::vector< Cylinder* >                  refCylinders_;
+    std::vector< Vec< 3, floatingpoint > >    refCoords_;
+    Stats                                     stats_;
+};
+
+} // namespace medyan
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef MEDYAN_Structure_Output_OCheckpoint_hpp
+#define MEDYAN_Structure_Output_OCheckpoint_hpp
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+#include "Rand.h"
+#include "Structure/OutputStruct.hpp"
+#include "Util/Io/H5.hpp"
+#include "Util/Io/Log.hpp"
+
+namespace medyan {
+
+// A restart checkpoint stores the text data dump together with the state of
+// the random engine. It is not a binary snapshot of the simulation state:
+// restart still parses the data dump text, and the SubSystem, the possible
+// bindings of the binding managers and the NRM heap are rebuilt instead of
+// being restored. The order in which they are rebuilt may depend on memory
+// addresses, so a resumed run is not a bit-for-bit continuation of the
+// original run, and two restarts from the same checkpoint are not guaranteed
+// to give the same trajectory.
+//
+// The checkpoint file has the following structure:
+// /header/version
+// /state/simulationTime
+// /state/rngState
+// /state/datadump
+
+inline void extract(OutputStructCheckpoint& outCheckpoint, double simulationTime, std::string datadump) {
+    outCheckpoint.version = OutputStructCheckpoint::currentVersion;
+    outCheckpoint.simulationTime = simulationTime;
+    outCheckpoint.rngState = Rand::engState();
+    outCheckpoint.datadump = std::move(datadump);
+}
+
+inline void write(h5::File& file, const OutputStructCheckpoint& outCheckpoint) {
+    auto grpHeader = file.createGroup("header");
+    h5::writeDataSet(grpHeader, "version", outCheckpoint.version);
+
+    auto grpState = file.createGroup("state");
+    h5::writeDataSet(grpState, "simulationTime", outCheckpoint.simulationTime);
+    h5::writeDataSet(grpState, "rngState", outCheckpoint.rngState);
+    h5::writeDataSet(grpState, "datadump", outCheckpoint.datadump);
+}
+
+inline void read(OutputStructCheckpoint& outCheckpoint, const h5::File& file) {
+    h5::readDataSet(outCheckpoint.version, file.getGroup("header"), "version");
+    if(outCheckpoint.version > OutputStructCheckpoint::currentVersion) {
+        log::error("Checkpoint version {} is newer than the supported version {}.", outCheckpoint.version, OutputStructCheckpoint::currentVersion);
+        throw std::runtime_error("Unsupported checkpoint version.");
+    }
+
+    auto grpState = file.getGroup("state");
+    h5::readDataSet(outCheckpoint.simulationTime, grpState, "simulationTime");
+    h5::readDataSet(outCheckpoint.rngState, grpState, "rngState");
+    h5::readDataSet(outCheckpoint.datadump, grpState, "datadump");
+}
+
+// Write the checkpoint atomically.
+// The checkpoint is first written to a temporary file in the same directory,
+// which then replaces the target file, so that an interrupted write never
+// leaves a partial checkpoint behind.
+inline void writeCheckpoint(const std::filesystem::path& path, const OutputStructCheckpoint& outCheckpoint) {
+    auto tempPath = path;
+    tempPath += ".tmp";
+    {
+        h5::File file(tempPath.string(), h5::File::ReadWrite | h5::File::Create | h5::File::Truncate);
+        write(file, outCheckpoint);
+        file.flush();
+    }
+    std::filesystem::rename(tempPath, path);
+}
+
+inline OutputStructCheckpoint readCheckpoint(const std::filesystem::path& path) {
+    OutputStructCheckpoint outCheckpoint;
+    h5::File file(path.string(), h5::File::ReadOnly);
+    read(outCheckpoint, file);
+    return outCheckpoint;
+}
+
+// Whether the restart input file is a checkpoint instead of a text data dump.
+inline bool isCheckpointFile(const std::filesystem::path& path) {
+    return path.extension() == ".h5";
+}
+
+} // namespace medyan
+
+#endif
@@ -6,6 +6,7 @@
 #include "Structure/Output/OFilament.hpp"
 #include "Structure/Output/OLinker.hpp"
 #include "Structure/Output/OMembrane.hpp"
+#include "Structure/Output/OSnapshotPacked.hpp"
 
 namespace medyan {
 
@@ -72,6 +73,26 @@ inline void read(OutputStructSnapshot& outSnapshot, const h5::Group& grpSnapshot
     h5::readDataSet(outSnapshot.energies, grpSnapshot, "energies");
 }
 
+// Get the layout of snapshots in the trajectory file.
+inline TrajectoryLayout readTrajectoryLayout(const h5::File& file) {
+    const auto grpHeader = file.getGroup("header");
+    // Files without the layout information use the group layout.
+    if(!grpHeader.exist("layout")) return TrajectoryLayout::group;
+
+    TrajectoryLayout layout {};
+    parse(layout, h5::readDataSet<std::string>(grpHeader, "layout"));
+    return layout;
+}
+
+// Read a snapshot from the trajectory file in any layout.
+inline void read(OutputStructSnapshot& outSnapshot, const h5::File& file, Index snapshot) {
+    if(readTrajectoryLayout(file) == TrajectoryLayout::packed) {
+        readPacked(outSnapshot, file.getGroup("frames"), snapshot);
+    } else {
+        read(outSnapshot, file.getGroup("snapshots"), snapshot);
+    }
+}
+
 } // namespace medyan
 
 #endif
@@ -0,0 +1,407 @@
+#ifndef MEDYAN_Structure_Output_OSnapshotPacked_hpp
+#define MEDYAN_Structure_Output_OSnapshotPacked_hpp
+
+// The packed layout of snapshots in the trajectory file.
+//
+// Instead of creating a group for each snapshot, all snapshots are stored in
+// the "frames" group, where each kind of data is concatenated over snapshots
+// in an extendible, chunked and optionally compressed 2D dataset.
+//
+//   - Per-snapshot data have one row per snapshot:
+//       time                        (1)
+//       energies                    (number of energies)
+//       globalSpeciesCopyNumbers    (number of global species)
+//       diffusingSpeciesCopyNumbers (product of diffusingSpeciesShape), where
+//                                   the shape of the 4D data is stored in
+//                                   diffusingSpeciesShape.
+//
+//   - Per-element data have one row per element. The rows of snapshot i are
+//     [offsets[i], offsets[i+1]) in the corresponding offsets dataset, which
+//     has (number of snapshots + 1) rows.
+//       filaments            (id, type, numBeads, deltaMinusEnd, deltaPlusEnd)     filamentOffsets
+//       beadCoords           (x, y, z)                                              beadOffsets
+//       linkers              (id, type, subtype)                                    linkerOffsets
+//       linkerCoords         (x1, y1, z1, x2, y2, z2)                               linkerOffsets
+//       bubbles              (id, type)                                             bubbleOffsets
+//       bubbleCoords         (x, y, z, radius)                                      bubbleOffsets
+//       membranes            (type, numVertices, numTriangles, numBorders, size of packedBorderVertices)
+//                                                                                   membraneOffsets
+//       vertexDataFloat64    (vertex float attributes)                              vertexOffsets
+//       vertexDataInt64      (vertex integer attributes)                            vertexOffsets
+//       triangles            (v0, v1, v2)                                           triangleOffsets
+//       packedBorderVertices (1)                                                    borderOffsets
+//
+// Therefore, any snapshot can be read without going through other snapshots.
+//
+// Note:
+//   - A dataset is created when the data are not empty for the first time.
+//     A dataset that does not exist is read as empty data.
+//   - Vertex/triangle indices are local to each membrane, same as in the
+//     group layout.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Parameter/Output.hpp"
+#include "Structure/OutputStruct.hpp"
+#include "Util/Io/H5.hpp"
+#include "Util/Io/Log.hpp"
+
+namespace medyan {
+
+// Target number of bytes in each chunk of the packed datasets.
+inline constexpr std::size_t packedTrajChunkBytes = 1 << 18;
+
+// Get the compression that is actually used, because the filter might not be available in the HDF5 library.
+inline TrajectoryCompression availableTrajCompression(TrajectoryCompression compression) {
+    const auto checkFilter = [&](H5Z_filter_t id) {
+        if(h5::isFilterAvailable(id)) {
+            return compression;
+        } else {
+            log::warn("Trajectory compression {} is not available. Compression is disabled.", toString(compression));
+            return TrajectoryCompression::none;
+        }
+    };
+
+    switch(compression) {
+        case TrajectoryCompression::gzip: return checkFilter(H5Z_FILTER_DEFLATE);
+        case TrajectoryCompression::szip: return checkFilter(H5Z_FILTER_SZIP);
+        case TrajectoryCompression::lzf:  return checkFilter(h5::LzfFilter::id);
+        default:                          return compression;
+    }
+}
+
+template< typename T >
+inline auto packedDataSetProps(const OutputParams& params, std::size_t numCols) {
+    h5::DataSetCreateProps props;
+    const std::size_t chunkRows = std::max< std::size_t >(1, packedTrajChunkBytes / (numCols * sizeof(T)));
+    props.add(HighFive::Chunking(std::vector< hsize_t > { chunkRows, numCols }));
+
+    switch(params.trajCompression) {
+        case TrajectoryCompression::gzip:
+            props.add(HighFive::Shuffle());
+            props.add(HighFive::Deflate(params.trajCompressionLevel));
+            break;
+        case TrajectoryCompression::szip:
+            props.add(h5::SzipFilter {});
+            break;
+        case TrajectoryCompression::lzf:
+            props.add(HighFive::Shuffle());
+            props.add(h5::LzfFilter {});
+            break;
+        default:
+            break;
+    }
+    return props;
+}
+
+// Auxiliary writer of the "frames" group.
+struct PackedFramesWriter {
+    h5::Group&          grpFrames;
+    const OutputParams& params;
+
+    template< typename T >
+    void appendRows(std::string_view name, const T* data, std::size_t numRows, std::size_t numCols) const {
+        if(numCols == 0) return;
+        h5::appendRows(grpFrames, name, data, numRows, numCols, [this](std::size_t numCols) {
+            return packedDataSetProps< T >(params, numCols);
+        });
+    }
+    template< typename T >
+    void appendRows(std::string_view name, const std::vector< T >& data, std::size_t numCols) const {
+        appendRows(name, data.data(), numCols == 0 ? 0 : data.size() / numCols, numCols);
+    }
+
+    // Append the end offset of a snapshot, where the number of rows in the snapshot is numRows.
+    void appendOffset(std::string_view name, std::size_t numRows) const {
+        std::int64_t lastOffset = 0;
+        const auto numOffsets = h5::numRows(grpFrames, name);
+        if(numOffsets == 0) {
+            // The first offset is always 0.
+            appendRows(name, &lastOffset, 1, 1);
+        } else {
+            std::vector< std::int64_t > last;
+            h5::readRows(last, grpFrames, name, numOffsets - 1, 1);
+            lastOffset = last[0];
+        }
+        const std::int64_t offset = lastOffset + numRows;
+        appendRows(name, &offset, 1, 1);
+    }
+};
+
+// Auxiliary reader of the "frames" group.
+struct PackedFramesReader {
+    const h5::Group& grpFrames;
+    Index            snapshot = 0;
+
+    // Get the range of rows of the snapshot.
+    std::array< std::size_t, 2 > rowRange(std::string_view offsetsName) const {
+        std::vector< std::int64_t > offsets;
+        h5::readRows(offsets, grpFrames, offsetsName, snapshot, 2);
+        if(offsets.size() < 2) return { 0, 0 };
+        return { static_cast< std::size_t >(offsets[0]), static_cast< std::size_t >(offsets[1]) };
+    }
+
+    template< typename T >
+    std::size_t readRows(std::vector< T >& data, std::string_view name, const std::array< std::size_t, 2 >& range) const {
+        if(range[1] == range[0]) {
+            data.clear();
+            return 0;
+        }
+        return h5::readRows(data, grpFrames, name, range[0], range[1] - range[0]);
+    }
+    template< typename T >
+    std::size_t readRows(std::vector< T >& data, std::string_view name) const {
+        return readRows(data, name, { static_cast< std::size_t >(snapshot), static_cast< std::size_t >(snapshot) + 1 });
+    }
+};
+
+
+inline void writePacked(h5::Group& grpFrames, const OutputStructSnapshot& outSnapshot, const OutputParams& params) {
+    using namespace std;
+    PackedFramesWriter w { grpFrames, params };
+
+    w.appendRows("time", &outSnapshot.simulationTime, 1, 1);
+    w.appendRows("energies", outSnapshot.energies.data(), 1, outSnapshot.energies.size());
+
+    // Filaments.
+    {
+        vector< int64_t > filaments;
+        vector< double >  beadCoords;
+        for(auto& f : outSnapshot.filamentStruct) {
+            filaments.insert(filaments.end(), { f.id, f.type, f.numBeads, f.deltaMinusEnd, f.deltaPlusEnd });
+            beadCoords.insert(beadCoords.end(), f.rawCoords.data(), f.rawCoords.data() + f.rawCoords.size());
+        }
+        w.appendRows("filaments", filaments, 5);
+        w.appendOffset("filamentOffsets", outSnapshot.filamentStruct.size());
+        w.appendRows("beadCoords", beadCoords, 3);
+        w.appendOffset("beadOffsets", beadCoords.size() / 3);
+    }
+
+    // Linkers.
+    {
+        vector< int64_t > linkers;
+        vector< double >  linkerCoords;
+        for(auto& l : outSnapshot.linkerStruct) {
+            const int64_t type =
+                l.type == "linker" ? 0 :
+                l.type == "motor"  ? 1 :
+                l.type == "brancher" ? 2 : -1;
+            linkers.insert(linkers.end(), { l.id, type, l.subtype });
+            linkerCoords.insert(linkerCoords.end(), l.rawCoords.data(), l.rawCoords.data() + l.rawCoords.size());
+        }
+        w.appendRows("linkers", linkers, 3);
+        w.appendRows("linkerCoords", linkerCoords, 6);
+        w.appendOffset("linkerOffsets", outSnapshot.linkerStruct.size());
+    }
+
+    // Bubbles.
+    {
+        vector< int64_t > bubbles;
+        vector< double >  bubbleCoords;
+        for(auto& b : outSnapshot.bubbleStruct) {
+            bubbles.insert(bubbles.end(), { b.id, b.type });
+            bubbleCoords.insert(bubbleCoords.end(), { b.coords[0], b.coords[1], b.coords[2], b.radius });
+        }
+        w.appendRows("bubbles", bubbles, 2);
+        w.appendRows("bubbleCoords", bubbleCoords, 4);
+        w.appendOffset("bubbleOffsets", outSnapshot.bubbleStruct.size());
+    }
+
+    // Membranes.
+    {
+        vector< int64_t > membranes;
+        vector< double >  vertexDataFloat64;
+        vector< int64_t > vertexDataInt64;
+        vector< int64_t > triangles;
+        vector< int64_t > packedBorderVertices;
+        Size numVertexAttrFloat64 = 0;
+        Size numVertexAttrInt64 = 0;
+        Size numVertices = 0;
+        for(auto& m : outSnapshot.membraneStruct) {
+            membranes.insert(membranes.end(), {
+                m.type, m.numVertices, m.numTriangles, m.numBorders, static_cast< int64_t >(m.packedBorderVertices.size())
+            });
+            numVertexAttrFloat64 = m.vertexDataFloat64.rows();
+            numVertexAttrInt64 = m.vertexDataInt64.rows();
+            numVertices += m.numVertices;
+            vertexDataFloat64.insert(vertexDataFloat64.end(), m.vertexDataFloat64.data(), m.vertexDataFloat64.data() + m.vertexDataFloat64.size());
+            vertexDataInt64.insert(vertexDataInt64.end(), m.vertexDataInt64.data(), m.vertexDataInt64.data() + m.vertexDataInt64.size());
+            triangles.insert(triangles.end(), m.triangleDataInt64.data(), m.triangleDataInt64.data() + m.triangleDataInt64.size());
+            packedBorderVertices.insert(packedBorderVertices.end(), m.packedBorderVertices.begin(), m.packedBorderVertices.end());
+        }
+        w.appendRows("membranes", membranes, 5);
+        w.appendOffset("membraneOffsets", outSnapshot.membraneStruct.size());
+        w.appendRows("vertexDataFloat64", vertexDataFloat64, numVertexAttrFloat64);
+        w.appendRows("vertexDataInt64", vertexDataInt64, numVertexAttrInt64);
+        w.appendOffset("vertexOffsets", numVertices);
+        w.appendRows("triangles", triangles, 3);
+        w.appendOffset("triangleOffsets", triangles.size() / 3);
+        w.appendRows("packedBorderVertices", packedBorderVertices, 1);
+        w.appendOffset("borderOffsets", packedBorderVertices.size());
+    }
+
+    // Chemistry.
+    {
+        auto& chem = outSnapshot.chemistry;
+        vector< int64_t > globalCopyNumbers(chem.globalSpeciesCopyNumbers.begin(), chem.globalSpeciesCopyNumbers.end());
+        w.appendRows("globalSpeciesCopyNumbers", globalCopyNumbers.data(), 1, globalCopyNumbers.size());
+
+        auto& diffusing = chem.diffusingSpeciesCopyNumbers;
+        if(!grpFrames.exist("diffusingSpeciesShape")) {
+            const auto& shape = diffusing.shape();
+            h5::writeDataSet(grpFrames, "diffusingSpeciesShape", vector< int64_t >(shape.begin(), shape.end()));
+        }
+        vector< int64_t > diffusingCopyNumbers(diffusing.data(), diffusing.data() + diffusing.size());
+        w.appendRows("diffusingSpeciesCopyNumbers", diffusingCopyNumbers.data(), 1, diffusingCopyNumbers.size());
+    }
+}
+
+
+inline void readPacked(OutputStructSnapshot& outSnapshot, const h5::Group& grpFrames, Index snapshot) {
+    using namespace std;
+    PackedFramesReader r { grpFrames, snapshot };
+
+    outSnapshot.snapshot = snapshot;
+    {
+        vector< double > time;
+        r.readRows(time, "time");
+        outSnapshot.simulationTime = time.at(0);
+    }
+    r.readRows(outSnapshot.energies, "energies");
+
+    // Filaments.
+    {
+        vector< int64_t > filaments;
+        vector< double >  beadCoords;
+        r.readRows(filaments, "filaments", r.rowRange("filamentOffsets"));
+        r.readRows(beadCoords, "beadCoords", r.rowRange("beadOffsets"));
+
+        outSnapshot.filamentStruct.resize(filaments.size() / 5);
+        Index beadIndex = 0;
+        for(Index i = 0; i < outSnapshot.filamentStruct.size(); ++i) {
+            auto& f = outSnapshot.filamentStruct[i];
+            f.id            = filaments[5 * i];
+            f.type          = filaments[5 * i + 1];
+            f.numBeads      = filaments[5 * i + 2];
+            f.deltaMinusEnd = filaments[5 * i + 3];
+            f.deltaPlusEnd  = filaments[5 * i + 4];
+            f.rawCoords = Eigen::Map< const Eigen::MatrixXd >(beadCoords.data() + 3 * beadIndex, 3, f.numBeads);
+            beadIndex += f.numBeads;
+        }
+    }
+
+    // Linkers.
+    {
+        vector< int64_t > linkers;
+        vector< double >  linkerCoords;
+        const auto range = r.rowRange("linkerOffsets");
+        r.readRows(linkers, "linkers", range);
+        r.readRows(linkerCoords, "linkerCoords", range);
+
+        outSnapshot.linkerStruct.resize(linkers.size() / 3);
+        for(Index i = 0; i < outSnapshot.linkerStruct.size(); ++i) {
+            auto& l = outSnapshot.linkerStruct[i];
+            l.id = linkers[3 * i];
+            switch(linkers[3 * i + 1]) {
+                case 0:  l.type = "linker";   break;
+                case 1:  l.type = "motor";    break;
+                case 2:  l.type = "brancher"; break;
+                default: l.type = "unknown";  break;
+            }
+            l.subtype = linkers[3 * i + 2];
+            l.rawCoords = Eigen::Map< const Eigen::Matrix< double, 3, 2 > >(linkerCoords.data() + 6 * i);
+        }
+    }
+
+    // Bubbles.
+    {
+        vector< int64_t > bubbles;
+        vector< double >  bubbleCoords;
+        const auto range = r.rowRange("bubbleOffsets");
+        r.readRows(bubbles, "bubbles", range);
+        r.readRows(bubbleCoords, "bubbleCoords", range);
+
+        outSnapshot.bubbleStruct.resize(bubbles.size() / 2);
+        for(Index i = 0; i < outSnapshot.bubbleStruct.size(); ++i) {
+            auto& b = outSnapshot.bubbleStruct[i];
+            b.id   = bubbles[2 * i];
+            b.type = bubbles[2 * i + 1];
+            b.coords = Eigen::Vector3d(bubbleCoords[4 * i], bubbleCoords[4 * i + 1], bubbleCoords[4 * i + 2]);
+            b.radius = bubbleCoords[4 * i + 3];
+        }
+    }
+
+    // Membranes.
+    {
+        vector< int64_t > membranes;
+        vector< double >  vertexDataFloat64;
+        vector< int64_t > vertexDataInt64;
+        vector< int64_t > triangles;
+        vector< int64_t > packedBorderVertices;
+        r.readRows(membranes, "membranes", r.rowRange("membraneOffsets"));
+        const auto vertexRange = r.rowRange("vertexOffsets");
+        const Size numVertexAttrFloat64 = r.readRows(vertexDataFloat64, "vertexDataFloat64", vertexRange);
+        const Size numVertexAttrInt64 = r.readRows(vertexDataInt64, "vertexDataInt64", vertexRange);
+        r.readRows(triangles, "triangles", r.rowRange("triangleOffsets"));
+        r.readRows(packedBorderVertices, "packedBorderVertices", r.rowRange("borderOffsets"));
+
+        outSnapshot.membraneStruct.resize(membranes.size() / 5);
+        Index vertexIndex = 0;
+        Index triangleIndex = 0;
+        Index borderIndex = 0;
+        for(Index i = 0; i < outSnapshot.membraneStruct.size(); ++i) {
+            auto& m = outSnapshot.membraneStruct[i];
+            m.type         = membranes[5 * i];
+            m.numVertices  = membranes[5 * i + 1];
+            m.numTriangles = membranes[5 * i + 2];
+            m.numBorders   = membranes[5 * i + 3];
+            const Size packedBorderSize = membranes[5 * i + 4];
+
+            m.vertexDataFloat64 = Eigen::Map< const Eigen::MatrixXd >(
+                vertexDataFloat64.data() + numVertexAttrFloat64 * vertexIndex, numVertexAttrFloat64, m.numVertices
+            );
+            m.vertexDataInt64.resize(numVertexAttrInt64, m.numVertices);
+            for(Index j = 0; j < m.vertexDataInt64.size(); ++j) {
+                m.vertexDataInt64(j) = vertexDataInt64[numVertexAttrInt64 * vertexIndex + j];
+            }
+            m.triangleDataInt64.resize(3, m.numTriangles);
+            for(Index j = 0; j < m.triangleDataInt64.size(); ++j) {
+                m.triangleDataInt64(j) = triangles[3 * triangleIndex + j];
+            }
+            m.packedBorderVertices.assign(
+                packedBorderVertices.begin() + borderIndex,
+                packedBorderVertices.begin() + borderIndex + packedBorderSize
+            );
+
+            vertexIndex += m.numVertices;
+            triangleIndex += m.numTriangles;
+            borderIndex += packedBorderSize;
+        }
+    }
+
+    // Chemistry.
+    {
+        auto& chem = outSnapshot.chemistry;
+        vector< int64_t > globalCopyNumbers;
+        r.readRows(globalCopyNumbers, "globalSpeciesCopyNumbers");
+        chem.globalSpeciesCopyNumbers.assign(globalCopyNumbers.begin(), globalCopyNumbers.end());
+
+        array< Size, 4 > shape {};
+        if(grpFrames.exist("diffusingSpeciesShape")) {
+            const auto shapeData = h5::readDataSet< vector< int64_t > >(grpFrames, "diffusingSpeciesShape");
+            copy(shapeData.begin(), shapeData.end(), shape.begin());
+        }
+        vector< int64_t > diffusingCopyNumbers;
+        r.readRows(diffusingCopyNumbers, "diffusingSpeciesCopyNumbers");
+        chem.diffusingSpeciesCopyNumbers.resize(shape);
+        copy(diffusingCopyNumbers.begin(), diffusingCopyNumbers.end(), chem.diffusingSpeciesCopyNumbers.data());
+    }
+}
+
+} // namespace medyan
+
+#endif
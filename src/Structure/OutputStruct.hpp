@@ -206,6 +206,24 @@ struct OutputStructMeta {
     std::vector< std::string > globalSpeciesNames;
 };
 
+// Restart checkpoint of the simulation. The network is stored as the data dump
+// text, not as binary state. The possible bindings and the NRM heap are not
+// stored (see OCheckpoint.hpp).
+struct OutputStructCheckpoint {
+    // Version of the checkpoint format. Increase it when the format changes.
+    inline static constexpr int currentVersion = 1;
+    int version = currentVersion;
+
+    double simulationTime = 0;
+
+    // State of the global random number engine, in its standard text representation.
+    std::string rngState;
+
+    // Network state, in the same format as the text data dump, with coordinates
+    // printed in full precision.
+    std::string datadump;
+};
+
 } // namespace medyan
 
 #endif
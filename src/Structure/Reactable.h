@@ -14,10 +14,50 @@
 #ifndef MEDYAN_Reactable_h
 #define MEDYAN_Reactable_h
 
+#include <array>
+#include <cmath>
+#include <cstddef>
+
 #include "common.h"
 #include "Util/DoubleLinkedList.h"
 
 namespace medyan {
+
+/// Inputs of the force dependent reaction rates of an element, recorded at the
+/// last rate update.
+
+/*! The rates need to be recomputed only if one of the forces has changed by
+ *  more than a tolerance, or if one of the discrete flags (such as the run state)
+ *  has changed. Before the first record, the inputs are always considered changed.
+ */
+template< std::size_t numForces >
+class RateInputs {
+public:
+    using ForceArray = std::array< floatingpoint, numForces >;
+
+    bool changed(const ForceArray& forces, unsigned flags, floatingpoint forceTolerance) const {
+        if(!recorded_ || flags != flags_) return true;
+        for(std::size_t i = 0; i < numForces; ++i) {
+            if(std::abs(forces[i] - forces_[i]) > forceTolerance) return true;
+        }
+        return false;
+    }
+
+    void record(const ForceArray& forces, unsigned flags) {
+        forces_   = forces;
+        flags_    = flags;
+        recorded_ = true;
+    }
+
+    /// Forget the recorded inputs, so that the next check always reports a change.
+    void reset() { recorded_ = false; }
+
+private:
+    ForceArray forces_ {};
+    unsigned   flags_ = 0;
+    bool       recorded_ = false;
+};
+
 /// An abstract base class for a reactable element in the SubSystem.
 
 /*! The main function of the Reactable class is to implement updateReactionRates(),
@@ -38,6 +78,15 @@ public:
     /// a set of chemical steps, or any other event in the SubSystem. This
     /// function will be called by the SubSystem on all Reactables.
     virtual void updateReactionRates() = 0;
+
+    ///Update the reactions in this element only if the mechanical state that
+    ///the rates depend on has changed by more than the force tolerance since
+    ///the last update.
+    /// @note - By default, the reactions are always updated. Discrete changes,
+    /// such as binding or walking, must still call updateReactionRates().
+    virtual void updateReactionRatesIfChanged(floatingpoint forceTolerance) {
+        updateReactionRates();
+    }
     
     ///Destructor
     /// @note noexcept is important here. Otherwise, gcc flags the constructor as
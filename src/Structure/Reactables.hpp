@@ -33,6 +33,25 @@ constexpr Overload updateReactionRates {
     },
 };
 
+// Same as updateReactionRates, but elements supporting it skip the update if
+// their mechanical state has not changed by more than the force tolerance.
+inline auto updateReactionRatesIfChanged(floatingpoint forceTolerance) {
+    return Overload {
+        [=](auto&& sys, Reactable& r) {
+            r.updateReactionRatesIfChanged(forceTolerance);
+        },
+        [](auto&& sys, AFM& obj) {
+            obj.updateReactionRates();
+        },
+        [](auto&& sys, MTOC& obj) {
+            obj.updateReactionRates();
+        },
+        [](auto&& sys, Membrane& obj) {
+            setReactionRates(sys, obj.getMesh());
+        },
+    };
+}
+
 } // namespace medyan::reactable
 
 #endif
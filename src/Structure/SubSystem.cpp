@@ -190,7 +190,16 @@ void SubSystem::resetNeighborLists() {
     chrono::high_resolution_clock::time_point mins, mine;
     mins = chrono::high_resolution_clock::now();
 
+    // Cylinder-cylinder neighbor lists are kept if no cylinder has moved
+    // beyond the skin. Cylinders are still reassigned to bins, because the
+    // neighbors of cylinders added between rebuilds are searched in the bins.
+    const bool rebuildCylinderLists = cylinderNeighborListSkin.needsRebuild(
+        SysParams::Chemistry().chemistryAlgorithm.neighborListSkin);
+    if(rebuildCylinderLists) cylinderNeighborListSkin.recordRebuild();
+    else                     cylinderNeighborListSkin.recordSkip();
+
     #if defined(HYBRID_NLSTENCILLIST) || defined(SIMDBINDINGSEARCH)
+    if(rebuildCylinderLists) {
         _HneighborList->reset();
         mine= chrono::high_resolution_clock::now();
         #ifdef OPTIMOUT
@@ -201,9 +210,23 @@ void SubSystem::resetNeighborLists() {
             chrono::duration<floatingpoint> elapsed_B(mine - mins);
             std::cout<<"H NLSTEN B reset time "<<elapsed_B.count()<<endl;
         #endif
+    }
+    else {
+        _HneighborList->updateBins();
+    }
     #endif
-    for (auto nl: _neighborLists)
+    for (auto nl: _neighborLists) {
+        if(!rebuildCylinderLists) {
+            if(auto cnl = dynamic_cast<CylinderCylinderNL*>(nl)) {
+                #ifdef NLSTENCILLIST
+                cnl->updateallcylinderstobin();
+                #endif
+                cnl->updateRowIndices();
+                continue;
+            }
+        }
         nl->reset();
+    }
 
     // Other neighbor lists or neighbor list primitives (such as cell lists, BVHs).
     //----------------------------------
@@ -228,6 +251,13 @@ void SubSystem::resetNeighborLists() {
         }
     }
 }
+void SubSystem::updateNeighborListRowIndices() {
+    #if defined(HYBRID_NLSTENCILLIST) || defined(SIMDBINDINGSEARCH)
+    _HneighborList->updateRowIndices();
+    #endif
+    for(auto nl : _neighborLists) nl->updateRowIndices();
+}
+
 void SubSystem::updateBindingManagers(medyan::SimulConfig& sc) {
 #ifdef OPTIMOUT
 	chrono::high_resolution_clock::time_point mins, mine, minsinit, mineinit,
@@ -369,7 +399,10 @@ void SubSystem::updateBindingManagers(medyan::SimulConfig& sc) {
 			<<"L/M Update binding pair map in Cmp "<<C->getId()<<endl;
         }
 		for(auto &manager : C->getBranchingManagers()) {
+				const auto minsbranching = chrono::high_resolution_clock::now();
 				manager->updateAllPossibleBindingsstencil();
+				chrono::duration<floatingpoint> elapsed_branching(chrono::high_resolution_clock::now() - minsbranching);
+				branchingUpdateTime += elapsed_branching.count();
             if(CROSSCHECK_SWITCH) {
                 HybridNeighborList::_crosscheckdumpFileNL
 				<<"B Update binding pair map in Cmp "<<C->getId()<<endl;
@@ -870,6 +903,7 @@ bool SubSystem::initialize = false;
 floatingpoint SubSystem::SIMDtime  = 0.0;
 floatingpoint SubSystem::SIMDtimeV2  = 0.0;
 floatingpoint SubSystem::HYBDtime  = 0.0;
+floatingpoint SubSystem::branchingUpdateTime  = 0.0;
 floatingpoint SubSystem::timeneighbor  = 0.0;
 floatingpoint SubSystem::timedneighbor  = 0.0;
 floatingpoint SubSystem::timetrackable  = 0.0;
@@ -47,6 +47,7 @@
 #include "Structure/Linker.h"
 #include "Structure/MotorGhost.h"
 #include "Structure/NeighborListImpl.h"
+#include "Structure/NeighborListSkin.hpp"
 #include "Structure/Special/AFM.h"
 #include "Structure/Special/MTOC.h"
 #include "Structure/SurfaceMesh/Edge.hpp"
@@ -200,8 +201,13 @@ public:
     /// Add a neighbor list to the subsystem
     void addNeighborList(NeighborList *nl) { _neighborLists.push_back(nl); }
 
-    /// Reset all neighbor lists in subsystem
+    /// Reset all neighbor lists in subsystem.
+    /// Cylinder-cylinder neighbor lists are only rebuilt if they are outdated
+    /// (see CylinderNeighborListSkin).
     void resetNeighborLists();
+    /// Update all neighbor lists after the indices of elements change,
+    /// without searching for neighbors.
+    void updateNeighborListRowIndices();
     //create vectors of cylinder information.
     void vectorizeCylinder(medyan::SimulConfig&);
 
@@ -230,6 +236,8 @@ public:
     static floatingpoint SIMDtime;
     static floatingpoint SIMDtimeV2;
     static floatingpoint HYBDtime;
+    // Time spent in updating branching binding sites.
+    static floatingpoint branchingUpdateTime;
 	static floatingpoint timeneighbor;
 	static floatingpoint timedneighbor;
 	static floatingpoint timetrackable;
@@ -271,6 +279,9 @@ public:
         HybridCylinderCylinderNL* _HneighborList;
     #endif
 
+    // Decides whether the cylinder-cylinder neighbor lists need rebuilding.
+    CylinderNeighborListSkin cylinderNeighborListSkin;
+
     // Neighbor list between meshless vertices.
     NeighborListCellList3D meshlessSpinVertexCellList;
 
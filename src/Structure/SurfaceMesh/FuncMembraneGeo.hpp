@@ -2,6 +2,7 @@
 #define MEDYAN_Structure_SurfaceMesh_FuncMembraneGeo_hpp
 
 #include <tuple>
+#include <vector>
 
 #include "MathFunctions.h"
 #include "Mechanics/ForceField/Types.hpp"
@@ -9,6 +10,7 @@
 #include "Structure/SurfaceMesh/MembraneMeshAttribute.hpp"
 #include "Structure/SurfaceMesh/SurfaceMesh.hpp"
 #include "Structure/SurfaceMesh/Types.hpp"
+#include "Util/ThreadPool.hpp"
 
 namespace medyan {
 
@@ -48,11 +50,14 @@ namespace medyan {
 //     void updateGeometryValue(mesh, coord, curvature policy)
 //     void updateGeometryValueWithDerivative(mesh, coord, curvature policy)
 //     void updateGeometryValueForSystem(mesh)
+//     void updateTriangleTree(mesh)
 //
 //   - Other auxiliary functions
 //
-//     double signedDistance(mesh)
-//     bool   contains(mesh)
+//     double signedDistanceToTriangle(mesh, triangle index, point)
+//     double signedDistance(mesh, point)
+//     vector signedDistance(mesh, points)
+//     bool   contains(mesh, point)
 //-----------------------------------------------------------------------------
 
 
@@ -805,6 +810,30 @@ inline void updateGeometryValueWithDerivative(
 
 } // updateGeometryValueWithDerivative(...)
 
+// Update the bounding volume hierarchy of triangles used in signed distance
+// queries. The tree is refitted if the triangles are the same as when it was
+// built, and is rebuilt otherwise.
+inline void updateTriangleTree(const SubSystem& sys, MembraneMeshAttribute::MeshType& mesh) {
+    using MT = MembraneMeshAttribute::MeshType;
+
+    const auto numTriangles = mesh.getTriangles().size();
+    auto& meta = mesh.metaAttribute();
+
+    std::vector< Aabb<> > boxes(numTriangles);
+    for(MT::TriangleIndex ti {}; ti < numTriangles; ++ti) {
+        for(auto vi : vertexIndices(mesh, ti)) {
+            boxes[ti.index].expand(mesh.attribute(vi).vertex(sys).coord);
+        }
+    }
+
+    if(meta.triangleTreeValid && meta.triangleTree.numPrimitives() == numTriangles) {
+        meta.triangleTree.refit(boxes);
+    } else {
+        meta.triangleTree.build(boxes);
+        meta.triangleTreeValid = true;
+    }
+}
+
 // This function updates geometries necessary for MEDYAN system. Currently
 // the system needs
 //   - (pseudo) unit normals          -- compartment slicing and signed distance
@@ -908,13 +937,15 @@ inline void updateGeometryValueForSystem(SubSystem& sys, MembraneMeshAttribute::
 
         normalize(vag.pseudoUnitNormal);
     }
+
+    updateTriangleTree(sys, mesh);
 } // void updateGeometryValueForSystem(...)
 
-// Signed distance using geometric attributes (the inefficient way)
+// Signed distance using geometric attributes
 /**************************************************************************
 The function works in the following procedure:
 
-- Iterate through the triangles, and for each triangle
+- For each triangle that may be the closest to the point
     - Find the projection of the point on the triangle plane, and determine
         which element is responsible for being the closest to the point
         (which vertex/ which edge/ this triangle).
@@ -922,9 +953,16 @@ The function works in the following procedure:
         the signed distance using the normal or pseudo normal. Record the
         value with the smallest unsigned distance.
 
+The candidate triangles are found using the triangle tree in the meta
+attribute, which skips triangles whose bounding boxes are farther than the
+closest triangle found so far. If the tree is not valid, all triangles are
+checked.
+
 Before this function is used, the following must be calculated:
     - The positions of all the elements are updated
     - The normal and pseudo normal at the triangles, edges and vertices
+    - The triangle tree
+All of them are updated in updateGeometryValueForSystem.
 
 Note: this method only works if the mesh is closed. This must be ensured by
         the caller of the function.
@@ -934,104 +972,138 @@ boundary potential. However, this field is not C1-continuous everywhere,
 which is detrimental to conjugate gradient methods.
 **************************************************************************/
 template< typename VecType, std::enable_if_t< VecType::vec_size == 3 >* = nullptr >
-inline double signedDistance(const SubSystem& sys, const MembraneMeshAttribute::MeshType& mesh, const VecType& p, bool allowOpen = false) {
+inline double signedDistanceToTriangle(
+    const SubSystem& sys, const MembraneMeshAttribute::MeshType& mesh,
+    MembraneMeshAttribute::MeshType::TriangleIndex ti, const VecType& p
+) {
     using namespace mathfunc;
     using MT = MembraneMeshAttribute::MeshType;
     using CT = MembraneMeshAttribute::CoordinateType;
 
+    /**********************************************************************
+    Calculate the barycentric coordinate of the projection point p'
+
+    See Heidrich 2005, Computing the Barycentric Coordinates of a Projected
+    Point.
+    **********************************************************************/
+    const auto hei0 = mesh.halfEdge(ti);
+    const auto hei1 = mesh.next(hei0);
+    const auto hei2 = mesh.next(hei1);
+    const MT::VertexIndex vi[] {
+        mesh.target(hei0), mesh.target(hei1), mesh.target(hei2)
+    };
+    const CT c[] {
+        mesh.attribute(vi[0]).vertex(sys).coord,
+        mesh.attribute(vi[1]).vertex(sys).coord,
+        mesh.attribute(vi[2]).vertex(sys).coord
+    };
+
+    const auto r01 = c[1] - c[0];
+    const auto r02 = c[2] - c[0];
+    const auto r0p = p - c[0];
+    const auto cp = cross(r01, r02);
+    const auto oneOver4AreaSquared = 1.0 / magnitude2(cp);
+
+    const auto b1 = dot(cross(r0p, r02), cp) * oneOver4AreaSquared;
+    const auto b2 = dot(cross(r01, r0p), cp) * oneOver4AreaSquared;
+    const auto b0 = 1.0 - b1 - b2;
+
+    // Now p' = b0*v0 + b1*v1 + b2*v2
+    // which is the projection of p in the plane of the triangle
+
+    double d = numeric_limits<double>::infinity();
+    if(b0 >= 0 && b1 >= 0 && b2 >= 0) {
+        // p' is inside the triangle
+        d = dot(mesh.attribute(ti).gTriangle.unitNormal, r0p);
+    } else {
+        // p' is outside the triangle
+        const Vec< 3, typename CT::float_type > r2 {
+            distance2(c[1], c[2]),
+            distance2(c[2], c[0]),
+            distance2(c[0], c[1])
+        };
+        const auto r1p = p - c[1];
+        const auto r2p = p - c[2];
+        const auto r12 = c[2] - c[1];
+        const auto dot_1p_12 = dot(r1p, r12);
+        const auto dot_2p_20 = -dot(r2p, r02);
+        const auto dot_0p_01 = dot(r0p, r01);
+
+        if(b0 < 0 && dot_1p_12 >= 0 && dot_1p_12 <= r2[0]) {
+            // On edge 12
+            d = magnitude(cross(r1p, r12)) / std::sqrt(r2[0]);
+            if(dot(mesh.attribute(mesh.edge(hei2)).gEdge.pseudoUnitNormal, r1p) < 0) d = -d;
+        } else if(b1 < 0 && dot_2p_20 >= 0 && dot_2p_20 <= r2[1]) {
+            // On edge 20
+            d = magnitude(cross(r2p, r02)) / std::sqrt(r2[1]);
+            if(dot(mesh.attribute(mesh.edge(hei0)).gEdge.pseudoUnitNormal, r2p) < 0) d = -d;
+        } else if(b2 < 0 && dot_0p_01 >= 0 && dot_0p_01 <= r2[2]) {
+            // On edge 01
+            d = magnitude(cross(r0p, r01)) / std::sqrt(r2[2]);
+            if(dot(mesh.attribute(mesh.edge(hei1)).gEdge.pseudoUnitNormal, r0p) < 0) d = -d;
+        } else if(dot_0p_01 < 0 && dot_2p_20 > r2[1]) {
+            // On vertex 0
+            d = distance(c[0], p);
+            if(dot(mesh.attribute(vi[0]).gVertex.pseudoUnitNormal, r0p) < 0) d = -d;
+        } else if(dot_1p_12 < 0 && dot_0p_01 > r2[2]) {
+            // On vertex 1
+            d = distance(c[1], p);
+            if(dot(mesh.attribute(vi[1]).gVertex.pseudoUnitNormal, r1p) < 0) d = -d;
+        } else if(dot_2p_20 < 0 && dot_1p_12 > r2[0]) {
+            // On vertex 2
+            d = distance(c[2], p);
+            if(dot(mesh.attribute(vi[2]).gVertex.pseudoUnitNormal, r2p) < 0) d = -d;
+        } else {
+            // The program should never come here
+            throw logic_error("Unknown case of point projection on the plane of triangle.");
+        }
+    }
+
+    return d;
+}
+
+template< typename VecType, std::enable_if_t< VecType::vec_size == 3 >* = nullptr >
+inline double signedDistance(const SubSystem& sys, const MembraneMeshAttribute::MeshType& mesh, const VecType& p, bool allowOpen = false) {
+    using MT = MembraneMeshAttribute::MeshType;
+
     if(!allowOpen && !mesh.isClosed()) {
         throw std::runtime_error("Mesh is not closed while trying to find signed distance field.");
     }
 
     const auto numTriangles = mesh.getTriangles().size();
+    const auto& meta = mesh.metaAttribute();
+
+    if(meta.triangleTreeValid && meta.triangleTree.numPrimitives() == numTriangles) {
+        return meta.triangleTree.nearest(p, [&](Index ti) {
+            return signedDistanceToTriangle(sys, mesh, MT::TriangleIndex{ti}, p);
+        });
+    }
 
     double minAbsDistance = numeric_limits<double>::infinity();
     for(MT::TriangleIndex ti {}; ti < numTriangles; ++ti) {
-        /**********************************************************************
-        Calculate the barycentric coordinate of the projection point p'
-
-        See Heidrich 2005, Computing the Barycentric Coordinates of a Projected
-        Point.
-        **********************************************************************/
-        const auto hei0 = mesh.halfEdge(ti);
-        const auto hei1 = mesh.next(hei0);
-        const auto hei2 = mesh.next(hei1);
-        const MT::VertexIndex vi[] {
-            mesh.target(hei0), mesh.target(hei1), mesh.target(hei2)
-        };
-        const CT c[] {
-            mesh.attribute(vi[0]).vertex(sys).coord,
-            mesh.attribute(vi[1]).vertex(sys).coord,
-            mesh.attribute(vi[2]).vertex(sys).coord
-        };
-
-        const auto r01 = c[1] - c[0];
-        const auto r02 = c[2] - c[0];
-        const auto r0p = p - c[0];
-        const auto cp = cross(r01, r02);
-        const auto oneOver4AreaSquared = 1.0 / magnitude2(cp);
-
-        const auto b1 = dot(cross(r0p, r02), cp) * oneOver4AreaSquared;
-        const auto b2 = dot(cross(r01, r0p), cp) * oneOver4AreaSquared;
-        const auto b0 = 1.0 - b1 - b2;
-
-        // Now p' = b0*v0 + b1*v1 + b2*v2
-        // which is the projection of p in the plane of the triangle
-
-        double d = numeric_limits<double>::infinity();
-        if(b0 >= 0 && b1 >= 0 && b2 >= 0) {
-            // p' is inside the triangle
-            d = dot(mesh.attribute(ti).gTriangle.unitNormal, r0p);
-        } else {
-            // p' is outside the triangle
-            const Vec< 3, typename CT::float_type > r2 {
-                distance2(c[1], c[2]),
-                distance2(c[2], c[0]),
-                distance2(c[0], c[1])
-            };
-            const auto r1p = p - c[1];
-            const auto r2p = p - c[2];
-            const auto r12 = c[2] - c[1];
-            const auto dot_1p_12 = dot(r1p, r12);
-            const auto dot_2p_20 = -dot(r2p, r02);
-            const auto dot_0p_01 = dot(r0p, r01);
-
-            if(b0 < 0 && dot_1p_12 >= 0 && dot_1p_12 <= r2[0]) {
-                // On edge 12
-                d = magnitude(cross(r1p, r12)) / std::sqrt(r2[0]);
-                if(dot(mesh.attribute(mesh.edge(hei2)).gEdge.pseudoUnitNormal, r1p) < 0) d = -d;
-            } else if(b1 < 0 && dot_2p_20 >= 0 && dot_2p_20 <= r2[1]) {
-                // On edge 20
-                d = magnitude(cross(r2p, r02)) / std::sqrt(r2[1]);
-                if(dot(mesh.attribute(mesh.edge(hei0)).gEdge.pseudoUnitNormal, r2p) < 0) d = -d;
-            } else if(b2 < 0 && dot_0p_01 >= 0 && dot_0p_01 <= r2[2]) {
-                // On edge 01
-                d = magnitude(cross(r0p, r01)) / std::sqrt(r2[2]);
-                if(dot(mesh.attribute(mesh.edge(hei1)).gEdge.pseudoUnitNormal, r0p) < 0) d = -d;
-            } else if(dot_0p_01 < 0 && dot_2p_20 > r2[1]) {
-                // On vertex 0
-                d = distance(c[0], p);
-                if(dot(mesh.attribute(vi[0]).gVertex.pseudoUnitNormal, r0p) < 0) d = -d;
-            } else if(dot_1p_12 < 0 && dot_0p_01 > r2[2]) {
-                // On vertex 1
-                d = distance(c[1], p);
-                if(dot(mesh.attribute(vi[1]).gVertex.pseudoUnitNormal, r1p) < 0) d = -d;
-            } else if(dot_2p_20 < 0 && dot_1p_12 > r2[0]) {
-                // On vertex 2
-                d = distance(c[2], p);
-                if(dot(mesh.attribute(vi[2]).gVertex.pseudoUnitNormal, r2p) < 0) d = -d;
-            } else {
-                // The program should never come here
-                throw logic_error("Unknown case of point projection on the plane of triangle.");
-            }
-        }
+        const double d = signedDistanceToTriangle(sys, mesh, ti, p);
 
         // Update with distance with less absolute value
         if(abs(d) < abs(minAbsDistance)) minAbsDistance = d;
     }
-    
+
     return minAbsDistance;
 }
+
+// Signed distances of a batch of points, computed in parallel.
+template< typename VecType, std::enable_if_t< VecType::vec_size == 3 >* = nullptr >
+inline std::vector< double > signedDistance(const SubSystem& sys, const MembraneMeshAttribute::MeshType& mesh, const std::vector< VecType >& ps, bool allowOpen = false) {
+    if(!allowOpen && !mesh.isClosed()) {
+        throw std::runtime_error("Mesh is not closed while trying to find signed distance field.");
+    }
+
+    std::vector< double > res(ps.size());
+    ThreadPool::global().parallelFor(0, ps.size(), [&](Index i) {
+        res[i] = signedDistance(sys, mesh, ps[i], true);
+    }, 64);
+    return res;
+}
+
 template< typename VecType, std::enable_if_t< VecType::vec_size == 3 >* = nullptr >
 inline bool contains(const SubSystem& sys, const MembraneMeshAttribute::MeshType& mesh, const VecType& p) {
     return signedDistance(sys, mesh, p) < 0.0;
@@ -18,6 +18,7 @@
 #include "Structure/SurfaceMesh/Triangle.hpp"
 #include "Structure/SurfaceMesh/Vertex.hpp"
 #include "Structure/SurfaceMesh/Types.hpp"
+#include "Util/Math/AabbTree.hpp"
 #include "SysParams.h"
 #include "Util/Io/Log.hpp"
 #include "Util/StableVector.hpp"
@@ -176,6 +177,14 @@ struct MembraneMeshAttribute {
         Index cachedVertexOffsetLeavingHE    (Index idx) const { return cachedVertexTopoSize() * idx + vertexMaxDegree * 2; }
         Index cachedVertexOffsetOuterHE      (Index idx) const { return cachedVertexTopoSize() * idx + vertexMaxDegree * 3; }
         Index cachedVertexOffsetPolygon      (Index idx) const { return cachedVertexTopoSize() * idx + vertexMaxDegree * 4; }
+
+        // Bounding volume hierarchy of triangles, used in signed distance queries.
+        //
+        // Notes:
+        //   - The tree is rebuilt or refitted when the geometry for the system is updated.
+        //   - Adding or removing triangles invalidates the tree.
+        AabbTree<> triangleTree;
+        bool triangleTreeValid = false;
     };
 
     using CoordinateType = typename VertexAttribute::CoordinateType;
@@ -226,6 +235,7 @@ struct ElementAttributeModifier {
         mesh.attribute(he).halfEdge = std::make_unique< medyan::HalfEdge >();
     }
     void newTriangle(MembraneMeshAttribute::MeshType& mesh, HalfEdgeMeshConnection::TriangleIndex t) {
+        mesh.metaAttribute().triangleTreeValid = false;
         mesh.attribute(t).triangleSysIndex = sysFunc.template emplaceTrackable<Triangle>(*ps, mesh.metaAttribute().membraneSysIndex, t.index);
     }
     void newBorder(MembraneMeshAttribute::MeshType& mesh, HalfEdgeMeshConnection::BorderIndex) {
@@ -242,6 +252,7 @@ struct ElementAttributeModifier {
         // Do nothing
     }
     void removeElement(MembraneMeshAttribute::MeshType& mesh, HalfEdgeMeshConnection::TriangleIndex i) {
+        mesh.metaAttribute().triangleTreeValid = false;
         sysFunc.template removeTrackable<Triangle>(*ps, mesh.attribute(i).triangleSysIndex);
     }
     void removeElement(MembraneMeshAttribute::MeshType& mesh, HalfEdgeMeshConnection::BorderIndex i) {
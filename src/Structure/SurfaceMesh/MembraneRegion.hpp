@@ -71,7 +71,8 @@ public:
             - not in any of the membranes in _hierIn
         **************************************************************************/
         if(boundary_) {
-            auto p = mathfunc::vec2Vector(point);
+            Vec< 3, floatingpoint > p;
+            p = point;
             if(!boundary_->within(p)) return false;
         }
 
@@ -93,6 +94,43 @@ public:
         return true;
     }
 
+    /// Are points inside region. The signed distances to each membrane are
+    /// found for all points in one batch.
+    template< typename VecType, typename Context, std::enable_if_t< VecType::vec_size == 3 >* = nullptr >
+    std::vector< bool > contains(Context& sys, const std::vector< VecType >& points) const {
+        std::vector< bool > res(points.size(), true);
+
+        if(boundary_) {
+            Vec< 3, floatingpoint > p;
+            for(Index i = 0; i < points.size(); ++i) {
+                p = points[i];
+                if(!boundary_->within(p)) res[i] = false;
+            }
+        }
+
+        if(!_hierOut.empty()) {
+            std::vector< bool > inAnyOut(points.size(), false);
+            for(auto eachHier: _hierOut) {
+                const auto ds = medyan::signedDistance(sys, sys.membranes[eachHier->getMembraneIndex()].getMesh(), points);
+                for(Index i = 0; i < points.size(); ++i) {
+                    if(ds[i] < 0.0) inAnyOut[i] = true;
+                }
+            }
+            for(Index i = 0; i < points.size(); ++i) {
+                if(!inAnyOut[i]) res[i] = false;
+            }
+        }
+
+        for(auto eachHier: _hierIn) {
+            const auto ds = medyan::signedDistance(sys, sys.membranes[eachHier->getMembraneIndex()].getMesh(), points);
+            for(Index i = 0; i < points.size(); ++i) {
+                if(ds[i] < 0.0) res[i] = false;
+            }
+        }
+
+        return res;
+    }
+
     /**************************************************************************
     Getters and Setters
     **************************************************************************/
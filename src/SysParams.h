@@ -120,6 +120,11 @@ struct MechParams {
         floatingpoint lambdarunningaverageprobability = 0.0;
         string linesearchalgorithm = "BACKTRACKING";
         bool tryToRecoverInLineSearchError = true;
+
+        // L-BFGS and FIRE parameters.
+        int lbfgsNumHistory = 10;
+        floatingpoint fireDtInit = 0.05;
+        floatingpoint fireDtMax = 0.5;
         
         /// Not yet used
         string MD = "";
@@ -264,6 +269,8 @@ struct MechParams {
     bool denseEstimationBool = true;
     bool hessMatrixPrintBool = false;
     int hessSkip = 20;
+    // Number of the smallest eigenpairs computed by the sparse eigen solver.
+    int hessNumEigs = 100;
 
     int cylThresh = 0;
 
@@ -301,6 +308,28 @@ struct ChemParams {
         int minimizationSteps = 0;
         int neighborListSteps = 0;
         //@}
+
+        /// Extra distance added to the cutoffs of cylinder neighbor lists. The
+        /// lists are rebuilt only if some cylinder has moved by more than half
+        /// of the skin, or if cylinders are created or removed. Zero means that
+        /// the lists are always rebuilt.
+        floatingpoint neighborListSkin = 0.0;
+
+        //@{
+        /// Parallel chemistry using compartment sub-domains (the PARTITIONED algorithm).
+        /// The number of sub-domains, where 0 means the number of threads.
+        int partitionNumDomains = 0;
+        /// Time window after which the sub-domains are synchronized.
+        floatingpoint partitionSyncTime = 0.001;
+        //@}
+
+        //@{
+        /// Hybrid chemistry with tau-leaping of abundant diffusing species (the HYBRID algorithm).
+        /// Diffusion reactions whose reactant copy number is at least the threshold are leaped.
+        floatingpoint hybridCopyNumberThreshold = 1000;
+        /// Length of the tau-leaping window.
+        floatingpoint hybridLeapTime = 0.001;
+        //@}
     };
 
     /// Struct to hold chem setup information
@@ -542,6 +571,12 @@ struct DyRateParams {
     float manualMinusPolyRate = 1.0;
     /// Minusend Depolymerization Rate Ratio
     float manualMinusDepolyRate = 1.0;
+
+    /// Force tolerance (pN) for updating reaction rates after minimization.
+    /// The rates of an element are only recomputed if one of the forces they
+    /// depend on has changed by more than this value. With 0, only elements
+    /// whose forces are exactly unchanged are skipped.
+    floatingpoint rateUpdateForceTolerance = 0.0;
 };
 
 /// Struct to hold Filament setup information
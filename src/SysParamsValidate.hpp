@@ -81,6 +81,11 @@ inline bool checkChemParameters(const SimulConfig& conf) {
     bool passed = true;
     std::ostringstream errMsg;
 
+    if(chemParams.chemistryAlgorithm.neighborListSkin < 0) {
+        errMsg << "Neighbor list skin must not be negative.\n";
+        passed = false;
+    }
+
     // Check filament species.
     if(chemParams.numFilaments < 1) {
         errMsg << "Must specify at least one type of filament.\n";
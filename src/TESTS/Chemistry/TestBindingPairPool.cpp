@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "Chemistry/BindingPairPool.hpp"
+
+namespace medyan {
+
+namespace {
+
+// Check that the pool contains exactly the expected pairs, in any order.
+void checkPairs(const BindingPairPool& pool, std::vector< std::pair< std::uint32_t, std::uint32_t > > expected) {
+    std::vector< std::pair< std::uint32_t, std::uint32_t > > actual;
+    for(auto& p : pool) actual.push_back({ p.site1, p.site2 });
+    std::sort(actual.begin(), actual.end());
+    std::sort(expected.begin(), expected.end());
+    CHECK(actual == expected);
+}
+
+} // namespace
+
+TEST_CASE("BindingPairPool", "[BindingPairPool]") {
+    BindingPairPool pool;
+    CHECK(pool.empty());
+
+    pool.insert(1, 10);
+    pool.insert(1, 11);
+    pool.insert(2, 10);
+    pool.insert(3, 12);
+    pool.insert(4, 1);
+    CHECK(pool.size() == 5);
+    CHECK(pool.count(1) == 3);
+    CHECK(pool.count(10) == 2);
+    CHECK(pool.count(5) == 0);
+
+    SECTION("Removing a site removes pairs containing it on either side") {
+        CHECK(pool.removeSite(1) == 3);
+        checkPairs(pool, { {2, 10}, {3, 12} });
+        CHECK(pool.count(1) == 0);
+        CHECK(pool.count(10) == 1);
+        CHECK(pool.count(11) == 0);
+        CHECK(pool.count(4) == 0);
+
+        CHECK(pool.removeSite(1) == 0);
+        CHECK(pool.removeSite(12) == 1);
+        checkPairs(pool, { {2, 10} });
+    }
+
+    SECTION("Site indices stay consistent after pairs are moved") {
+        CHECK(pool.removeSite(11) == 1);
+        CHECK(pool.removeSite(10) == 2);
+        checkPairs(pool, { {3, 12}, {4, 1} });
+        CHECK(pool.removeSite(4) == 1);
+        CHECK(pool.removeSite(3) == 1);
+        CHECK(pool.empty());
+        CHECK(pool.count(1) == 0);
+    }
+
+    SECTION("Duplicated pairs are kept") {
+        pool.insert(2, 10);
+        CHECK(pool.count(2) == 2);
+        CHECK(pool.removeSite(10) == 3);
+        checkPairs(pool, { {1, 11}, {3, 12}, {4, 1} });
+    }
+
+    SECTION("Clear") {
+        pool.clear();
+        CHECK(pool.empty());
+        CHECK(pool.count(1) == 0);
+    }
+}
+
+} // namespace medyan
@@ -0,0 +1,282 @@
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+
+#include "catch2/catch.hpp"
+
+#include "Chemistry/ChemCRImpl.h"
+#include "Chemistry/ChemGillespieImpl.h"
+#include "Chemistry/ChemNRMImpl.h"
+#include "Chemistry/ReactionDy.hpp"
+#include "Rand.h"
+
+namespace medyan {
+
+namespace {
+
+// A network of reactions owning all its species and reactions.
+struct TestReactionNetwork {
+    std::vector< std::unique_ptr< Species > >    species;
+    std::vector< std::unique_ptr< ReactionDy > > reactions;
+
+    Species& addSpecies(int n) {
+        auto name = "S" + std::to_string(species.size());
+        species.push_back(std::make_unique< Species >(name, n, 1000000, SpeciesType::unspecified, RSpeciesType::REG));
+        return *species.back();
+    }
+    ReactionDy& addReaction(std::vector< Species* > reactants, std::vector< Species* > products, floatingpoint rate) {
+        reactions.push_back(std::make_unique< ReactionDy >(reactants, products, ReactionType::REGULAR, rate));
+        return *reactions.back();
+    }
+};
+
+// Independent isomerizations A_i <-> B_i, with rates spanning many propensity groups.
+struct IsomerizationNetwork : TestReactionNetwork {
+    std::vector< Species* > as;
+    std::vector< floatingpoint > kfs, kbs;
+
+    IsomerizationNetwork(int numPairs, int n) {
+        for(int i = 0; i < numPairs; ++i) {
+            auto& a = addSpecies(n);
+            auto& b = addSpecies(0);
+            const floatingpoint kf = std::pow((floatingpoint)2, i % 8 - 4);
+            const floatingpoint kb = std::pow((floatingpoint)2, (3 * i) % 7 - 3);
+            addReaction({ &a }, { &b }, kf);
+            addReaction({ &b }, { &a }, kb);
+            as.push_back(&a);
+            kfs.push_back(kf);
+            kbs.push_back(kb);
+        }
+    }
+};
+
+// Time averaged copy numbers of given species, sampled at regular intervals.
+template< typename ChemSimImpl >
+std::vector< double > timeAveragedCopyNumbers(
+    TestReactionNetwork& network,
+    const std::vector< Species* >& observed,
+    floatingpoint burnIn,
+    floatingpoint interval,
+    int numSamples
+) {
+    ChemSimImpl sim;
+    for(auto& r : network.reactions) sim.addReaction(r.get());
+    sim.initialize();
+
+    std::vector< double > res(observed.size());
+    REQUIRE(sim.run(burnIn));
+    for(int si = 0; si < numSamples; ++si) {
+        REQUIRE(sim.run(interval));
+        for(int i = 0; i < observed.size(); ++i) res[i] += observed[i]->getN();
+    }
+    for(auto& x : res) x /= numSamples;
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("ChemCRImpl tests", "[ChemSim]") {
+
+    Species a{"A", 0, 1000000, SpeciesType::unspecified, RSpeciesType::REG};
+    Species b{"B", 0, 1000000, SpeciesType::unspecified, RSpeciesType::REG};
+    Species c{"C", 0, 1000000, SpeciesType::unspecified, RSpeciesType::REG};
+    vector<Species*> reactants{ &a, &b };
+    vector<Species*> products{ &c };
+    ReactionDy reaction{reactants, products, ReactionType::REGULAR, 1.0};
+    ChemCRImpl sim{};//resets global time to 0
+    sim.addReaction(&reaction);
+    sim.initialize();
+
+    SECTION("Test runSteps") {
+        REQUIRE(sim.computeTotalA()==0);
+        a.up();
+        //sim.initialize() must be called to refresh propensities
+        //after any copy number changes externally
+        sim.initialize();
+        REQUIRE(sim.computeTotalA()==0);
+        b.up();
+        sim.initialize();
+        REQUIRE(sim.computeTotalA()==1.0);
+        b.up();
+        sim.initialize();
+        REQUIRE(sim.computeTotalA()==2.0);
+        REQUIRE(sim.runSteps(1));
+        REQUIRE(a.getN()==0);
+        REQUIRE(b.getN()==1);
+        REQUIRE(c.getN()==1);
+        REQUIRE(sim.computeTotalA()==0);
+        REQUIRE(sim.getTime()>0);
+    }
+
+    SECTION("Test run") {
+        REQUIRE(sim.run(1.0));
+        REQUIRE(c.getN()==0);
+        REQUIRE(a.getN()==0);
+        REQUIRE(b.getN()==0);
+        REQUIRE(sim.getTime() == Approx(1.0));
+        a.up();
+        b.up();
+        sim.initialize();
+        REQUIRE(sim.run(100.0));
+        REQUIRE(sim.getTime() == Approx(100.0));
+        REQUIRE(a.getN()==0);
+        REQUIRE(b.getN()==0);
+        REQUIRE(c.getN()==1);
+    }
+
+    SECTION("Test adding and removing reactions") {
+        a.setN(10);
+        b.setN(10);
+        ReactionDy reverse{products, reactants, ReactionType::REGULAR, 1000.0};
+        sim.addReaction(&reverse);
+        sim.initialize();
+        REQUIRE(sim.getSize() == 2);
+        REQUIRE(sim.computeTotalA() == 100.0);
+
+        REQUIRE(sim.runSteps(1000));
+        REQUIRE(a.getN() + c.getN() == 10);
+        REQUIRE(b.getN() + c.getN() == 10);
+
+        sim.removeReaction(&reaction);
+        sim.initialize();
+        REQUIRE(sim.getSize() == 1);
+        REQUIRE(sim.computeTotalA() == Approx(1000.0 * c.getN()));
+        REQUIRE(sim.run(100.0));
+        REQUIRE(c.getN() == 0);
+        REQUIRE(a.getN() == 10);
+        REQUIRE(sim.computeTotalA() == 0);
+    }
+
+    SECTION("Test dependents outside of the network") {
+        // C -> A is not simulated, and C -> B is simulated by NRM.
+        // C is not empty, so that the dependents are not passivated.
+        c.setN(1);
+        ReactionDy unsimulated{products, vector<Species*>{ &a }, ReactionType::REGULAR, 1.0};
+        ReactionDy other{products, vector<Species*>{ &b }, ReactionType::REGULAR, 1.0};
+        unsimulated.activateReaction();
+        ChemNRMImpl otherSim;
+        otherSim.addReaction(&other);
+        otherSim.initialize();
+        reaction.setDependentReactions();
+        REQUIRE(reaction.dependents().size() == 2);
+
+        a.setN(1);
+        b.setN(1);
+        sim.initialize();
+        REQUIRE(sim.runSteps(1));
+        REQUIRE(c.getN() == 2);
+        // The NRM network has been notified of the new propensity.
+        CHECK(static_cast<RNodeNRM*>(other.getRnode())->getPropensity() == Approx(2.0));
+    }
+}
+
+TEST_CASE("ChemCRImpl propensity groups", "[ChemSim]") {
+    IsomerizationNetwork network(16, 100);
+    ChemCRImpl sim;
+    for(auto& r : network.reactions) sim.addReaction(r.get());
+    sim.initialize();
+
+    // Forward rates span 8 powers of two, and B species are all empty.
+    CHECK(sim.getNumGroups() == 8);
+    double aTotal = 0;
+    for(auto kf : network.kfs) aTotal += kf * 100;
+    CHECK(sim.computeTotalA() == Approx(aTotal));
+
+    // The cached total propensity stays in sync with the species.
+    REQUIRE(sim.runSteps(10000));
+    aTotal = 0;
+    for(int i = 0; i < network.as.size(); ++i) {
+        const auto na = network.as[i]->getN();
+        aTotal += network.kfs[i] * na + network.kbs[i] * (100 - na);
+    }
+    CHECK(sim.computeTotalA() == Approx(aTotal).epsilon(1e-6));
+}
+
+TEST_CASE("ChemCRImpl statistics", "[ChemSim]") {
+    Rand::eng.seed(12345);
+
+    SECTION("Isomerization equilibrium") {
+        const int n = 100;
+        IsomerizationNetwork network(16, n);
+        const auto avgCR = timeAveragedCopyNumbers< ChemCRImpl >(network, network.as, 20.0, 1.0, 2000);
+
+        for(int i = 0; i < network.as.size(); ++i) {
+            // Stationary distribution of A_i is binomial.
+            const double p = network.kbs[i] / (network.kfs[i] + network.kbs[i]);
+            const double mean = n * p;
+            // Standard error of the time average, with correlation time 1/(kf+kb).
+            const double relaxTime = 1.0 / (network.kfs[i] + network.kbs[i]);
+            const double numIndependent = 2000 / std::max(1.0, 2 * relaxTime);
+            const double stderror = std::sqrt(n * p * (1 - p) / numIndependent);
+            INFO("Pair " << i << ", kf = " << network.kfs[i] << ", kb = " << network.kbs[i]);
+            CHECK(std::abs(avgCR[i] - mean) < 5 * stderror + 0.1);
+        }
+    }
+
+    SECTION("Dimerization compared with Gillespie and NRM") {
+        // A + B <-> C, and A -> 0 -> A, where the copy number of C is not
+        // analytically tractable.
+        const auto makeNetwork = [](TestReactionNetwork& network) {
+            auto& a = network.addSpecies(50);
+            auto& b = network.addSpecies(50);
+            auto& c = network.addSpecies(0);
+            network.addReaction({ &a, &b }, { &c }, 0.05);
+            network.addReaction({ &c }, { &a, &b }, 1.0);
+            network.addReaction({ &a }, {}, 0.1);
+            network.addReaction({}, { &a }, 2.0);
+        };
+        const auto average = [&](auto simTag) {
+            TestReactionNetwork network;
+            makeNetwork(network);
+            using Sim = typename decltype(simTag)::type;
+            return timeAveragedCopyNumbers< Sim >(
+                network,
+                { network.species[0].get(), network.species[2].get() },
+                20.0, 0.5, 40000
+            );
+        };
+        const auto avgCR        = average(std::common_type< ChemCRImpl >{});
+        const auto avgGillespie = average(std::common_type< ChemGillespieImpl >{});
+        const auto avgNRM       = average(std::common_type< ChemNRMImpl >{});
+
+        for(int i = 0; i < 2; ++i) {
+            INFO("Observed species " << i << ": CR " << avgCR[i] << ", Gillespie " << avgGillespie[i] << ", NRM " << avgNRM[i]);
+            CHECK(avgCR[i] == Approx(avgGillespie[i]).epsilon(0.03));
+            CHECK(avgCR[i] == Approx(avgNRM[i]).epsilon(0.03));
+        }
+    }
+}
+
+TEST_CASE("Chemistry algorithm benchmark", "[.][benchmark][ChemSim]") {
+    using namespace std;
+
+    const auto bench = [](auto simTag, int numPairs, int numSteps) {
+        IsomerizationNetwork network(numPairs, 10);
+        // Randomize rates over several orders of magnitude.
+        for(auto& r : network.reactions) {
+            r->setRateMulFactor(pow((floatingpoint)10, Rand::randfloatingpoint(-3, 3)), ReactionBase::RateMulFactorType::mechanochemical);
+        }
+        typename decltype(simTag)::type sim;
+        for(auto& r : network.reactions) sim.addReaction(r.get());
+        sim.initialize();
+
+        const auto start = chrono::steady_clock::now();
+        REQUIRE(sim.runSteps(numSteps));
+        const chrono::duration< double > elapsed = chrono::steady_clock::now() - start;
+        return numSteps / elapsed.count();
+    };
+
+    for(int numPairs : { 500, 5000, 50000 }) {
+        const int numReactions = 2 * numPairs;
+        const auto stepsNRM = bench(common_type< ChemNRMImpl >{}, numPairs, 200000);
+        const auto stepsCR  = bench(common_type< ChemCRImpl >{},  numPairs, 200000);
+        log::info("{} reactions: NRM {:.3g} steps/s, CR {:.3g} steps/s", numReactions, stepsNRM, stepsCR);
+        if(numReactions <= 10000) {
+            const auto stepsGillespie = bench(common_type< ChemGillespieImpl >{}, numPairs, 20000);
+            log::info("{} reactions: Gillespie {:.3g} steps/s", numReactions, stepsGillespie);
+        }
+    }
+}
+
+} // namespace medyan
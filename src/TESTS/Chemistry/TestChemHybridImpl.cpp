@@ -0,0 +1,168 @@
+
+#include <memory>
+
+#include "catch2/catch.hpp"
+
+#include "Chemistry/ChemHybridImpl.h"
+#include "Chemistry/ChemNRMImpl.h"
+#include "Chemistry/Reaction.h"
+#include "Chemistry/ReactionDy.hpp"
+#include "Composite.h"
+#include "Rand.h"
+
+namespace medyan {
+
+namespace {
+
+struct TestCompartment : Composite {
+    virtual void printSelf() const override {}
+    virtual int getType() override { return 0; }
+};
+
+// A row of compartments, with abundant A diffusing between them and A <-> B
+// in each compartment. Optionally, A is created in the first compartment and
+// destroyed in the last one.
+struct TestChannel {
+    std::vector< std::unique_ptr< TestCompartment > > compartments;
+    std::vector< std::unique_ptr< Species > >    as, bs;
+    std::vector< std::unique_ptr< ReactionBase > > reactions;
+    int numDiffusionReactions = 0;
+
+    TestChannel(int numCompartments, int initialA, bool open) {
+        const auto makeSpecies = [](std::string name, int n, Composite& parent) {
+            auto res = std::make_unique< Species >(name, n, 1000000, SpeciesType::unspecified, RSpeciesType::REG);
+            res->setParent(&parent);
+            return res;
+        };
+        const auto addReaction = [this](std::vector< Species* > reactants, std::vector< Species* > products, floatingpoint rate) {
+            reactions.push_back(std::make_unique< ReactionDy >(reactants, products, ReactionType::REGULAR, rate));
+        };
+        const auto addDiffusion = [this](Species* from, Species* to, floatingpoint rate) {
+            reactions.push_back(std::make_unique< DiffusionReaction >(std::initializer_list< Species* >{ from, to }, rate));
+            ++numDiffusionReactions;
+        };
+
+        for(int i = 0; i < numCompartments; ++i) {
+            auto& comp = *compartments.emplace_back(std::make_unique< TestCompartment >());
+            as.push_back(makeSpecies("A", initialA, comp));
+            bs.push_back(makeSpecies("B", 0, comp));
+        }
+
+        for(int i = 0; i < numCompartments; ++i) {
+            addReaction({ as[i].get() }, { bs[i].get() }, 0.1);
+            addReaction({ bs[i].get() }, { as[i].get() }, 0.1);
+            if(i + 1 < numCompartments) {
+                addDiffusion(as[i].get(), as[i+1].get(), 1.0);
+                addDiffusion(as[i+1].get(), as[i].get(), 1.0);
+            }
+        }
+        if(open) {
+            addReaction({}, { as.front().get() }, 200.0);
+            addReaction({ as.back().get() }, {}, 0.2);
+        }
+    }
+
+    int totalCopyNumber() const {
+        int res = 0;
+        for(auto& a : as) res += a->getN();
+        for(auto& b : bs) res += b->getN();
+        return res;
+    }
+};
+
+// Time averaged copy numbers of A in each compartment.
+std::vector< double > averageProfile(ChemSim& sim, TestChannel& channel, int numSamples) {
+    std::vector< double > res(channel.as.size());
+    REQUIRE(sim.run(10.0));
+    for(int si = 0; si < numSamples; ++si) {
+        REQUIRE(sim.run(0.5));
+        for(int i = 0; i < res.size(); ++i) res[i] += channel.as[i]->getN();
+    }
+    for(auto& x : res) x /= numSamples;
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("ChemHybridImpl tests", "[ChemSim]") {
+    Rand::eng.seed(12345);
+
+    const int numCompartments = 6;
+    TestChannel channel(numCompartments, 1000, false);
+    // The leap window is exactly representable, so that the windows add up to the run time.
+    ChemHybridImpl sim(200, 1.0 / 128);
+    for(auto& r : channel.reactions) sim.addReaction(r.get());
+    sim.initialize();
+
+    SECTION("Abundant diffusion is leaped") {
+        CHECK(sim.getLeapedSize() == 0);
+        CHECK(sim.getExactSize() == channel.reactions.size());
+
+        REQUIRE(sim.run(1.0));
+        CHECK(sim.getTime() == Approx(1.0));
+        CHECK(global_time == Approx(1.0));
+        CHECK(sim.getLeapedSize() == channel.numDiffusionReactions);
+        CHECK(sim.getExactSize() == channel.reactions.size() - channel.numDiffusionReactions);
+        CHECK(sim.getStats().numWindows == 128);
+        CHECK(sim.getStats().numLeapSteps == 2 * 128);
+        CHECK(sim.getStats().numLeapEvents > 0);
+        CHECK(sim.getStats().maxPropensityChange < 0.1);
+
+        // Copy numbers are conserved in the closed channel.
+        CHECK(channel.totalCopyNumber() == numCompartments * 1000);
+    }
+
+    SECTION("Running steps is exact") {
+        REQUIRE(sim.run(1.0));
+        REQUIRE(sim.runSteps(1000));
+        CHECK(sim.getLeapedSize() == 0);
+        CHECK(sim.getExactSize() == channel.reactions.size());
+        CHECK(channel.totalCopyNumber() == numCompartments * 1000);
+    }
+
+    SECTION("Rare species are simulated exactly") {
+        for(auto& a : channel.as) a->setN(10);
+        sim.initialize();
+        REQUIRE(sim.run(1.0));
+        CHECK(sim.getLeapedSize() == 0);
+        CHECK(sim.getStats().numWindows == 0);
+        CHECK(channel.totalCopyNumber() == numCompartments * 10);
+    }
+
+    SECTION("Leaped reactions can be removed") {
+        REQUIRE(sim.run(1.0));
+        for(auto& r : channel.reactions) sim.removeReaction(r.get());
+        CHECK(sim.getLeapedSize() == 0);
+        CHECK(sim.getExactSize() == 0);
+    }
+}
+
+TEST_CASE("ChemHybridImpl statistics compared with NRM", "[ChemSim]") {
+    Rand::eng.seed(23456);
+
+    const int numCompartments = 6;
+    const int numSamples = 200;
+
+    std::vector< double > profileNRM;
+    {
+        TestChannel channel(numCompartments, 1000, true);
+        ChemNRMImpl sim;
+        for(auto& r : channel.reactions) sim.addReaction(r.get());
+        sim.initialize();
+        profileNRM = averageProfile(sim, channel, numSamples);
+    }
+
+    TestChannel channel(numCompartments, 1000, true);
+    ChemHybridImpl sim(200, 0.01);
+    for(auto& r : channel.reactions) sim.addReaction(r.get());
+    sim.initialize();
+    const auto profile = averageProfile(sim, channel, numSamples);
+
+    CHECK(sim.getStats().numRejectedEvents == 0);
+    for(int i = 0; i < numCompartments; ++i) {
+        INFO("Compartment " << i << ", NRM " << profileNRM[i] << ", hybrid " << profile[i]);
+        CHECK(profile[i] == Approx(profileNRM[i]).epsilon(0.05));
+    }
+}
+
+} // namespace medyan
@@ -1,9 +1,13 @@
 
 
+#include <chrono>
+#include <memory>
+
 #include "catch2/catch.hpp"
 
 #include "Chemistry/ChemNRMImpl.h"
 #include "Chemistry/ReactionDy.hpp"
+#include "Util/Io/Log.hpp"
 
 namespace medyan {
 
@@ -53,4 +57,137 @@ TEST_CASE("ChemNRMImpl tests", "[ChemSim]") {
 
 }
 
+TEST_CASE("ChemNRMImpl batched rate updates", "[ChemSim]") {
+    using namespace std;
+
+    const int numReactions = 20;
+    vector< unique_ptr< Species > >    species;
+    vector< unique_ptr< ReactionDy > > reactions;
+    for(int i = 0; i < numReactions; ++i) {
+        species.push_back(make_unique< Species >("A" + to_string(i), 1000, 1000000, SpeciesType::unspecified, RSpeciesType::REG));
+        species.push_back(make_unique< Species >("B" + to_string(i), 0, 1000000, SpeciesType::unspecified, RSpeciesType::REG));
+        reactions.push_back(make_unique< ReactionDy >(
+            vector< Species* > { species[2*i].get() }, vector< Species* > { species[2*i+1].get() },
+            ReactionType::REGULAR, 1.0
+        ));
+    }
+
+    ChemNRMImpl sim;
+    for(auto& r : reactions) sim.addReaction(r.get());
+    sim.initialize();
+
+    // The next fired reaction must always be the one with the smallest tau.
+    const auto checkFiringOrder = [&](int numSteps) {
+        for(int step = 0; step < numSteps; ++step) {
+            int next = 0;
+            for(int i = 1; i < numReactions; ++i) {
+                if(static_cast< RNodeNRM* >(reactions[i]->getRnode())->getTau() < static_cast< RNodeNRM* >(reactions[next]->getRnode())->getTau()) next = i;
+            }
+            const auto n = species[2*next+1]->getN();
+            REQUIRE(sim.runSteps(1));
+            REQUIRE(species[2*next+1]->getN() == n + 1);
+        }
+    };
+
+    const auto updateRates = [&](int numUpdated) {
+        sim.beginRateUpdates();
+        for(int i = 0; i < numUpdated; ++i) {
+            // Update some reactions twice, which should be harmless.
+            for(int k = 0; k < 1 + i % 2; ++k) {
+                reactions[i]->setRateMulFactor(0.1 + 0.2 * (i % 7), ReactionBase::mechanochemical);
+                reactions[i]->updatePropensity();
+            }
+        }
+        sim.endRateUpdates();
+    };
+
+    SECTION("Few updates") {
+        for(int round = 0; round < 10; ++round) {
+            updateRates(numReactions / 10);
+            checkFiringOrder(20);
+        }
+        REQUIRE(sim.crosschecktau());
+    }
+
+    SECTION("Heap rebuild") {
+        for(int round = 0; round < 10; ++round) {
+            updateRates(numReactions);
+            checkFiringOrder(20);
+        }
+        REQUIRE(sim.crosschecktau());
+    }
+
+    SECTION("Removal while deferred") {
+        sim.beginRateUpdates();
+        reactions[0]->setRateMulFactor(2.0, ReactionBase::mechanochemical);
+        reactions[0]->updatePropensity();
+        sim.removeReaction(reactions[0].get());
+        sim.endRateUpdates();
+        REQUIRE(sim.getSize() == numReactions - 1);
+        REQUIRE(sim.runSteps(10));
+    }
+}
+
+// A reaction network with the shape of examples/50filaments_motor_linker:
+// 2x2x1 compartments with diffusing actin, linkers and motors, 50 filaments
+// growing and shrinking at both ends, and linker/motor binding sites.
+TEST_CASE("ChemNRMImpl dependency update benchmark", "[.][benchmark][ChemSim]") {
+    using namespace std;
+
+    vector< unique_ptr< Species > >    species;
+    vector< unique_ptr< ReactionDy > > reactions;
+    const auto addSpecies = [&](int n) -> Species* {
+        species.push_back(make_unique< Species >("S" + to_string(species.size()), n, 1000000, SpeciesType::unspecified, RSpeciesType::REG));
+        return species.back().get();
+    };
+    const auto addReaction = [&](vector< Species* > reactants, vector< Species* > products, floatingpoint rate) {
+        reactions.push_back(make_unique< ReactionDy >(reactants, products, ReactionType::REGULAR, rate));
+    };
+
+    const int numCompartments = 4;
+    const int numFilaments = 50;
+    vector< Species* > actin, linker, motor, sites, boundLinker, boundMotor;
+    for(int c = 0; c < numCompartments; ++c) {
+        actin.push_back(addSpecies(5000 / numCompartments));
+        linker.push_back(addSpecies(500 / numCompartments));
+        motor.push_back(addSpecies(50 / numCompartments));
+        sites.push_back(addSpecies(400));
+        boundLinker.push_back(addSpecies(0));
+        boundMotor.push_back(addSpecies(0));
+
+        addReaction({ linker[c], sites[c] }, { boundLinker[c] }, 0.01);
+        addReaction({ boundLinker[c] }, { linker[c], sites[c] }, 0.3);
+        addReaction({ motor[c], sites[c] }, { boundMotor[c] }, 0.2);
+        addReaction({ boundMotor[c] }, { motor[c], sites[c] }, 1.7);
+    }
+    // Diffusion between neighboring compartments, with 500 nm compartments.
+    for(int c = 0; c < numCompartments; ++c) {
+        for(int d : { c ^ 1, c ^ 2 }) {
+            addReaction({ actin[c] },  { actin[d] },  80.0);
+            addReaction({ linker[c] }, { linker[d] }, 8.0);
+            addReaction({ motor[c] },  { motor[d] },  0.8);
+        }
+    }
+    for(int f = 0; f < numFilaments; ++f) {
+        const int c = f % numCompartments;
+        auto filament = addSpecies(100);
+        auto plusEnd  = addSpecies(1);
+        auto minusEnd = addSpecies(1);
+        addReaction({ actin[c], plusEnd },  { filament, plusEnd },  0.154);
+        addReaction({ actin[c], minusEnd }, { filament, minusEnd }, 0.0173);
+        addReaction({ filament, plusEnd },  { actin[c], plusEnd },  1.4);
+        addReaction({ filament, minusEnd }, { actin[c], minusEnd }, 0.8);
+    }
+
+    ChemNRMImpl sim;
+    for(auto& r : reactions) sim.addReaction(r.get());
+    sim.initialize();
+
+    const int numSteps = 2000000;
+    const auto start = chrono::steady_clock::now();
+    REQUIRE(sim.runSteps(numSteps));
+    const chrono::duration< double > elapsed = chrono::steady_clock::now() - start;
+    log::info("{} reactions: NRM {:.3g} events/s", reactions.size(), numSteps / elapsed.count());
+}
+
 } // namespace medyan
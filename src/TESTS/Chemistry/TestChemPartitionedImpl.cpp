@@ -0,0 +1,193 @@
+
+#include <memory>
+
+#include "catch2/catch.hpp"
+
+#include "Chemistry/ChemNRMImpl.h"
+#include "Chemistry/ChemPartitionedImpl.h"
+#include "Chemistry/ReactionDy.hpp"
+#include "Composite.h"
+#include "Rand.h"
+#include "Util/ThreadPool.hpp"
+
+namespace medyan {
+
+namespace {
+
+struct TestCompartment : Composite {
+    virtual void printSelf() const override {}
+    virtual int getType() override { return 0; }
+};
+
+// A row of compartments, with A diffusing between them and A <-> B in each
+// compartment. A is created in the first compartment and destroyed in the
+// last one. B in one of the compartments is also converted to C, which
+// triggers a callback.
+struct TestChannel {
+    std::vector< std::unique_ptr< TestCompartment > > compartments;
+    std::vector< std::unique_ptr< Species > >    as, bs;
+    std::unique_ptr< Species >                   c;
+    std::vector< std::unique_ptr< ReactionDy > > reactions;
+    int numCallbacks = 0;
+
+    TestChannel(int numCompartments) {
+        const auto makeSpecies = [](std::string name, int n, Composite& parent) {
+            auto res = std::make_unique< Species >(name, n, 1000000, SpeciesType::unspecified, RSpeciesType::REG);
+            res->setParent(&parent);
+            return res;
+        };
+        const auto addReaction = [this](std::vector< Species* > reactants, std::vector< Species* > products, floatingpoint rate) -> auto& {
+            reactions.push_back(std::make_unique< ReactionDy >(reactants, products, ReactionType::REGULAR, rate));
+            return *reactions.back();
+        };
+
+        for(int i = 0; i < numCompartments; ++i) {
+            auto& comp = *compartments.emplace_back(std::make_unique< TestCompartment >());
+            as.push_back(makeSpecies("A", 20, comp));
+            bs.push_back(makeSpecies("B", 0, comp));
+        }
+        c = makeSpecies("C", 0, *compartments[numCompartments / 2]);
+
+        for(int i = 0; i < numCompartments; ++i) {
+            addReaction({ as[i].get() }, { bs[i].get() }, 0.5);
+            addReaction({ bs[i].get() }, { as[i].get() }, 0.5);
+            if(i + 1 < numCompartments) {
+                addReaction({ as[i].get() }, { as[i+1].get() }, 1.0);
+                addReaction({ as[i+1].get() }, { as[i].get() }, 1.0);
+            }
+        }
+        addReaction({}, { as.front().get() }, 20.0);
+        addReaction({ as.back().get() }, {}, 1.0);
+        addReaction({ bs[numCompartments / 2].get() }, { c.get() }, 0.1)
+            .connect([this](ReactionBase*) { ++numCallbacks; });
+    }
+
+    auto domainOfParent(int numDomains) const {
+        std::unordered_map< const Composite*, Index > res;
+        for(int i = 0; i < compartments.size(); ++i) {
+            res[compartments[i].get()] = i * numDomains / compartments.size();
+        }
+        return res;
+    }
+
+    // Total propensity recomputed from scratch.
+    floatingpoint computeTotalA() const {
+        floatingpoint res = 0;
+        for(auto& r : reactions) res += r->computePropensity();
+        return res;
+    }
+};
+
+// Time averaged copy numbers of A in each compartment.
+std::vector< double > averageProfile(ChemSim& sim, TestChannel& channel, int numSamples) {
+    std::vector< double > res(channel.as.size());
+    REQUIRE(sim.run(20.0));
+    for(int si = 0; si < numSamples; ++si) {
+        REQUIRE(sim.run(0.5));
+        for(int i = 0; i < res.size(); ++i) res[i] += channel.as[i]->getN();
+    }
+    for(auto& x : res) x /= numSamples;
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("ChemPartitionedImpl tests", "[ChemSim]") {
+    Rand::eng.seed(12345);
+
+    const int numCompartments = 8;
+    const int numDomains = 4;
+    TestChannel channel(numCompartments);
+    ChemPartitionedImpl sim(channel.domainOfParent(numDomains), numDomains, 0.01);
+    for(auto& r : channel.reactions) sim.addReaction(r.get());
+    sim.initialize();
+
+    SECTION("Reactions are assigned to sub-domains") {
+        REQUIRE(sim.getNumDomains() == numDomains);
+        // Shared: 3 boundaries x 2 diffusion directions, and the reaction with
+        // callback.
+        CHECK(sim.getSharedSize() == 7);
+        // Each domain has 2 compartments, with 2 reactions each and 2 diffusion
+        // reactions in between. The source is in the first domain, and the sink
+        // is in the last domain.
+        CHECK(sim.getDomainSize(0) == 7);
+        CHECK(sim.getDomainSize(1) == 6);
+        CHECK(sim.getDomainSize(2) == 6);
+        CHECK(sim.getDomainSize(3) == 7);
+        CHECK(sim.computeTotalA() == Approx(channel.computeTotalA()));
+    }
+
+    SECTION("Propensities stay consistent") {
+        ThreadPool::resetGlobal(2);
+
+        REQUIRE(sim.run(10.0));
+        CHECK(sim.getTime() == Approx(10.0));
+        CHECK(global_time == Approx(10.0));
+        CHECK(sim.computeTotalA() == Approx(channel.computeTotalA()));
+        CHECK(channel.numCallbacks == channel.c->getN());
+        CHECK(channel.numCallbacks > 0);
+
+        REQUIRE(sim.runSteps(10000));
+        CHECK(sim.computeTotalA() == Approx(channel.computeTotalA()));
+        CHECK(channel.numCallbacks == channel.c->getN());
+
+        ThreadPool::resetGlobal(0);
+    }
+
+    SECTION("Dependents of shared reactions are restored") {
+        ThreadPool::resetGlobal(2);
+
+        // Empty the system, so that reactions are passivated and activated.
+        for(auto& a : channel.as) a->setN(0);
+        sim.initialize();
+        REQUIRE(sim.run(2.0));
+
+        for(auto& r : channel.reactions) {
+            if(r->isPassivated()) continue;
+            CHECK_FALSE(r->areUpdatesDeferred());
+            // Every active reaction depending on the species changed by r is a dependent.
+            for(auto& rep : r->getRepRSpecies()) {
+                for(auto rr : rep.prs->reactantReactions()) {
+                    if(rr != r.get() && !rr->isPassivated()) {
+                        CHECK(r->dependents().count(rr) == 1);
+                    }
+                }
+            }
+        }
+
+        ThreadPool::resetGlobal(0);
+    }
+}
+
+TEST_CASE("ChemPartitionedImpl statistics compared with NRM", "[ChemSim]") {
+    Rand::eng.seed(23456);
+
+    const int numCompartments = 8;
+    const int numSamples = 4000;
+
+    std::vector< double > profileNRM;
+    {
+        TestChannel channel(numCompartments);
+        ChemNRMImpl sim;
+        for(auto& r : channel.reactions) sim.addReaction(r.get());
+        sim.initialize();
+        profileNRM = averageProfile(sim, channel, numSamples);
+    }
+
+    ThreadPool::resetGlobal(2);
+    for(int numDomains : { 1, 4 }) {
+        TestChannel channel(numCompartments);
+        ChemPartitionedImpl sim(channel.domainOfParent(numDomains), numDomains, 0.01);
+        for(auto& r : channel.reactions) sim.addReaction(r.get());
+        sim.initialize();
+        const auto profile = averageProfile(sim, channel, numSamples);
+
+        for(int i = 0; i < numCompartments; ++i) {
+            INFO("Sub-domains: " << numDomains << ", compartment " << i << ", NRM " << profileNRM[i] << ", partitioned " << profile[i]);
+            CHECK(profile[i] == Approx(profileNRM[i]).epsilon(0.05).margin(0.5));
+        }
+    }
+    ThreadPool::resetGlobal(0);
+}
+
+} // namespace medyan
@@ -277,6 +277,61 @@ TEST_CASE("Reaction dependents 1", "[Reaction]") {
     CHECK(2 == rxn2.dependents().size());
     CHECK(1 == rxn3.dependents().size());
 }
+
+TEST_CASE("Reaction dependents with shared species", "[Reaction]") {
+    Species A("A",  10, max_ulim, SpeciesType::BULK, RSpeciesType::REG);
+    Species B("B",  20, max_ulim, SpeciesType::BULK, RSpeciesType::REG);
+    Species C("C",  0,  max_ulim, SpeciesType::BULK, RSpeciesType::REG);
+    // (1) and (2) are both A + B -> C, sharing two reactants. (3) is C -> A.
+    Reaction<2,1> rxn1 = { {&A,&B,&C}, 10.0 };
+    Reaction<2,1> rxn2 = { {&A,&B,&C}, 10.0 };
+    Reaction<1,1> rxn3 = { {&C,&A}, 10.0 };
+    const vector<ReactionBase*> all { &rxn1, &rxn2, &rxn3 };
+
+    // The dependents found incrementally are the same as those rebuilt from scratch.
+    const auto checkDependents = [](ReactionBase& r) {
+        auto incremental = r.dependents().values();
+        r.setDependentReactions();
+        auto rebuilt = r.dependents().values();
+        CHECK_FALSE(r.areDependentsOutdated());
+        sort(incremental.begin(), incremental.end());
+        sort(rebuilt.begin(), rebuilt.end());
+        CHECK(incremental == rebuilt);
+    };
+
+    rxn1.activateReaction();
+    rxn2.activateReaction();
+    rxn3.activateReaction();
+    REQUIRE(rxn3.isPassivated());
+    // (2) is a dependent of (1) only once.
+    CHECK(rxn1.dependents().values() == vector<ReactionBase*> { &rxn2 });
+    checkDependents(rxn1);
+    CHECK(rxn1.dependents().values() == vector<ReactionBase*> { &rxn2 });
+
+    // Activating an active reaction does not register it again.
+    rxn2.activateReactionUnconditional();
+    CHECK(rxn1.dependents().size() == 1);
+    CHECK_FALSE(rxn1.areDependentsOutdated());
+
+    // (3) is activated.
+    rxn1.makeStep();
+    REQUIRE(!rxn3.isPassivated());
+    CHECK(rxn1.areDependentsOutdated());
+    CHECK(rxn1.dependents().size() == 2);
+    for(auto r : all) checkDependents(*r);
+
+    // (1) and (2) are passivated.
+    for(int i = 1; i < 10; ++i) rxn1.makeStep();
+    REQUIRE(rxn1.isPassivated());
+    REQUIRE(rxn2.isPassivated());
+    CHECK(rxn3.areDependentsOutdated());
+    for(auto r : all) checkDependents(*r);
+
+    // (1) and (2) are activated again.
+    rxn3.makeStep();
+    REQUIRE(!rxn1.isPassivated());
+    for(auto r : all) checkDependents(*r);
+}
 #endif // of TRACK_ZERO_COPY_N
 #endif // of TRACK_UPPER_COPY_N
 
@@ -393,4 +448,50 @@ TEST_CASE("Reaction cloning", "[Reaction]") {
     CHECK(r3->is_equal(*r4));
 }
 
+TEST_CASE("Reaction species rebinding", "[Reaction]") {
+
+    Compartment* C1 = new Compartment;
+    Compartment* C2 = new Compartment;
+
+    Species* ADiff1 = C1->addSpeciesUnique(std::make_unique<Species>("ADiff", 10, max_ulim, SpeciesType::DIFFUSING, RSpeciesType::REG));
+    Species* ADiff2 = C2->addSpeciesUnique(std::make_unique<Species>("ADiff", 20, max_ulim, SpeciesType::DIFFUSING, RSpeciesType::REG));
+
+    Species* BDiff1 = C1->addSpeciesUnique(std::make_unique<Species>("BDiff", 10, max_ulim, SpeciesType::DIFFUSING, RSpeciesType::REG));
+    Species* CDiff1 = C1->addSpeciesUnique(std::make_unique<Species>("CDiff", 10, max_ulim, SpeciesType::DIFFUSING, RSpeciesType::REG));
+
+    ReactionBase* r1 = C1->addInternal<Reaction,1,2>({ADiff1, BDiff1, CDiff1}, 100.0);
+    ReactionBase* r2 = C2->addInternal<Reaction,1,1>({ADiff2, BDiff1}, 10.0);
+
+    ///Rebind, species not in the container are kept
+    CHECK(r1->rebindSpecies(C2->getSpeciesContainer()));
+    CHECK(r1->containsSpecies(ADiff2));
+    CHECK(!r1->containsSpecies(ADiff1));
+    CHECK(r1->containsSpecies(BDiff1));
+    CHECK(r1->containsSpecies(CDiff1));
+    r1->activateReaction();
+    CHECK(Approx(20 * 100.0) == r1->computePropensity());
+
+    ///The reactant lists of the species are updated
+    CHECK(ADiff1->getRSpecies().reactantReactions().empty());
+    CHECK(1 == ADiff2->getRSpecies().reactantReactions().size());
+
+    ///Dependents found from the new species
+    r2->activateReaction();
+    r1->setDependentReactions();
+    CHECK(r1->dependents().contains(r2));
+
+    ///Nothing to replace
+    CHECK(!r1->rebindSpecies(C2->getSpeciesContainer()));
+}
+
+TEST_CASE("Reaction unbinding HRCDIDs", "[Reaction]") {
+    const Index onId = hrcdidNames().id("TestLinkerBinding");
+    registerHRCDIDOff(onId);
+    CHECK(hrcdidNames().name(hrcdidOff(onId)) == "TestLinkerBindingoff");
+    // Registering again keeps the same id.
+    const Index offId = hrcdidOff(onId);
+    registerHRCDIDOff(onId);
+    CHECK(hrcdidOff(onId) == offId);
+}
+
 } // namespace medyan
@@ -0,0 +1,231 @@
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "Mechanics/ForceField/ForceFieldManager.h"
+#include "Mechanics/ForceField/Hessian.hpp"
+#include "TESTS/Mechanics/ForceField/TestFFCommon.hpp"
+#include "Util/ThreadPool.hpp"
+
+using namespace medyan::test_ff_common;
+
+namespace medyan {
+namespace {
+
+// Harmonic springs between pairs of beads.
+struct TestPairSpringFF : ForceField {
+    std::vector< std::array< int, 2 >> pairs;
+    floatingpoint k = 1.0;
+    bool ranged = true;
+
+    virtual std::string getName() override { return "TestPairSpring"; }
+
+    virtual floatingpoint computeEnergy(floatingpoint* coord) override {
+        return computeEnergyRange(coord, 0, pairs.size());
+    }
+    virtual void computeForces(floatingpoint* coord, floatingpoint* f) override {
+        computeForcesRange(coord, f, 0, pairs.size());
+    }
+
+    virtual Size numRangedInteractions() const override { return ranged ? pairs.size() : 0; }
+    virtual floatingpoint computeEnergyRange(floatingpoint* coord, Index begin, Index end) override {
+        floatingpoint en = 0;
+        for(Index i = begin; i < end; ++i) {
+            const auto d = makeRefVec<3>(coord + pairs[i][1]) - makeRefVec<3>(coord + pairs[i][0]);
+            en += k * magnitude2(d) / 2;
+        }
+        return en;
+    }
+    virtual void computeForcesRange(floatingpoint* coord, floatingpoint* f, Index begin, Index end) override {
+        for(Index i = begin; i < end; ++i) {
+            const auto d = makeRefVec<3>(coord + pairs[i][1]) - makeRefVec<3>(coord + pairs[i][0]);
+            makeRefVec<3>(f + pairs[i][0]) += k * d;
+            makeRefVec<3>(f + pairs[i][1]) -= k * d;
+        }
+    }
+};
+
+// Harmonic bonds with nonzero equilibrium lengths between pairs of beads.
+struct TestBondFF : ForceField {
+    std::vector< std::array< int, 2 >> pairs;
+    floatingpoint k = 1.0;
+    floatingpoint eql = 1.0;
+    bool analytic = true;
+
+    virtual std::string getName() override { return "TestBond"; }
+
+    virtual floatingpoint computeEnergy(floatingpoint* coord) override {
+        floatingpoint en = 0;
+        for(auto& p : pairs) {
+            const auto d = magnitude(makeRefVec<3>(coord + p[1]) - makeRefVec<3>(coord + p[0])) - eql;
+            en += k * d * d / 2;
+        }
+        return en;
+    }
+    virtual void computeForces(floatingpoint* coord, floatingpoint* f) override {
+        for(auto& p : pairs) {
+            const auto r = makeRefVec<3>(coord + p[1]) - makeRefVec<3>(coord + p[0]);
+            const auto dist = magnitude(r);
+            const auto fr = k * (dist - eql) / dist * r;
+            makeRefVec<3>(f + p[0]) += fr;
+            makeRefVec<3>(f + p[1]) -= fr;
+        }
+    }
+    virtual bool addHessian(const floatingpoint* coord, std::vector< Eigen::Triplet<double> >& triplets) const override {
+        if(!analytic) return false;
+        for(auto& p : pairs) {
+            addHarmonicBondHessian<2>(triplets, coord, p, { -1.0, 1.0 }, k, eql);
+        }
+        return true;
+    }
+};
+
+} // namespace
+
+TEST_CASE("Force field manager: parallel evaluation", "[ForceField]") {
+    using namespace std;
+
+    SubSystem sys;
+    ForceFieldManager ffm(&sys);
+
+    const int numBeads = 2000;
+    const int numPairs = 10000;
+    vector< floatingpoint > coord(3 * numBeads);
+    fillNormalRand(coord, (floatingpoint)0.0, (floatingpoint)10.0);
+
+    // Add force fields, some of which can only be evaluated as a whole.
+    uniform_int_distribution< int > bd(0, numBeads - 1);
+    for(int ffi = 0; ffi < 5; ++ffi) {
+        auto pff = make_unique< TestPairSpringFF >();
+        pff->k = 0.5 + ffi;
+        pff->ranged = ffi % 2 == 0;
+        for(int i = 0; i < numPairs; ++i) {
+            pff->pairs.push_back({ 3 * bd(Rand::eng), 3 * bd(Rand::eng) });
+        }
+        ffm.forceFields.push_back(move(pff));
+    }
+    ffm.minInteractionsPerPart = 100;
+
+    const auto computeAll = [&] {
+        vector< floatingpoint > force(coord.size());
+        const auto energy = ffm.computeEnergy(coord.data());
+        ffm.computeForces(coord.data(), force.data(), force.size());
+        return make_pair(energy, force);
+    };
+
+    ffm.setNumThreads(1);
+    const auto [energySerial, forceSerial] = computeAll();
+
+    ThreadPool::resetGlobal(2);
+
+    for(int numThreads : { 2, 3, 8 }) {
+        ffm.setNumThreads(numThreads);
+        REQUIRE(ffm.getNumThreads() == numThreads);
+
+        const auto [energyParallel, forceParallel] = computeAll();
+        CHECK(energyParallel == Approx(energySerial).epsilon(1e-5));
+        for(int i = 0; i < coord.size(); ++i) {
+            REQUIRE(forceParallel[i] == Approx(forceSerial[i]).epsilon(1e-5).margin(1e-5));
+        }
+
+        // Results are reproducible with the same number of threads.
+        const auto [energyRepeat, forceRepeat] = computeAll();
+        CHECK(energyRepeat == energyParallel);
+        CHECK(forceRepeat == forceParallel);
+    }
+
+    ThreadPool::resetGlobal(0);
+}
+
+TEST_CASE("Force field manager: Hessian", "[ForceField]") {
+    using namespace std;
+
+    SubSystem sys;
+    ForceFieldManager ffm(&sys);
+
+    const int numBeads = 40;
+    const int numPairs = 80;
+    const int ndof = 3 * numBeads;
+    vector< floatingpoint > coord(ndof);
+    fillNormalRand(coord, (floatingpoint)0.0, (floatingpoint)3.0);
+
+    uniform_int_distribution< int > bd(0, numBeads - 1);
+    vector< TestBondFF* > bondFFs;
+    for(int ffi = 0; ffi < 2; ++ffi) {
+        auto pff = make_unique< TestBondFF >();
+        pff->k = 1.0 + ffi;
+        pff->eql = 2.0 + ffi;
+        for(int i = 0; i < numPairs; ++i) {
+            const int b0 = bd(Rand::eng);
+            const int b1 = (b0 + 1 + bd(Rand::eng) % (numBeads - 1)) % numBeads;
+            pff->pairs.push_back({ 3 * b0, 3 * b1 });
+        }
+        bondFFs.push_back(pff.get());
+        ffm.forceFields.push_back(move(pff));
+    }
+    // Only the first force field provides the analytic Hessian.
+    bondFFs[1]->analytic = false;
+
+    const floatingpoint delta = 1e-4;
+    ForceFieldManager::HessianOperator hessOp(ffm, coord, ndof, delta);
+    REQUIRE(hessOp.rows() == ndof);
+    REQUIRE(hessOp.numFiniteDifferenceForceFields() == 1);
+    REQUIRE(hessOp.isAssembled());
+    const Eigen::MatrixXd hess = hessOp.matrix();
+
+    SECTION("Analytic Hessian matches finite differences") {
+        bondFFs[0]->analytic = false;
+        ForceFieldManager::HessianOperator hessOpFd(ffm, coord, ndof, delta);
+        REQUIRE(hessOpFd.numFiniteDifferenceForceFields() == 2);
+        const Eigen::MatrixXd hessFd = hessOpFd.matrix();
+
+        for(int i = 0; i < ndof; ++i) {
+            for(int j = 0; j < ndof; ++j) {
+                REQUIRE(hess(i, j) == Approx(hessFd(i, j)).epsilon(1e-4).margin(1e-4));
+            }
+        }
+    }
+
+    SECTION("Assembled matrix is sparse and symmetric") {
+        const auto& hessSparse = hessOp.matrix();
+        // Each bond couples 6 coordinates, so there are at most 36 entries per bond.
+        CHECK(hessSparse.nonZeros() <= 36 * 2 * numPairs);
+        for(int i = 0; i < ndof; ++i) {
+            for(int j = 0; j < i; ++j) {
+                REQUIRE(hess(i, j) == Approx(hess(j, i)));
+            }
+        }
+    }
+
+    SECTION("Matrix-free products match the assembled matrix") {
+        ForceFieldManager::HessianOperator hessOpFree(ffm, coord, ndof, delta, false);
+        REQUIRE_FALSE(hessOpFree.isAssembled());
+        REQUIRE(hessOpFree.numFiniteDifferenceForceFields() == 1);
+
+        vector< Eigen::VectorXd > xs, ys;
+        for(int rep = 0; rep < 3; ++rep) {
+            Eigen::VectorXd x(ndof), y(ndof);
+            fillNormalRand(x.data(), x.data() + ndof, 0.0, 1.0);
+            x.normalize();
+            hessOpFree.perform_op(x.data(), y.data());
+
+            const Eigen::VectorXd yExpected = hess * x;
+            for(int i = 0; i < ndof; ++i) {
+                REQUIRE(y(i) == Approx(yExpected(i)).epsilon(1e-4).margin(1e-4));
+            }
+            xs.push_back(x);
+            ys.push_back(y);
+        }
+
+        // The products are symmetric up to the finite difference error.
+        for(int i = 0; i < xs.size(); ++i) {
+            for(int j = 0; j < i; ++j) {
+                CHECK(xs[i].dot(ys[j]) == Approx(xs[j].dot(ys[i])).epsilon(1e-4).margin(1e-4));
+            }
+        }
+    }
+}
+
+} // namespace medyan
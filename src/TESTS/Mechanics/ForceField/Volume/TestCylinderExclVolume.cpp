@@ -1,3 +1,4 @@
+#include <chrono>
 #include <numeric> // iota
 #include <type_traits> // is_same
 #include <vector>
@@ -242,3 +243,143 @@ TEST_CASE("Force field: Cylinder excl volume", "[ForceField]") {
     }
 }
 
+
+namespace {
+
+// Random cylinders, each with its own 2 beads, and interactions between random pairs of cylinders.
+struct RandomCylinderExclVolInput {
+    std::vector<floatingpoint> coord;
+    std::vector<int>           beadSet;
+    std::vector<floatingpoint> k;
+    std::vector<floatingpoint> eqLength;
+
+    RandomCylinderExclVolInput(int numCylinders, int numInteractions, floatingpoint boxSize) {
+        using namespace medyan;
+        std::uniform_real_distribution< floatingpoint > pos(0, boxSize);
+        std::uniform_real_distribution< floatingpoint > len(20, 100);
+        std::uniform_int_distribution< int > cyl(0, numCylinders - 1);
+
+        for(int ci = 0; ci < numCylinders; ++ci) {
+            Vec< 3, floatingpoint > c0 { pos(Rand::eng), pos(Rand::eng), pos(Rand::eng) };
+            Vec< 3, floatingpoint > dir;
+            test_ff_common::fillNormalRand(dir.value.begin(), dir.value.end(), (floatingpoint)0, (floatingpoint)1);
+            const auto c1 = c0 + normalizedVector(dir) * len(Rand::eng);
+            coord.insert(coord.end(), c0.begin(), c0.end());
+            coord.insert(coord.end(), c1.begin(), c1.end());
+        }
+        for(int i = 0; i < numInteractions; ++i) {
+            int c1 = cyl(Rand::eng), c2 = cyl(Rand::eng);
+            while(c2 == c1) c2 = cyl(Rand::eng);
+            addInteraction(c1, c2);
+        }
+    }
+
+    void addInteraction(int c1, int c2) {
+        beadSet.insert(beadSet.end(), { 6 * c1, 6 * c1 + 3, 6 * c2, 6 * c2 + 3 });
+        k.push_back(medyan::Rand::randfloatingpoint(1, 100));
+        eqLength.insert(eqLength.end(), { (floatingpoint)108, medyan::Rand::randfloatingpoint(50, 108) });
+    }
+    int numInteractions() const { return k.size(); }
+};
+
+} // namespace
+
+TEST_CASE("Force field: Cylinder excl volume SIMD kernels", "[ForceField]") {
+    // The test case checks whether the SIMD kernels agree with the scalar kernel.
+
+    using namespace std;
+    using namespace medyan;
+    using Kernel = CylinderExclVolRepulsion::Kernel;
+
+    Rand::eng.seed(12345);
+
+    // 203 interactions, which are not a multiple of the batch sizes.
+    RandomCylinderExclVolInput input(50, 200, 200);
+
+    // Coplanar and parallel cylinders, which are handled by the scalar kernel.
+    const int ci = input.coord.size() / 6;
+    input.coord.insert(input.coord.end(), {
+        0, 0, 0,    50, 0, 0,
+        10, 10, 0,  30, 40, 0,
+        0, 20, 20,  50, 20, 20,
+    });
+    input.addInteraction(ci, ci + 1);
+    input.addInteraction(ci, ci + 2);
+    input.addInteraction(ci + 1, 0);
+
+    CylinderExclVolRepulsion ref;
+    ref.kernel = Kernel::scalar;
+    auto coordRef = input.coord;
+    const auto energyRef = ref.energy(coordRef.data(), input.beadSet.data(), input.k.data(), input.eqLength.data(), input.numInteractions(), false);
+    vector<floatingpoint> forceRef(input.coord.size());
+    ref.forces(coordRef.data(), forceRef.data(), input.beadSet.data(), input.k.data(), input.eqLength.data(), input.numInteractions());
+    REQUIRE(energyRef > 0);
+
+    floatingpoint maxForceRef = 0;
+    for(auto x : forceRef) maxForceRef = max(maxForceRef, abs(x));
+
+    // The analytical formula loses precision for distant cylinders, so rounding differences are amplified.
+    const floatingpoint relEps = is_same< floatingpoint, float >::value ? 1e-3 : 1e-7;
+
+    for(auto kernel : { Kernel::avx2, Kernel::avx512 }) {
+        if(!CylinderExclVolRepulsion::isKernelSupported(kernel)) {
+            WARN("SIMD kernel " << (int)kernel << " is not supported on this CPU.");
+            continue;
+        }
+        INFO("SIMD kernel " << (int)kernel);
+
+        CylinderExclVolRepulsion simd;
+        simd.kernel = kernel;
+        auto coord = input.coord;
+
+        // Energies of every 8 interactions, which fill the SIMD lanes.
+        for(int i = 0; i + 8 <= input.numInteractions(); i += 8) {
+            const auto energyI    = simd.energy(coord.data(), input.beadSet.data() + 4 * i, input.k.data() + i, input.eqLength.data() + 2 * i, 8, false);
+            const auto energyIRef = ref.energy(coordRef.data(), input.beadSet.data() + 4 * i, input.k.data() + i, input.eqLength.data() + 2 * i, 8, false);
+            INFO("Interactions from " << i);
+            CHECK(energyI == Approx(energyIRef).epsilon(relEps));
+        }
+
+        // Total energy and forces.
+        const auto energy = simd.energy(coord.data(), input.beadSet.data(), input.k.data(), input.eqLength.data(), input.numInteractions(), false);
+        CHECK(energy == Approx(energyRef).epsilon(relEps));
+
+        vector<floatingpoint> force(input.coord.size());
+        simd.forces(coord.data(), force.data(), input.beadSet.data(), input.k.data(), input.eqLength.data(), input.numInteractions());
+        for(int i = 0; i < force.size(); ++i) {
+            INFO("Force component " << i);
+            CHECK(abs(force[i] - forceRef[i]) <= relEps * maxForceRef);
+        }
+        CHECK(coord == input.coord);
+    }
+}
+
+TEST_CASE("Force field: Cylinder excl volume SIMD kernel benchmark", "[.][benchmark][ForceField]") {
+    using namespace std;
+    using namespace medyan;
+    using Kernel = CylinderExclVolRepulsion::Kernel;
+
+    Rand::eng.seed(12345);
+    RandomCylinderExclVolInput input(2000, 200000, 1000);
+    vector<floatingpoint> force(input.coord.size());
+
+    for(auto kernel : { Kernel::scalar, Kernel::avx2, Kernel::avx512 }) {
+        if(!CylinderExclVolRepulsion::isKernelSupported(kernel)) continue;
+
+        CylinderExclVolRepulsion ff;
+        ff.kernel = kernel;
+
+        auto start = chrono::steady_clock::now();
+        const auto energy = ff.energy(input.coord.data(), input.beadSet.data(), input.k.data(), input.eqLength.data(), input.numInteractions(), false);
+        const chrono::duration< double > elapsedEnergy = chrono::steady_clock::now() - start;
+
+        start = chrono::steady_clock::now();
+        ff.forces(input.coord.data(), force.data(), input.beadSet.data(), input.k.data(), input.eqLength.data(), input.numInteractions());
+        const chrono::duration< double > elapsedForces = chrono::steady_clock::now() - start;
+
+        log::info(
+            "Kernel {}, {} interactions: energy {} in {:.3g} s, forces in {:.3g} s",
+            (int)kernel, input.numInteractions(), energy, elapsedEnergy.count(), elapsedForces.count()
+        );
+    }
+}
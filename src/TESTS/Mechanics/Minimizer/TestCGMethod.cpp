@@ -1,5 +1,7 @@
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <cmath>
 #include <string>
 
 #include <catch2/catch.hpp>
@@ -89,5 +91,155 @@ TEST_CASE("Conjugate gradient minimizer", "[Minimizer]") {
     problemHarmonic10(cgMethod, ConjugateGradientDescentSearch::steepest,       "steepest");
     problemHarmonic10(cgMethod, ConjugateGradientDescentSearch::fletcherRieves, "fletcher_rieves");
     problemHarmonic10(cgMethod, ConjugateGradientDescentSearch::polakRibiere,   "polak_ribiere");
+    problemHarmonic10(cgMethod, ConjugateGradientDescentSearch::lbfgs,          "lbfgs");
+    problemHarmonic10(cgMethod, ConjugateGradientDescentSearch::fire,           "fire");
 
 }
+
+namespace {
+
+// A stiff bead-spring chain with weak bending, with the first bead tethered to the origin.
+struct StiffChainProblem {
+    int           numBeads = 100;
+    floatingpoint kStretch = 1000;
+    floatingpoint kBend    = 1;
+    floatingpoint kTether  = 10;
+    floatingpoint eqLength = 1;
+
+    floatingpoint energy(const floatingpoint* coord) const {
+        floatingpoint en = 0;
+        for(int i = 0; i < numBeads - 1; ++i) {
+            floatingpoint d2 = 0;
+            for(int dim = 0; dim < 3; ++dim) {
+                const auto d = coord[3 * (i + 1) + dim] - coord[3 * i + dim];
+                d2 += d * d;
+            }
+            const auto dl = std::sqrt(d2) - eqLength;
+            en += 0.5 * kStretch * dl * dl;
+        }
+        for(int i = 1; i < numBeads - 1; ++i) {
+            for(int dim = 0; dim < 3; ++dim) {
+                const auto c = coord[3 * (i + 1) + dim] - 2 * coord[3 * i + dim] + coord[3 * (i - 1) + dim];
+                en += 0.5 * kBend * c * c;
+            }
+        }
+        for(int dim = 0; dim < 3; ++dim) {
+            en += 0.5 * kTether * coord[dim] * coord[dim];
+        }
+        return en;
+    }
+    void force(const floatingpoint* coord, floatingpoint* f) const {
+        std::fill(f, f + 3 * numBeads, 0);
+        for(int i = 0; i < numBeads - 1; ++i) {
+            floatingpoint d[3];
+            floatingpoint d2 = 0;
+            for(int dim = 0; dim < 3; ++dim) {
+                d[dim] = coord[3 * (i + 1) + dim] - coord[3 * i + dim];
+                d2 += d[dim] * d[dim];
+            }
+            const auto l = std::sqrt(d2);
+            const auto fmag = kStretch * (l - eqLength) / l;
+            for(int dim = 0; dim < 3; ++dim) {
+                f[3 * i + dim]       += fmag * d[dim];
+                f[3 * (i + 1) + dim] -= fmag * d[dim];
+            }
+        }
+        for(int i = 1; i < numBeads - 1; ++i) {
+            for(int dim = 0; dim < 3; ++dim) {
+                const auto c = coord[3 * (i + 1) + dim] - 2 * coord[3 * i + dim] + coord[3 * (i - 1) + dim];
+                f[3 * (i - 1) + dim] -= kBend * c;
+                f[3 * i + dim]       += 2 * kBend * c;
+                f[3 * (i + 1) + dim] -= kBend * c;
+            }
+        }
+        for(int dim = 0; dim < 3; ++dim) {
+            f[dim] -= kTether * coord[dim];
+        }
+    }
+
+    // A slightly bent and compressed chain.
+    std::vector< floatingpoint > initCoord() const {
+        std::vector< floatingpoint > coord(3 * numBeads);
+        for(int i = 0; i < numBeads; ++i) {
+            coord[3 * i]     = 0.9 * i;
+            coord[3 * i + 1] = 2 * std::sin(0.1 * i);
+            coord[3 * i + 2] = 0.5 * std::cos(0.23 * i);
+        }
+        return coord;
+    }
+};
+
+struct MinimizationRunStats {
+    medyan::MinimizationResult result;
+    double                     seconds = 0;
+};
+
+inline MinimizationRunStats minimizeStiffChain(const StiffChainProblem& problem, medyan::ConjugateGradientDescentSearch descentSearchMethod) {
+    using namespace std;
+    using namespace medyan;
+
+    ConjugateGradientParams cgParams;
+    cgParams.descentSearchMethod = descentSearchMethod;
+    cgParams.gradTol = 0.01;
+    cgParams.energyRelTol = 0;
+    cgParams.maxDist = 1;
+    cgParams.lambdaMax = 0.01;
+    cgParams.forceCallLimit = 100000;
+    cgParams.tryToRecoverInLineSearchError = false;
+
+    CGMethod cg;
+    auto coord = problem.initCoord();
+    vector< floatingpoint > force;
+
+    MinimizationRunStats stats;
+    const auto tbegin = chrono::steady_clock::now();
+    stats.result = cg.minimize(
+        cgParams,
+        coord, coord.size(),
+        [&](const floatingpoint* c) { return problem.energy(c); },
+        [&](const floatingpoint* c, floatingpoint* f, int) { problem.force(c, f); },
+        [&](const floatingpoint* c) { EnergyReport res; res.total = problem.energy(c); return res; },
+        [](std::vector<floatingpoint>&, const std::vector<floatingpoint>&) {},
+        &force
+    );
+    stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - tbegin).count();
+    return stats;
+}
+
+} // namespace
+
+TEST_CASE("Minimizers on a stiff chain", "[Minimizer]") {
+    using namespace medyan;
+
+    StiffChainProblem problem;
+    problem.numBeads = 30;
+
+    for(auto method : { ConjugateGradientDescentSearch::polakRibiere, ConjugateGradientDescentSearch::lbfgs, ConjugateGradientDescentSearch::fire }) {
+        INFO("Descent search method " << underlying(method));
+        const auto stats = minimizeStiffChain(problem, method);
+        REQUIRE(stats.result.success());
+        CHECK(stats.result.gradInfNormConverged());
+        CHECK(stats.result.energiesAfter.total <= stats.result.energiesBefore.total);
+    }
+}
+
+// Benchmark of force calls and wall time. Run explicitly with the "[benchmark]" tag.
+TEST_CASE("Minimizer benchmark on a stiff chain", "[.][benchmark][Minimizer]") {
+    using namespace medyan;
+
+    StiffChainProblem problem;
+
+    const std::pair< ConjugateGradientDescentSearch, const char* > methods[] {
+        { ConjugateGradientDescentSearch::polakRibiere, "polak_ribiere" },
+        { ConjugateGradientDescentSearch::lbfgs,        "lbfgs" },
+        { ConjugateGradientDescentSearch::fire,         "fire" },
+    };
+    for(auto [method, name] : methods) {
+        const auto stats = minimizeStiffChain(problem, method);
+        log::info(
+            "{:>14}: converged={} force_calls={} energy_calls={} max_force={} time={}s",
+            name, stats.result.converged(), stats.result.numForceCall, stats.result.numEnergyCall, stats.result.gradInfNorm, stats.seconds
+        );
+        CHECK(stats.result.success());
+    }
+}
@@ -1,6 +1,12 @@
+#include <chrono>
+#include <random>
+
 #include <catch2/catch.hpp>
 
+#include "Structure/SubSystemFunc.hpp"
 #include "Structure/SurfaceMesh/FuncMembraneGeo.hpp"
+#include "Structure/SurfaceMesh/SurfaceMeshGenerator.hpp"
+#include "Util/Io/Log.hpp"
 
 namespace medyan {
 
@@ -31,4 +37,119 @@ TEST_CASE("Membrane geometry functions", "[Mesh]") {
     }
 }
 
+namespace {
+
+// Adds a closed spherical membrane of radius 8 centered at the origin.
+// Smaller cube sizes result in finer meshes.
+auto addSphereMembrane(SubSystem& sys, double cubeSize) {
+    const auto numCubes = static_cast< std::size_t >(20 / cubeSize);
+    const auto mesh = mesh_gen::MarchingTetrahedraGenerator<>(cubeSize, { -10.0, -10.0, -10.0 }, { numCubes, numCubes, numCubes })(
+        [](const auto& p) { return p[0] * p[0] + p[1] * p[1] + p[2] * p[2] - 8 * 8; }
+    );
+    std::vector< Membrane::CoordinateType > coords;
+    for(auto& c : mesh.vertexCoordinateList) coords.push_back(static_cast< Membrane::CoordinateType >(c));
+    return SubSystemFunc{}.emplaceTrackable<Membrane>(sys, MembraneSetup{}, coords, mesh.triangleList);
+}
+
+std::vector< Vec3d > randomPoints(int n, double range) {
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution< double > ud(-range, range);
+    std::vector< Vec3d > res(n);
+    for(auto& p : res) p = Vec3d { ud(rng), ud(rng), ud(rng) };
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("Membrane signed distance", "[Mesh]") {
+    SubSystem sys;
+    ScopeGuard clearMembranesGuard { [&] {
+        for(auto it = sys.membranes.begin(); it != sys.membranes.end(); ++it) {
+            SubSystemFunc{}.removeTrackable<Membrane>(sys, sys.membranes.indexat(it));
+        }
+    } };
+
+    auto& mesh = sys.membranes.at(addSphereMembrane(sys, 1.0)).getMesh();
+    REQUIRE(mesh.isClosed());
+    REQUIRE(mesh.metaAttribute().triangleTreeValid);
+    REQUIRE(mesh.metaAttribute().triangleTree.numPrimitives() == mesh.getTriangles().size());
+
+    const auto points = randomPoints(500, 12.0);
+
+    // Reference values are computed without the triangle tree.
+    const auto bruteForce = [&](const Vec3d& p) {
+        mesh.metaAttribute().triangleTreeValid = false;
+        const auto res = signedDistance(sys, mesh, p);
+        mesh.metaAttribute().triangleTreeValid = true;
+        return res;
+    };
+
+    SECTION("Signed distance matches checking all triangles") {
+        for(auto& p : points) {
+            const auto d = signedDistance(sys, mesh, p);
+            CHECK(d == Approx(bruteForce(p)).margin(1e-9));
+            // The mesh is close to the sphere.
+            CHECK(d == Approx(magnitude(p) - 8).margin(0.2));
+        }
+        CHECK(contains(sys, mesh, Vec3d { 0.0, 0.0, 0.0 }));
+        CHECK_FALSE(contains(sys, mesh, Vec3d { 9.0, 0.0, 0.0 }));
+    }
+
+    SECTION("Batched query") {
+        const auto ds = signedDistance(sys, mesh, points);
+        REQUIRE(ds.size() == points.size());
+        for(Index i = 0; i < points.size(); ++i) {
+            CHECK(ds[i] == signedDistance(sys, mesh, points[i]));
+        }
+    }
+
+    SECTION("Tree is refitted when geometry is updated") {
+        // Inflate the sphere.
+        for(auto& v : mesh.getVertices()) v.attr.vertex(sys).coord *= 1.1;
+        updateGeometryValueForSystem(sys, mesh);
+        for(auto& p : points) {
+            CHECK(signedDistance(sys, mesh, p) == Approx(bruteForce(p)).margin(1e-9));
+        }
+        CHECK(contains(sys, mesh, Vec3d { 8.5, 0.0, 0.0 }));
+    }
+}
+
+// Timings of signed distance queries on a fine mesh. Run explicitly with the "[benchmark]" tag.
+TEST_CASE("Membrane signed distance benchmark", "[.][benchmark][Mesh]") {
+    SubSystem sys;
+    ScopeGuard clearMembranesGuard { [&] {
+        for(auto it = sys.membranes.begin(); it != sys.membranes.end(); ++it) {
+            SubSystemFunc{}.removeTrackable<Membrane>(sys, sys.membranes.indexat(it));
+        }
+    } };
+
+    auto& mesh = sys.membranes.at(addSphereMembrane(sys, 0.3)).getMesh();
+    const auto points = randomPoints(2000, 12.0);
+
+    auto start = std::chrono::steady_clock::now();
+    updateTriangleTree(sys, mesh);
+    const std::chrono::duration< double > elapsedRefit = std::chrono::steady_clock::now() - start;
+
+    double sumTree = 0, sumBruteForce = 0;
+    start = std::chrono::steady_clock::now();
+    for(auto& p : points) sumTree += signedDistance(sys, mesh, p);
+    const std::chrono::duration< double > elapsedTree = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    const auto ds = signedDistance(sys, mesh, points);
+    const std::chrono::duration< double > elapsedBatch = std::chrono::steady_clock::now() - start;
+
+    mesh.metaAttribute().triangleTreeValid = false;
+    start = std::chrono::steady_clock::now();
+    for(auto& p : points) sumBruteForce += signedDistance(sys, mesh, p);
+    const std::chrono::duration< double > elapsedBruteForce = std::chrono::steady_clock::now() - start;
+
+    CHECK(sumTree == Approx(sumBruteForce));
+    log::info(
+        "{} triangles, {} points: refit {:.3g} s, tree {:.3g} s, batched {:.3g} s, all triangles {:.3g} s",
+        mesh.getTriangles().size(), points.size(),
+        elapsedRefit.count(), elapsedTree.count(), elapsedBatch.count(), elapsedBruteForce.count()
+    );
+}
+
 } // namespace medyan
@@ -5,6 +5,15 @@
 
 namespace medyan {
 
+namespace {
+
+struct DummyBeadParent : Composite {
+    void printSelf() const override {}
+    int getType() override { return 0; }
+};
+
+} // namespace
+
 TEST_CASE("DOF serialization", "[DofSerializer]") {
     // Initialize a system to be serialized.
     SubSystem sys;
@@ -76,6 +85,54 @@ TEST_CASE("DOF serialization", "[DofSerializer]") {
         updateVertexPinning(sys);
         REQUIRE(countPinned() == 40);
     }
+
+    SECTION("Beads are serialized in place") {
+        addMembraneSheet();
+        const auto& vertex0 = sys.vertices[0];
+        auto& beadData = Bead::getBeadData();
+
+        DummyBeadParent parent;
+        std::vector< Bead* > beads;
+        for(int i = 0; i < 5; ++i) {
+            beads.push_back(new Bead(&parent, i));
+            beads.back()->coordinate() = Vec< 3, floatingpoint > { 1.0 * i, 2.0, 3.0 };
+        }
+
+        // Removing a bead moves the data of the last bead.
+        parent.removeChild(beads[1]);
+        beads.erase(beads.begin() + 1);
+        REQUIRE(Bead::numBeads() == 4);
+        REQUIRE(beadData.numBeads == 4);
+        CHECK(beads[3]->getIndex() == 1);
+        CHECK(beads[3]->coordinate()[0] == 4.0);
+
+        const auto si = serializeDof(sys);
+        REQUIRE(si.bead == 0);
+        REQUIRE(si.movableVertex == 3 * 4);
+        REQUIRE(si.ndof == 3 * (4 + 49));
+        REQUIRE(beadData.coords.size() == si.ndof);
+        for(auto pb : beads) {
+            CHECK(beadData.coords.data() + findBeadCoordIndex(*pb, si) == pb->coordinate().data());
+        }
+
+        // Changes by the minimizer apply directly to beads, and other degrees of freedom are copied back.
+        const auto vertex0Coord = vertex0.coord;
+        beadData.forces.assign(si.ndof, 1.0);
+        for(auto& x : beadData.coords) x += 1.0;
+        deserializeDof(sys);
+        CHECK(beads[0]->coordinate()[0] == 1.0);
+        CHECK(beads[3]->coordinate()[0] == 5.0);
+        CHECK(beads[2]->force()[2] == 1.0);
+        CHECK(vertex0.coord[0] == vertex0Coord[0] + 1.0);
+        CHECK(vertex0.force[1] == 1.0);
+
+        // Adding a bead discards the data of other degrees of freedom.
+        auto pb = new Bead(&parent, 5);
+        CHECK(beadData.coords.size() == 3 * 5);
+        CHECK(beadData.forces.size() == 3 * 5);
+        CHECK(pb->force()[0] == 0.0);
+        CHECK(beads[3]->coordinate()[0] == 5.0);
+    }
 }
 
 } // namespace medyan
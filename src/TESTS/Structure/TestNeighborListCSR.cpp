@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "Rand.h"
+#include "Structure/NeighborListCSR.hpp"
+#include "Structure/NeighborListImpl.h"
+#include "Util/ThreadPool.hpp"
+
+namespace medyan {
+
+namespace {
+
+struct TestPoint {
+    Index index = 0;
+    Eigen::Vector3d coord;
+
+    // Incremented whenever any index is changed.
+    inline static std::size_t numIndexChanges = 0;
+};
+
+struct TestPointRowIndex {
+    Index operator()(const TestPoint* p) const { return p->index; }
+    auto version() const { return TestPoint::numIndexChanges; }
+};
+
+using TestNeighborList = NeighborListCSR< TestPoint*, TestPoint*, TestPointRowIndex >;
+using ReferenceList    = std::unordered_map< TestPoint*, std::vector< TestPoint* > >;
+
+std::vector< TestPoint > makeRandomPoints(int numPoints, floatingpoint boxSize) {
+    std::vector< TestPoint > res(numPoints);
+    for(int i = 0; i < numPoints; ++i) {
+        res[i].index = i;
+        for(int d = 0; d < 3; ++d) res[i].coord[d] = Rand::randfloatingpoint(0, boxSize);
+    }
+    return res;
+}
+
+// Find neighbors with smaller indices using a cell list.
+// The initial indices of the points are their positions in the vector.
+struct HalfListFinder {
+    std::vector< TestPoint >& points;
+    floatingpoint             cutoff;
+    NeighborListCellList3D    cellList;
+    std::vector< int >        cellOfPoint;
+
+    HalfListFinder(std::vector< TestPoint >& points, floatingpoint cutoff, floatingpoint boxSize) :
+        points(points), cutoff(cutoff)
+    {
+        cellList.init(cutoff, Eigen::Vector3d(boxSize, boxSize, boxSize));
+        cellOfPoint.reserve(points.size());
+        for(int i = 0; i < points.size(); ++i) {
+            cellList.add(i, points[i].coord);
+            cellOfPoint.push_back(cellList.resolveCellIndex(points[i].coord));
+        }
+    }
+
+    void operator()(TestPoint* p, std::vector< TestPoint* >& output) const {
+        const auto pi = p - points.data();
+        const auto oldSize = output.size();
+        cellList.forEachNeighbor<false>(cellOfPoint[pi], [&](int ci) {
+            for(auto pj : cellList.list.getElements(ci)) {
+                if(pj < pi && (points[pj].coord - p->coord).norm() < cutoff) {
+                    output.push_back(&points[pj]);
+                }
+            }
+        });
+        // Sort the neighbors by their indices.
+        std::sort(output.begin() + oldSize, output.end());
+    }
+};
+
+std::vector< TestPoint* > pointersOf(std::vector< TestPoint >& points) {
+    std::vector< TestPoint* > res;
+    for(auto& p : points) res.push_back(&p);
+    return res;
+}
+
+void checkSameList(const TestNeighborList& list, const ReferenceList& ref) {
+    Size numNeighbors = 0;
+    for(auto& [key, neighbors] : ref) {
+        INFO("Key index " << key->index);
+        REQUIRE(list.hasRow(key));
+        const auto view = list.getNeighbors(key);
+        CHECK(std::vector< TestPoint* >(view.begin(), view.end()) == neighbors);
+        numNeighbors += neighbors.size();
+    }
+    CHECK(list.numNeighbors() == numNeighbors);
+
+    Size numRows = 0;
+    list.forEachRow([&](TestPoint*, TestNeighborList::SpanType) { ++numRows; });
+    CHECK(numRows == ref.size());
+}
+
+} // namespace
+
+TEST_CASE("CSR neighbor list tests", "[NeighborList]") {
+    Rand::eng.seed(12345);
+
+    const floatingpoint boxSize = 10;
+    const floatingpoint cutoff  = 1.5;
+    auto points = makeRandomPoints(500, boxSize);
+    const auto keys = pointersOf(points);
+    HalfListFinder finder(points, cutoff, boxSize);
+
+    // Reference list using brute force.
+    ReferenceList ref;
+    for(auto p : keys) {
+        auto& neighbors = ref[p];
+        for(int j = 0; j < p->index; ++j) {
+            if((points[j].coord - p->coord).norm() < cutoff) neighbors.push_back(&points[j]);
+        }
+    }
+
+    TestNeighborList list;
+    list.build(keys, finder);
+
+    SECTION("Build and lookup") {
+        checkSameList(list, ref);
+        CHECK(list.numRows() == points.size());
+
+        // Keys without rows.
+        TestPoint outside { 1000 };
+        CHECK_FALSE(list.hasRow(&outside));
+        CHECK(list.getNeighbors(&outside).empty());
+    }
+
+    SECTION("Parallel build gives the same list") {
+        ThreadPool::resetGlobal(2);
+
+        TestNeighborList listParallel, listFull;
+        TestNeighborList::buildAll({ &listParallel, &listFull }, keys, [&](TestPoint* p, std::vector< TestPoint* >* const* outputs) {
+            finder(p, *outputs[0]);
+            // The second list also contains the point itself.
+            finder(p, *outputs[1]);
+            outputs[1]->push_back(p);
+        });
+        checkSameList(listParallel, ref);
+
+        auto refFull = ref;
+        for(auto& [key, neighbors] : refFull) neighbors.push_back(key);
+        checkSameList(listFull, refFull);
+
+        ThreadPool::resetGlobal(0);
+    }
+
+    SECTION("Runtime modification") {
+        // Grow a row in the middle, which relocates it.
+        auto p = keys[250];
+        for(int i = 0; i < 20; ++i) {
+            list.pushBack(p, keys[i]);
+            ref[p].push_back(keys[i]);
+        }
+        checkSameList(list, ref);
+
+        // Replace rows, both shrinking and growing.
+        list.assignRow(keys[10], std::vector< TestPoint* > { keys[1] });
+        ref[keys[10]] = { keys[1] };
+        list.assignRow(keys[11], std::vector< TestPoint* >(keys.begin(), keys.begin() + 11));
+        ref[keys[11]].assign(keys.begin(), keys.begin() + 11);
+        checkSameList(list, ref);
+
+        // Remove neighbors while preserving the order.
+        list.removeNeighbor(p, keys[5]);
+        ref[p].erase(std::find(ref[p].begin(), ref[p].end(), keys[5]));
+        list.removeNeighborInAllRows(keys[1]);
+        for(auto& [key, neighbors] : ref) {
+            auto it = std::find(neighbors.begin(), neighbors.end(), keys[1]);
+            if(it != neighbors.end()) neighbors.erase(it);
+        }
+        checkSameList(list, ref);
+
+        // Remove rows, and then add them back.
+        list.removeRow(keys[20]);
+        ref.erase(keys[20]);
+        checkSameList(list, ref);
+        CHECK_FALSE(list.hasRow(keys[20]));
+
+        list.pushBack(keys[20], keys[3]);
+        ref[keys[20]] = { keys[3] };
+        checkSameList(list, ref);
+
+        // Many relocations trigger compaction, which should keep the memory bounded.
+        for(int round = 0; round < 10; ++round) {
+            for(auto key : keys) {
+                list.pushBack(key, keys[round]);
+                ref[key].push_back(keys[round]);
+            }
+        }
+        checkSameList(list, ref);
+        CHECK(list.memoryUsage() < 4 * (list.numNeighbors() + 1024) * sizeof(TestPoint*) + 8 * list.numRows() * sizeof(Index));
+    }
+
+    SECTION("Rows are remapped after indices change") {
+        // Reverse the indices.
+        for(auto& point : points) point.index = points.size() - 1 - point.index;
+        ++TestPoint::numIndexChanges;
+        // Lookups are still valid before the rows are remapped.
+        CHECK_FALSE(list.rowIndicesUpdated());
+        checkSameList(list, ref);
+        CHECK_FALSE(list.rowIndicesUpdated());
+        list.updateRowIndices();
+        CHECK(list.rowIndicesUpdated());
+        checkSameList(list, ref);
+
+        // Remove some points and compress the indices.
+        for(int i = 0; i < 100; ++i) {
+            list.removeRow(keys[i]);
+            list.removeNeighborInAllRows(keys[i]);
+            ref.erase(keys[i]);
+            for(auto& [key, neighbors] : ref) {
+                neighbors.erase(std::remove(neighbors.begin(), neighbors.end(), keys[i]), neighbors.end());
+            }
+        }
+        for(int i = 100; i < points.size(); ++i) points[i].index = i - 100;
+        ++TestPoint::numIndexChanges;
+        checkSameList(list, ref);
+        list.updateRowIndices();
+        checkSameList(list, ref);
+        CHECK(list.numRows() == points.size() - 100);
+
+        list.pushBack(keys[100], keys[101]);
+        ref[keys[100]].push_back(keys[101]);
+        checkSameList(list, ref);
+    }
+}
+
+TEST_CASE("CSR neighbor list benchmark", "[.][benchmark][NeighborList]") {
+    using namespace std;
+
+    // About 20 neighbors in the half list of each point.
+    const floatingpoint cutoff = 1.0;
+    const floatingpoint density = 10.0;
+
+    for(int numPoints : { 10000, 100000, 1000000 }) {
+        const floatingpoint boxSize = cbrt(numPoints / density);
+        auto points = makeRandomPoints(numPoints, boxSize);
+        const auto keys = pointersOf(points);
+        HalfListFinder finder(points, cutoff, boxSize);
+
+        // Node based hash map of vectors.
+        ReferenceList mapList;
+        auto start = chrono::steady_clock::now();
+        for(auto p : keys) finder(p, mapList[p]);
+        const chrono::duration< double > elapsedMap = chrono::steady_clock::now() - start;
+
+        Size mapMemory = mapList.bucket_count() * sizeof(void*);
+        for(auto& [key, neighbors] : mapList) {
+            mapMemory += sizeof(void*) + sizeof(ReferenceList::value_type) + neighbors.capacity() * sizeof(TestPoint*);
+        }
+
+        // CSR, built in serial and in parallel.
+        const Size numNeighbors = accumulate(mapList.begin(), mapList.end(), Size(0), [](Size n, auto& kv) { return n + kv.second.size(); });
+        for(int numThreads : { 0, (int)thread::hardware_concurrency() }) {
+            ThreadPool::resetGlobal(numThreads);
+
+            TestNeighborList csrList;
+            start = chrono::steady_clock::now();
+            csrList.build(keys, finder);
+            const chrono::duration< double > elapsedCSR = chrono::steady_clock::now() - start;
+            CHECK(csrList.numNeighbors() == numNeighbors);
+
+            log::info(
+                "{} points, {} pairs: map {:.3g} s, {:.3g} MB; CSR ({} threads) {:.3g} s, {:.3g} MB",
+                numPoints, numNeighbors,
+                elapsedMap.count(), mapMemory / 1e6,
+                numThreads, elapsedCSR.count(), csrList.memoryUsage() / 1e6
+            );
+        }
+        ThreadPool::resetGlobal(0);
+    }
+}
+
+} // namespace medyan
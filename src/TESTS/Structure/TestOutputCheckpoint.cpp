@@ -0,0 +1,44 @@
+#include <filesystem>
+#include <string>
+
+#include "catch2/catch.hpp"
+
+#include "Structure/Output/OCheckpoint.hpp"
+
+namespace medyan {
+
+TEST_CASE("Restart checkpoint", "[Output]") {
+    using namespace std;
+
+    const auto filename = filesystem::temp_directory_path() / "medyan-test-checkpoint.h5";
+
+    Rand::eng.seed(42);
+    Rand::randInteger(0, 100);
+
+    OutputStructCheckpoint checkpoint;
+    extract(checkpoint, 12.5, "0 12.5\nNFIL NCYL NBEAD NLINK NMOTOR NBRANCH NBUBBLE\n0 0 0 0 0 0 0\n");
+
+    // Numbers drawn after the checkpoint.
+    vector< int > expected;
+    for(int i = 0; i < 10; ++i) expected.push_back(Rand::randInteger(0, 1000000));
+
+    writeCheckpoint(filename, checkpoint);
+    CHECK(filesystem::exists(filename));
+    CHECK_FALSE(filesystem::exists(filesystem::path(filename) += ".tmp"));
+
+    const auto restored = readCheckpoint(filename);
+    CHECK(restored.version == OutputStructCheckpoint::currentVersion);
+    CHECK(restored.simulationTime == checkpoint.simulationTime);
+    CHECK(restored.datadump == checkpoint.datadump);
+
+    // The random engine continues from the checkpoint.
+    Rand::eng.seed(0);
+    Rand::setEngState(restored.rngState);
+    for(int i = 0; i < 10; ++i) CHECK(Rand::randInteger(0, 1000000) == expected[i]);
+
+    CHECK_THROWS(Rand::setEngState("not an engine state"));
+
+    filesystem::remove(filename);
+}
+
+} // namespace medyan
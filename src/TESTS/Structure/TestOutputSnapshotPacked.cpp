@@ -0,0 +1,211 @@
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+#include "catch2/catch.hpp"
+
+#include "Structure/Output/OSnapshot.hpp"
+
+namespace medyan {
+
+namespace {
+
+// Make a snapshot with dummy data. Different frames have different numbers of elements.
+OutputStructSnapshot makeTestSnapshot(Index frame, int numFilaments = 3, int numBeadsPerFilament = 4) {
+    OutputStructSnapshot s(frame);
+    s.simulationTime = 0.5 * frame;
+    s.energies = { 1.0 * frame, 2.0, 3.0 };
+
+    for(int i = 0; i < numFilaments + frame % 2; ++i) {
+        auto& f = s.filamentStruct.emplace_back();
+        f.id = i;
+        f.type = i % 2;
+        f.numBeads = numBeadsPerFilament + i;
+        f.deltaMinusEnd = -i;
+        f.deltaPlusEnd = i;
+        f.rawCoords = Eigen::MatrixXd::Random(3, f.numBeads);
+    }
+
+    for(int i = 0; i < frame % 3; ++i) {
+        auto& l = s.linkerStruct.emplace_back();
+        l.id = i;
+        l.type = i == 0 ? "linker" : "motor";
+        l.subtype = 1;
+        l.rawCoords = Eigen::Matrix< double, 3, 2 >::Random();
+    }
+
+    {
+        auto& b = s.bubbleStruct.emplace_back();
+        b.id = 7;
+        b.type = 1;
+        b.coords = { 1.0, 2.0, 3.0 * frame };
+        b.radius = 10;
+    }
+
+    if(frame % 2 == 0) {
+        auto& m = s.membraneStruct.emplace_back();
+        m.type = 0;
+        m.numVertices = 4;
+        m.numTriangles = 2;
+        m.numBorders = 1;
+        m.vertexDataFloat64 = Eigen::MatrixXd::Random(6, m.numVertices);
+        m.vertexDataInt64 = Eigen::MatrixXi::Constant(1, m.numVertices, frame);
+        m.triangleDataInt64.resize(3, m.numTriangles);
+        m.triangleDataInt64 << 0, 1, 2, 1, 2, 3;
+        m.packedBorderVertices = { 3, 0, 1, 3 };
+    }
+
+    s.chemistry.globalSpeciesCopyNumbers = { 10, 20, Size(frame) };
+    s.chemistry.diffusingSpeciesCopyNumbers.resize(std::array< Size, 4 > { 2, 2, 1, 1 });
+    for(Index i = 0; i < 4; ++i) {
+        s.chemistry.diffusingSpeciesCopyNumbers.data()[i] = frame + i;
+    }
+
+    return s;
+}
+
+void checkSnapshotEqual(const OutputStructSnapshot& a, const OutputStructSnapshot& b) {
+    CHECK(a.snapshot == b.snapshot);
+    CHECK(a.simulationTime == b.simulationTime);
+    CHECK(a.energies == b.energies);
+
+    REQUIRE(a.filamentStruct.size() == b.filamentStruct.size());
+    for(Index i = 0; i < a.filamentStruct.size(); ++i) {
+        auto& fa = a.filamentStruct[i];
+        auto& fb = b.filamentStruct[i];
+        CHECK(fa.id == fb.id);
+        CHECK(fa.type == fb.type);
+        CHECK(fa.numBeads == fb.numBeads);
+        CHECK(fa.deltaMinusEnd == fb.deltaMinusEnd);
+        CHECK(fa.deltaPlusEnd == fb.deltaPlusEnd);
+        CHECK(fa.rawCoords == fb.rawCoords);
+    }
+
+    REQUIRE(a.linkerStruct.size() == b.linkerStruct.size());
+    for(Index i = 0; i < a.linkerStruct.size(); ++i) {
+        CHECK(a.linkerStruct[i].id == b.linkerStruct[i].id);
+        CHECK(a.linkerStruct[i].type == b.linkerStruct[i].type);
+        CHECK(a.linkerStruct[i].subtype == b.linkerStruct[i].subtype);
+        CHECK(a.linkerStruct[i].rawCoords == b.linkerStruct[i].rawCoords);
+    }
+
+    REQUIRE(a.bubbleStruct.size() == b.bubbleStruct.size());
+    for(Index i = 0; i < a.bubbleStruct.size(); ++i) {
+        CHECK(a.bubbleStruct[i].id == b.bubbleStruct[i].id);
+        CHECK(a.bubbleStruct[i].coords == b.bubbleStruct[i].coords);
+        CHECK(a.bubbleStruct[i].radius == b.bubbleStruct[i].radius);
+    }
+
+    REQUIRE(a.membraneStruct.size() == b.membraneStruct.size());
+    for(Index i = 0; i < a.membraneStruct.size(); ++i) {
+        auto& ma = a.membraneStruct[i];
+        auto& mb = b.membraneStruct[i];
+        CHECK(ma.numVertices == mb.numVertices);
+        CHECK(ma.numTriangles == mb.numTriangles);
+        CHECK(ma.numBorders == mb.numBorders);
+        CHECK(ma.vertexDataFloat64 == mb.vertexDataFloat64);
+        CHECK(ma.vertexDataInt64 == mb.vertexDataInt64);
+        CHECK(ma.triangleDataInt64 == mb.triangleDataInt64);
+        CHECK(ma.packedBorderVertices == mb.packedBorderVertices);
+    }
+
+    CHECK(a.chemistry.globalSpeciesCopyNumbers == b.chemistry.globalSpeciesCopyNumbers);
+    CHECK(a.chemistry.diffusingSpeciesCopyNumbers == b.chemistry.diffusingSpeciesCopyNumbers);
+}
+
+} // namespace
+
+TEST_CASE("Packed trajectory layout", "[Output]") {
+    using namespace std;
+
+    const auto filename = filesystem::temp_directory_path() / "medyan-test-packed-traj.h5";
+
+    for(auto compression : { TrajectoryCompression::none, TrajectoryCompression::gzip }) {
+        OutputParams params;
+        params.trajLayout = TrajectoryLayout::packed;
+        params.trajCompression = compression;
+
+        const Size numFrames = 6;
+        vector< OutputStructSnapshot > snapshots;
+        {
+            h5::File file(filename.string(), h5::File::ReadWrite | h5::File::Create | h5::File::Truncate);
+            auto grpHeader = file.createGroup("header");
+            h5::writeDataSet(grpHeader, "layout", toString(params.trajLayout));
+            auto grpFrames = file.createGroup("frames");
+            for(Index i = 0; i < numFrames; ++i) {
+                snapshots.push_back(makeTestSnapshot(i));
+                writePacked(grpFrames, snapshots.back(), params);
+            }
+        }
+
+        {
+            h5::File file(filename.string(), h5::File::ReadOnly);
+            REQUIRE(readTrajectoryLayout(file) == TrajectoryLayout::packed);
+            // Random access.
+            for(Index i : { 3, 0, 5, 2, 1, 4 }) {
+                OutputStructSnapshot s;
+                read(s, file, i);
+                checkSnapshotEqual(s, snapshots[i]);
+            }
+        }
+    }
+
+    filesystem::remove(filename);
+}
+
+TEST_CASE("Trajectory layout benchmark", "[.][benchmark][Output]") {
+    using namespace std;
+
+    const auto filename = filesystem::temp_directory_path() / "medyan-bench-traj.h5";
+    const Size numFrames = 2000;
+    const auto snapshot = makeTestSnapshot(0, 200, 20);
+
+    for(auto [layout, compression] : {
+        pair { TrajectoryLayout::group,  TrajectoryCompression::none },
+        pair { TrajectoryLayout::packed, TrajectoryCompression::none },
+        pair { TrajectoryLayout::packed, TrajectoryCompression::gzip },
+        pair { TrajectoryLayout::packed, TrajectoryCompression::szip },
+        pair { TrajectoryLayout::packed, TrajectoryCompression::lzf },
+    }) {
+        OutputParams params;
+        params.trajLayout = layout;
+        params.trajCompression = availableTrajCompression(compression);
+        if(params.trajCompression != compression) continue;
+
+        const auto start = chrono::steady_clock::now();
+        {
+            h5::File file(filename.string(), h5::File::ReadWrite | h5::File::Create | h5::File::Truncate);
+            auto grpHeader = file.createGroup("header");
+            h5::writeDataSet(grpHeader, "layout", toString(params.trajLayout));
+            auto grp = file.createGroup(layout == TrajectoryLayout::packed ? "frames" : "snapshots");
+            auto s = snapshot;
+            for(Index i = 0; i < numFrames; ++i) {
+                s.snapshot = i;
+                if(layout == TrajectoryLayout::packed) writePacked(grp, s, params);
+                else                                   write(grp, s);
+            }
+        }
+        const chrono::duration< double > elapsedWrite = chrono::steady_clock::now() - start;
+        const auto fileSize = filesystem::file_size(filename);
+
+        const auto startRead = chrono::steady_clock::now();
+        {
+            h5::File file(filename.string(), h5::File::ReadOnly);
+            OutputStructSnapshot s;
+            for(Index i = 0; i < numFrames; i += 97) {
+                read(s, file, i);
+            }
+        }
+        const chrono::duration< double > elapsedRead = chrono::steady_clock::now() - startRead;
+
+        WARN(
+            "Layout " << toString(layout) << ", compression " << toString(compression) << ": "
+            << numFrames << " frames, file size " << fileSize / 1e6 << " MB, "
+            << "write " << elapsedWrite.count() << " s, random read " << elapsedRead.count() << " s"
+        );
+    }
+
+    filesystem::remove(filename);
+}
+
+} // namespace medyan
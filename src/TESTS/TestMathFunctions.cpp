@@ -1,6 +1,10 @@
+#include <chrono>
+#include <vector>
+
 #include <catch2/catch.hpp>
 
 #include "MathFunctions.h"
+#include "Util/Io/Log.hpp"
 
 TEST_CASE("Math functions", "[Math]") {
     using namespace std;
@@ -80,4 +84,80 @@ TEST_CASE("Math functions", "[Math]") {
             CHECK(ceildiv(3, -3) == -1);
         }
     }
+
+    SECTION("Fixed size geometry helpers") {
+        const Vec3d v1 { 1.0, -2.0, 3.5 };
+        const Vec3d v2 { -4.0, 0.5, 2.0 };
+        const vector<double> w1 { 1.0, -2.0, 3.5 };
+        const vector<double> w2 { -4.0, 0.5, 2.0 };
+
+        const auto checkSame = [](const auto& v, const vector<double>& w) {
+            for(int i = 0; i < 3; ++i) CHECK(v[i] == Approx(w[i]));
+        };
+
+        CHECK(twoPointDistancesquared(v1, v2) == Approx(twoPointDistancesquared(w1, w2)));
+        CHECK(twoPointDistance(v1, v2) == Approx(twoPointDistance(w1, w2)));
+        CHECK(dotProduct(v1, v2) == Approx(dotProduct(w1, w2)));
+        checkSame(twoPointDirection(v1, v2), twoPointDirection(w1, w2));
+        checkSame(normalizeVector(v1), normalizeVector(w1));
+        checkSame(crossProduct(v1, v2), crossProduct(w1, w2));
+        checkSame(midPointCoordinate(v1, v2, 0.3), midPointCoordinate(w1, w2, 0.3));
+        checkSame(nextPointProjection(v1, 2.5, v2), nextPointProjection(w1, 2.5, w2));
+
+        // VecMap over raw coordinates gives the same results.
+        checkSame(midPointCoordinate(makeConstRefVec<3>(w1.data()), v2, 0.3), midPointCoordinate(w1, w2, 0.3));
+
+        static_assert(dotProduct(Vec3d { 1.0, 2.0, 3.0 }, Vec3d { 4.0, 5.0, 6.0 }) == 32.0);
+    }
+}
+
+// Typical per step geometry update of a cross-linker: two midpoints on the
+// bound cylinders, the linker midpoint, and the linker length.
+TEST_CASE("Geometry helper benchmark", "[.][benchmark][Math]") {
+    using namespace std;
+    using namespace medyan;
+    using namespace mathfunc;
+
+    const int numLinkers = 10000;
+    const int numSteps = 100;
+    vector< Vec3d > beads(4 * numLinkers);
+    for(int i = 0; i < 4 * numLinkers; ++i) {
+        beads[i] = Vec3d { 1.0 * i, 0.5 * i, -0.25 * i };
+    }
+
+    double sumVector = 0;
+    const auto startVector = chrono::steady_clock::now();
+    for(int step = 0; step < numSteps; ++step) {
+        for(int l = 0; l < numLinkers; ++l) {
+            // As with Bead::vcoordinate(), each coordinate is copied into a new vector.
+            auto x1 = vec2Vector(beads[4 * l]);
+            auto x2 = vec2Vector(beads[4 * l + 1]);
+            auto x3 = vec2Vector(beads[4 * l + 2]);
+            auto x4 = vec2Vector(beads[4 * l + 3]);
+            auto m1 = midPointCoordinate(x1, x2, 0.3);
+            auto m2 = midPointCoordinate(x3, x4, 0.6);
+            auto mid = midPointCoordinate(m1, m2, 0.5);
+            sumVector += mid[0] + twoPointDistance(m1, m2);
+        }
+    }
+    const chrono::duration< double > elapsedVector = chrono::steady_clock::now() - startVector;
+
+    double sumVec = 0;
+    const auto startVec = chrono::steady_clock::now();
+    for(int step = 0; step < numSteps; ++step) {
+        for(int l = 0; l < numLinkers; ++l) {
+            const auto& x1 = beads[4 * l];
+            const auto& x2 = beads[4 * l + 1];
+            const auto& x3 = beads[4 * l + 2];
+            const auto& x4 = beads[4 * l + 3];
+            auto m1 = midPointCoordinate(x1, x2, 0.3);
+            auto m2 = midPointCoordinate(x3, x4, 0.6);
+            auto mid = midPointCoordinate(m1, m2, 0.5);
+            sumVec += mid[0] + twoPointDistance(m1, m2);
+        }
+    }
+    const chrono::duration< double > elapsedVec = chrono::steady_clock::now() - startVec;
+
+    CHECK(sumVec == Approx(sumVector));
+    log::info("Linker geometry update: vector {:.3g} s, Vec {:.3g} s", elapsedVector.count(), elapsedVec.count());
 }
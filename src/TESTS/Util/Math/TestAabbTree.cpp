@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "Util/Math/AabbTree.hpp"
+
+namespace medyan {
+
+TEST_CASE("AABB tree nearest query", "[AabbTree]") {
+    using V = Vec< 3, double >;
+
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution< double > ud(-10.0, 10.0);
+    const auto randomPoint = [&] { return V { ud(rng), ud(rng), ud(rng) }; };
+
+    // Primitives are points.
+    std::vector< V > points(500);
+    for(auto& p : points) p = randomPoint();
+
+    const auto boxesOf = [](const std::vector< V >& points) {
+        std::vector< Aabb<> > boxes(points.size());
+        for(Index i = 0; i < points.size(); ++i) boxes[i].expand(points[i]);
+        return boxes;
+    };
+    const auto bruteForce = [&](const V& q) {
+        double res = std::numeric_limits< double >::infinity();
+        for(auto& p : points) res = std::min(res, distance(p, q));
+        return res;
+    };
+
+    AabbTree<> tree;
+    CHECK(tree.nearest(V { 0.0, 0.0, 0.0 }, [](Index) { return 0.0; }) == std::numeric_limits< double >::infinity());
+
+    tree.build(boxesOf(points));
+    REQUIRE(tree.numPrimitives() == points.size());
+
+    // Every primitive is in exactly one leaf, and every box contains its children.
+    {
+        std::vector< int > count(points.size());
+        const auto& nodes = tree.nodes();
+        for(Index ni = 0; ni < nodes.size(); ++ni) {
+            if(nodes[ni].isLeaf()) {
+                CHECK(nodes[ni].count <= AabbTree<>::maxLeafSize);
+                for(Index k = nodes[ni].first; k < nodes[ni].first + nodes[ni].count; ++k) ++count[k];
+            } else {
+                for(auto ci : { ni + 1, nodes[ni].first }) {
+                    for(int dim = 0; dim < 3; ++dim) {
+                        CHECK(nodes[ci].box.lo[dim] >= nodes[ni].box.lo[dim]);
+                        CHECK(nodes[ci].box.hi[dim] <= nodes[ni].box.hi[dim]);
+                    }
+                }
+            }
+        }
+        CHECK(std::all_of(count.begin(), count.end(), [](int c) { return c == 1; }));
+    }
+
+    SECTION("Nearest primitive is found") {
+        for(int i = 0; i < 200; ++i) {
+            const auto q = randomPoint() * 1.5;
+            int numEvaluated = 0;
+            const auto d = tree.nearest(q, [&](Index pi) { ++numEvaluated; return distance(points[pi], q); });
+            CHECK(d == bruteForce(q));
+            CHECK(numEvaluated < points.size());
+        }
+    }
+
+    SECTION("Signed distances are compared by absolute value") {
+        const V q { 0.0, 0.0, 0.0 };
+        const auto d = tree.nearest(q, [&](Index pi) { return -distance(points[pi], q); });
+        CHECK(d == -bruteForce(q));
+    }
+
+    SECTION("Refitted tree finds the nearest primitive") {
+        for(auto& p : points) p += randomPoint() * 0.2;
+        tree.refit(boxesOf(points));
+        for(int i = 0; i < 200; ++i) {
+            const auto q = randomPoint();
+            CHECK(tree.nearest(q, [&](Index pi) { return distance(points[pi], q); }) == bruteForce(q));
+        }
+    }
+}
+
+} // namespace medyan
@@ -0,0 +1,91 @@
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "Util/AsyncBufferedWriter.hpp"
+
+TEST_CASE("Async buffered writer", "[Util][AsyncBufferedWriter]") {
+    using namespace std;
+    using namespace medyan;
+
+    SECTION("Buffers are written in order and reused") {
+        vector< int > written;
+        {
+            AsyncBufferedWriter< vector< int > > writer(2);
+            REQUIRE(writer.numBuffers() == 2);
+
+            vector< const vector< int >* > acquired;
+            for(int i = 0; i < 10; ++i) {
+                auto& buffer = writer.acquire();
+                acquired.push_back(&buffer);
+                buffer.assign(3, i);
+                writer.submit([&](vector< int >& b) {
+                    written.insert(written.end(), b.begin(), b.end());
+                });
+            }
+            writer.flush();
+            REQUIRE(written.size() == 30);
+
+            // Round-robin buffer reuse.
+            CHECK(acquired[0] != acquired[1]);
+            CHECK(acquired[0] == acquired[2]);
+            CHECK(acquired[1] == acquired[3]);
+
+            // Pending buffers are written on destruction.
+            writer.acquire().assign(1, 10);
+            writer.submit([&](vector< int >& b) { written.push_back(b[0]); });
+        }
+        REQUIRE(written.size() == 31);
+        for(int i = 0; i < 30; ++i) {
+            CHECK(written[i] == i / 3);
+        }
+        CHECK(written[30] == 10);
+    }
+
+    SECTION("Queue depth is bounded") {
+        atomic_bool hold { true };
+        atomic_int  numWritten { 0 };
+        AsyncBufferedWriter< int > writer(2);
+        const auto write = [&](int&) {
+            while(hold) {}
+            ++numWritten;
+        };
+
+        writer.acquire();
+        writer.submit(write);
+        writer.acquire();
+        writer.submit(write);
+
+        // Both buffers are pending, so acquire() must wait for the writer.
+        atomic_bool acquired { false };
+        std::thread t([&] { writer.acquire(); acquired = true; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        CHECK(!acquired);
+        CHECK(numWritten == 0);
+
+        hold = false;
+        t.join();
+        CHECK(acquired);
+        writer.flush();
+        CHECK(numWritten == 2);
+    }
+
+    SECTION("Errors on the writer thread are rethrown") {
+        AsyncBufferedWriter< int > writer(2);
+        writer.acquire() = 1;
+        writer.submit([](int&) { throw runtime_error("write error"); });
+        REQUIRE_THROWS_AS(writer.flush(), runtime_error);
+
+        // Writing resumes after the error is reported.
+        int value = 0;
+        writer.acquire() = 2;
+        writer.submit([&](int& b) { value = b; });
+        writer.flush();
+        CHECK(value == 2);
+    }
+}
@@ -4,13 +4,17 @@ AUTHOR: G.A. Papoian, Date: Nov 22, 2018
 A simple testing suite. Mainly checks the SIMD version results again the serial ones.
 */
 
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 #include <catch2/catch.hpp>
 
 #include "Util/DistModule/dist_coords.h"
 #include "Util/DistModule/dist_driver.h"
 #include "Util/DistModule/dist_out.h"
+#include "Util/Io/Log.hpp"
+#include "Util/ThreadPool.hpp"
 
 TEST_CASE("Dist module", "[Dist]") {
     using namespace std;
@@ -233,6 +237,7 @@ TEST_CASE("Dist module", "[Dist]") {
     tag_simd<simd_no,  float>           t_serial;
     tag_simd<simd_avx, float>           t_avx;		
     tag_simd<dist::simd_avx_par,float>  t_avx_par;
+    tag_simd<simd_dispatch, float>      t_dispatch;
 #ifdef __CUDACC__
     tag_simd<cuda,     float>           t_cuda;
 #endif
@@ -240,7 +245,8 @@ TEST_CASE("Dist module", "[Dist]") {
     {
         INFO("single comparisions");
         test_algo1(c1, t_avx, "AVX");
-        // test_algo1(c1, t_avx_par, "AVX-PARALLEL");
+        test_algo1(c1, t_avx_par, "AVX-PARALLEL");
+        test_algo1(c1, t_dispatch, "DISPATCH");
 #ifdef __CUDACC__
         test_algo1(c1, t_cuda, "CUDA");
 #endif
@@ -249,7 +255,8 @@ TEST_CASE("Dist module", "[Dist]") {
     {
         INFO("two comparisions");
         test_algo2(c1, t_avx, "AVX");
-        // test_algo2(c1, t_avx_par, "AVX-PARALLEL");
+        test_algo2(c1, t_avx_par, "AVX-PARALLEL");
+        test_algo2(c1, t_dispatch, "DISPATCH");
 #ifdef __CUDACC__
         test_algo2(c1, t_cuda, "CUDA");
 #endif
@@ -261,16 +268,109 @@ TEST_CASE("Dist module", "[Dist]") {
         test_algo1_betwn_comps(c1, c2, t_cuda, "CUDA");
 #endif
         test_algo1_betwn_comps(c1, c2, t_avx, "AVX");
-        // test_algo1_betwn_comps(c1, c2, t_avx_par, "AVX-PARALLEL");
+        test_algo1_betwn_comps(c1, c2, t_avx_par, "AVX-PARALLEL");
+        test_algo1_betwn_comps(c1, c2, t_dispatch, "DISPATCH");
     }
 
     {
         INFO("two-compartment functions with two comparisions:");
         test_algo2_betwn_comps(c1, c2, t_avx, "AVX");
-        // test_algo2_betwn_comps(c1, c2, t_avx_par, "AVX-PARALLEL");
+        test_algo2_betwn_comps(c1, c2, t_avx_par, "AVX-PARALLEL");
+        test_algo2_betwn_comps(c1, c2, t_dispatch, "DISPATCH");
 #ifdef __CUDACC__
         test_algo2_betwn_comps(c1, c2, t_cuda, "CUDA");
 #endif
     }
 
 }
+
+TEST_CASE("Dist module runtime dispatch", "[Dist]") {
+    using namespace std;
+    using namespace medyan;
+    using namespace medyan::dist;
+
+    // Sizes are not multiples of the SIMD width, to cover the scalar tails.
+    Coords c1(601), c2(563);
+
+    // All contacts of the first threshold window, in output order.
+    const auto contacts = [](const auto &out) {
+        vector<pair<int,int>> res;
+        for(uint k=0; k<out.counter[0]; ++k) res.emplace_back(out.dout[0][k], out.dout[1][k]);
+        return res;
+    };
+
+    dOut<1> out_serial(c1.size(), {5.0f, 12.0f});
+    find_distances(out_serial, c1, tag_simd<simd_no,float>());
+    dOut<1,false> out_serial2(c1.size(), c2.size(), {5.0f, 12.0f});
+    find_distances(out_serial2, c1, c2, tag_simd<simd_no,float>());
+    REQUIRE(out_serial.counter[0] > 0);
+    REQUIRE(out_serial2.counter[0] > 0);
+
+    CHECK(is_isa_supported(Isa::serial));
+    CHECK(is_isa_supported(best_isa()));
+
+    for(auto isa : { Isa::serial, Isa::avx2, Isa::avx512 }) {
+        if(!is_isa_supported(isa)) continue;
+        for(bool pooled : { false, true }) {
+            INFO(isa_name(isa) << (pooled ? " pooled" : ""));
+            // The rows are only split if the pool has working threads.
+            if(pooled) ThreadPool::resetGlobal(2);
+
+            // The kernels produce the same contacts in the same order as the serial search.
+            dOut<1> out(c1.size(), {5.0f, 12.0f});
+            find_distances_isa(out, c1, c1, true, isa, pooled);
+            CHECK(contacts(out) == contacts(out_serial));
+
+            dOut<1,false> out2(c1.size(), c2.size(), {5.0f, 12.0f});
+            find_distances_isa(out2, c1, c2, false, isa, pooled);
+            CHECK(contacts(out2) == contacts(out_serial2));
+
+            // Contacts are appended, and the output grows if needed.
+            dOut<1,false> out_small(1, 1, {5.0f, 12.0f});
+            find_distances_isa(out_small, c1, c2, false, isa, pooled);
+            find_distances_isa(out_small, c1, c2, false, isa, pooled);
+            CHECK(out_small.counter[0] == 2 * out_serial2.counter[0]);
+            if(pooled) ThreadPool::resetGlobal(0);
+        }
+    }
+}
+
+// Timings of all variants of the contact search. Run explicitly with the "[benchmark]" tag.
+TEST_CASE("Dist module benchmark", "[.][benchmark][Dist]") {
+    using namespace std;
+    using namespace medyan;
+    using namespace medyan::dist;
+
+    const uint n1 = 6000, n2 = 5600;
+    Coords c1(n1), c2(n2);
+
+    ThreadPool::resetGlobal(std::max(1u, thread::hardware_concurrency()) - 1);
+
+    const auto time = [](const string& name, auto &out, auto&& search) {
+        out.reset_counters();
+        const auto start = chrono::steady_clock::now();
+        search();
+        const chrono::duration< double > elapsed = chrono::steady_clock::now() - start;
+        log::info("{}: {} contacts in {:.3g} ms", name, out.counter[0], elapsed.count() * 1000);
+    };
+
+    dOut<2> out(n1, {5.0f, 12.0f, 6.0f, 13.0f});
+    dOut<2,false> out2(n1 / 2, n2 / 2, {5.0f, 12.0f, 6.0f, 13.0f});
+    Coords c3(n1 / 2), c4(n2 / 2);
+
+    time("SERIAL-F2", out, [&] { find_distances(out, c1, tag_simd<simd_no,float>()); });
+    time("SIMD-AVX-F2", out, [&] { find_distances(out, c1, tag_simd<simd_avx,float>()); });
+    time("SIMD-CMP2-SERIAL-F2", out2, [&] { find_distances(out2, c3, c4, tag_simd<simd_no,float>()); });
+    time("SIMD-CMP2-AVX-F2", out2, [&] { find_distances(out2, c3, c4, tag_simd<simd_avx,float>()); });
+
+    for(auto isa : { Isa::serial, Isa::avx2, Isa::avx512 }) {
+        if(!is_isa_supported(isa)) continue;
+        for(bool pooled : { false, true }) {
+            const string name = string("DISPATCH-") + isa_name(isa) + (pooled ? "-POOLED" : "");
+            time(name + "-F2", out, [&] { find_distances_isa(out, c1, c1, true, isa, pooled); });
+            time(name + "-CMP2-F2", out2, [&] { find_distances_isa(out2, c3, c4, false, isa, pooled); });
+        }
+    }
+
+    ThreadPool::resetGlobal(0);
+}
@@ -0,0 +1,41 @@
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "Util/FlatSet.hpp"
+
+namespace medyan {
+
+TEST_CASE("FlatSet", "[FlatSet]") {
+    FlatSet< int > s;
+    CHECK(s.empty());
+
+    CHECK(s.insert(3));
+    CHECK(s.insert(1));
+    CHECK(s.insert(4));
+    CHECK_FALSE(s.insert(1));
+    CHECK(s.size() == 3);
+    CHECK(s.values() == std::vector< int > { 3, 1, 4 });
+
+    CHECK(s.contains(4));
+    CHECK(s.count(5) == 0);
+    CHECK(s.find(1) != s.end());
+
+    // Erasing moves the last element to the erased position.
+    CHECK(s.erase(3) == 1);
+    CHECK(s.values() == std::vector< int > { 4, 1 });
+    CHECK(s.erase(3) == 0);
+    CHECK(s.erase(1) == 1);
+    CHECK(s.values() == std::vector< int > { 4 });
+
+    s.clear();
+    CHECK(s.empty());
+
+    // Building from a sequence with duplicates keeps the first occurrences.
+    for(int x : { 5, 2, 5, 7, 2, 2, 9, 7 }) s.insertUnchecked(x);
+    s.removeDuplicates();
+    CHECK(s.values() == std::vector< int > { 5, 2, 7, 9 });
+    CHECK_FALSE(s.insert(7));
+}
+
+} // namespace medyan
@@ -0,0 +1,60 @@
+#include <set>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "Util/SlabAllocator.hpp"
+
+namespace medyan {
+
+namespace {
+
+struct TestSlabObject : SlabAllocated< TestSlabObject > {
+    double value[3] {};
+};
+struct TestSlabObjectDerived : TestSlabObject {
+    double extra = 0;
+};
+
+} // namespace
+
+TEST_CASE("Slab pool", "[SlabAllocator]") {
+    SlabPool pool("test", 24, 4);
+
+    // Allocate over several slabs.
+    std::vector< void* > ptrs;
+    for(int i = 0; i < 10; ++i) ptrs.push_back(pool.allocate());
+    CHECK(std::set< void* >(ptrs.begin(), ptrs.end()).size() == ptrs.size());
+    CHECK(pool.stats().numSlabs == 3);
+    CHECK(pool.stats().numLive == 10);
+
+    // Freed objects are reused.
+    pool.deallocate(ptrs[5]);
+    CHECK(pool.allocate() == ptrs[5]);
+
+    for(auto p : ptrs) pool.deallocate(p);
+    const auto stats = pool.stats();
+    CHECK(stats.numSlabs == 3);
+    CHECK(stats.numLive == 0);
+    CHECK(stats.peakLive == 10);
+    CHECK(stats.numAllocations == 11);
+}
+
+TEST_CASE("Slab allocated objects", "[SlabAllocator]") {
+    const auto before = slabPool< TestSlabObject >().stats();
+
+    auto p1 = new TestSlabObject;
+    auto p2 = new TestSlabObject;
+    CHECK(slabPool< TestSlabObject >().stats().numLive == before.numLive + 2);
+
+    // Derived objects of a different size use the global allocator.
+    auto pd = new TestSlabObjectDerived;
+    CHECK(slabPool< TestSlabObject >().stats().numLive == before.numLive + 2);
+    delete pd;
+
+    delete p1;
+    delete p2;
+    CHECK(slabPool< TestSlabObject >().stats().numLive == before.numLive);
+}
+
+} // namespace medyan
@@ -0,0 +1,30 @@
+#include <string>
+
+#include "catch2/catch.hpp"
+
+#include "Util/StringInterner.hpp"
+
+namespace medyan {
+
+TEST_CASE("StringInterner", "[StringInterner]") {
+    StringInterner si { "DNT" };
+    CHECK(si.size() == 1);
+    CHECK(si.id("DNT") == 0);
+
+    // Ids are dense and assigned in the order of first appearance.
+    CHECK(si.id("DIF_A") == 1);
+    CHECK(si.id("LB") == 2);
+    CHECK(si.id("DIF_A") == 1);
+    CHECK(si.size() == 3);
+
+    CHECK(si.name(0) == "DNT");
+    CHECK(si.name(2) == "LB");
+    CHECK_THROWS(si.name(3));
+
+    // References to names stay valid.
+    const std::string& name = si.name(1);
+    for(int i = 0; i < 1000; ++i) si.id("R" + std::to_string(i));
+    CHECK(name == "DIF_A");
+}
+
+} // namespace medyan
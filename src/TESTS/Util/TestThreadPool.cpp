@@ -1,5 +1,10 @@
-#ifdef THIS_THREADPOOL_IS_CURRENTLY_NOT_USED_IN_MEDYAN
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "catch2/catch.hpp"
 
@@ -70,4 +75,80 @@ TEST_CASE("Thread Pool test", "[ThreadPool]") {
 
     }
 }
-#endif
+
+TEST_CASE("Thread Pool parallel loops", "[ThreadPool]") {
+    using namespace std;
+
+    const int n = 10000;
+
+    for(size_t numThreads : { 0, 1, 3 }) {
+        ThreadPool tp(numThreads);
+
+        SECTION("Parallel for with " + to_string(numThreads) + " threads") {
+            vector< int > visited(n, 0);
+            tp.parallelFor(0, n, [&](ptrdiff_t i) { ++visited[i]; }, 16);
+            CHECK(count(visited.begin(), visited.end(), 1) == n);
+
+            // Empty range.
+            tp.parallelFor(5, 5, [&](ptrdiff_t i) { ++visited[i]; });
+            CHECK(count(visited.begin(), visited.end(), 1) == n);
+        }
+
+        SECTION("Parallel reduce with " + to_string(numThreads) + " threads") {
+            const auto sum = tp.parallelReduce(
+                1, n + 1, 0LL,
+                [](ptrdiff_t i) { return (long long)i; },
+                [](long long a, long long b) { return a + b; }
+            );
+            CHECK(sum == 50005000LL);
+
+            // Floating point reductions are reproducible.
+            vector< double > x(n);
+            for(int i = 0; i < n; ++i) x[i] = 1.0 / (i + 1);
+            const auto reduceX = [&] {
+                return tp.parallelReduce(
+                    0, n, 0.0,
+                    [&](ptrdiff_t i) { return x[i]; },
+                    [](double a, double b) { return a + b; },
+                    100
+                );
+            };
+            const auto res = reduceX();
+            CHECK(res == Approx(accumulate(x.begin(), x.end(), 0.0)));
+            for(int rep = 0; rep < 10; ++rep) {
+                CHECK(reduceX() == res);
+            }
+        }
+
+        SECTION("Nested loops and exceptions with " + to_string(numThreads) + " threads") {
+            vector< int > visited(100 * 100, 0);
+            tp.parallelFor(0, 100, [&](ptrdiff_t i) {
+                tp.parallelFor(0, 100, [&](ptrdiff_t j) { ++visited[100 * i + j]; });
+            });
+            CHECK(count(visited.begin(), visited.end(), 1) == 100 * 100);
+
+            CHECK_THROWS_AS(
+                tp.parallelFor(0, n, [&](ptrdiff_t i) {
+                    if(i == n / 2) throw runtime_error("Error in task.");
+                }),
+                runtime_error
+            );
+
+            // The pool is still usable after an exception.
+            atomic_int numDone {0};
+            tp.parallelFor(0, n, [&](ptrdiff_t) { ++numDone; });
+            CHECK(numDone == n);
+        }
+
+        SECTION("Usage stats with " + to_string(numThreads) + " threads") {
+            tp.parallelFor(0, n, [](ptrdiff_t) { this_thread::yield(); });
+            const auto stats = tp.getUsageStats();
+            CHECK(stats.threads.size() == numThreads);
+            for(const auto& ts : stats.threads) {
+                CHECK(ts.workTime >= 0);
+                CHECK(ts.workTime + ts.idleTime <= ts.upTime * 1.01 + 1e-3);
+            }
+            CHECK(tp.numTasks() == 0);
+        }
+    }
+}
@@ -0,0 +1,151 @@
+#ifndef MEDYAN_Util_AsyncBufferedWriter_hpp
+#define MEDYAN_Util_AsyncBufferedWriter_hpp
+
+#include <algorithm> // max
+#include <condition_variable>
+#include <cstddef> // size_t
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility> // forward, move
+#include <vector>
+
+
+namespace medyan {
+
+// Writes data in a pool of buffers on a dedicated background thread.
+//
+// Usage:
+//   - On the calling thread, acquire() a free buffer, fill it, and submit()
+//     it together with the function that writes it. The write function runs
+//     on the writer thread, in the order of submission.
+//   - The pool has a fixed number of buffers, which is also the maximum
+//     number of submitted buffers not yet written. With 2 buffers, one buffer
+//     can be filled while the other is being written. acquire() blocks if all
+//     buffers are pending.
+//   - flush() waits until all submitted buffers are written.
+//
+// Notes:
+//   - Buffers are reused in a round-robin fashion, so the memory allocated by
+//     the buffers is kept across submissions.
+//   - An exception thrown on the writer thread is rethrown on the calling
+//     thread by the next acquire() or flush(). Buffers submitted before the
+//     exception is rethrown are discarded.
+//   - Only one thread should acquire and submit buffers.
+template< typename Buffer >
+class AsyncBufferedWriter {
+public:
+    using WriteFunc = std::function< void(Buffer&) >;
+
+    explicit AsyncBufferedWriter(std::size_t numBuffers = 2) :
+        buffers_(std::max< std::size_t >(numBuffers, 1)),
+        writer_([this] { writerLoop_(); })
+    {}
+
+    AsyncBufferedWriter(const AsyncBufferedWriter&) = delete;
+    AsyncBufferedWriter& operator=(const AsyncBufferedWriter&) = delete;
+
+    // Destructor writes all pending buffers. Errors are discarded.
+    ~AsyncBufferedWriter() {
+        {
+            std::lock_guard< std::mutex > lk(me_);
+            done_ = true;
+        }
+        cvWork_.notify_one();
+        writer_.join();
+    }
+
+    auto numBuffers() const { return buffers_.size(); }
+
+    // Get the next free buffer, waiting for the writer if necessary.
+    Buffer& acquire() {
+        std::unique_lock< std::mutex > lk(me_);
+        cvIdle_.wait(lk, [this] { return error_ || numPending_ < buffers_.size(); });
+        rethrowIfError_();
+        return buffers_[next_];
+    }
+
+    // Submit the buffer obtained by the last acquire(), with the function
+    // that writes it on the writer thread.
+    template< typename F >
+    void submit(F&& write) {
+        {
+            std::lock_guard< std::mutex > lk(me_);
+            queue_.push_back({ next_, WriteFunc(std::forward< F >(write)) });
+            ++numPending_;
+            next_ = (next_ + 1) % buffers_.size();
+        }
+        cvWork_.notify_one();
+    }
+
+    // Wait until all submitted buffers are written.
+    void flush() {
+        std::unique_lock< std::mutex > lk(me_);
+        cvIdle_.wait(lk, [this] { return error_ || numPending_ == 0; });
+        rethrowIfError_();
+    }
+
+private:
+    struct Job_ {
+        std::size_t bufferIndex = 0;
+        WriteFunc   write;
+    };
+
+    std::vector< Buffer > buffers_;
+    std::size_t           next_ = 0;       // Index of the next buffer to be acquired.
+    std::size_t           numPending_ = 0; // Number of submitted buffers not yet written.
+    std::deque< Job_ >    queue_;
+    bool                  done_ = false;
+    std::exception_ptr    error_;
+
+    std::mutex              me_;
+    std::condition_variable cvWork_; // Notifies the writer thread.
+    std::condition_variable cvIdle_; // Notifies the calling thread.
+
+    // Must be initialized last, after all the other states.
+    std::thread writer_;
+
+    // Must be called with the mutex locked.
+    void rethrowIfError_() {
+        if(error_) {
+            auto e = error_;
+            error_ = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+    void writerLoop_() {
+        std::unique_lock< std::mutex > lk(me_);
+        while(true) {
+            cvWork_.wait(lk, [this] { return done_ || !queue_.empty(); });
+            if(queue_.empty()) {
+                // done_ is set, and all jobs are finished.
+                return;
+            }
+
+            auto job = std::move(queue_.front());
+            queue_.pop_front();
+
+            if(!error_) {
+                lk.unlock();
+                std::exception_ptr e;
+                try {
+                    job.write(buffers_[job.bufferIndex]);
+                } catch(...) {
+                    e = std::current_exception();
+                }
+                lk.lock();
+                if(e) error_ = e;
+            }
+
+            --numPending_;
+            cvIdle_.notify_all();
+        }
+    }
+};
+
+} // namespace medyan
+
+#endif
@@ -0,0 +1,306 @@
+/*
+Kernels of the contact search with the instruction set selected at runtime.
+
+Each kernel broadcasts one row i of c1 and compares it with SIMD-width columns
+of c2 at a time, followed by a scalar tail. The contacts of a row are appended
+in increasing j, so every kernel produces exactly the same output.
+*/
+
+#include "dist_dispatch.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib> // abs
+#include <stdexcept>
+#include <string>
+
+#include "Util/ThreadPool.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+	#define MEDYAN_DIST_DISPATCH_SIMD
+	#include <immintrin.h>
+#endif
+
+namespace medyan::dist {
+
+namespace {
+
+	// Found contacts of each threshold window, in the layout of dOut.
+	//
+	// The SIMD kernels store a full vector of contacts and then advance the
+	// counter by the number of contacts found, so room for a full vector more
+	// than the contacts of a row must be made before the row.
+	template <uint D>
+	struct Contacts {
+		std::array<std::vector<int>, 2*D> dout;
+		std::array<uint, D> counter {};
+
+		void reserve_more(uint d, uint n) {
+			const std::size_t need = counter[d] + n;
+			if(dout[2*d].size() < need) {
+				const auto new_size = std::max(need, 2 * dout[2*d].size());
+				dout[2*d].resize(new_size);
+				dout[2*d+1].resize(new_size);
+			}
+		}
+		int* first(uint d)  { return dout[2*d].data() + counter[d]; }
+		int* second(uint d) { return dout[2*d+1].data() + counter[d]; }
+
+		void push(uint d, int ci, int cj) {
+			reserve_more(d, 1);
+			*first(d) = ci;
+			*second(d) = cj;
+			++counter[d];
+		}
+	};
+
+	// Thresholds shared by all the kernels.
+	template <uint D>
+	struct Criteria {
+		std::array<float, 2*D> dt;
+		int min_fil_dist;
+	};
+
+	// Same predicate as dist_scalar_ij.
+	template <uint D>
+	inline void row_scalar(const Criteria<D> &cr, const Coords &c1, const Coords &c2, uint i, uint jbegin, uint jend, Contacts<D> &res) {
+		for(uint j=jbegin; j<jend; ++j){
+			const float dx = c2.x[j]-c1.x[i];
+			const float dy = c2.y[j]-c1.y[i];
+			const float dz = c2.z[j]-c1.z[i];
+			const float dist_sq = dx*dx + dy*dy + dz*dz;
+			if(std::abs(c1.filinfo[i] - c2.filinfo[j]) <= cr.min_fil_dist) continue;
+
+			for(uint d=0; d<D; ++d){
+				if(dist_sq > cr.dt[2*d] && dist_sq < cr.dt[2*d+1])
+					res.push(d, c1.indices[i], c2.indices[j]);
+			}
+		}
+	}
+
+	template <uint D>
+	void rows_serial(const Criteria<D> &cr, const Coords &c1, const Coords &c2, bool self, uint ibegin, uint iend, Contacts<D> &res) {
+		const uint N2 = c2.size();
+		for(uint i=ibegin; i<iend; ++i)
+			row_scalar(cr, c1, c2, i, self ? i+1 : 0, N2, res);
+	}
+
+#ifdef MEDYAN_DIST_DISPATCH_SIMD
+
+	bool cpu_supports_avx2()   { return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"); }
+	bool cpu_supports_avx512() { return cpu_supports_avx2() && __builtin_cpu_supports("avx512f"); }
+
+	// Lanes set in an 8-bit mask, packed to the front in lane order.
+	struct CompressTable {
+		alignas(32) int lanes[256][8] {};
+
+		constexpr CompressTable() {
+			for(int mask=0; mask<256; ++mask){
+				int cnt = 0;
+				for(int lane=0; lane<8; ++lane){
+					if(mask & (1<<lane)) lanes[mask][cnt++] = lane;
+				}
+			}
+		}
+	};
+	constexpr CompressTable compress_table;
+
+	// AVX2: 8 columns at a time.
+	template <uint D>
+	__attribute__((target("avx2,popcnt")))
+	void rows_avx2(const Criteria<D> &cr, const Coords &c1, const Coords &c2, bool self, uint ibegin, uint iend, Contacts<D> &res) {
+		constexpr uint width = 8;
+		const uint N2 = c2.size();
+
+		__m256 vdt[2*D];
+		for(uint k=0; k<2*D; ++k) vdt[k] = _mm256_set1_ps(cr.dt[k]);
+		const __m256i vmin_fil = _mm256_set1_epi32(cr.min_fil_dist);
+
+		for(uint i=ibegin; i<iend; ++i){
+			const __m256 xi = _mm256_set1_ps(c1.x[i]);
+			const __m256 yi = _mm256_set1_ps(c1.y[i]);
+			const __m256 zi = _mm256_set1_ps(c1.z[i]);
+			const __m256i fi = _mm256_set1_epi32(c1.filinfo[i]);
+			const __m256i vci = _mm256_set1_epi32(c1.indices[i]);
+
+			uint j = self ? i+1 : 0;
+			// Room for every column of the row plus a full vector, so that no
+			// check is needed before each store.
+			for(uint d=0; d<D; ++d) res.reserve_more(d, N2 - j + width);
+			for(; j + width <= N2; j += width){
+				const __m256i fj = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&c2.filinfo[j]));
+				const __m256i fdiff = _mm256_abs_epi32(_mm256_sub_epi32(fi, fj));
+				const unsigned fil_mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(fdiff, vmin_fil)));
+				if(!fil_mask) continue;
+
+				const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&c2.x[j]), xi);
+				const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&c2.y[j]), yi);
+				const __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(&c2.z[j]), zi);
+				const __m256 dist_sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+				const __m256i cj = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&c2.indices[j]));
+
+				for(uint d=0; d<D; ++d){
+					const __m256 in = _mm256_and_ps(
+						_mm256_cmp_ps(dist_sq, vdt[2*d], _CMP_GT_OQ),
+						_mm256_cmp_ps(dist_sq, vdt[2*d+1], _CMP_LT_OQ));
+					const unsigned mask = fil_mask & _mm256_movemask_ps(in);
+
+					// Contacts are stored without branching on the mask, which is hard to predict.
+					const __m256i perm = _mm256_load_si256(reinterpret_cast<const __m256i*>(compress_table.lanes[mask]));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(res.first(d)), vci);
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(res.second(d)), _mm256_permutevar8x32_epi32(cj, perm));
+					res.counter[d] += __builtin_popcount(mask);
+				}
+			}
+			row_scalar(cr, c1, c2, i, j, N2, res);
+		}
+	}
+
+	// AVX-512: 16 columns at a time.
+	template <uint D>
+	__attribute__((target("avx512f,avx2,popcnt")))
+	void rows_avx512(const Criteria<D> &cr, const Coords &c1, const Coords &c2, bool self, uint ibegin, uint iend, Contacts<D> &res) {
+		constexpr uint width = 16;
+		const uint N2 = c2.size();
+
+		__m512 vdt[2*D];
+		for(uint k=0; k<2*D; ++k) vdt[k] = _mm512_set1_ps(cr.dt[k]);
+		const __m512i vmin_fil = _mm512_set1_epi32(cr.min_fil_dist);
+
+		for(uint i=ibegin; i<iend; ++i){
+			const __m512 xi = _mm512_set1_ps(c1.x[i]);
+			const __m512 yi = _mm512_set1_ps(c1.y[i]);
+			const __m512 zi = _mm512_set1_ps(c1.z[i]);
+			const __m512i fi = _mm512_set1_epi32(c1.filinfo[i]);
+			const __m512i vci = _mm512_set1_epi32(c1.indices[i]);
+
+			uint j = self ? i+1 : 0;
+			for(uint d=0; d<D; ++d) res.reserve_more(d, N2 - j + width);
+			for(; j + width <= N2; j += width){
+				const __m512i fj = _mm512_loadu_si512(&c2.filinfo[j]);
+				// The masked abs with a zero source is used, because gcc warns
+				// about the undefined source of _mm512_abs_epi32.
+				const __m512i fdiff = _mm512_mask_abs_epi32(_mm512_setzero_si512(), 0xffff, _mm512_sub_epi32(fi, fj));
+				const __mmask16 fil_mask = _mm512_cmpgt_epi32_mask(fdiff, vmin_fil);
+				if(!fil_mask) continue;
+
+				const __m512 dx = _mm512_sub_ps(_mm512_loadu_ps(&c2.x[j]), xi);
+				const __m512 dy = _mm512_sub_ps(_mm512_loadu_ps(&c2.y[j]), yi);
+				const __m512 dz = _mm512_sub_ps(_mm512_loadu_ps(&c2.z[j]), zi);
+				const __m512 dist_sq = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy)), _mm512_mul_ps(dz, dz));
+				const __m512i cj = _mm512_loadu_si512(&c2.indices[j]);
+
+				for(uint d=0; d<D; ++d){
+					const __mmask16 lo = _mm512_mask_cmp_ps_mask(fil_mask, dist_sq, vdt[2*d], _CMP_GT_OQ);
+					const __mmask16 in = _mm512_mask_cmp_ps_mask(lo, dist_sq, vdt[2*d+1], _CMP_LT_OQ);
+					_mm512_storeu_si512(res.first(d), vci);
+					_mm512_mask_compressstoreu_epi32(res.second(d), in, cj);
+					res.counter[d] += __builtin_popcount(in);
+				}
+			}
+			row_scalar(cr, c1, c2, i, j, N2, res);
+		}
+	}
+
+#endif // MEDYAN_DIST_DISPATCH_SIMD
+
+	template <uint D>
+	void find_rows(Isa isa, const Criteria<D> &cr, const Coords &c1, const Coords &c2, bool self, uint ibegin, uint iend, Contacts<D> &res) {
+		switch(isa){
+#ifdef MEDYAN_DIST_DISPATCH_SIMD
+			case Isa::avx2:   rows_avx2(cr, c1, c2, self, ibegin, iend, res); break;
+			case Isa::avx512: rows_avx512(cr, c1, c2, self, ibegin, iend, res); break;
+#endif
+			default:          rows_serial(cr, c1, c2, self, ibegin, iend, res); break;
+		}
+	}
+
+	// The pooled search uses a few chunks per thread for load balancing, since
+	// rows of the self search have different lengths.
+	constexpr uint min_rows_per_chunk = 32;
+	constexpr uint chunks_per_thread = 8;
+
+} // namespace
+
+	const char* isa_name(Isa isa) {
+		switch(isa){
+			case Isa::serial: return "serial";
+			case Isa::avx2:   return "AVX2";
+			case Isa::avx512: return "AVX-512";
+			default:          return "unknown";
+		}
+	}
+
+	bool is_isa_supported(Isa isa) {
+		switch(isa){
+			case Isa::serial: return true;
+#ifdef MEDYAN_DIST_DISPATCH_SIMD
+			case Isa::avx2:   return cpu_supports_avx2();
+			case Isa::avx512: return cpu_supports_avx512();
+#endif
+			default:          return false;
+		}
+	}
+
+	Isa best_isa() {
+		static const Isa isa =
+			is_isa_supported(Isa::avx512) ? Isa::avx512 :
+			is_isa_supported(Isa::avx2)   ? Isa::avx2   :
+			Isa::serial;
+		return isa;
+	}
+
+	template <uint D, bool SELF>
+	void find_distances_isa(dOut<D,SELF> &out, const Coords &c1, const Coords &c2, bool self, Isa isa, bool pooled) {
+		if(!is_isa_supported(isa)) {
+			throw std::runtime_error(std::string("Contact search kernel not supported by the CPU: ") + isa_name(isa));
+		}
+
+		Criteria<D> cr;
+		cr.dt = out.dt;
+		cr.min_fil_dist = ChemParams::minCylinderDistanceSameFilament;
+
+		const uint N1 = c1.size();
+		const uint nthreads = ThreadPool::global().numThreads() + 1;
+		const uint nchunks = pooled && nthreads > 1
+			? std::max(1u, std::min(N1 / min_rows_per_chunk, chunks_per_thread * nthreads))
+			: 1;
+
+		// The first chunk writes to the output directly.
+		std::vector<Contacts<D>> res(nchunks);
+		res[0].dout = std::move(out.dout);
+		res[0].counter = out.counter;
+
+		if(nchunks == 1) {
+			find_rows(isa, cr, c1, c2, self, 0, N1, res[0]);
+		}
+		else {
+			ThreadPool::global().parallelFor(0, nchunks, [&](std::ptrdiff_t c) {
+				const uint ibegin = std::size_t(N1) * c / nchunks;
+				const uint iend = std::size_t(N1) * (c + 1) / nchunks;
+				find_rows(isa, cr, c1, c2, self, ibegin, iend, res[c]);
+			});
+		}
+
+		// Append the other chunks in row order.
+		auto &all = res[0];
+		for(uint c=1; c<nchunks; ++c){
+			for(uint d=0; d<D; ++d){
+				const uint n = res[c].counter[d];
+				all.reserve_more(d, n);
+				std::copy_n(res[c].dout[2*d].begin(), n, all.first(d));
+				std::copy_n(res[c].dout[2*d+1].begin(), n, all.second(d));
+				all.counter[d] += n;
+			}
+		}
+
+		out.dout = std::move(all.dout);
+		out.counter = all.counter;
+	}
+
+	template void find_distances_isa(dOut<1,true>  &, const Coords &, const Coords &, bool, Isa, bool);
+	template void find_distances_isa(dOut<1,false> &, const Coords &, const Coords &, bool, Isa, bool);
+	template void find_distances_isa(dOut<2,true>  &, const Coords &, const Coords &, bool, Isa, bool);
+	template void find_distances_isa(dOut<2,false> &, const Coords &, const Coords &, bool, Isa, bool);
+
+} // end-of-namespace dist
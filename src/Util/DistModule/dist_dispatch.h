@@ -0,0 +1,58 @@
+/*
+Contact search with the instruction set selected at runtime.
+
+The kernels for AVX2 and AVX-512 are compiled for their targets regardless of
+the compiler flags, and the best kernel supported by the CPU is chosen at the
+first call. Unlike the simd_avx algorithm, the results do not depend on the
+instruction set, and the coordinates need not be padded to the SIMD width.
+Large searches are split over the global thread pool when it has working
+threads.
+*/
+
+#ifndef DIST_DISPATCH
+#define DIST_DISPATCH
+
+#include "dist_common.h"
+#include "dist_coords.h"
+#include "dist_out.h"
+
+namespace medyan::dist {
+
+	struct simd_dispatch{}; // Best instruction set available at runtime
+
+	enum class Isa { serial, avx2, avx512 };
+
+	const char* isa_name(Isa isa);
+
+	// Whether the CPU can run the kernel for the instruction set.
+	bool is_isa_supported(Isa isa);
+
+	// The best instruction set supported by the CPU. The result is cached.
+	Isa best_isa();
+
+	// Find the contacts using the kernel for the given instruction set, which
+	// must be supported. The contacts are appended after out.counter, and the
+	// output vectors are enlarged if needed.
+	//
+	// If self is true, c1 and c2 must be the same, and only pairs with i < j
+	// are considered.
+	//
+	// If pooled is true and the global thread pool has working threads, the
+	// rows are split into chunks running on the pool. The order of the found
+	// contacts is the same as in the single threaded search.
+	template <uint D, bool SELF>
+	void find_distances_isa(dOut<D,SELF> &out, const Coords &c1, const Coords &c2, bool self, Isa isa, bool pooled);
+
+	template <uint D, bool SELF>
+	inline void find_distances(dOut<D,SELF> &out, Coords &c, tag_simd<simd_dispatch,float> tag){
+		find_distances_isa(out, c, c, true, best_isa(), true);
+	}
+
+	template <uint D, bool SELF>
+	inline void find_distances(dOut<D,SELF> &out, Coords &c1, Coords &c2, tag_simd<simd_dispatch,float> tag){
+		find_distances_isa(out, c1, c2, false, best_isa(), true);
+	}
+
+} // end-of-namespace dist
+
+#endif // DIST_DISPATCH
@@ -24,6 +24,7 @@ This is the main header that should be included in the client code.
 #include "dist_serial.h"
 #include "dist_simd.h"
 #include "dist_avx.h"
+#include "dist_dispatch.h"
 #include "dist_avx_par.h"
 #include "dist_cuda.h"
 
@@ -0,0 +1,102 @@
+#ifndef MEDYAN_Util_FlatSet_hpp
+#define MEDYAN_Util_FlatSet_hpp
+
+#include <algorithm> // find, sort
+#include <cstddef> // size_t
+#include <functional> // less
+#include <utility> // pair, swap
+#include <vector>
+
+namespace medyan {
+
+// A set of unique elements stored contiguously in a vector.
+//
+// Notes:
+// - Intended for small sets that are mostly iterated, such as the dependents
+//   of a reaction. Lookup is a linear scan over contiguous memory.
+// - Elements are kept in insertion order, except that erasing an element
+//   moves the last element to its place. So the iteration order does not
+//   depend on the element values (e.g. pointer addresses).
+// - Erasing invalidates iterators to the erased and the last elements.
+// - When building a set from a sequence with repeated elements, use
+//   insertUnchecked() followed by removeDuplicates(), which avoids the linear
+//   lookup of each insert().
+template< typename T >
+class FlatSet {
+public:
+    using value_type     = T;
+    using size_type      = std::size_t;
+    using iterator       = typename std::vector<T>::const_iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    auto begin() const noexcept { return value_.cbegin(); }
+    auto end()   const noexcept { return value_.cend(); }
+
+    auto size()  const noexcept { return value_.size(); }
+    bool empty() const noexcept { return value_.empty(); }
+
+    void clear() noexcept { value_.clear(); }
+    void reserve(size_type n) { value_.reserve(n); }
+
+    auto find(const T& t) const { return std::find(value_.cbegin(), value_.cend(), t); }
+    size_type count(const T& t) const { return find(t) == end() ? 0 : 1; }
+    bool contains(const T& t) const { return find(t) != end(); }
+
+    // Returns whether the element is inserted.
+    bool insert(const T& t) {
+        if(contains(t)) return false;
+        value_.push_back(t);
+        return true;
+    }
+
+    // Appends the element without checking whether it is already in the set.
+    // The set may contain duplicates until removeDuplicates() is called.
+    void insertUnchecked(const T& t) { value_.push_back(t); }
+
+    // Removes repeated elements, keeping the first occurrence of each element
+    // in the original order. Takes O(n log n) time.
+    void removeDuplicates() {
+        const size_type n = value_.size();
+        if(n < 2) return;
+
+        // Sort the elements with their positions, so that the first occurrence
+        // comes first among the equal elements.
+        thread_local std::vector< std::pair< T, size_type > > sorted;
+        thread_local std::vector< char > keep;
+        sorted.clear();
+        for(size_type i = 0; i < n; ++i) sorted.emplace_back(value_[i], i);
+        std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+            return std::less< T >{}(a.first, b.first) || (!std::less< T >{}(b.first, a.first) && a.second < b.second);
+        });
+        keep.assign(n, false);
+        keep[sorted[0].second] = true;
+        for(size_type i = 1; i < n; ++i) {
+            if(!(sorted[i].first == sorted[i - 1].first)) keep[sorted[i].second] = true;
+        }
+
+        size_type size = 0;
+        for(size_type i = 0; i < n; ++i) {
+            if(keep[i]) value_[size++] = value_[i];
+        }
+        value_.resize(size);
+    }
+
+    // Returns the number of elements erased.
+    size_type erase(const T& t) {
+        auto it = std::find(value_.begin(), value_.end(), t);
+        if(it == value_.end()) return 0;
+        std::swap(*it, value_.back());
+        value_.pop_back();
+        return 1;
+    }
+
+    // Access the underlying contiguous storage.
+    const std::vector<T>& values() const noexcept { return value_; }
+
+private:
+    std::vector<T> value_;
+};
+
+} // namespace medyan
+
+#endif
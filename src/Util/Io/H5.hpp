@@ -2,14 +2,19 @@
 #define MEDYAN_Util_Io_H5_hpp
 
 #include <algorithm>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <vector>
 
 #include <highfive/H5Attribute.hpp>
 #include <highfive/H5File.hpp>
 #include <highfive/H5DataSet.hpp>
 #include <highfive/H5DataSpace.hpp>
+#include <highfive/H5PropertyList.hpp>
+#include <H5Ppublic.h>
+#include <H5Zpublic.h>
 #include <xtensor/xarray.hpp>
 
 namespace medyan::h5 {
@@ -19,6 +24,7 @@ using Group = HighFive::Group;
 using DataSpace = HighFive::DataSpace;
 using Attribute = HighFive::Attribute;
 using DataSet = HighFive::DataSet;
+using DataSetCreateProps = HighFive::DataSetCreateProps;
 
 // Some type traits.
 //------------------------------------------------------------------------------
@@ -128,6 +134,99 @@ inline void readDataSet(EigenMatrix& mat, const Group& grp, std::string_view nam
 
 
 
+// Extendible 2D datasets, where data are appended as rows.
+//
+// The data are stored in row major order, with a fixed number of columns.
+//------------------------------------------------------------------------------
+
+// Append rows to the dataset. If the dataset does not exist, it is created
+// using the properties built by makeProps(numCols), which should include the
+// chunk dimensions.
+// Returns the number of rows after appending.
+template< typename T, typename MakeProps >
+inline std::size_t appendRows(Group& group, std::string_view name, const T* data, std::size_t numRows, std::size_t numCols, MakeProps&& makeProps) {
+    using namespace HighFive;
+    const std::string namestr(name);
+    if(!group.exist(namestr)) {
+        if(numRows == 0) return 0;
+        DataSpace dataspace({ 0, numCols }, { DataSpace::UNLIMITED, numCols });
+        group.createDataSet<T>(namestr, dataspace, makeProps(numCols));
+    }
+
+    DataSet dataset = group.getDataSet(namestr);
+    const std::size_t oldNumRows = dataset.getSpace().getDimensions()[0];
+    if(numRows > 0) {
+        dataset.resize({ oldNumRows + numRows, numCols });
+        dataset.select({ oldNumRows, 0 }, { numRows, numCols }).write((const T**) data);
+    }
+    return oldNumRows + numRows;
+}
+
+// Read rows [rowBegin, rowBegin + numRows) from the dataset.
+// If the dataset does not exist, which means no rows were ever appended, the
+// data will be empty with 0 columns.
+// Returns the number of columns.
+template< typename T >
+inline std::size_t readRows(std::vector<T>& data, const Group& group, std::string_view name, std::size_t rowBegin, std::size_t numRows) {
+    using namespace HighFive;
+    const std::string namestr(name);
+    if(!group.exist(namestr)) {
+        data.clear();
+        return 0;
+    }
+
+    DataSet dataset = group.getDataSet(namestr);
+    const std::size_t numCols = dataset.getSpace().getDimensions()[1];
+    data.resize(numRows * numCols);
+    if(numRows > 0 && numCols > 0) {
+        dataset.select({ rowBegin, 0 }, { numRows, numCols }).read((T**) data.data());
+    }
+    return numCols;
+}
+
+// Number of rows in the dataset, or 0 if it does not exist.
+inline std::size_t numRows(const Group& group, std::string_view name) {
+    const std::string namestr(name);
+    return group.exist(namestr) ? group.getDataSet(namestr).getSpace().getDimensions()[0] : 0;
+}
+
+
+// Compression filters that are not provided by HighFive.
+// They can be added to DataSetCreateProps.
+//------------------------------------------------------------------------------
+
+// SZIP filter, using nearest neighbor coding.
+struct SzipFilter {
+    unsigned pixelsPerBlock = 16;
+
+    void apply(hid_t hid) const {
+        if(H5Pset_szip(hid, H5_SZIP_NN_OPTION_MASK, pixelsPerBlock) < 0) {
+            throw std::runtime_error("Cannot set SZIP filter.");
+        }
+    }
+};
+
+// LZF filter, which is registered by h5py and available as an HDF5 plugin.
+struct LzfFilter {
+    static constexpr H5Z_filter_t id = 32000;
+
+    void apply(hid_t hid) const {
+        if(H5Pset_filter(hid, id, H5Z_FLAG_OPTIONAL, 0, nullptr) < 0) {
+            throw std::runtime_error("Cannot set LZF filter.");
+        }
+    }
+};
+
+// Whether the filter is available for both encoding and decoding.
+// Dynamically loaded filters are loaded by this query if possible.
+inline bool isFilterAvailable(H5Z_filter_t id) {
+    if(H5Zfilter_avail(id) <= 0) return false;
+    unsigned config = 0;
+    if(H5Zget_filter_info(id, &config) < 0) return false;
+    return (config & H5Z_FILTER_CONFIG_ENCODE_ENABLED) && (config & H5Z_FILTER_CONFIG_DECODE_ENABLED);
+}
+
+
 // Alternative read dataset function that creates and returns the data.
 template< typename T >
 inline T readDataSet(const Group& group, std::string_view name) {
@@ -0,0 +1,217 @@
+#ifndef MEDYAN_Util_Math_AabbTree_Hpp
+#define MEDYAN_Util_Math_AabbTree_Hpp
+
+#include <algorithm> // max, min, nth_element
+#include <cmath>
+#include <limits>
+#include <utility> // swap
+#include <vector>
+
+#include "common.h"
+#include "Util/Math/Vec.hpp"
+
+namespace medyan {
+
+// Axis aligned bounding box.
+template< typename Float = double >
+struct Aabb {
+    Vec< 3, Float > lo {
+        std::numeric_limits< Float >::infinity(),
+        std::numeric_limits< Float >::infinity(),
+        std::numeric_limits< Float >::infinity()
+    };
+    Vec< 3, Float > hi {
+        -std::numeric_limits< Float >::infinity(),
+        -std::numeric_limits< Float >::infinity(),
+        -std::numeric_limits< Float >::infinity()
+    };
+
+    template< typename VecType >
+    void expand(const VecType& p) {
+        for(int dim = 0; dim < 3; ++dim) {
+            lo[dim] = std::min< Float >(lo[dim], p[dim]);
+            hi[dim] = std::max< Float >(hi[dim], p[dim]);
+        }
+    }
+    void expand(const Aabb& box) {
+        expand(box.lo);
+        expand(box.hi);
+    }
+
+    auto center() const { return (lo + hi) * Float(0.5); }
+
+    // Squared distance from a point to the box. Zero if the point is inside.
+    template< typename VecType >
+    Float distance2(const VecType& p) const {
+        Float res = 0;
+        for(int dim = 0; dim < 3; ++dim) {
+            const Float d = std::max< Float >({ lo[dim] - p[dim], Float(0), p[dim] - hi[dim] });
+            res += d * d;
+        }
+        return res;
+    }
+};
+
+// Bounding volume hierarchy over primitives given by their bounding boxes.
+//
+// Notes:
+// - The tree only stores the primitive indices. The caller computes the
+//   distance to a primitive in the query, so the tree does not depend on the
+//   type of the primitives.
+// - Build splits the primitives at the median of the centroids along the
+//   longest axis, in O(n log n).
+// - Refit updates the boxes for new primitive boxes without changing the
+//   tree structure, in O(n). The queries stay exact, but the tree may become
+//   less efficient if the primitives move a lot, in which case it should be
+//   rebuilt.
+template< typename Float = double >
+class AabbTree {
+public:
+    using BoxType = Aabb< Float >;
+
+    // Max number of primitives in a leaf.
+    static constexpr Index maxLeafSize = 4;
+
+    struct Node {
+        BoxType box;
+        // For a leaf, the range of primitives in the primitive list.
+        // For an internal node, "first" is the index of the right child, and
+        // the left child is the next node.
+        Index first = 0;
+        Index count = 0;
+
+        bool isLeaf() const { return count > 0; }
+    };
+
+    Size numPrimitives() const { return primitives_.size(); }
+    bool empty()         const { return primitives_.empty(); }
+    const auto& nodes()  const { return nodes_; }
+
+    void clear() {
+        nodes_.clear();
+        primitives_.clear();
+    }
+
+    void build(const std::vector< BoxType >& boxes) {
+        clear();
+        const Size n = boxes.size();
+        if(n == 0) return;
+
+        primitives_.resize(n);
+        for(Index i = 0; i < n; ++i) primitives_[i] = i;
+
+        std::vector< Vec< 3, Float > > centers(n);
+        for(Index i = 0; i < n; ++i) centers[i] = boxes[i].center();
+
+        nodes_.reserve(2 * ((n + maxLeafSize - 1) / maxLeafSize));
+        buildNode_(boxes, centers, 0, n);
+    }
+
+    // Update all boxes, given new boxes of the same primitives.
+    void refit(const std::vector< BoxType >& boxes) {
+        // Children always come after their parent.
+        for(Index ni = static_cast< Index >(nodes_.size()) - 1; ni >= 0; --ni) {
+            auto& node = nodes_[ni];
+            node.box = BoxType {};
+            if(node.isLeaf()) {
+                for(Index k = node.first; k < node.first + node.count; ++k) node.box.expand(boxes[primitives_[k]]);
+            } else {
+                node.box.expand(nodes_[ni + 1].box);
+                node.box.expand(nodes_[node.first].box);
+            }
+        }
+    }
+
+    // Find the primitive with the smallest |distance| to the point.
+    //
+    // distanceFunc(primitive index) returns a (possibly signed) distance to
+    // the primitive, whose absolute value must be no less than the distance
+    // to the bounding box of the primitive.
+    //
+    // Returns the distance with the smallest absolute value, or infinity if
+    // the tree is empty.
+    template< typename VecType, typename DistanceFunc >
+    Float nearest(const VecType& p, DistanceFunc&& distanceFunc) const {
+        Float best = std::numeric_limits< Float >::infinity();
+        if(nodes_.empty()) return best;
+
+        // Pairs of node index and squared distance to its box.
+        std::vector< std::pair< Index, Float > > stack;
+        stack.reserve(64);
+        stack.push_back({ 0, nodes_[0].box.distance2(p) });
+
+        while(!stack.empty()) {
+            const auto [ni, nodeDist2] = stack.back();
+            stack.pop_back();
+            if(nodeDist2 > best * best) continue;
+
+            const auto& node = nodes_[ni];
+            if(node.isLeaf()) {
+                for(Index k = node.first; k < node.first + node.count; ++k) {
+                    const Float d = distanceFunc(primitives_[k]);
+                    if(std::abs(d) < std::abs(best)) best = d;
+                }
+            } else {
+                const Index left = ni + 1, right = node.first;
+                const Float dl = nodes_[left].box.distance2(p);
+                const Float dr = nodes_[right].box.distance2(p);
+                // Visit the closer child first.
+                if(dl <= dr) {
+                    stack.push_back({ right, dr });
+                    stack.push_back({ left, dl });
+                } else {
+                    stack.push_back({ left, dl });
+                    stack.push_back({ right, dr });
+                }
+            }
+        }
+        return best;
+    }
+
+private:
+    std::vector< Node >  nodes_;
+    std::vector< Index > primitives_;
+
+    // Build the node for primitives in range [begin, end). Returns the node index.
+    Index buildNode_(
+        const std::vector< BoxType >& boxes,
+        const std::vector< Vec< 3, Float > >& centers,
+        Index begin, Index end
+    ) {
+        const Index ni = nodes_.size();
+        nodes_.emplace_back();
+
+        BoxType box, centerBox;
+        for(Index k = begin; k < end; ++k) {
+            box.expand(boxes[primitives_[k]]);
+            centerBox.expand(centers[primitives_[k]]);
+        }
+        nodes_[ni].box = box;
+
+        if(end - begin <= maxLeafSize) {
+            nodes_[ni].first = begin;
+            nodes_[ni].count = end - begin;
+            return ni;
+        }
+
+        // Split at the median along the longest axis of the centers.
+        int axis = 0;
+        for(int dim = 1; dim < 3; ++dim) {
+            if(centerBox.hi[dim] - centerBox.lo[dim] > centerBox.hi[axis] - centerBox.lo[axis]) axis = dim;
+        }
+        const Index mid = begin + (end - begin) / 2;
+        std::nth_element(
+            primitives_.begin() + begin, primitives_.begin() + mid, primitives_.begin() + end,
+            [&](Index a, Index b) { return centers[a][axis] < centers[b][axis]; }
+        );
+
+        buildNode_(boxes, centers, begin, mid);
+        const Index right = buildNode_(boxes, centers, mid, end);
+        nodes_[ni].first = right;
+        return ni;
+    }
+};
+
+} // namespace medyan
+
+#endif
@@ -24,6 +24,31 @@ inline const auto& outputParamsParser() {
             [](auto&& params) -> auto& { return params.logSimulationTimeEachCycle; }
         );
 
+        p.addEmptyLine();
+        p.addComment(" Trajectory file layout.");
+        p.addComment(" - traj-layout: group (default) or packed.");
+        p.addComment(" - traj-compression: none, gzip (default), szip or lzf. Only used by the packed layout.");
+        p.addSingleArg(
+            "traj-layout",
+            [](auto&& params) -> auto& { return params.trajLayout; }
+        );
+        p.addSingleArg(
+            "traj-compression",
+            [](auto&& params) -> auto& { return params.trajCompression; }
+        );
+        p.addSingleArg(
+            "traj-compression-level",
+            [](auto&& params) -> auto& { return params.trajCompressionLevel; }
+        );
+
+        p.addEmptyLine();
+        p.addComment(" Restart checkpoints.");
+        p.addComment(" - checkpoint-interval: write checkpoint.h5 every n data dumps. 0 (default) disables checkpoints.");
+        p.addSingleArg(
+            "checkpoint-interval",
+            [](auto&& params) -> auto& { return params.checkpointInterval; }
+        );
+
         return p;
     }();
 
@@ -0,0 +1,181 @@
+#ifndef MEDYAN_Util_SlabAllocator_hpp
+#define MEDYAN_Util_SlabAllocator_hpp
+
+#include <algorithm> // max
+#include <cstddef> // byte, max_align_t, size_t
+#include <memory> // unique_ptr
+#include <mutex>
+#include <new>
+#include <string>
+#include <typeinfo>
+#include <utility> // move
+#include <vector>
+
+#include <boost/core/demangle.hpp>
+
+namespace medyan {
+
+// Allocation statistics of a slab pool.
+struct SlabPoolStats {
+    std::string name;
+    std::size_t objectSize = 0;
+    std::size_t numSlabs = 0;
+    std::size_t numLive = 0;        // Objects currently allocated.
+    std::size_t peakLive = 0;       // Maximum number of objects allocated at the same time.
+    std::size_t numAllocations = 0; // Total number of allocations.
+};
+
+// A pool of fixed-size objects, allocated in slabs.
+//
+// Notes:
+// - Freed objects are kept in an intrusive free list and reused. Slabs are
+//   never returned to the system.
+// - Allocation and deallocation are thread safe.
+class SlabPool {
+public:
+    SlabPool(std::string name, std::size_t objectSize, std::size_t objectsPerSlab = 1024) :
+        objectSize_(roundUp_(std::max(objectSize, sizeof(FreeNode_)))),
+        objectsPerSlab_(objectsPerSlab)
+    {
+        stats_.name = std::move(name);
+        stats_.objectSize = objectSize;
+    }
+
+    void* allocate() {
+        std::lock_guard lk(me_);
+        if(freeList_ == nullptr) addSlab_();
+        auto node = freeList_;
+        freeList_ = node->next;
+
+        ++stats_.numLive;
+        ++stats_.numAllocations;
+        stats_.peakLive = std::max(stats_.peakLive, stats_.numLive);
+        return node;
+    }
+
+    void deallocate(void* ptr) noexcept {
+        std::lock_guard lk(me_);
+        auto node = static_cast< FreeNode_* >(ptr);
+        node->next = freeList_;
+        freeList_ = node;
+        --stats_.numLive;
+    }
+
+    SlabPoolStats stats() const {
+        std::lock_guard lk(me_);
+        return stats_;
+    }
+
+private:
+    struct FreeNode_ { FreeNode_* next; };
+
+    static constexpr std::size_t roundUp_(std::size_t size) {
+        constexpr std::size_t align = alignof(std::max_align_t);
+        return (size + align - 1) / align * align;
+    }
+
+    void addSlab_() {
+        // Memory from operator new[] is suitably aligned for any fundamental type.
+        slabs_.emplace_back(new std::byte[objectSize_ * objectsPerSlab_]);
+        auto base = slabs_.back().get();
+        // Link objects in the address order.
+        for(std::size_t i = objectsPerSlab_; i > 0; --i) {
+            auto node = reinterpret_cast< FreeNode_* >(base + (i - 1) * objectSize_);
+            node->next = freeList_;
+            freeList_ = node;
+        }
+        ++stats_.numSlabs;
+    }
+
+    std::size_t objectSize_;
+    std::size_t objectsPerSlab_;
+    std::vector< std::unique_ptr< std::byte[] > > slabs_;
+    FreeNode_* freeList_ = nullptr;
+    SlabPoolStats stats_;
+    mutable std::mutex me_;
+};
+
+// Registry of all slab pools, used for reporting statistics.
+class SlabPoolRegistry {
+public:
+    static SlabPoolRegistry& global() {
+        // Never destroyed, because objects may be freed during static destruction.
+        static auto& registry = *new SlabPoolRegistry();
+        return registry;
+    }
+
+    void add(const SlabPool* pool) {
+        std::lock_guard lk(me_);
+        pools_.push_back(pool);
+    }
+
+    std::vector< SlabPoolStats > stats() const {
+        std::lock_guard lk(me_);
+        std::vector< SlabPoolStats > res;
+        for(auto pool : pools_) res.push_back(pool->stats());
+        return res;
+    }
+
+private:
+    std::vector< const SlabPool* > pools_;
+    mutable std::mutex me_;
+};
+
+// The slab pool of a specific type.
+template< typename T >
+inline SlabPool& slabPool() {
+    // Never destroyed, because objects may be freed during static destruction.
+    static auto& pool = [] () -> SlabPool& {
+        auto p = new SlabPool(boost::core::demangle(typeid(T).name()), sizeof(T));
+        SlabPoolRegistry::global().add(p);
+        return *p;
+    }();
+    return pool;
+}
+
+// Functions to be used in class specific operator new and operator delete.
+// Objects of derived types with a different size fall back to the global allocator.
+template< typename T >
+inline void* slabAllocate(std::size_t size) {
+    return size == sizeof(T) ? slabPool<T>().allocate() : ::operator new(size);
+}
+template< typename T >
+inline void slabDeallocate(void* ptr, std::size_t size) noexcept {
+    if(size == sizeof(T)) slabPool<T>().deallocate(ptr);
+    else                  ::operator delete(ptr);
+}
+
+// Base class that makes the objects of type T allocated in the slab pool of T.
+template< typename T >
+struct SlabAllocated {
+    static void* operator new(std::size_t size) { return slabAllocate<T>(size); }
+    static void operator delete(void* ptr, std::size_t size) noexcept { slabDeallocate<T>(ptr, size); }
+};
+
+// Standard allocator using slab pools for single objects, which can be used
+// in node based containers.
+template< typename T >
+struct SlabStdAllocator {
+    using value_type = T;
+
+    SlabStdAllocator() = default;
+    template< typename U >
+    SlabStdAllocator(const SlabStdAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast< T* >(n == 1 ? slabPool<T>().allocate() : ::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        if(n == 1) slabPool<T>().deallocate(ptr);
+        else       ::operator delete(ptr);
+    }
+
+    template< typename U >
+    bool operator==(const SlabStdAllocator<U>&) const noexcept { return true; }
+    template< typename U >
+    bool operator!=(const SlabStdAllocator<U>&) const noexcept { return false; }
+};
+
+} // namespace medyan
+
+#endif
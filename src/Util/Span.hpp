@@ -0,0 +1,48 @@
+#ifndef MEDYAN_Util_Span_hpp
+#define MEDYAN_Util_Span_hpp
+
+#include <cassert>
+#include <type_traits>
+
+#include "common.h"
+
+namespace medyan {
+
+// A non-owning view of contiguous elements, similar to std::span in C++20.
+//
+// Note:
+// - The view is invalidated when the underlying storage is reallocated.
+template< typename T >
+class Span {
+public:
+    using element_type = T;
+    using value_type   = std::remove_cv_t< T >;
+    using iterator     = T*;
+
+    constexpr Span() = default;
+    constexpr Span(T* data, Size size) : data_(data), size_(size) {}
+    template< typename Container >
+    constexpr Span(Container& c) : data_(c.data()), size_(c.size()) {}
+
+    constexpr T*   data()  const { return data_; }
+    constexpr Size size()  const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+
+    constexpr T* begin() const { return data_; }
+    constexpr T* end()   const { return data_ + size_; }
+
+    constexpr T& operator[](Index i) const {
+        assert(i >= 0 && i < size_);
+        return data_[i];
+    }
+    constexpr T& front() const { return (*this)[0]; }
+    constexpr T& back()  const { return (*this)[size_ - 1]; }
+
+private:
+    T*   data_ = nullptr;
+    Size size_ = 0;
+};
+
+} // namespace medyan
+
+#endif
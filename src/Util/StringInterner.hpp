@@ -0,0 +1,55 @@
+#ifndef MEDYAN_Util_StringInterner_hpp
+#define MEDYAN_Util_StringInterner_hpp
+
+#include <deque>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common.h"
+
+namespace medyan {
+
+// Maps strings to dense integer ids, in the order they are first seen.
+//
+// Notes:
+// - Strings are interned once at setup, so that hot paths can compare and
+//   index by the integer ids. Names are resolved only when needed (e.g. for
+//   output).
+// - References returned by name() stay valid for the lifetime of the interner.
+// - All functions are thread safe.
+class StringInterner {
+public:
+    StringInterner() = default;
+    StringInterner(std::initializer_list< std::string > names) {
+        for(auto& name : names) id(name);
+    }
+
+    // Returns the id of the name. If the name is new, it is assigned the next id.
+    Index id(const std::string& name) {
+        std::lock_guard lk(me_);
+        const auto [it, inserted] = ids_.try_emplace(name, names_.size());
+        if(inserted) names_.push_back(name);
+        return it->second;
+    }
+
+    const std::string& name(Index id) const {
+        std::lock_guard lk(me_);
+        return names_.at(id);
+    }
+
+    Size size() const {
+        std::lock_guard lk(me_);
+        return names_.size();
+    }
+
+private:
+    std::unordered_map< std::string, Index > ids_;
+    std::deque< std::string > names_;
+    mutable std::mutex me_;
+};
+
+} // namespace medyan
+
+#endif
@@ -1,25 +1,24 @@
 #ifndef MEDYAN_Util_ThreadPool_hpp
 #define MEDYAN_Util_ThreadPool_hpp
 
+#include <algorithm> // max, min
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
-#include <cstddef> // size_t
+#include <cstddef> // ptrdiff_t, size_t
+#include <cstdint> // uint64_t
+#include <deque>
+#include <exception>
 #include <functional>
 #include <future>
 #include <memory> // unique_ptr
 #include <mutex>
-#include <ostream>
-#include <queue>
+#include <string>
 #include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
-// IMPORTANT
-//   THIS IMPLEMENTATION OF THREAD POOL IS CURRENTLY NOT USED IN THE MAIN CODE
-//
-
 // The implementation for thread pooling in MEDYAN.
 //
 // Purpose: Increase performance by running computational-heavy work on
@@ -35,19 +34,34 @@
 //   - Can explicitly wait for specific tasks to complete.
 //   - Tasks waiting for other tasks can work on pending tasks.
 //   - Can terminate running tasks (via setting and polling shared states).
+//   - Can run loops and reductions in parallel, where the calling thread
+//     also works on the loop. Therefore, a pool with N working threads runs
+//     loops on up to (N + 1) threads.
+//
+// Scheduling:
+//   - Each working thread owns a task deque. Tasks pushed from a working
+//     thread go to its own deque, and tasks pushed from other threads go to
+//     a shared queue.
+//   - A thread looking for work first takes the newest task in its own
+//     deque, then the oldest task in the shared queue, and finally steals
+//     the oldest task from the deques of other working threads.
 //
 // Possible Additional Features
 //   [ ] priority queues
-//   [ ] thread idle/contention stats and recommendations
-//   [ ] automatic load balancing
+//   [x] thread idle/contention stats and recommendations
+//   [x] automatic load balancing (via work stealing)
 //
 // Notes:
 //   - The thread vector is not thread-safe, so no interface is provided for
 //     managing the number of threads.
+//   - A pool without working threads is valid, in which case all the work is
+//     done on the calling thread.
 
 class ThreadPool {
 private:
 
+    using TimePoint_ = std::chrono::time_point<std::chrono::steady_clock>;
+
     // An implementation of function wrapper to store movable objects
     // It can be also used to store additional task information
     class FuncWrapper_ {
@@ -82,101 +96,178 @@ private:
         std::unique_ptr< Base_ > f_;
     };
 
-    // Wrapper of std::thread to allow for storing meta data of the working thread
-    class WorkingThread_ {
-    private:
+    template< typename IntegralType >
+    struct ScopeCounter_ {
+        std::atomic< IntegralType >& c;
+        ScopeCounter_(std::atomic< IntegralType >& c) : c(c) { ++c; }
+        ~ScopeCounter_() { --c; }
+    };
 
-        using TimePoint_ = std::chrono::time_point<std::chrono::steady_clock>;
+    // Accumulates the duration of the scope. Only one thread is allowed to write to the timer.
+    struct ScopeTimer_ {
+        std::atomic< double >& t;
+        TimePoint_ start;
+        ScopeTimer_(std::atomic< double >& t) : t(t), start(std::chrono::steady_clock::now()) {}
+        ~ScopeTimer_() {
+            using namespace std::chrono;
+            t.store(t.load() + duration_cast<duration<double>>(steady_clock::now() - start).count());
+        }
+    };
 
-        template< typename IntegralType >
-        struct ScopeCounter_ {
-            std::atomic< IntegralType >& c;
-            ScopeCounter_(std::atomic< IntegralType >& c) : c(c) { ++c; }
-            ~ScopeCounter_() { --c; }
-        };
+    // Task queue protected by a mutex.
+    struct TaskQueue_ {
+        std::mutex                 me;
+        std::deque< FuncWrapper_ > tasks;
+    };
 
-        struct ScopeTimer_ {
-            double& t;
-            TimePoint_ start;
-            ScopeTimer_(double& t) : t(t), start(std::chrono::steady_clock::now()) {}
-            ~ScopeTimer_() {
-                using namespace std::chrono;
-                t += duration_cast<duration<double>>(steady_clock::now() - start).count();
-            }
-        };
+    // Stats of a thread. Only written by the owning thread, but can be read by any thread.
+    struct ThreadStatsCounter_ {
+        std::atomic< double >        durWork        { 0.0 }; // Total duration for working, in seconds
+        std::atomic< double >        durIdle        { 0.0 }; // Total duration for waiting for tasks, in seconds
+        std::atomic< std::uint64_t > numTasksDone   { 0 };
+        std::atomic< std::uint64_t > numSteals      { 0 }; // Number of tasks taken from other threads' deques
+        std::atomic< std::uint64_t > numContentions { 0 }; // Number of times a queue was locked by another thread
+    };
+
+    // Data owned by each working thread.
+    struct PerThread_ {
+        TaskQueue_          queue;
+        ThreadStatsCounter_ stats;
+    };
 
+    // Records which pool and which working thread the current thread belongs to.
+    struct ThreadLocalInfo_ {
+        const ThreadPool* pool  = nullptr;
+        std::ptrdiff_t    index = -1;
+    };
+
+    // Wrapper of std::thread to allow for storing meta data of the working thread
+    class WorkingThread_ {
     public:
-        WorkingThread_(ThreadPool* whichPool) :
-            t_(&WorkingThread_::work_, this, whichPool),
-            timeInit_(std::chrono::steady_clock::now())
+        WorkingThread_(ThreadPool* whichPool, std::ptrdiff_t index) :
+            timeInit_(std::chrono::steady_clock::now()),
+            t_(&WorkingThread_::work_, this, whichPool, index)
         {}
-        WorkingThread_(WorkingThread_&&) = default;
 
         ~WorkingThread_() { t_.join(); }
 
         // Accessors (could be non-thread-safe)
         auto getTimeInit() const { return timeInit_; }
-        auto getDurWork() const { return durWork_; }
 
     private:
 
         // Working thread
         // Note:
         //   - The thread pool must ensure that it outlives all the working threads.
-        void work_(ThreadPool* p) {
+        //   - Pending tasks are finished before the thread exits.
+        void work_(ThreadPool* p, std::ptrdiff_t index) {
+            threadLocalInfo_() = { p, index };
+            auto& stats = p->perThread_[index]->stats;
+
             while(true) {
                 FuncWrapper_ f;
-                bool queuePopped = false;
+                if(p->tryPop_(f, index, stats)) {
+                    ScopeCounter_<int> sc(p->numWorkingThreads_);
+                    ScopeTimer_        st(stats.durWork);
+                    f();
+                    ++stats.numTasksDone;
+                    continue;
+                }
 
                 {
-                    std::unique_lock< std::mutex > lk(p->meQueue_);
+                    ScopeTimer_ st(stats.durIdle);
+                    std::unique_lock< std::mutex > lk(p->meWait_);
                     p->cvWork_.wait(
                         lk,
-                        [&] {
-                            queuePopped = p->tryPop_(f);
-                            return queuePopped || p->done_;
-                        }
+                        [&] { return p->numTasks_.load() > 0 || p->done_; }
                     );
+                    if(p->done_ && p->numTasks_.load() <= 0) return;
                 }
-
-                if(p->done_) return;
-                if(queuePopped) {
-                    ScopeCounter_<int> sc(p->numWorkingThreads_);
-                    ScopeTimer_        st(durWork_);
-                    f();
-                }
-
             }
         }
 
-        std::thread t_;
-
         // Time measurements
         TimePoint_ timeInit_; // should not be changed after initialization, to make it thread-safe
-        double durWork_ = 0.0; // Total duration for working, in seconds
+
+        // The thread must be started after other members are initialized.
+        std::thread t_;
+    };
+
+    struct ThreadUsageStats_ {
+        double upTime   = 0.0;
+        double workTime = 0.0;
+        double idleTime = 0.0;
+        std::uint64_t numTasksDone   = 0;
+        std::uint64_t numSteals      = 0;
+        std::uint64_t numContentions = 0;
     };
 
     struct UsageStats_ {
         double totalUpTime = 0.0;
         double totalWorkTime = 0.0;
         double timeUsageRate = 0.0;
+        std::uint64_t totalTasksDone   = 0;
+        std::uint64_t totalContentions = 0;
+
+        // Stats of each working thread.
+        std::vector< ThreadUsageStats_ > threads;
+        // Contentions encountered by threads outside the pool, such as the threads waiting for parallel loops.
+        std::uint64_t numExternalContentions = 0;
+
+        // Returns a suggestion based on the stats, or an empty string if nothing needs to be changed.
+        std::string recommendation() const {
+            if(threads.empty() || totalUpTime <= 0) return {};
+
+            if(timeUsageRate < 0.2) {
+                return "Working threads are idle most of the time. Using fewer threads may be more efficient.";
+            }
+            if(totalContentions + numExternalContentions > totalTasksDone / 10 + 100) {
+                return "Task queues are frequently contended. Using coarser tasks or fewer threads may be more efficient.";
+            }
+            if(timeUsageRate > 0.9 && threads.size() + 1 < std::thread::hardware_concurrency()) {
+                return "Working threads are busy most of the time. Using more threads may be more efficient.";
+            }
+            return {};
+        }
     };
 
 public:
 
     // Constructor
     ThreadPool(std::size_t numThreads) {
+        // Create per-thread data before starting any thread, because working threads may steal from each other.
+        perThread_.reserve(numThreads);
+        for(std::size_t i = 0; i < numThreads; ++i) {
+            perThread_.push_back(std::make_unique< PerThread_ >());
+        }
+
         // Create working threads
         threads_.reserve(numThreads);
-        for(int i = 0; i < numThreads; ++i) {
-            threads_.emplace_back(this);
+        for(std::size_t i = 0; i < numThreads; ++i) {
+            threads_.push_back(std::make_unique< WorkingThread_ >(this, i));
         }
     }
 
     // Destructor
     ~ThreadPool() {
-        done_ = true;
+        {
+            std::lock_guard< std::mutex > guard(meWait_);
+            done_ = true;
+        }
         cvWork_.notify_all();
+
+        // Join all threads before other members are destroyed.
+        threads_.clear();
+    }
+
+    // The thread pool shared by the whole simulation.
+    // Initially, the global pool has no working threads.
+    static ThreadPool& global() { return *globalPtr_(); }
+
+    // Replace the global thread pool with a new pool of the given number of working threads.
+    // Must not be called when the global thread pool is being used.
+    static void resetGlobal(std::size_t numThreads) {
+        globalPtr_() = std::make_unique< ThreadPool >(numThreads);
     }
 
     // Submit a new task
@@ -184,6 +275,7 @@ public:
     // Note:
     //   - When arguments include references or pointers, it is the caller's
     //     job to ensure that the ref or ptr is valid when the job is running.
+    //   - If the pool has no working threads, the task is run immediately.
     template< typename F, typename... Args >
     auto submit(F&& f, Args&&... args) {
         using ReturnType = std::result_of_t< F(Args...) >;
@@ -194,26 +286,76 @@ public:
         );
         auto res = task.get_future();
 
-        {
-            std::lock_guard< std::mutex > guard(meQueue_);
-
-            queue_.push(
+        if(threads_.empty()) {
+            task();
+        }
+        else {
+            push_(
                 [task{std::move(task)}]() mutable { task(); }
             );
         }
-        cvWork_.notify_one();
 
         return res;
     }
 
+    // Run f(i) for all i in [begin, end), and wait for all of them to finish.
+    //
+    // Note:
+    //   - The range is divided into contiguous chunks of at least grainSize
+    //     indices. The calling thread works on the first chunk, and then works
+    //     on pending tasks while waiting for the other chunks.
+    //   - If f throws, the remaining indices in the same chunk are skipped,
+    //     and one of the exceptions is rethrown on the calling thread after
+    //     all tasks of this loop are finished.
+    template< typename F >
+    void parallelFor(std::ptrdiff_t begin, std::ptrdiff_t end, F&& f, std::ptrdiff_t grainSize = 1) {
+        const auto n = end - begin;
+        const auto nc = numChunks_(n, grainSize);
+        runChunks_(nc, [&](std::ptrdiff_t c) {
+            const auto cbegin = begin + n * c / nc;
+            const auto cend   = begin + n * (c + 1) / nc;
+            for(auto i = cbegin; i < cend; ++i) f(i);
+        });
+    }
+
+    // Compute reduce(... reduce(reduce(identity, map(begin)), map(begin + 1)) ..., map(end - 1)) in parallel.
+    //
+    // Note:
+    //   - The reduce function must be associative. The values are reduced in
+    //     each chunk in index order, and the chunk results are then reduced
+    //     in chunk order. Since the division into chunks only depends on the
+    //     range, the grain size and the number of working threads, the result
+    //     is deterministic for a given pool.
+    template< typename T, typename MapFunc, typename ReduceFunc >
+    T parallelReduce(
+        std::ptrdiff_t begin, std::ptrdiff_t end, T identity,
+        MapFunc&& mapFunc, ReduceFunc&& reduceFunc,
+        std::ptrdiff_t grainSize = 1
+    ) {
+        const auto n = end - begin;
+        const auto nc = numChunks_(n, grainSize);
+        std::vector< T > partialResults(nc, identity);
+        runChunks_(nc, [&](std::ptrdiff_t c) {
+            const auto cbegin = begin + n * c / nc;
+            const auto cend   = begin + n * (c + 1) / nc;
+            T res = identity;
+            for(auto i = cbegin; i < cend; ++i) res = reduceFunc(std::move(res), mapFunc(i));
+            partialResults[c] = std::move(res);
+        });
+
+        T res = std::move(identity);
+        for(auto& pr : partialResults) res = reduceFunc(std::move(res), std::move(pr));
+        return res;
+    }
+
     // Accessors
     auto numThreads()        const noexcept { return threads_.size(); }
     auto numWorkingThreads() const noexcept { return numWorkingThreads_.load(); }
     auto numIdleThreads()    const noexcept { return numThreads() - numWorkingThreads(); }
 
-    auto numTasks() {
-        std::lock_guard< std::mutex > guard(meQueue_);
-        return queue_.size();
+    // Number of pending tasks that are not yet picked up by any thread.
+    std::size_t numTasks() const noexcept {
+        return std::max< std::ptrdiff_t >(numTasks_.load(), 0);
     }
 
     auto getUsageStats() {
@@ -224,11 +366,25 @@ public:
         const auto curTime = steady_clock::now();
         {
             std::lock_guard< std::mutex > guard(meThreads_);
-            for(const auto& t : threads_) {
-                res.totalUpTime += duration_cast<duration<double>>(curTime - t.getTimeInit()).count();
-                res.totalWorkTime += t.getDurWork();
+            for(std::size_t i = 0; i < threads_.size(); ++i) {
+                const auto& stats = perThread_[i]->stats;
+
+                ThreadUsageStats_ ts;
+                ts.upTime         = duration_cast<duration<double>>(curTime - threads_[i]->getTimeInit()).count();
+                ts.workTime       = stats.durWork.load();
+                ts.idleTime       = stats.durIdle.load();
+                ts.numTasksDone   = stats.numTasksDone.load();
+                ts.numSteals      = stats.numSteals.load();
+                ts.numContentions = stats.numContentions.load();
+
+                res.totalUpTime      += ts.upTime;
+                res.totalWorkTime    += ts.workTime;
+                res.totalTasksDone   += ts.numTasksDone;
+                res.totalContentions += ts.numContentions;
+                res.threads.push_back(ts);
             }
         }
+        res.numExternalContentions = externalStats_.numContentions.load();
         if(res.totalUpTime) {
             res.timeUsageRate = res.totalWorkTime / res.totalUpTime;
         }
@@ -238,17 +394,158 @@ public:
 
 private:
 
-    // Utility function for popping the queue:
-    // If the queue is empty, then return false
+    static std::unique_ptr< ThreadPool >& globalPtr_() {
+        static auto pool = std::make_unique< ThreadPool >(0);
+        return pool;
+    }
+
+    static ThreadLocalInfo_& threadLocalInfo_() {
+        thread_local ThreadLocalInfo_ info;
+        return info;
+    }
+
+    // Index of the current thread in this pool, or -1 if the current thread is not a working thread of this pool.
+    std::ptrdiff_t currentThreadIndex_() const {
+        const auto& info = threadLocalInfo_();
+        return info.pool == this ? info.index : -1;
+    }
+    ThreadStatsCounter_& currentStats_() {
+        const auto index = currentThreadIndex_();
+        return index >= 0 ? perThread_[index]->stats : externalStats_;
+    }
+
+    // Lock a mutex, and record a contention if it is already locked.
+    static std::unique_lock< std::mutex > lockCounted_(std::mutex& me, ThreadStatsCounter_& stats) {
+        std::unique_lock< std::mutex > lk(me, std::try_to_lock);
+        if(!lk.owns_lock()) {
+            ++stats.numContentions;
+            lk.lock();
+        }
+        return lk;
+    }
+
+    // Push a task to the deque of the current working thread, or the shared queue if the current thread is not a working thread.
+    void push_(FuncWrapper_&& f) {
+        const auto index = currentThreadIndex_();
+        auto& q = index >= 0 ? perThread_[index]->queue : sharedQueue_;
+        {
+            auto lk = lockCounted_(q.me, currentStats_());
+            q.tasks.push_back(std::move(f));
+        }
+        {
+            std::lock_guard< std::mutex > guard(meWait_);
+            ++numTasks_;
+        }
+        cvWork_.notify_one();
+    }
+
+    // Utility function for finding a task:
+    // If no task is found, then return false
     // Else return true and the popped value is written in the parameter x
     //
-    // Note:
-    //   - This function is NOT thread-safe
-    bool tryPop_(FuncWrapper_& x) {
-        if(queue_.empty()) return false;
-        x = std::move(queue_.front());
-        queue_.pop();
-        return true;
+    // Parameters:
+    //   - index: the index of the current working thread, or -1 if the current thread is not a working thread.
+    bool tryPop_(FuncWrapper_& x, std::ptrdiff_t index, ThreadStatsCounter_& stats) {
+        const auto popFrom = [&, this](TaskQueue_& q, bool back) {
+            if(q.tasks.empty()) return false;
+            if(back) {
+                x = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            } else {
+                x = std::move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+            --numTasks_;
+            return true;
+        };
+
+        // Own deque.
+        if(index >= 0) {
+            auto& q = perThread_[index]->queue;
+            auto lk = lockCounted_(q.me, stats);
+            if(popFrom(q, true)) return true;
+        }
+
+        // Shared queue.
+        {
+            auto lk = lockCounted_(sharedQueue_.me, stats);
+            if(popFrom(sharedQueue_, false)) return true;
+        }
+
+        // Steal from other working threads. Contended deques are skipped.
+        const std::ptrdiff_t n = perThread_.size();
+        for(std::ptrdiff_t k = 1; k <= n; ++k) {
+            const auto victim = (std::max< std::ptrdiff_t >(index, 0) + k) % n;
+            if(victim == index) continue;
+
+            auto& q = perThread_[victim]->queue;
+            std::unique_lock< std::mutex > lk(q.me, std::try_to_lock);
+            if(!lk.owns_lock()) {
+                ++stats.numContentions;
+                continue;
+            }
+            if(popFrom(q, false)) {
+                ++stats.numSteals;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Number of chunks used for parallel loops.
+    // Using more chunks than threads helps balance the loads.
+    std::ptrdiff_t numChunks_(std::ptrdiff_t n, std::ptrdiff_t grainSize) const {
+        if(n <= 0) return 0;
+        grainSize = std::max< std::ptrdiff_t >(grainSize, 1);
+        const std::ptrdiff_t maxChunks = 4 * (threads_.size() + 1);
+        return std::min((n + grainSize - 1) / grainSize, maxChunks);
+    }
+
+    // Run chunkFunc(c) for every c in [0, numChunks), and wait for all of them to finish.
+    template< typename ChunkFunc >
+    void runChunks_(std::ptrdiff_t numChunks, ChunkFunc&& chunkFunc) {
+        if(numChunks <= 0) return;
+        if(numChunks == 1 || threads_.empty()) {
+            for(std::ptrdiff_t c = 0; c < numChunks; ++c) chunkFunc(c);
+            return;
+        }
+
+        // All tasks reference local variables, so they must finish before leaving this function.
+        std::atomic< std::ptrdiff_t > numRemaining { numChunks - 1 };
+        std::exception_ptr eptr;
+        std::mutex         meEptr;
+        const auto runChunk = [&](std::ptrdiff_t c) {
+            try { chunkFunc(c); }
+            catch(...) {
+                std::lock_guard< std::mutex > guard(meEptr);
+                if(!eptr) eptr = std::current_exception();
+            }
+        };
+
+        for(std::ptrdiff_t c = 1; c < numChunks; ++c) {
+            push_([&, c] {
+                runChunk(c);
+                --numRemaining;
+            });
+        }
+        runChunk(0);
+
+        // Work on pending tasks while waiting.
+        const auto index = currentThreadIndex_();
+        auto& stats = currentStats_();
+        while(numRemaining.load() > 0) {
+            FuncWrapper_ f;
+            if(tryPop_(f, index, stats)) {
+                f();
+                ++stats.numTasksDone;
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+
+        if(eptr) std::rethrow_exception(eptr);
     }
 
     // Member variables
@@ -258,15 +555,22 @@ private:
     std::atomic_bool done_ {false};
 
     std::condition_variable cvWork_;
-    std::mutex              meQueue_;
+    std::mutex              meWait_;
     std::mutex              meThreads_;
 
-    std::queue< FuncWrapper_ >    queue_; // not thread-safe
-    std::vector< WorkingThread_ > threads_; // not thread-safe
+    // Number of tasks in all queues.
+    // It might be temporarily inaccurate while tasks are being pushed.
+    std::atomic< std::ptrdiff_t > numTasks_ {0};
+
+    TaskQueue_                                 sharedQueue_;
+    std::vector< std::unique_ptr< PerThread_ >> perThread_;
+    ThreadStatsCounter_                        externalStats_;
 
     // Stats
     std::atomic_int numWorkingThreads_ {0};
 
+    std::vector< std::unique_ptr< WorkingThread_ >> threads_; // not thread-safe
+
 };
 
 #endif
@@ -357,7 +357,6 @@ inline DisplayData readAllFrameDataFromOutput(
         // Read snapshot.
         h5::File file(inputs.trajSnapshot.string(), h5::File::ReadOnly);
         h5::Group groupHeader = file.getGroup("/header");
-        h5::Group groupSnapshots = file.getGroup("/snapshots");
 
         // Read number of frames.
         std::int64_t numFrames = 0;
@@ -376,7 +375,7 @@ inline DisplayData readAllFrameDataFromOutput(
         for(Index curFrame = 0; curFrame < numFrames; ++curFrame) {
             if(curFrame % 20 == 0) log::info("Loading frame {}", curFrame);
             OutputStructSnapshot outSnapshot;
-            read(outSnapshot, groupSnapshots, curFrame);
+            read(outSnapshot, file, curFrame);
             res.frames.push_back(readOneFrameDataFromOutput(meta, outSnapshot, res.displayTypeMap));
 
             // Energies.